@@ -0,0 +1,682 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Math\Vectors.h"
+#include "Math\SoA.h"
+#include "Math\Compression.h"
+#include "Math\Expressions.h"
+#include "Math\Matrices.h"
+#include "Math\Transforms.h"
+#include "Math\Dense.h"
+#include "Math\Hierarchy.h"
+#include "Math\Animation.h"
+#include "Math\Skinning.h"
+#include "Math\Kinematics.h"
+#include "Math\Curves.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                        HELPERS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @brief Times a function, keeping the fastest of several runs to filter out scheduling noise
+ * @param f The function to time
+ * @param repeats Number of runs
+ * @return [double] Seconds taken by the fastest run
+ */
+template<typename F>
+double BestTime(F f, int repeats = 7)
+{
+    double best = 1e30;
+    for (int r=0; r<repeats; r++)
+    {
+        auto start = chrono::steady_clock::now();
+        f();
+        chrono::duration<double> d = chrono::steady_clock::now() - start;
+        if (d.count() < best) best = d.count();
+    }
+    return best;
+}
+
+/*!
+ * @brief Prints the throughput of a timed run
+ * @param name Label of the run
+ * @param elements Number of elements processed by the run
+ * @param bytes Number of bytes read and written by the run
+ * @param seconds Time taken by the run
+ */
+inline void PrintThroughput(const string& name, double elements, double bytes, double seconds)
+{
+    cout << "  " << left << setw(28) << name << right << fixed << setprecision(1)
+         << setw(9) << elements / seconds * 1e-6 << " Melem/s"
+         << setw(9) << bytes / seconds * 1e-9 << " GB/s" << endl;
+}
+
+/*!
+ * @brief Prints the arithmetic rate of a timed run
+ * @param name Label of the run
+ * @param flops Number of floating-point operations performed by the run
+ * @param seconds Time taken by the run
+ */
+inline void PrintFlops(const string& name, double flops, double seconds)
+{
+    cout << "  " << left << setw(28) << name << right << fixed << setprecision(2)
+         << setw(9) << flops / seconds * 1e-9 << " GFLOP/s" << endl;
+}
+
+//! Keeps the compiler from discarding results that are never read
+#if defined(__GNUC__)
+inline void Consume(float f) {asm volatile("" :: "x"(f));}
+#else
+inline void Consume(float f) {static volatile float sink; sink = f; (void)sink;}
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                       BENCHMARKS
+//---------------------------------------------------------------------------------------------
+
+struct BenchmarkCompression
+{
+    //! Number of unit vectors packed and unpacked per run
+    static const int n = 1 << 20;
+    SoA<Vector3> a, out;
+    SoA<Vector4> a4, out4;
+    SoA<Quaternion> q, outq;
+
+    BenchmarkCompression() : a(n), out(n), a4(n), out4(n), q(n), outq(n)
+    {
+        for (int i=0; i<n; i++)
+        {
+            float z = 1.0f - (2.0f*i + 1.0f)/n, r = sqrtf(1.0f - z*z), phi = 2.39996323f*i;
+            Vector3 v(r*cosf(phi), r*sinf(phi), z);
+            a.Set(i, v);
+            a4.Set(i, Vector4(v.x, v.y, v.z, 1.0f));
+            float t = 3.14159265f*fmodf(0.618034f*i, 1.0f);
+            q.Set(i, Quaternion(v*sinf(t), cosf(t)));
+        }
+    }
+    //! Times the batch kernels of one packed type. Pack reads 12 bytes (16 for Vector4) and
+    //! writes sizeof(P) per element, unpack does the reverse
+    template<typename P, typename V, typename PackF, typename UnpackF>
+    void Run(const string& name, SoA<V>& in, SoA<V>& res, PackF pack, UnpackF unpack)
+    {
+        vector<P> packed(n);
+        double bytes = double(n) * (sizeof(float)*SoA<V>::Components + sizeof(P));
+        PrintThroughput(name + " pack", n, bytes, BestTime([&]{pack(in, packed.data());}));
+        PrintThroughput(name + " unpack", n, bytes, BestTime([&]{unpack(packed.data(), res);}));
+        Consume(res.X()[n/2]);
+    }
+    //! Times the smallest-three kernels of one code size. Pack reads 16 bytes and writes bits/8
+    //! per element, unpack does the reverse
+    void RunSmallestThree(int bits)
+    {
+        vector<uint8_t> packed(SmallestThreeStreamBytes(n, bits));
+        double bytes = double(n) * (sizeof(Quaternion) + bits/8.0);
+        string name = "SmallestThree" + to_string(bits);
+        PrintThroughput(name + " pack", n, bytes, BestTime([&]{PackSmallestThree(q, bits, packed.data());}));
+        PrintThroughput(name + " unpack", n, bytes, BestTime([&]{UnpackSmallestThree(packed.data(), bits, outq);}));
+        Consume(outq.W()[n/2]);
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "     PACKED VECTOR THROUGHPUT (" << n << " elements)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        Run<Half3>("Half3", a, out,
+            [](const SoASpan<const Vector3>& s, Half3 *p) {PackHalf3(s, p);},
+            [](const Half3 *p, const SoASpan<Vector3>& s) {UnpackHalf3(p, s);});
+        Run<Half4>("Half4", a4, out4,
+            [](const SoASpan<const Vector4>& s, Half4 *p) {PackHalf4(s, p);},
+            [](const Half4 *p, const SoASpan<Vector4>& s) {UnpackHalf4(p, s);});
+        Run<SNorm16x3>("SNorm16x3", a, out,
+            [](const SoASpan<const Vector3>& s, SNorm16x3 *p) {PackSNorm16x3(s, p);},
+            [](const SNorm16x3 *p, const SoASpan<Vector3>& s) {UnpackSNorm16x3(p, s);});
+        Run<Octahedral32>("Octahedral32", a, out,
+            [](const SoASpan<const Vector3>& s, Octahedral32 *p) {PackOctahedral32(s, p);},
+            [](const Octahedral32 *p, const SoASpan<Vector3>& s) {UnpackOctahedral32(p, s);});
+        RunSmallestThree(MATH_SMALLEST_THREE_MIN_BITS);
+        RunSmallestThree(MATH_SMALLEST_THREE_MAX_BITS);
+        cout << endl;
+    }
+};
+
+struct BenchmarkExpressions
+{
+    //! Number of vectors per run
+    static const int n = 1 << 18;
+    vector<Vector3> a, b, c, out;
+    vector<Vector4> a4, b4, out4;
+    Quaternion q;
+
+    BenchmarkExpressions() : a(n), b(n), c(n), out(n), a4(n), b4(n), out4(n), q(0.2f, -0.4f, 0.1f, 0.87f)
+    {
+        for (int i=0; i<n; i++)
+        {
+            a[i] = Vector3(1.0f + 0.001f*i, 2.0f, -0.5f*(i % 7));
+            b[i] = Vector3(0.25f, -1.0f - 0.002f*(i % 13), 3.0f);
+            c[i] = Vector3(-2.0f, 0.5f, 1.0f + 0.003f*(i % 5));
+            a4[i] = Vector4(a[i].x, a[i].y, a[i].z, 1.0f);
+            b4[i] = Vector4(b[i].x, b[i].y, b[i].z, -2.0f);
+        }
+    }
+    //! Times an eager and a lazy version of the same per-element expression
+    template<typename V, typename EagerF, typename LazyF>
+    void Run(const string& name, vector<V>& res, EagerF eager, LazyF lazy)
+    {
+        double bytes = double(n) * 4 * sizeof(V);
+        PrintThroughput(name + " eager", n, bytes, BestTime([&]{for (int i=0; i<n; i++) res[i] = eager(i);}));
+        PrintThroughput(name + " lazy", n, bytes, BestTime([&]{for (int i=0; i<n; i++) res[i] = lazy(i);}));
+        Consume(res[n/2][0]);
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "    LAZY EXPRESSION THROUGHPUT (" << n << " elements)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        const float s0 = 0.5f, s1 = 1.5f, s2 = -0.25f, s3 = 3.0f;
+        Run("Vector3 chain", out,
+            [&](int i) {return a[i]*s0 + b[i]*s1 - c[i]*s2 + (a[i] - b[i])*s3 - (c[i] + a[i])/s1 + CrossProduct(a[i], c[i]);},
+            [&](int i) {return Eval(Lazy(a[i])*s0 + Lazy(b[i])*s1 - Lazy(c[i])*s2 + (Lazy(a[i]) - b[i])*s3
+                                    - (Lazy(c[i]) + a[i])/s1 + CrossProduct(Lazy(a[i]), Lazy(c[i])));});
+        Run("Vector4 chain", out4,
+            [&](int i) {return a4[i]*s0 + b4[i]*s1 - (a4[i] - b4[i])*s3 - (b4[i] + a4[i])/s1;},
+            [&](int i) {return Eval(Lazy(a4[i])*s0 + Lazy(b4[i])*s1 - (Lazy(a4[i]) - b4[i])*s3 - (Lazy(b4[i]) + a4[i])/s1);});
+        Run("Rejection", out,
+            [&](int i) {return a[i] - ((a[i]*b[i])/(b[i]*b[i]))*b[i];},
+            [&](int i) {return Eval(Lazy(a[i]) - Lazy(b[i])*((a[i]*b[i])/(b[i]*b[i])));});
+        Vector3 u = q.GetVector();
+        float uDotU = u.x*u.x + u.y*u.y + u.z*u.z;
+        Run("Quaternion rotation", out,
+            [&](int i) {return a[i]*(q.w*q.w - uDotU) + u*u*a[i]*2.0f + CrossProduct(u, a[i])*q.w*2.0f;},
+            [&](int i) {return Eval(Lazy(a[i])*(q.w*q.w - uDotU) + Lazy(a[i])*(u*u)*2.0f + CrossProduct(Lazy(u), Lazy(a[i]))*q.w*2.0f);});
+        cout << endl;
+    }
+};
+
+struct BenchmarkMatrices
+{
+    //! Number of matrices per run, small enough to stay in cache so the kernels are measured
+    static const int n = 1 << 11;
+    vector<Matrix4> a, b, out;
+    vector<Transform4> ta, tb, tout;
+    vector<Vector4> v, vout;
+
+    BenchmarkMatrices() : a(n), b(n), out(n), ta(n), tb(n), tout(n), v(n), vout(n)
+    {
+        for (int i=0; i<n; i++)
+        {
+            // Diagonally dominant, so the scalar Cofactor reference never hits its singular branch
+            a[i] = Matrix4::Generate([&](int r, int c) {return float((r*5 + c*3 + i) % 9) - 4.0f + (r == c ? 20.0f : 0.0f);});
+            b[i] = Matrix4::Generate([&](int r, int c) {return 0.25f*float((r + c*7 + i) % 5) - 0.5f;});
+            const Matrix4& A = a[i];
+            const Matrix4& B = b[i];
+            ta[i] = Transform4(A(0,0), A(0,1), A(0,2), 1.0f, A(1,0), A(1,1), A(1,2), 2.0f, A(2,0), A(2,1), A(2,2), float(i % 3));
+            tb[i] = Transform4(B(0,0), B(0,1), B(0,2), -1.0f, B(1,0), B(1,1), B(1,2), 0.5f, B(2,0), B(2,1), B(2,2), 2.0f);
+            v[i] = Vector4(1.0f, -2.0f, 0.5f*(i % 4), 1.0f);
+        }
+    }
+    //! Times the library kernel and a plain scalar loop computing the same result
+    template<typename T, typename KernelF, typename ScalarF>
+    void Run(const string& name, vector<T>& res, double bytes, KernelF kernel, ScalarF scalar)
+    {
+        PrintThroughput(name, n, n*bytes, BestTime([&]{for (int i=0; i<n; i++) res[i] = kernel(i);}));
+        PrintThroughput(name + " scalar", n, n*bytes, BestTime([&]{for (int i=0; i<n; i++) res[i] = scalar(i);}));
+        Consume(reinterpret_cast<const float *>(&res[n/2])[5]);
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "     MATRIX4 KERNEL THROUGHPUT (" << n << " elements)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        const double m = sizeof(Matrix4);
+        Run("Matrix4*Matrix4", out, 3*m, [&](int i) {return a[i]*b[i];},
+            [&](int i) {return Matrix4::Generate([&](int r, int c)
+                {return a[i](r,0)*b[i](0,c) + a[i](r,1)*b[i](1,c) + a[i](r,2)*b[i](2,c) + a[i](r,3)*b[i](3,c);});});
+        Run("Matrix4*Vector4", vout, m + 2*sizeof(Vector4), [&](int i) {return a[i]*v[i];},
+            [&](int i) {return Vector4(a[i](0,0)*v[i].x + a[i](0,1)*v[i].y + a[i](0,2)*v[i].z + a[i](0,3)*v[i].w,
+                                       a[i](1,0)*v[i].x + a[i](1,1)*v[i].y + a[i](1,2)*v[i].z + a[i](1,3)*v[i].w,
+                                       a[i](2,0)*v[i].x + a[i](2,1)*v[i].y + a[i](2,2)*v[i].z + a[i](2,3)*v[i].w,
+                                       a[i](3,0)*v[i].x + a[i](3,1)*v[i].y + a[i](3,2)*v[i].z + a[i](3,3)*v[i].w);});
+        Run("Transform4*Transform4", tout, 3*m, [&](int i) {return ta[i]*tb[i];},
+            [&](int i) {const Transform4& A = ta[i]; const Transform4& B = tb[i];
+                return Transform4(
+                    A(0,0)*B(0,0) + A(0,1)*B(1,0) + A(0,2)*B(2,0), A(0,0)*B(0,1) + A(0,1)*B(1,1) + A(0,2)*B(2,1),
+                    A(0,0)*B(0,2) + A(0,1)*B(1,2) + A(0,2)*B(2,2), A(0,0)*B(0,3) + A(0,1)*B(1,3) + A(0,2)*B(2,3) + A(0,3),
+                    A(1,0)*B(0,0) + A(1,1)*B(1,0) + A(1,2)*B(2,0), A(1,0)*B(0,1) + A(1,1)*B(1,1) + A(1,2)*B(2,1),
+                    A(1,0)*B(0,2) + A(1,1)*B(1,2) + A(1,2)*B(2,2), A(1,0)*B(0,3) + A(1,1)*B(1,3) + A(1,2)*B(2,3) + A(1,3),
+                    A(2,0)*B(0,0) + A(2,1)*B(1,0) + A(2,2)*B(2,0), A(2,0)*B(0,1) + A(2,1)*B(1,1) + A(2,2)*B(2,1),
+                    A(2,0)*B(0,2) + A(2,1)*B(1,2) + A(2,2)*B(2,2), A(2,0)*B(0,3) + A(2,1)*B(1,3) + A(2,2)*B(2,3) + A(2,3));});
+        Run("Transpose", out, 2*m, [&](int i) {return Transpose(a[i]);},
+            [&](int i) {return Matrix4::Generate([&](int r, int c) {return a[i](c,r);});});
+        Run("Cofactor", out, 2*m, [&](int i) {return Cofactor(a[i]);},
+            [&](int i) {return Det(a[i])*Transpose(Inverse(a[i]));});
+        // Batch inversion against the single matrix functions
+        vector<float> det(n);
+        vector<uint8_t> valid((n + 7)/8);
+        PrintThroughput("TryInverse Matrix4 batch", n, n*(2*m + 4), BestTime([&]{TryInverse(a.data(), n, out.data(), det.data(), valid.data());}));
+        PrintThroughput("TryInverse Matrix4", n, n*(2*m + 4), BestTime([&]{for (int i=0; i<n; i++) TryInverse(a[i], out[i], det[i]);}));
+        PrintThroughput("Inverse Matrix4", n, n*2*m, BestTime([&]{for (int i=0; i<n; i++) out[i] = Inverse(a[i]);}));
+        PrintThroughput("TryInverse Transform4 batch", n, n*(2*m + 4), BestTime([&]{TryInverse(ta.data(), n, tout.data(), det.data(), valid.data());}));
+        PrintThroughput("TryInverse Transform4", n, n*(2*m + 4), BestTime([&]{for (int i=0; i<n; i++) TryInverse(ta[i], tout[i], det[i]);}));
+        PrintThroughput("Inverse Transform4", n, n*2*m, BestTime([&]{for (int i=0; i<n; i++) tout[i] = Inverse(ta[i]);}));
+        Consume(out[n/2](1,2) + tout[n/2](0,3) + det[n/2]);
+        cout << endl;
+    }
+};
+
+struct BenchmarkTransforms
+{
+    //! Number of elements per run, enough to be split across MathThreadCount() threads
+    static const int n = 1 << 18;
+    //! Interleaved vertex layout read through strided spans
+    struct Vertex {Point3 p; Vector3 n; float uv[2];};
+    Transform4 T;
+    vector<Point3> p, pout;
+    vector<Vector3> v, vout;
+    vector<Plane> f, fout;
+    vector<Vertex> verts;
+    SoA<Point3> ps, psout;
+    vector<Transform4> trs;
+    vector<Quaternion> q, qb, qout;
+    vector<float> blend;
+    vector<UnitQuaternion> uq;
+    SoA<UnitQuaternion> uqs;
+    SoA<Vector3> vs, vso;
+    SoA<Matrix3> rots;
+    vector<uint8_t> valid;
+    vector<Matrix3> sym, rot, rotV;
+
+    BenchmarkTransforms() : p(n), pout(n), v(n), vout(n), f(n), fout(n), verts(n), ps(n), psout(n), trs(n), q(n), qb(n), qout(n), blend(n), uq(n), uqs(n), vs(n), vso(n), rots(n), valid(n/8), sym(n), rot(n), rotV(n)
+    {
+        T = Transform4(0.0f, -1.5f, 0.0f, 2.0f, 1.5f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.5f, 0.25f);
+        for (int i=0; i<n; i++)
+        {
+            p[i] = Point3(0.25f*(i % 7) - 1.0f, 0.5f - 0.125f*(i % 5), 0.0625f*(i % 11));
+            v[i] = Vector3(0.5f - 0.0625f*(i % 13), 0.125f*(i % 3) + 0.25f, -0.75f + 0.25f*(i % 4));
+            f[i] = Plane(v[i], 0.5f*(i % 6) - 1.25f);
+            verts[i].p = p[i];
+            verts[i].n = v[i];
+            ps.Set(i, p[i]);
+            trs[i] = ComposeTRS(p[i], Quaternion(v[i], 0.5f), Vector3(1.0f + 0.25f*(i % 3), 0.5f, (i % 2) ? 2.0f : -2.0f));
+            sym[i] = Matrix3(2.0f + p[i].x, v[i].x, v[i].y, v[i].x, 1.0f + p[i].y, v[i].z, v[i].y, v[i].z, p[i].z);
+            uq[i] = UnitQuaternion(Quaternion(v[i], 0.5f));
+            q[i] = uq[i];
+            uqs.Set(i, uq[i]);
+            vs.Set(i, v[i]);
+            qb[i] = Normalize(Quaternion(0.5f, v[i].z, p[i].x, v[i].y));
+            blend[i] = (i % 17)/16.0f;
+        }
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   BATCH TRANSFORM THROUGHPUT (" << n << " elements, " << MathThreadCount() << " threads)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        const double b3 = 2*sizeof(Vector3), b4 = 2*sizeof(Plane);
+        PrintThroughput("TransformPoints", n, n*b3, BestTime([&]{TransformPoints(T, p, pout);}));
+        // Chunks below the threading threshold measure the single thread kernel
+        PrintThroughput("TransformPoints 1 thread", n, n*b3, BestTime([&]
+        {
+            for (int i=0; i<n; i += MATH_TRANSFORM_PARALLEL_GRAIN)
+                TransformPoints(T, StridedSpan<const Point3>(&p[i], MATH_TRANSFORM_PARALLEL_GRAIN), StridedSpan<Point3>(&pout[i], MATH_TRANSFORM_PARALLEL_GRAIN));
+        }));
+        PrintThroughput("TransformPoints scalar", n, n*b3, BestTime([&]{for (int i=0; i<n; i++) pout[i] = T*p[i] + T.GetTranslation();}));
+        PrintThroughput("TransformPoints SoA", n, n*b3, BestTime([&]{TransformPoints(T, ps, psout);}));
+        PrintThroughput("TransformPoints strided", n, n*b3, BestTime([&]
+        {
+            StridedSpan<Point3> s(&verts[0].p, n, sizeof(Vertex));
+            TransformPoints(T, s, s);
+        }));
+        PrintThroughput("TransformVectors", n, n*b3, BestTime([&]{TransformVectors(T, v, vout);}));
+        PrintThroughput("TransformVectors scalar", n, n*b3, BestTime([&]{for (int i=0; i<n; i++) vout[i] = T*v[i];}));
+        PrintThroughput("TransformNormals", n, n*b3, BestTime([&]{TransformNormals(T, v, vout);}));
+        PrintThroughput("TransformNormals scalar", n, n*b3, BestTime([&]{for (int i=0; i<n; i++) vout[i] = v[i]*T;}));
+        PrintThroughput("TransformPlanes", n, n*b4, BestTime([&]{TransformPlanes(T, f, fout);}));
+        PrintThroughput("TransformPlanes scalar", n, n*b4, BestTime([&]{for (int i=0; i<n; i++) fout[i] = f[i]*T;}));
+        const double bt = sizeof(Transform4) + sizeof(Point3) + sizeof(Quaternion) + sizeof(Vector3);
+        PrintThroughput("DecomposeTRS", n, n*bt, BestTime([&]{DecomposeTRS(trs.data(), n, pout.data(), q.data(), vout.data(), valid.data());}, 3));
+        PrintThroughput("DecomposeTRS scalar", n, n*bt, BestTime([&]{for (int i=0; i<n; i++) DecomposeTRS(trs[i], pout[i], q[i], vout[i]);}, 3));
+        PrintThroughput("ComposeTRS", n, n*bt, BestTime([&]{ComposeTRS(pout.data(), q.data(), vout.data(), n, trs.data());}));
+        PrintThroughput("ComposeTRS scalar", n, n*bt, BestTime([&]{for (int i=0; i<n; i++) trs[i] = ComposeTRS(pout[i], q[i], vout[i]);}));
+        // Quaternion checks and normalizes, UnitQuaternion does neither
+        const double bq = sizeof(Quaternion) + sizeof(Matrix3);
+        PrintThroughput("GetRotation Quaternion scalar", n, n*bq, BestTime([&]{for (int i=0; i<n; i++) rot[i] = q[i].GetRotation();}));
+        PrintThroughput("GetRotation UnitQuaternion scalar", n, n*bq, BestTime([&]{for (int i=0; i<n; i++) rot[i] = uq[i].GetRotation();}));
+        PrintThroughput("QuaternionsToRotations", n, n*bq, BestTime([&]{QuaternionsToRotations(uq, rot);}));
+        PrintThroughput("QuaternionsToRotations SoA", n, n*bq, BestTime([&]{QuaternionsToRotations(uqs, rots);}));
+        PrintThroughput("SetRotation Quaternion scalar", n, n*bq, BestTime([&]{for (int i=0; i<n; i++) q[i].SetRotation(rot[i]);}));
+        PrintThroughput("SetRotation UnitQuaternion scalar", n, n*bq, BestTime([&]{for (int i=0; i<n; i++) uq[i].SetRotation(rot[i]);}));
+        PrintThroughput("RotationsToQuaternions", n, n*bq, BestTime([&]{RotationsToQuaternions(rot, uq);}));
+        PrintThroughput("RotationsToQuaternions SoA", n, n*bq, BestTime([&]{RotationsToQuaternions(rots, uqs);}));
+        // One rotation for every vector, then one per vector, against the Matrix3 path
+        const UnitQuaternion r = uq[1];
+        const Matrix3 R = r.GetRotation();
+        const Transform4 TR(R(0,0), R(0,1), R(0,2), 0.0f, R(1,0), R(1,1), R(1,2), 0.0f, R(2,0), R(2,1), R(2,2), 0.0f);
+        PrintThroughput("TransformVectors UnitQuaternion", n, n*b3, BestTime([&]{TransformVectors(r, v, vout);}));
+        PrintThroughput("TransformVectors Matrix3", n, n*b3, BestTime([&]{TransformVectors(TR, v, vout);}));
+        PrintThroughput("Transform Quaternion scalar", n, n*b3, BestTime([&]{for (int i=0; i<n; i++) vout[i] = Transform(v[i], q[1]);}));
+        PrintThroughput("Matrix3*Vector3 scalar", n, n*b3, BestTime([&]{for (int i=0; i<n; i++) vout[i] = R*v[i];}));
+        const double bv = 2*sizeof(Vector3) + sizeof(Quaternion);
+        PrintThroughput("TransformVectors UnitQuaternions", n, n*bv, BestTime([&]{TransformVectors(uq, v, vout);}));
+        PrintThroughput("TransformVectors UnitQuaternions SoA", n, n*bv, BestTime([&]{TransformVectors(uqs, vs, vso);}));
+        PrintThroughput("Transform UnitQuaternion scalar", n, n*bv, BestTime([&]{for (int i=0; i<n; i++) vout[i] = Transform(v[i], uq[i]);}));
+        PrintThroughput("GetRotation()*Vector3 scalar", n, n*bv, BestTime([&]{for (int i=0; i<n; i++) vout[i] = uq[i].GetRotation()*v[i];}));
+        const double bi = 3*sizeof(Quaternion) + sizeof(float);
+        PrintThroughput("Nlerp", n, n*bi, BestTime([&]{Nlerp(q.data(), qb.data(), blend.data(), n, qout.data());}));
+        PrintThroughput("Nlerp scalar", n, n*bi, BestTime([&]{for (int i=0; i<n; i++) qout[i] = Nlerp(q[i], qb[i], blend[i]);}));
+        PrintThroughput("Slerp", n, n*bi, BestTime([&]{Slerp(q.data(), qb.data(), blend.data(), n, qout.data());}));
+        PrintThroughput("Slerp scalar", n, n*bi, BestTime([&]{for (int i=0; i<n; i++) qout[i] = Slerp(q[i], qb[i], blend[i]);}));
+        PrintThroughput("SlerpFast", n, n*bi, BestTime([&]{SlerpFast(q.data(), qb.data(), blend.data(), n, qout.data());}));
+        PrintThroughput("SlerpFast scalar", n, n*bi, BestTime([&]{for (int i=0; i<n; i++) qout[i] = SlerpFast(q[i], qb[i], blend[i]);}));
+        const double be = 2*sizeof(Matrix3) + sizeof(Vector3);
+        PrintThroughput("DiagonalizeSymmetric", n, n*be, BestTime([&]{DiagonalizeSymmetric(sym.data(), n, rot.data(), vout.data());}, 3));
+        PrintThroughput("DiagonalizeSymmetric scalar", n, n*be, BestTime([&]{for (int i=0; i<n; i++) DiagonalizeSymmetric(sym[i], rot[i], vout[i]);}, 3));
+        const double bs = 3*sizeof(Matrix3) + sizeof(Vector3);
+        PrintThroughput("SVD", n, n*bs, BestTime([&]{SVD(sym.data(), n, rot.data(), vout.data(), rotV.data());}, 3));
+        PrintThroughput("SVD scalar", n, n*bs, BestTime([&]{for (int i=0; i<n; i++) SVD(sym[i], rot[i], vout[i], rotV[i]);}, 3));
+        Consume(pout[n/2].x + vout[n/2].y + fout[n/2].w + psout.Get(n/2).z + vso.Get(n/2).z + verts[n/2].p.x + q[n/2].w + qout[n/2].w + uq[n/2].w + trs[n/2](0,0) + rot[n/2](0,0));
+        cout << endl;
+    }
+};
+struct BenchmarkDense
+{
+    //! Deterministic well conditioned n x n matrix
+    static MatrixX Sample(int n)
+    {
+        return MatrixX::Generate(n, n, [&](int i, int j) {return sinf(1.3f*i + 2.9f*j + 0.7f*i*j) + (i == j ? 2.0f : 0.0f);});
+    }
+    void Run(int n)
+    {
+        const double N = n;
+        MatrixX A = Sample(n), B = Sample(n), C;
+        MatrixX S = TransposeTimes(A, A)*(1.0f/n) + MatrixX::Identity(n);
+        LUDecomposition lu;
+        CholeskyDecomposition ch;
+        QRDecomposition qr;
+        const string size = " " + to_string(n);
+        PrintFlops("GEMM" + size, 2*N*N*N, BestTime([&]{C = A*B;}));
+        PrintFlops("LU" + size, 2*N*N*N/3, BestTime([&]{lu.Factor(A);}));
+        PrintFlops("Cholesky" + size, N*N*N/3, BestTime([&]{ch.Factor(S);}));
+        PrintFlops("QR" + size, 4*N*N*N/3, BestTime([&]{qr.Factor(A);}));
+        PrintFlops("LU solve" + size, 2*N*N*N, BestTime([&]{C = lu.Solve(B);}));
+        Consume(C(n/2,n/3) + lu.LU(n - 1,n - 1) + ch.L(n - 1,n - 1) + qr.QR(n - 1,n - 1));
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   DENSE LINEAR ALGEBRA (" << MathThreadCount() << " threads)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        // Naive triple loop reference, columns of C accumulated in the cache friendly order
+        const int n = 256;
+        MatrixX A = Sample(n), B = Sample(n), C(n, n);
+        PrintFlops("GEMM 256 naive", 2.0*n*n*n, BestTime([&]
+        {
+            for (int j=0; j<n; j++)
+                for (int p=0; p<n; p++)
+                    for (int i=0; i<n; i++) C(i,j) += A(i,p)*B(p,j);
+        }, 3));
+        Consume(C(n/2,n/2));
+        for (int size : {128, 256, 512}) Run(size);
+        cout << endl;
+    }
+};
+struct BenchmarkHierarchy
+{
+    static const int n = 100000;
+    //! Scene of n nodes with 4 children per node, 9 levels deep
+    static int Parent(int i) {return (i == 0) ? TransformHierarchy::NoParent : (i - 1)/4;}
+    static Transform4 Local(int i) {return ComposeTRS(Point3(0.5f, 0.25f*(i % 3), -0.125f), Quaternion(Vector3(0.0f, 1.0f, 0.5f), 0.01f*(i % 11)), Vector3(1.0f, 1.0f, 1.0f));}
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   TRANSFORM HIERARCHY (" << n << " nodes, " << MathThreadCount() << " threads)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        vector<Transform4> local(n), world(n);
+        vector<int> parent(n);
+        TransformHierarchy H;
+        H.Reserve(n);
+        for (int i=0; i<n; i++)
+        {
+            local[i] = Local(i);
+            parent[i] = Parent(i);
+            H.AddNode(local[i], parent[i]);
+        }
+        const double b = 2*sizeof(Transform4);
+        // Every world matrix recomputed by hand each frame, parents first
+        PrintThroughput("Compose by hand", n, n*b, BestTime([&]
+        {
+            world[0] = local[0];
+            for (int i=1; i<n; i++) world[i] = world[parent[i]]*local[i];
+        }));
+        PrintThroughput("UpdateAll", n, n*b, BestTime([&]{H.UpdateAll();}));
+        // One node in 100 animated, mostly leaves like a typical frame
+        PrintThroughput("Update 1% dirty", n, n*b, BestTime([&]
+        {
+            for (int i=n - 1; i>0; i -= 100) H.SetLocal(i, local[i]);
+            H.Update();
+        }));
+        Consume(world[n/2](0,3) + H.GetWorld(n/2)(0,3));
+        cout << endl;
+    }
+};
+
+struct BenchmarkAnimation
+{
+    static const int bones = 80, frames = 120, poses = 256;
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   ANIMATION SAMPLING (" << poses << " poses of " << bones << " bones)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        vector<Quaternion> rotation(bones*frames);
+        vector<Point3> translation(bones*frames);
+        vector<Vector3> scale(bones*frames);
+        for (int f=0; f<frames; f++)
+            for (int b=0; b<bones; b++)
+            {
+                const int i = f*bones + b;
+                const float a = 0.05f*f + 0.1f*b;
+                rotation[i] = Quaternion(Normalize(Vector3(1.0f, 0.5f*(b % 3), -0.25f)) * sinf(a), cosf(a));
+                translation[i] = Point3(0.01f*f, 0.1f*b, 1.0f);
+                scale[i] = Vector3(1.0f, 1.0f + 0.001f*f, 1.0f);
+            }
+        AnimationClip clip(bones, frames, 30.0f, rotation.data(), translation.data(), scale.data());
+        cout << "  Raw keys " << bones*frames*(sizeof(Quaternion) + sizeof(Point3) + sizeof(Vector3))
+             << " bytes, clip " << clip.Bytes() << " bytes" << endl;
+
+        SoA<Quaternion> rq(bones);
+        SoA<Point3> rp(bones);
+        SoA<Vector3> rs(bones);
+        const double n = double(poses)*bones, b = n*2*(sizeof(Quaternion) + sizeof(Point3) + sizeof(Vector3));
+        // Poses at spread out times, as for a crowd of skeletons playing the clip out of phase
+        auto time = [&](int k) {return clip.Duration()*float(k)/float(poses);};
+        PrintThroughput("Raw keys Nlerp + lerp", n, b, BestTime([&]
+        {
+            for (int k=0; k<poses; k++)
+            {
+                const float p = time(k)*30.0f;
+                const int f0 = min(int(p), frames - 2);
+                const float t = p - float(f0);
+                for (int j=0; j<bones; j++)
+                {
+                    const int i = f0*bones + j, i1 = i + bones;
+                    rq.Set(j, Nlerp(rotation[i], rotation[i1], t));
+                    rp.Set(j, Point3(translation[i].x + (translation[i1].x - translation[i].x)*t, translation[i].y + (translation[i1].y - translation[i].y)*t,
+                                     translation[i].z + (translation[i1].z - translation[i].z)*t));
+                    rs.Set(j, scale[i] + (scale[i1] - scale[i])*t);
+                }
+            }
+        }));
+        PrintThroughput("SampleBone", n, b, BestTime([&]
+        {
+            for (int k=0; k<poses; k++)
+                for (int j=0; j<bones; j++)
+                {
+                    Quaternion q;
+                    Point3 p;
+                    Vector3 s;
+                    clip.SampleBone(j, time(k), q, p, s);
+                    rq.Set(j, q); rp.Set(j, p); rs.Set(j, s);
+                }
+        }));
+        PrintThroughput("SamplePose", n, b, BestTime([&]{for (int k=0; k<poses; k++) clip.SamplePose(time(k), rq, rp, rs);}));
+        Consume(rq.W()[bones/2] + rp.X()[bones/2] + rs.Y()[bones/2]);
+        cout << endl;
+    }
+};
+
+struct BenchmarkSkinning
+{
+    static const int n = 1 << 17, bones = 64;
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   SKINNING (" << n << " vertices, " << bones << " bones, " << MathThreadCount() << " threads)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        vector<Transform4> palette(bones);
+        vector<DualQuaternion> dq(bones);
+        for (int b=0; b<bones; b++)
+        {
+            Quaternion q(Normalize(Vector3(1.0f, 0.1f*b, -0.5f))*sinf(0.05f*b), cosf(0.05f*b));
+            Point3 t(0.01f*b, 1.0f, -0.02f*b);
+            palette[b] = ComposeTRS(t, q, Vector3(1.0f, 1.0f, 1.0f));
+            dq[b] = DualQuaternion(UnitQuaternion::FromNormalized(q), t);
+        }
+        vector<uint16_t> index(MATH_SKINNING_INFLUENCES*n);
+        vector<Vector4> weight(n);
+        vector<Point3> pos(n), outPos(n);
+        vector<Vector3> nrm(n), outNrm(n);
+        SoA<Vector4> w(n);
+        SoA<Point3> p(n), op(n);
+        SoA<Vector3> nv(n), on(n);
+        for (int i=0; i<n; i++)
+        {
+            // Neighbouring vertices share bones, as on a real mesh
+            for (int k=0; k<MATH_SKINNING_INFLUENCES; k++) index[MATH_SKINNING_INFLUENCES*i + k] = uint16_t((i/256 + k) % bones);
+            weight[i] = Vector4(0.4f, 0.3f, 0.2f, 0.1f);
+            pos[i] = Point3(0.001f*(i % 1000), 0.002f*(i % 500), 1.0f);
+            nrm[i] = Normalize(Vector3(1.0f, 0.001f*(i % 700), 0.5f));
+            w.Set(i, weight[i]); p.Set(i, pos[i]); nv.Set(i, nrm[i]);
+        }
+        const double b = double(n)*(2*sizeof(Point3) + 2*sizeof(Vector3) + sizeof(Vector4) + MATH_SKINNING_INFLUENCES*sizeof(uint16_t));
+        // The scalar loop: every influence through operator*(Transform4, Point3) plus the translation
+        PrintThroughput("Scalar Transform4 loop", n, b, BestTime([&]
+        {
+            for (int i=0; i<n; i++)
+            {
+                Vector3 rp(0.0f, 0.0f, 0.0f), rn(0.0f, 0.0f, 0.0f);
+                for (int k=0; k<MATH_SKINNING_INFLUENCES; k++)
+                {
+                    const Transform4& T = palette[index[MATH_SKINNING_INFLUENCES*i + k]];
+                    rp = rp + weight[i][k]*(Vector3(T*pos[i]) + Vector3(T.GetTranslation()));
+                    rn = rn + weight[i][k]*(T*nrm[i]);
+                }
+                outPos[i] = Point3(rp.x, rp.y, rp.z);
+                outNrm[i] = Normalize(rn);
+            }
+        }));
+        PrintThroughput("SkinLinear", n, b, BestTime([&]{SkinLinear(palette.data(), index.data(), w, p, nv, op, on);}));
+        PrintThroughput("SkinDualQuaternion", n, b, BestTime([&]{SkinDualQuaternion(dq.data(), index.data(), w, p, nv, op, on);}));
+        Consume(outPos[n/2].x + outNrm[n/2].y + op.X()[n/2] + on.Y()[n/2]);
+        cout << endl;
+    }
+};
+struct BenchmarkKinematics
+{
+    static const int joints = 6, iterations = 10;
+    //! Times both solvers on n chains against a per-chain scalar CCD. Every run starts from the
+    //! same pose, restoring it first, and runs every iteration (zero tolerance)
+    void Run(int n)
+    {
+        SoA<Point3> pose(joints*n), work(joints*n), target(n);
+        SoA<Quaternion> rotation((joints - 1)*n);
+        vector<Vector3> scalar(joints*n);
+        for (int c=0; c<n; c++)
+        {
+            for (int j=0; j<joints; j++) pose.Set(j*n + c, Point3(0.4f*j, 0.05f*sinf(float(c + j)), 0.05f*cosf(float(c*j))));
+            target.Set(c, Point3(1.2f, 0.5f + 0.001f*(c % 500), -0.3f));
+        }
+        const SoASpan<const Point3> from = pose;
+        const SoASpan<Point3> to = work;
+        auto reset = [&]{for (int k=0; k<3; k++) memcpy(to[k], from[k], sizeof(float)*joints*n);};
+        const double b = double(n)*(2*joints*sizeof(Point3) + sizeof(Point3) + (joints - 1)*sizeof(Quaternion));
+        const string size = " (" + to_string(n) + ")";
+        PrintThroughput("Scalar CCD" + size, n, b, BestTime([&]
+        {
+            for (int i=0; i<joints*n; i++) {const Point3 p = pose.Get(i); scalar[i] = Vector3(p.x, p.y, p.z);}
+            for (int c=0; c<n; c++)
+            {
+                const Point3 g = target.Get(c);
+                const Vector3 t(g.x, g.y, g.z);
+                Vector3 p[joints];
+                for (int j=0; j<joints; j++) p[j] = scalar[j*n + c];
+                for (int it=0; it<iterations; it++)
+                    for (int j=joints - 2; j>=0; j--)
+                    {
+                        const Vector3 a = p[joints - 1] - p[j], d = t - p[j];
+                        const Quaternion r = Normalize(Quaternion(CrossProduct(a, d), Magnitude(a)*Magnitude(d) + InnerProduct(a, d)));
+                        for (int k=j + 1; k<joints; k++) p[k] = p[j] + Transform(p[k] - p[j], UnitQuaternion::FromNormalized(r));
+                    }
+                for (int j=0; j<joints; j++) scalar[j*n + c] = p[j];
+            }
+        }));
+        PrintThroughput("SolveCCD" + size, n, b, BestTime([&]{reset(); SolveCCD(joints, iterations, 0.0f, work, target, rotation);}));
+        PrintThroughput("SolveFABRIK" + size, n, b, BestTime([&]{reset(); SolveFABRIK(joints, iterations, 0.0f, work, target, rotation);}));
+        Consume(scalar[n/2].x + work.X()[n/2] + rotation.W()[n/2]);
+    }
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   INVERSE KINEMATICS (" << joints << " joints, " << iterations << " iterations, " << MathThreadCount() << " threads)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        Run(1000);
+        Run(10000);
+        cout << endl;
+    }
+};
+struct BenchmarkCurves
+{
+    static const int segments = 64, steps = 1024, n = segments*steps;
+    void AllBenchmarks(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   CURVES (" << segments << " Catmull-Rom segments, " << n << " samples)" << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+
+        vector<Point3> points(segments + 1);
+        for (int i=0; i<=segments; i++) points[i] = Point3(cosf(0.3f*i)*(1.0f + 0.05f*i), sinf(0.3f*i), 0.1f*i);
+        const CubicCurve curve = CubicCurve::CatmullRom(points.data(), segments + 1);
+        vector<float> u(n), s(n);
+        for (int i=0; i<n; i++) {u[i] = float(i)/steps; s[i] = curve.Length()*float(i)/n;}
+        vector<Point3> scalar(n);
+        SoA<Point3> out(n + 1);
+        const double b = double(n)*(sizeof(float) + sizeof(Point3));
+        PrintThroughput("Scalar Evaluate loop", n, b, BestTime([&]{for (int i=0; i<n; i++) scalar[i] = curve.Evaluate(u[i]);}));
+        PrintThroughput("Evaluate batch", n, b, BestTime([&]{curve.Evaluate(u.data(), n, out);}));
+        // The same parameters out of order, so that the lanes of a packet rarely share a segment
+        vector<float> shuffled(n);
+        for (int i=0; i<n; i++) shuffled[i] = u[(7919*i) % n];
+        PrintThroughput("Scalar Evaluate loop, shuffled", n, b, BestTime([&]{for (int i=0; i<n; i++) scalar[i] = curve.Evaluate(shuffled[i]);}));
+        PrintThroughput("Evaluate batch, shuffled", n, b, BestTime([&]{curve.Evaluate(shuffled.data(), n, out);}));
+        PrintThroughput("SampleUniform", n, double(n)*sizeof(Point3), BestTime([&]{curve.SampleUniform(steps, out);}));
+        PrintThroughput("Scalar EvaluateAtLength loop", n, b, BestTime([&]{for (int i=0; i<n; i++) scalar[i] = curve.EvaluateAtLength(s[i]);}));
+        PrintThroughput("EvaluateAtLength batch", n, b, BestTime([&]{curve.EvaluateAtLength(s.data(), n, out);}));
+        Consume(scalar[n/2].x + out.X()[n/2]);
+        cout << endl;
+    }
+};
@@ -0,0 +1,140 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Vectors.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+
+using namespace std;
+
+/*!
+ * Compressed animation clips. A clip holds the rotation, translation and scale of every bone of
+ * a skeleton at evenly spaced frames. Each of the 10 float tracks of a bone is range reduced: its
+ * keys are stored as 16 bit fractions of the interval between its smallest and largest value.
+ *
+ * Everything lives in one flat, pointer-free block of little-endian bytes that can be written to
+ * a file and mapped back as is (see AnimationClip::View()):
+ *
+ *  AnimationClipHeader    32 bytes
+ *  Ranges                 per group of 8 bones: the 10 x 8 track minimums, then the 10 x 8 steps
+ *  Keys                   per frame, per group of 8 bones: 10 x 8 uint16 keys
+ *
+ * A frame of a group is 160 contiguous bytes, laid out so that one load gives a component of 8
+ * bones, and a pose only reads the two frames around the sampled time. Bones past the last one
+ * pad the last group with the identity.
+ */
+
+//! Magic number of the clip header, "ANIM"
+#define MATH_ANIMATION_MAGIC 0x4D494E41u
+//! Version of the clip layout, changed with every incompatible change to it
+#define MATH_ANIMATION_VERSION 1u
+
+//---------------------------------------------------------------------------------------------
+//                                          CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class AnimationClipHeader
+ * @brief First 32 bytes of a clip. Offsets are in bytes from the start of the header
+ */
+struct AnimationClipHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t bones;
+    uint32_t frames;
+    float frameRate;            // frames per second
+    uint32_t groups;            // groups of 8 bones, the last one padded
+    uint32_t rangeOffset;
+    uint32_t keyOffset;
+};
+
+/*!
+ * @class AnimationClip
+ * @brief Compressed clip of a skeleton, either owning its bytes or viewing a block mapped from
+ *        a file. Rotations are stored with consecutive keys in the same hemisphere and
+ *        interpolated by Nlerp(), translations and scales linearly. Times are clamped to
+ *        [0, Duration()]
+ * @param Bones() Number of bones
+ * @param Frames() Number of keys per track
+ */
+struct AnimationClip
+{
+protected:
+    vector<uint8_t> storage;    // the clip bytes, empty when viewing external memory
+    const uint8_t *view;
+
+    const AnimationClipHeader& Header(void) const {return *reinterpret_cast<const AnimationClipHeader *>(Data());}
+    const float *Ranges(int group) const;
+    const uint16_t *Keys(int frame, int group) const;
+    // First key, second key and the weight of the second one for a time in seconds
+    void Frame(float time, int& f0, int& f1, float& t) const;
+public:
+    //! Bones sharing one block of keys, the width of the pose sampler
+    static const int GroupBones = 8;
+    //! Float tracks per bone: rotation x, y, z, w, translation x, y, z and scale x, y, z
+    static const int Components = 10;
+
+    //! @public @memberof AnimationClip
+    //! @brief Creates an empty clip, of no bones and no frames
+    AnimationClip();
+    /*!
+     * @public @memberof AnimationClip
+     * @brief Compresses a clip sampled at evenly spaced frames
+     * @param boneCount Number of bones
+     * @param frameCount Number of frames, at least 1
+     * @param frameRate Frames per second
+     * @param rotation Unit quaternion of bone b at frame f at [f*boneCount + b]
+     * @param translation Translations, laid out like rotation
+     * @param scale Scales, laid out like rotation
+     * @note Keys are within 1/131070 of the track range of their value, before interpolation
+     */
+    AnimationClip(int boneCount, int frameCount, float frameRate, const Quaternion *rotation, const Point3 *translation, const Vector3 *scale);
+    /*!
+     * @public @memberof AnimationClip
+     * @brief Views a clip in external memory, such as a mapped file, without copying it
+     * @param memory The clip bytes, from Data() of an earlier clip, 4 byte aligned. They must
+     *        outlive the clip and every copy of it
+     * @param bytes Size of the block
+     * @return [bool] False, leaving the clip empty, if the block is not a clip of this version,
+     *         has bones but no frame, or is too short
+     */
+    bool View(const void *memory, size_t bytes);
+
+    //! @public @memberof AnimationClip
+    //! @brief [const uint8_t*] The clip bytes, to be written to a file
+    const uint8_t *Data(void) const {return storage.empty() ? view : storage.data();}
+    //! @public @memberof AnimationClip
+    //! @brief [size_t] Size of the clip bytes
+    size_t Bytes(void) const;
+    int Bones(void) const {return int(Header().bones);}
+    int Frames(void) const {return int(Header().frames);}
+    float FrameRate(void) const {return Header().frameRate;}
+    //! @public @memberof AnimationClip
+    //! @brief [float] Time of the last frame in seconds
+    float Duration(void) const {return Frames() > 1 ? float(Frames() - 1)/FrameRate() : 0.0f;}
+
+    /*!
+     * @public @memberof AnimationClip
+     * @brief Samples one bone
+     * @param bone The bone
+     * @param time Time in seconds
+     * @param rotation The interpolated unit quaternion
+     * @param translation The interpolated translation
+     * @param scale The interpolated scale
+     */
+    void SampleBone(int bone, float time, Quaternion& rotation, Point3& translation, Vector3& scale) const;
+    /*!
+     * @public @memberof AnimationClip
+     * @brief Samples every bone, decoding and interpolating 8 bones per packet
+     * @param time Time in seconds
+     * @param rotation Bones() unit quaternions, SampleBone() up to rounding
+     * @param translation Bones() translations
+     * @param scale Bones() scales
+     */
+    void SamplePose(float time, const SoASpan<Quaternion>& rotation, const SoASpan<Point3>& translation, const SoASpan<Vector3>& scale) const;
+};
@@ -0,0 +1,431 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Vectors.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                        CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * Compact storage types for vectors kept in memory or sent to the GPU. They have no arithmetic;
+ * a value is packed once and unpacked to a Vector3/Vector4 before being used.
+ *
+ *  Half3, Half4     IEEE 754 binary16 components (10 bit mantissa), any finite vector
+ *  SNorm16x3        Components in [-1, 1] mapped onto [-32767, 32767], unit and sub-unit vectors
+ *  Octahedral32     Unit vectors folded onto the octahedron and stored as two snorm16 values
+ *  Smallest three   Unit quaternions as the index of their largest component and the other three
+ *                   quantized, 29 to 48 bits each, packed back to back into a bit stream
+ *
+ * The worst-case angular errors below are between a unit vector and its unpacked value. They
+ * were measured over several million directions, including the axes and the octahedron edges,
+ * and are checked by the unit tests.
+ */
+//! Maximum angle in radians between a unit vector and its Half3 round trip (about 0.025 degrees)
+#define MATH_HALF3_MAX_ANGULAR_ERROR 4.4e-4f
+//! Maximum angle in radians between a unit Vector4 and its Half4 round trip (about 0.025 degrees)
+#define MATH_HALF4_MAX_ANGULAR_ERROR 4.4e-4f
+//! Maximum angle in radians between a unit vector and its SNorm16x3 round trip (about 0.0016 degrees)
+#define MATH_SNORM16X3_MAX_ANGULAR_ERROR 2.8e-5f
+//! Maximum angle in radians between a unit vector and its Octahedral32 round trip (about 0.0040 degrees)
+#define MATH_OCTAHEDRAL32_MAX_ANGULAR_ERROR 7.0e-5f
+//! Smallest size in bits of a smallest-three quaternion, 9 bits per stored component
+#define MATH_SMALLEST_THREE_MIN_BITS 29
+//! Largest size in bits of a smallest-three quaternion, 16, 15 and 15 bits per stored component
+#define MATH_SMALLEST_THREE_MAX_BITS 48
+
+/*!
+ * @class Half3
+ * @brief Vector3 stored as three half-precision floats (6 bytes)
+ * @param x,y,z binary16 bit patterns of the components
+ */
+struct Half3
+{
+    uint16_t x, y, z;
+
+    //! @public @memberof Half3
+    //! @brief Creates a Half3 holding the zero vector
+    Half3() {x = y = z = 0;}
+    //! @public @memberof Half3
+    //! @brief Creates a Half3 from three binary16 bit patterns
+    Half3(uint16_t a, uint16_t b, uint16_t c) {x = a; y = b; z = c;}
+};
+
+/*!
+ * @class Half4
+ * @brief Vector4 stored as four half-precision floats (8 bytes)
+ * @param x,y,z,w binary16 bit patterns of the components
+ */
+struct Half4
+{
+    uint16_t x, y, z, w;
+
+    //! @public @memberof Half4
+    //! @brief Creates a Half4 holding the zero vector
+    Half4() {x = y = z = w = 0;}
+    //! @public @memberof Half4
+    //! @brief Creates a Half4 from four binary16 bit patterns
+    Half4(uint16_t a, uint16_t b, uint16_t c, uint16_t d) {x = a; y = b; z = c; w = d;}
+};
+
+/*!
+ * @class SNorm16x3
+ * @brief Vector3 with components in [-1, 1] stored as signed normalized 16 bit integers (6 bytes)
+ * @param x,y,z Components scaled by 32767
+ */
+struct SNorm16x3
+{
+    int16_t x, y, z;
+
+    //! @public @memberof SNorm16x3
+    //! @brief Creates a SNorm16x3 holding the zero vector
+    SNorm16x3() {x = y = z = 0;}
+    //! @public @memberof SNorm16x3
+    //! @brief Creates a SNorm16x3 from three scaled components
+    SNorm16x3(int16_t a, int16_t b, int16_t c) {x = a; y = b; z = c;}
+};
+
+/*!
+ * @class Octahedral32
+ * @brief Unit Vector3 stored as its octahedral projection (4 bytes). The direction is projected
+ *        onto the octahedron |x|+|y|+|z| = 1, the lower half is folded over the upper one and the
+ *        resulting square [-1, 1]^2 is stored as two snorm16 coordinates.
+ * @param u,v Octahedral coordinates scaled by 32767
+ */
+struct Octahedral32
+{
+    int16_t u, v;
+
+    //! @public @memberof Octahedral32
+    //! @brief Creates an Octahedral32 holding the +Z direction
+    Octahedral32() {u = v = 0;}
+    //! @public @memberof Octahedral32
+    //! @brief Creates an Octahedral32 from two scaled octahedral coordinates
+    Octahedral32(int16_t a, int16_t b) {u = a; v = b;}
+};
+
+//---------------------------------------------------------------------------------------------
+//                                    INLINE FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * HALF PRECISION * * * * * //
+
+/*!
+ * @brief Converts a float to the nearest half-precision value (round to nearest even)
+ * @param f The float
+ * @return [uint16_t] binary16 bit pattern. Values beyond 65504 become infinity, NaN stays NaN
+ */
+inline uint16_t FloatToHalf(float f)
+{
+#if MATH_SIMD_F16C
+    return uint16_t(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+    uint32_t u;
+    memcpy(&u, &f, sizeof(u));
+    uint32_t sign = (u >> 16) & 0x8000u;
+    u &= 0x7FFFFFFFu;
+    // Infinity and NaN (quieted)
+    if (u >= 0x7F800000u) return uint16_t(sign | 0x7C00u | (u > 0x7F800000u ? 0x0200u : 0u));
+    // Rounds to infinity from 65520 up
+    if (u >= 0x477FF000u) return uint16_t(sign | 0x7C00u);
+    // Subnormal halves: adding 0.5 lines the float ulp up with the half ulp, 2^-24
+    if (u < 0x38800000u)
+    {
+        float a;
+        memcpy(&a, &u, sizeof(a));
+        a += 0.5f;
+        memcpy(&u, &a, sizeof(u));
+        return uint16_t(sign | (u - 0x3F000000u));
+    }
+    // Normal halves: rebias the exponent and round the 13 dropped bits to nearest even
+    u += 0xC8000FFFu + ((u >> 13) & 1u);
+    return uint16_t(sign | (u >> 13));
+#endif
+}
+/*!
+ * @brief Converts a half-precision value to float. The conversion is exact
+ * @param h binary16 bit pattern
+ * @return [float] The value of h
+ */
+inline float HalfToFloat(uint16_t h)
+{
+#if MATH_SIMD_F16C
+    return _cvtsh_ss(h);
+#else
+    uint32_t sign = uint32_t(h & 0x8000u) << 16;
+    uint32_t em = h & 0x7FFFu;
+    uint32_t u;
+    if (em >= 0x7C00u) u = sign | 0x7F800000u | ((em & 0x03FFu) << 13);
+    else if (em >= 0x0400u) u = sign | ((em << 13) + (112u << 23));
+    else
+    {
+        float a = float(em) * 5.9604645e-8f;
+        memcpy(&u, &a, sizeof(u));
+        u |= sign;
+    }
+    float f;
+    memcpy(&f, &u, sizeof(f));
+    return f;
+#endif
+}
+
+// * * * * * SIGNED NORMALIZED * * * * * //
+
+/*!
+ * @brief Converts a float to a signed normalized 16 bit integer
+ * @param f The float, clamped to [-1, 1]
+ * @return [int16_t] round(f * 32767)
+ */
+inline int16_t FloatToSNorm16(float f)
+{
+    f = f < -1.0f ? -1.0f : (f > 1.0f ? 1.0f : f);
+    return int16_t(nearbyintf(f * 32767.0f));
+}
+/*!
+ * @brief Converts a signed normalized 16 bit integer to float
+ * @param s The integer
+ * @return [float] s / 32767, with -32768 mapped to -1
+ */
+inline float SNorm16ToFloat(int16_t s)
+{
+    float f = float(s) * (1.0f / 32767.0f);
+    return f < -1.0f ? -1.0f : f;
+}
+
+// * * * * * PACKING * * * * * //
+
+//! @brief Packs a Vector3 into half-precision components
+inline Half3 PackHalf3(const Vector3& v) {return Half3(FloatToHalf(v.x), FloatToHalf(v.y), FloatToHalf(v.z));}
+//! @brief Unpacks half-precision components into a Vector3
+inline Vector3 UnpackHalf3(const Half3& h) {return Vector3(HalfToFloat(h.x), HalfToFloat(h.y), HalfToFloat(h.z));}
+//! @brief Packs a Vector4 into half-precision components
+inline Half4 PackHalf4(const Vector4& v)
+    {return Half4(FloatToHalf(v.x), FloatToHalf(v.y), FloatToHalf(v.z), FloatToHalf(v.w));}
+//! @brief Unpacks half-precision components into a Vector4
+inline Vector4 UnpackHalf4(const Half4& h)
+    {return Vector4(HalfToFloat(h.x), HalfToFloat(h.y), HalfToFloat(h.z), HalfToFloat(h.w));}
+//! @brief Packs a Vector3 into signed normalized components. Components are clamped to [-1, 1]
+inline SNorm16x3 PackSNorm16x3(const Vector3& v)
+    {return SNorm16x3(FloatToSNorm16(v.x), FloatToSNorm16(v.y), FloatToSNorm16(v.z));}
+//! @brief Unpacks signed normalized components into a Vector3
+inline Vector3 UnpackSNorm16x3(const SNorm16x3& s)
+    {return Vector3(SNorm16ToFloat(s.x), SNorm16ToFloat(s.y), SNorm16ToFloat(s.z));}
+
+/*!
+ * @brief Packs a unit vector into its octahedral encoding
+ * @param v The unit vector. Other non-zero vectors are packed by direction
+ * @return [Octahedral32] The encoded direction
+ * @warning The zero vector yields an undefined direction
+ */
+inline Octahedral32 PackOctahedral32(const Vector3& v)
+{
+    float inv = 1.0f / (fabsf(v.x) + fabsf(v.y) + fabsf(v.z));
+    float u = v.x * inv, w = v.y * inv;
+    if (v.z < 0.0f)
+    {
+        // Fold the lower half of the octahedron over the diagonals
+        float fu = (1.0f - fabsf(w)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float fw = (1.0f - fabsf(u)) * (w >= 0.0f ? 1.0f : -1.0f);
+        u = fu; w = fw;
+    }
+    return Octahedral32(FloatToSNorm16(u), FloatToSNorm16(w));
+}
+/*!
+ * @brief Unpacks an octahedral encoding
+ * @param o The encoded direction
+ * @return [Vector3] The unit vector
+ */
+inline Vector3 UnpackOctahedral32(const Octahedral32& o)
+{
+    float x = SNorm16ToFloat(o.u), y = SNorm16ToFloat(o.v);
+    float z = 1.0f - fabsf(x) - fabsf(y);
+    // Unfold the lower half: t is zero on the upper half
+    float t = z < 0.0f ? -z : 0.0f;
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    return Normalize(Vector3(x, y, z));
+}
+
+// * * * * * SMALLEST THREE * * * * * //
+
+/*!
+ * @brief Number of bits of the kth stored component of a smallest-three quaternion
+ * @param bits Size of the quaternion in bits, MATH_SMALLEST_THREE_MIN_BITS to MATH_SMALLEST_THREE_MAX_BITS
+ * @param k 0, 1 or 2. The 2 bit index takes the rest, and bits that do not divide by 3 widen
+ *          the first components
+ * @return [int] The width of component k
+ */
+inline int SmallestThreeWidth(int bits, int k) {return (bits - 2)/3 + (k < (bits - 2) % 3 ? 1 : 0);}
+/*!
+ * @brief Bound on the rotation angle between a unit quaternion and its smallest-three round trip
+ * @param bits Size of the quaternion in bits
+ * @return [float] 2*sqrt(6)/(2^w - 2) radians, w the narrowest component width: the stored
+ *         components are within 1/(sqrt(2)*(2^w - 2)) of their values, and the rebuilt largest
+ *         one (at least 1/2) within sqrt(3) times their combined error. The unit tests check the
+ *         bound for every size. Over random rotations the worst case reaches 80 to 86% of it
+ *         when all three widths are equal: 0.47 degrees at 29 bits, 0.055 at 38 and 0.0072 at 47
+ */
+inline float SmallestThreeMaxAngularError(int bits) {return 4.89897949f/float((1 << SmallestThreeWidth(bits, 2)) - 2);}
+/*!
+ * @brief Bytes of a bit stream holding count smallest-three quaternions, including the 7 bytes
+ *        of padding that let every code be read with a single 8 byte load
+ * @param count Number of quaternions
+ * @param bits Size of each quaternion in bits
+ * @return [size_t] ceil(count*bits/8) + 7
+ */
+inline size_t SmallestThreeStreamBytes(int count, int bits) {return (size_t(count)*size_t(bits) + 7)/8 + 7;}
+
+/*!
+ * @brief Packs a unit quaternion into its smallest-three code: bits 0-1 hold the index of the
+ *        largest component by magnitude, which is dropped, and the other three follow in x, y,
+ *        z, w order. As q and -q are the same rotation, q is negated when the dropped component
+ *        is negative, which leaves the stored components within [-1/sqrt(2), 1/sqrt(2)]. They
+ *        are quantized to 2^w - 1 levels, w bits less the largest code, so that 0 is exact and
+ *        the identity round trips unchanged
+ * @param q The unit quaternion. Other quaternions are packed as if of unit length, their stored
+ *          components clamped
+ * @param bits Size of the code, MATH_SMALLEST_THREE_MIN_BITS to MATH_SMALLEST_THREE_MAX_BITS
+ * @return [uint64_t] The code, in the low bits bits
+ */
+inline uint64_t PackSmallestThree(const Quaternion& q, int bits)
+{
+    const float c[4] = {q.x, q.y, q.z, q.w};
+    int largest = 0;
+    for (int k=1; k<4; k++)
+        if (fabsf(c[k]) > fabsf(c[largest])) largest = k;
+    const float sign = (c[largest] < 0.0f) ? -1.0f : 1.0f;
+    uint64_t code = uint64_t(largest);
+    int shift = 2;
+    for (int k=0, j=0; k<4; k++)
+    {
+        if (k == largest) continue;
+        const int w = SmallestThreeWidth(bits, j++);
+        const float v = fminf(fmaxf(sign*c[k]*1.41421356f, -1.0f), 1.0f);
+        code |= uint64_t(nearbyintf((v + 1.0f)*0.5f*float((1 << w) - 2))) << shift;
+        shift += w;
+    }
+    return code;
+}
+/*!
+ * @brief Unpacks a smallest-three code
+ * @param code The code, in its low bits bits
+ * @param bits Size of the code in bits
+ * @return [Quaternion] The unit quaternion, with a non-negative largest component
+ */
+inline Quaternion UnpackSmallestThree(uint64_t code, int bits)
+{
+    const int largest = int(code & 3u);
+    float c[4], sum = 0.0f;
+    int shift = 2;
+    for (int k=0, j=0; k<4; k++)
+    {
+        if (k == largest) continue;
+        const int w = SmallestThreeWidth(bits, j++);
+        const int m = (1 << w) - 2, n = int((code >> shift) & ((uint64_t(1) << w) - 1u));
+        // 2n - m is exact, so the single rounding is the same in the batch kernel
+        c[k] = float(2*n - m)*(0.707106781f/float(m));
+        sum += c[k]*c[k];
+        shift += w;
+    }
+    c[largest] = sqrtf(fmaxf(1.0f - sum, 0.0f));
+    return Quaternion(c[0], c[1], c[2], c[3]);
+}
+/*!
+ * @brief Reads code i of a smallest-three bit stream, for random access into packed rotations
+ * @param stream The stream, of at least SmallestThreeStreamBytes(i + 1, bits) bytes
+ * @param i Index of the code
+ * @param bits Size of every code in bits
+ * @return [uint64_t] The code, for UnpackSmallestThree()
+ */
+inline uint64_t ReadSmallestThree(const uint8_t *stream, int i, int bits)
+{
+    const size_t offset = size_t(i)*size_t(bits);
+    uint64_t word;
+    memcpy(&word, stream + offset/8, sizeof(word));
+    return (word >> (offset % 8)) & ((uint64_t(1) << bits) - 1u);
+}
+/*!
+ * @brief Writes code i of a smallest-three bit stream, leaving the other codes unchanged
+ * @param stream The stream, of at least SmallestThreeStreamBytes(i + 1, bits) bytes
+ * @param i Index of the code
+ * @param bits Size of every code in bits
+ * @param code The code, from PackSmallestThree()
+ */
+inline void WriteSmallestThree(uint8_t *stream, int i, int bits, uint64_t code)
+{
+    const size_t offset = size_t(i)*size_t(bits);
+    const int shift = int(offset % 8);
+    uint64_t word;
+    memcpy(&word, stream + offset/8, sizeof(word));
+    word = (word & ~(((uint64_t(1) << bits) - 1u) << shift)) | (code << shift);
+    memcpy(stream + offset/8, &word, sizeof(word));
+}
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+//! @note Batch packing runs MATH_BATCH_WIDTH elements per step like the SoA kernels. Packed
+//!       arrays are plain arrays of structures and need no particular alignment. Every packing
+//!       function matches its single element version bit for bit.
+
+// * * * * * HALF PRECISION * * * * * //
+
+//! @brief Packs every Vector3 into half-precision components
+//! @param a The vectors
+//! @param out PackHalf3(a[i]) for every element
+void PackHalf3(const SoASpan<const Vector3>& a, Half3 *out);
+//! @brief Unpacks count Half3 structures into Vector3 structures
+//! @param in The packed vectors
+//! @param out UnpackHalf3(in[i]) for every element of the span
+void UnpackHalf3(const Half3 *in, const SoASpan<Vector3>& out);
+//! @brief Packs every Vector4 into half-precision components
+//! @param a The vectors
+//! @param out PackHalf4(a[i]) for every element
+void PackHalf4(const SoASpan<const Vector4>& a, Half4 *out);
+//! @brief Unpacks Half4 structures into Vector4 structures
+//! @param in The packed vectors
+//! @param out UnpackHalf4(in[i]) for every element of the span
+void UnpackHalf4(const Half4 *in, const SoASpan<Vector4>& out);
+
+// * * * * * SIGNED NORMALIZED * * * * * //
+
+//! @brief Packs every Vector3 into signed normalized components
+//! @param a The vectors, components clamped to [-1, 1]
+//! @param out PackSNorm16x3(a[i]) for every element
+void PackSNorm16x3(const SoASpan<const Vector3>& a, SNorm16x3 *out);
+//! @brief Unpacks SNorm16x3 structures into Vector3 structures
+//! @param in The packed vectors
+//! @param out UnpackSNorm16x3(in[i]) for every element of the span
+void UnpackSNorm16x3(const SNorm16x3 *in, const SoASpan<Vector3>& out);
+
+// * * * * * OCTAHEDRAL * * * * * //
+
+//! @brief Packs every unit Vector3 into its octahedral encoding
+//! @param a The unit vectors
+//! @param out PackOctahedral32(a[i]) for every element
+void PackOctahedral32(const SoASpan<const Vector3>& a, Octahedral32 *out);
+//! @brief Unpacks octahedral encodings into unit Vector3 structures
+//! @param in The encoded directions
+//! @param out UnpackOctahedral32(in[i]) for every element of the span
+void UnpackOctahedral32(const Octahedral32 *in, const SoASpan<Vector3>& out);
+
+// * * * * * SMALLEST THREE * * * * * //
+
+//! @brief Packs every unit quaternion into a smallest-three bit stream
+//! @param q The quaternions
+//! @param bits Size of every code, MATH_SMALLEST_THREE_MIN_BITS to MATH_SMALLEST_THREE_MAX_BITS
+//! @param out The stream of SmallestThreeStreamBytes(q.count, bits) bytes, code i being
+//!        PackSmallestThree(q[i], bits). The padding is zeroed
+void PackSmallestThree(const SoASpan<const Quaternion>& q, int bits, uint8_t *out);
+//! @brief Unpacks a smallest-three bit stream
+//! @param in The stream of at least SmallestThreeStreamBytes(out.count, bits) bytes
+//! @param bits Size of every code in bits
+//! @param out UnpackSmallestThree(ReadSmallestThree(in, i, bits), bits) for every element of the span
+void UnpackSmallestThree(const uint8_t *in, int bits, const SoASpan<Quaternion>& out);
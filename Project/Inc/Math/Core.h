@@ -0,0 +1,537 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                       CORE HELPERS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * The fixed-size vector and matrix types of the library are generated from two templates,
+ * VecN<T,N> and Mat<T,R,C>, instantiated for float, double and int32_t. Vector2/3/4 and
+ * Matrix2/3/4 are aliases of the float instantiations.
+ *
+ * Construction, element access through compile-time indices, arithmetic, Identity(), Zero()
+ * and the axis rotations are constexpr, so constant operands fold at compile time. Loops over
+ * the components are expanded from integer sequences and are therefore fully unrolled.
+ *
+ * @note With the SSE backend the float Vector4 arithmetic still runs on a __m128 register.
+ *       The register path is skipped while the compiler is evaluating a constant expression
+ *       (see MATH_CONSTANT_EVALUATED), where the unrolled scalar path is used instead.
+ */
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    #define MATH_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#else
+    #define MATH_CONSTANT_EVALUATED() true
+#endif
+
+//! Compile-time component index, consumed by Component() and the generators below
+template<int I> using CoreIndex = integral_constant<int, I>;
+
+//! Keeps a function parameter out of template argument deduction, so that Vector3 * 2 still
+//! deduces T = float from the vector alone
+template<typename T> struct CoreIdentity {typedef T Type;};
+
+/*!
+ * @brief Compares two coefficients. Floating-point types use the same tolerance as CloseFloat(),
+ *        integer types are compared exactly.
+ * @param a First value
+ * @param b Second value
+ * @return [bool] True if a and b are considered equal
+ */
+template<typename T>
+constexpr bool CloseValue(T a, T b)
+{
+    if constexpr (is_floating_point<T>::value) return ((a - b) <= T(0.00001) && (b - a) <= T(0.00001));
+    else return (a == b);
+}
+
+//---------------------------------------------------------------------------------------------
+//                                        CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class VecTraits
+ * @brief Storage properties of VecN<T,N>
+ * @param Simd True when the vector maps onto one SSE register (float, 4 components)
+ * @param Alignment Alignment of the vector in bytes
+ */
+template<typename T, int N>
+struct VecTraits
+{
+    static const bool Simd = (MATH_SIMD_SSE && is_same<T, float>::value && N == 4);
+    static const size_t Alignment = Simd ? 16 : alignof(T);
+};
+
+//! Named component storage of VecN, one specialization per supported size
+template<typename T, int N> struct VecStorage;
+template<typename T> struct VecStorage<T, 2> {T x, y;};
+template<typename T> struct VecStorage<T, 3> {T x, y, z;};
+template<typename T> struct alignas(VecTraits<T, 4>::Alignment) VecStorage<T, 4> {T x, y, z, w;};
+
+/*!
+ * @class VecN
+ * @brief N dimensional vector data structure (N = 2, 3 or 4) with components x, y, z, w
+ * @param x First component
+ * @param y Second component
+ * @param z Third component (N >= 3)
+ * @param w Fourth component (N == 4)
+ * @param Zero() Creates a zero vector
+ */
+template<typename T, int N>
+struct VecN : VecStorage<T, N>
+{
+    typedef T Scalar;
+    static const int Size = N;
+
+    //! @public @memberof VecN
+    //! @brief Creates an empty VecN data structure
+    VecN() = default;
+    //! @public @memberof VecN
+    //! @brief Creates a VecN data structure from its N components
+    template<typename... A, typename = enable_if_t<sizeof...(A) == N && conjunction<is_arithmetic<A>...>::value>>
+    constexpr VecN(A... a) : VecStorage<T, N>{T(a)...} {}
+
+    constexpr VecN& operator +=(const VecN& vec);
+    constexpr VecN& operator -=(const VecN& vec);
+    constexpr T operator *=(const VecN& vec) const;
+    constexpr VecN& operator *=(T scalar);
+    constexpr VecN& operator /=(T scalar);
+    constexpr const bool operator ==(const VecN& vec) const;
+    constexpr const bool operator !=(const VecN& vec) const {return !((*this) == vec);}
+    T& operator [](int i) {return ((&this->x)[i]);}
+    const T& operator [](int i) const {return ((&this->x)[i]);}
+    //! @public @memberof VecN
+    //! @brief Creates a zero vector
+    static constexpr VecN Zero(void);
+    //! @public @memberof VecN
+    //! @brief Yields this vector as a string representation
+    const string ToString(void) const
+    {
+        string s = "(";
+        for (int i=0; i<N; i++) s += to_string((*this)[i]) + ((i != N - 1) ? ", " : ")");
+        return s;
+    }
+    //! @public @memberof VecN
+    //! @brief Prints this vector
+    const void Print(void) const {cout << "Vector" << N << ": " << (*this).ToString() << "\n";}
+};
+
+/*!
+ * @brief Yields component I of a vector (x, y, z, w)
+ * @param v The vector
+ * @return [T&] Reference to the component
+ */
+template<typename V, int I>
+constexpr auto& Component(V& v, CoreIndex<I>)
+{
+    static_assert(I >= 0 && I < 4, "Component index out of range");
+    if constexpr (I == 0) return v.x;
+    else if constexpr (I == 1) return v.y;
+    else if constexpr (I == 2) return v.z;
+    else return v.w;
+}
+
+/*!
+ * @brief Builds a vector whose ith component is f(CoreIndex<i>())
+ * @param f Generator, called once per component
+ * @return [VecN<T,N>] The generated vector
+ */
+template<typename T, int N, typename F, int... I>
+constexpr VecN<T, N> VecGenerate(F f, integer_sequence<int, I...>) {return VecN<T, N>(f(CoreIndex<I>())...);}
+template<typename T, int N, typename F>
+constexpr VecN<T, N> VecGenerate(F f) {return VecGenerate<T, N>(f, make_integer_sequence<int, N>());}
+
+/*!
+ * @brief Adds f(CoreIndex<i>()) over i = 0..N-1, left to right
+ * @param f Generator, called once per term
+ * @return Sum of the terms
+ */
+template<int N, typename F, int... I>
+constexpr auto VecSum(F f, integer_sequence<int, I...>) {return (... + f(CoreIndex<I>()));}
+template<int N, typename F>
+constexpr auto VecSum(F f) {return VecSum<N>(f, make_integer_sequence<int, N>());}
+
+/*!
+ * @class Mat
+ * @brief R x C matrix data structure stored in column-major order. Uses T values as matrix coefficients
+ * @param M(i,j) Coefficient accessed through the ith row and jth column
+ * @param M[j] VecN<T,R> accessed through the jth column
+ * @note Shares the alignment of its columns, so Matrix4 columns can be loaded as Vector4 structures
+ */
+template<typename T, int R, int C>
+struct alignas(VecTraits<T, R>::Alignment) Mat
+{
+    typedef T Scalar;
+    static const int Rows = R;
+    static const int Cols = C;
+protected:
+    T m[C][R];
+
+    //! Column-major coefficients used by the constexpr constructors
+    struct Flat {T v[R*C];};
+    template<int... K>
+    constexpr Mat(const Flat& f, integer_sequence<int, K...>) : m{f.v[K]...} {}
+    static constexpr Flat FromRows(const Flat& rows)
+    {
+        Flat f{};
+        for (int j=0; j<C; j++) for (int i=0; i<R; i++) f.v[j*R + i] = rows.v[i*C + j];
+        return f;
+    }
+    template<int... I>
+    static constexpr void StoreColumn(Flat& f, int j, const VecN<T, R>& col, integer_sequence<int, I...>)
+    {((f.v[j*R + I] = Component(col, CoreIndex<I>())), ...);}
+    template<typename... V>
+    static constexpr Flat FromColumns(const V&... cols)
+    {
+        Flat f{};
+        int j = 0;
+        (StoreColumn(f, j++, cols, make_integer_sequence<int, R>()), ...);
+        return f;
+    }
+    template<typename F, int... K>
+    static constexpr Mat Generate(F f, integer_sequence<int, K...>)
+    {return Mat(Flat{{T(f(CoreIndex<K % R>(), CoreIndex<K / R>()))...}}, integer_sequence<int, K...>());}
+public:
+    //! @public @memberof Mat
+    //! @brief Creates an empty Mat structure
+    Mat() = default;
+    //! @public @memberof Mat
+    //! @brief Creates a Mat structure with R*C coefficients given row by row
+    template<typename... A, typename = enable_if_t<sizeof...(A) == R*C && conjunction<is_arithmetic<A>...>::value>>
+    constexpr Mat(A... a) : Mat(FromRows(Flat{{T(a)...}}), make_integer_sequence<int, R*C>()) {}
+    //! @public @memberof Mat
+    //! @brief Creates a Mat structure with C VecN<T,R> components as columns
+    template<typename... V, typename = enable_if_t<sizeof...(V) == C && conjunction<is_convertible<const V&, const VecN<T, R>&>...>::value>, typename = void>
+    constexpr Mat(const V&... cols) : Mat(FromColumns(static_cast<const VecN<T, R>&>(cols)...), make_integer_sequence<int, R*C>()) {}
+    //! @public @memberof Mat
+    //! @brief Creates a matrix whose coefficient (i,j) is f(CoreIndex<i>(), CoreIndex<j>())
+    template<typename F>
+    static constexpr Mat Generate(F f) {return Generate(f, make_integer_sequence<int, R*C>());}
+
+    // [T] Operator for access to ith row and jth column
+    constexpr T& operator ()(int i, int j) {return (m[j][i]);}
+    // [const T] Operator for access to ith row and jth column
+    constexpr const T& operator ()(int i, int j) const {return (m[j][i]);}
+    // [VecN] Operator for access to jth column
+    VecN<T, R>& operator [](int j) {return (*reinterpret_cast<VecN<T, R> *>(m[j]));}
+    // [const VecN] Operator for access to jth column
+    const VecN<T, R>& operator [](int j) const {return (*reinterpret_cast<const VecN<T, R> *>(m[j]));}
+    constexpr Mat& operator +=(const Mat& A) {*this = Generate([&](auto i, auto j) {return (*this)(i,j) + A(i,j);}); return (*this);}
+    constexpr Mat& operator -=(const Mat& A) {*this = Generate([&](auto i, auto j) {return (*this)(i,j) - A(i,j);}); return (*this);}
+    constexpr Mat& operator *=(T sc) {*this = Generate([&](auto i, auto j) {return sc*(*this)(i,j);}); return (*this);}
+    constexpr Mat& operator /=(T sc)
+    {
+        if constexpr (is_floating_point<T>::value) return (*this) *= (T(1)/sc);
+        else {*this = Generate([&](auto i, auto j) {return (*this)(i,j)/sc;}); return (*this);}
+    }
+    constexpr const bool operator ==(const Mat& A) const
+    {
+        for (int j=0; j<C; j++) for (int i=0; i<R; i++) if (!CloseValue(m[j][i], A.m[j][i])) return false;
+        return true;
+    }
+    constexpr const bool operator !=(const Mat& A) const {return !(*this == A);}
+    //! @brief Returns the ith row as a VecN<T,C> structure
+    constexpr const VecN<T, C> Row(int i) const {return VecGenerate<T, C>([&](auto j) {return m[j][i];});}
+    //! @brief Returns the jth column as a VecN<T,R> structure
+    constexpr const VecN<T, R> Col(int j) const {return VecGenerate<T, R>([&](auto i) {return m[j][i];});}
+    //! @brief Returns a zero matrix
+    static constexpr Mat Zero(void) {return Mat(Flat{}, make_integer_sequence<int, R*C>());}
+    //! @brief Returns an identity matrix (square matrices only)
+    template<int S = R, typename = enable_if_t<S == C>>
+    static constexpr Mat Identity(void) {return Generate([](auto i, auto j) {return T(i == j);});}
+    //! @brief Returns the 2D rotation matrix for an angle given by its cosine and sine
+    template<int S = R, typename = enable_if_t<S == 2 && C == 2>>
+    static constexpr Mat Rotation(T cs, T sn) {return Mat(cs, -sn, sn, cs);}
+    //! @brief Returns the rotation matrix about the x axis for an angle given by its cosine and sine
+    template<int S = R, typename = enable_if_t<S == 3 && C == 3>>
+    static constexpr Mat RotationX(T cs, T sn) {return Mat(T(1), T(0), T(0), T(0), cs, -sn, T(0), sn, cs);}
+    //! @brief Returns the rotation matrix about the y axis for an angle given by its cosine and sine
+    template<int S = R, typename = enable_if_t<S == 3 && C == 3>>
+    static constexpr Mat RotationY(T cs, T sn) {return Mat(cs, T(0), sn, T(0), T(1), T(0), -sn, T(0), cs);}
+    //! @brief Returns the rotation matrix about the z axis for an angle given by its cosine and sine
+    template<int S = R, typename = enable_if_t<S == 3 && C == 3>>
+    static constexpr Mat RotationZ(T cs, T sn) {return Mat(cs, -sn, T(0), sn, cs, T(0), T(0), T(0), T(1));}
+    const string ToString(void) const
+    {
+        string s;
+        for (int i=0; i<R; i++)
+        {
+            s += "\t[";
+            for (int j=0; j<C; j++) s += to_string(m[j][i]) + ((j != C - 1) ? ", " : "");
+            s += "]\n";
+        }
+        return s;
+    }
+    const void Print(void) const
+    {
+        cout << "Matrix" << R;
+        if (R != C) cout << "x" << C;
+        cout << ": \n" << (*this).ToString();
+    }
+};
+
+//---------------------------------------------------------------------------------------------
+//                                         ALIASES
+//---------------------------------------------------------------------------------------------
+
+typedef VecN<float, 2> Vector2;
+typedef VecN<float, 3> Vector3;
+typedef VecN<float, 4> Vector4;
+typedef VecN<double, 2> Vector2d;
+typedef VecN<double, 3> Vector3d;
+typedef VecN<double, 4> Vector4d;
+typedef VecN<int32_t, 2> Vector2i;
+typedef VecN<int32_t, 3> Vector3i;
+typedef VecN<int32_t, 4> Vector4i;
+
+typedef Mat<float, 2, 2> Matrix2;
+typedef Mat<float, 3, 3> Matrix3;
+typedef Mat<float, 4, 4> Matrix4;
+typedef Mat<double, 2, 2> Matrix2d;
+typedef Mat<double, 3, 3> Matrix3d;
+typedef Mat<double, 4, 4> Matrix4d;
+typedef Mat<int32_t, 2, 2> Matrix2i;
+typedef Mat<int32_t, 3, 3> Matrix3i;
+typedef Mat<int32_t, 4, 4> Matrix4i;
+//! Affine storage: a 3x3 linear part followed by a translation column, without the (0,0,0,1) row
+typedef Mat<float, 3, 4> Matrix3x4;
+typedef Mat<double, 3, 4> Matrix3x4d;
+
+//---------------------------------------------------------------------------------------------
+//                                      INLINE FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+#if MATH_SIMD_SSE
+//! @brief Stores a SIMD register into a Vector4 structure
+inline Vector4 SimdToVector4(__m128 v) {Vector4 r; _mm_store_ps(&r.x, v); return r;}
+#endif
+
+// * * * * * INNER PRODUCTS * * * * * //
+
+//! @brief Calculates the inner product of two vectors. This is the function that is used by the
+//!        dot product operator.
+//! @param v1 First vector
+//! @param v2 Second vector
+//! @return [T] Value of their inner product.
+template<typename T, int N>
+constexpr T InnerProduct(const VecN<T, N>& v1, const VecN<T, N>& v2)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, N>::Simd)
+        if (!MATH_CONSTANT_EVALUATED()) return _mm_cvtss_f32(SimdDot4(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));
+#endif
+    return VecSum<N>([&](auto i) {return Component(v1, i) * Component(v2, i);});
+}
+
+// * * * * * VECTOR OPERATORS * * * * * //
+
+template<typename T, int N>
+constexpr VecN<T, N> operator +(const VecN<T, N>& v1, const VecN<T, N>& v2)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, N>::Simd)
+        if (!MATH_CONSTANT_EVALUATED()) return SimdToVector4(_mm_add_ps(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));
+#endif
+    return VecGenerate<T, N>([&](auto i) {return Component(v1, i) + Component(v2, i);});
+}
+template<typename T, int N>
+constexpr VecN<T, N> operator -(const VecN<T, N>& v1, const VecN<T, N>& v2)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, N>::Simd)
+        if (!MATH_CONSTANT_EVALUATED()) return SimdToVector4(_mm_sub_ps(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));
+#endif
+    return VecGenerate<T, N>([&](auto i) {return Component(v1, i) - Component(v2, i);});
+}
+template<typename T, int N>
+constexpr VecN<T, N> operator *(const VecN<T, N>& vec, typename CoreIdentity<T>::Type scalar)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, N>::Simd)
+        if (!MATH_CONSTANT_EVALUATED()) return SimdToVector4(_mm_mul_ps(_mm_load_ps(&vec.x), _mm_set1_ps(scalar)));
+#endif
+    return VecGenerate<T, N>([&](auto i) {return Component(vec, i) * scalar;});
+}
+template<typename T, int N>
+constexpr VecN<T, N> operator -(const VecN<T, N>& vec)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, N>::Simd)
+        if (!MATH_CONSTANT_EVALUATED()) return SimdToVector4(_mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(&vec.x)));
+#endif
+    return VecGenerate<T, N>([&](auto i) {return -Component(vec, i);});
+}
+template<typename T, int N>
+constexpr VecN<T, N> operator *(typename CoreIdentity<T>::Type scalar, const VecN<T, N>& vec) {return (vec * scalar);}
+template<typename T, int N>
+constexpr T operator *(const VecN<T, N>& a, const VecN<T, N>& b) {return InnerProduct(a, b);}
+template<typename T, int N>
+constexpr VecN<T, N> operator /(const VecN<T, N>& vec, typename CoreIdentity<T>::Type scalar)
+{
+    if constexpr (is_floating_point<T>::value) {scalar = T(1)/scalar; return (scalar * vec);}
+    else return VecGenerate<T, N>([&](auto i) {return Component(vec, i) / scalar;});
+}
+
+// * * * * * VECTOR MEMBERS * * * * * //
+
+template<typename T, int N>
+constexpr VecN<T, N> VecN<T, N>::Zero(void) {return VecGenerate<T, N>([](auto) {return T(0);});}
+template<typename T, int N>
+constexpr VecN<T, N>& VecN<T, N>::operator +=(const VecN& vec) {return ((*this) = (*this) + vec);}
+template<typename T, int N>
+constexpr VecN<T, N>& VecN<T, N>::operator -=(const VecN& vec) {return ((*this) = (*this) - vec);}
+template<typename T, int N>
+constexpr T VecN<T, N>::operator *=(const VecN& vec) const {return InnerProduct(*this, vec);}
+template<typename T, int N>
+constexpr VecN<T, N>& VecN<T, N>::operator *=(T scalar) {return ((*this) = (*this) * scalar);}
+template<typename T, int N>
+constexpr VecN<T, N>& VecN<T, N>::operator /=(T scalar) {return ((*this) = (*this) / scalar);}
+template<typename T, int N>
+constexpr const bool VecN<T, N>::operator ==(const VecN& vec) const
+{return VecSum<N>([&](auto i) {return int(CloseValue(Component(*this, i), Component(vec, i)));}) == N;}
+
+// * * * * * MAGNITUDES * * * * * //
+
+//! @brief Yields the magnitude of a vector
+//! @param vec The vector to find the magnitude for
+//! @return [T] Value of the magnitude
+template<typename T, int N>
+inline T Magnitude(const VecN<T, N>& vec)
+{
+    static_assert(is_floating_point<T>::value, "Magnitude requires a floating-point vector");
+    return sqrt(InnerProduct(vec, vec));
+}
+
+// * * * * * NORMALIZATION * * * * * //
+
+//! @brief Normalizes a vector
+//! @param vec The vector to normalize
+//! @return [VecN<T,N>] Normalized vector
+template<typename T, int N>
+inline VecN<T, N> Normalize(const VecN<T, N>& vec) {return (vec / Magnitude(vec));}
+
+// * * * * * 3D CROSS PRODUCT * * * * * //
+
+//! @brief Generates the cross product between two 3D vectors
+//! @param v1 First vector
+//! @param v2 Second vector
+//! @return [VecN<T,3>] The cross product v1 x v2
+template<typename T>
+constexpr VecN<T, 3> CrossProduct(const VecN<T, 3>& v1, const VecN<T, 3>& v2)
+{
+    return (VecN<T, 3>(v1.y*v2.z - v1.z*v2.y,
+                       v1.z*v2.x - v1.x*v2.z,
+                       v1.x*v2.y - v1.y*v2.x));
+}
+
+// * * * * * SWAP * * * * * //
+/*!
+ * @brief Swaps the values of two vectors
+ * @param v1 First vector
+ * @param v2 Second vector
+ */
+template<typename T, int N>
+inline void Swap(VecN<T, N> *v1, VecN<T, N> *v2)
+{
+    VecN<T, N> tmp = *v1;
+    *v1 = *v2;
+    *v2 = tmp;
+}
+
+// * * * * * MATRIX OPERATORS * * * * * //
+
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator +(const Mat<T, R, C>& A, const Mat<T, R, C>& B) {Mat<T, R, C> S = A; return (S += B);}
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator -(const Mat<T, R, C>& A, const Mat<T, R, C>& B) {Mat<T, R, C> S = A; return (S -= B);}
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator -(const Mat<T, R, C>& M) {Mat<T, R, C> S = M; return (S *= T(-1));}
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator *(typename CoreIdentity<T>::Type sc, const Mat<T, R, C>& M) {Mat<T, R, C> S = M; return (S *= sc);}
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator *(const Mat<T, R, C>& M, typename CoreIdentity<T>::Type sc) {return (sc*M);}
+template<typename T, int R, int C>
+constexpr Mat<T, R, C> operator /(const Mat<T, R, C>& M, typename CoreIdentity<T>::Type sc) {Mat<T, R, C> S = M; return (S /= sc);}
+#if MATH_SIMD_SSE
+/*!
+ * @brief Combines the four columns of a float 4x4 matrix with the coefficients of v, i.e. M*v.
+ *        Columns are stored contiguously, so this is four broadcasts, four multiplies and three
+ *        adds, summed in the same order as the scalar VecSum. The products are rounded before
+ *        they are added, even with FMA, so that the result matches the constexpr path bit for bit
+ * @param M Matrix whose columns are combined
+ * @param v Coefficients, one per column
+ * @return [__m128] M(.,0)*v.x + M(.,1)*v.y + M(.,2)*v.z + M(.,3)*v.w
+ */
+inline __m128 SimdCombineColumns(const Mat<float, 4, 4>& M, __m128 v)
+{
+    __m128 r = _mm_mul_ps(_mm_load_ps(&M(0,0)), SimdSplat<0>(v));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&M(0,1)), SimdSplat<1>(v)));
+    r = _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&M(0,2)), SimdSplat<2>(v)));
+    return _mm_add_ps(r, _mm_mul_ps(_mm_load_ps(&M(0,3)), SimdSplat<3>(v)));
+}
+#endif
+
+// The scalar sums vectorize as well as SimdCombineColumns() per column at SSE2, and better with
+// AVX, so the matrix product has no SIMD branch
+template<typename T, int R, int K, int C>
+constexpr Mat<T, R, C> operator *(const Mat<T, R, K>& A, const Mat<T, K, C>& B)
+{
+    return Mat<T, R, C>::Generate([&](auto i, auto j) {return VecSum<K>([&](auto k) {return A(i,k)*B(k,j);});});
+}
+template<typename T, int R, int C>
+constexpr VecN<T, R> operator *(const Mat<T, R, C>& M, const VecN<T, C>& v)
+{
+#if MATH_SIMD_SSE
+    if constexpr (VecTraits<T, R>::Simd && C == 4)
+        if (!MATH_CONSTANT_EVALUATED()) return SimdToVector4(SimdCombineColumns(M, _mm_load_ps(&v.x)));
+#endif
+    return VecGenerate<T, R>([&](auto i) {return VecSum<C>([&](auto k) {return M(i,k)*Component(v, k);});});
+}
+
+// * * * * * MATRIX METHODS * * * * * //
+
+/*!
+ * @brief Returns the transpose of the matrix
+ * @param M Matrix to transpose
+ * @return [Mat<T,C,R>] Transpose of the matrix
+ */
+template<typename T, int R, int C>
+constexpr Mat<T, C, R> Transpose(const Mat<T, R, C>& M)
+{
+#if MATH_SIMD_SSE && !MATH_SIMD_AVX
+    // With AVX the compiler shuffles the scalar copy faster than the SSE transpose
+    if constexpr (VecTraits<T, R>::Simd && C == 4)
+        if (!MATH_CONSTANT_EVALUATED())
+        {
+            __m128 c0 = _mm_load_ps(&M(0,0)), c1 = _mm_load_ps(&M(0,1)), c2 = _mm_load_ps(&M(0,2)), c3 = _mm_load_ps(&M(0,3));
+            _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+            Mat<T, C, R> S;
+            _mm_store_ps(&S(0,0), c0); _mm_store_ps(&S(0,1), c1); _mm_store_ps(&S(0,2), c2); _mm_store_ps(&S(0,3), c3);
+            return S;
+        }
+#endif
+    return Mat<T, C, R>::Generate([&](auto i, auto j) {return M(j,i);});
+}
+/*!
+ * @brief Returns the diagonal of the matrix
+ * @param M Matrix to get the diagonal of
+ * @return [VecN<T,N>] Diagonal of the matrix
+ */
+template<typename T, int N>
+constexpr VecN<T, N> Diagonal(const Mat<T, N, N>& M) {return VecGenerate<T, N>([&](auto i) {return M(i,i);});}
+/*!
+ * @brief Returns the trace of the matrix
+ * @param M Matrix to get the trace of
+ * @return [T] Sum of the diagonal coefficients
+ */
+template<typename T, int N>
+constexpr T Trace(const Mat<T, N, N>& M) {return VecSum<N>([&](auto i) {return M(i,i);});}
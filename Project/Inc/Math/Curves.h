@@ -0,0 +1,137 @@
+#pragma once
+#include <stdexcept>
+#include <vector>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Vectors.h"
+#include "Math\Geometry.h"
+#include "Math\SoA.h"
+
+using namespace std;
+
+/*!
+ * Piecewise cubic curves through 3D space, for camera rails, particle paths and swept meshes.
+ * Bezier, Catmull-Rom and B-spline control points are all converted to the same form: every
+ * segment is a cubic a t^3 + b t^2 + c t + d over t in [0, 1], and segment s covers the curve
+ * parameters u in [s, s + 1].
+ *
+ *  Bezier         Segments of 4 control points sharing their end points; passes through every
+ *                 third point and is tangent to the control polygon there
+ *  Catmull-Rom    Passes through every point, with tangents from the neighbouring points. The
+ *                 end points are mirrored to give the first and last segments their tangents
+ *  B-spline       Uniform cubic B-spline: approximates the points, curvature continuous
+ *
+ * Curves carry an arc-length table, sampled MATH_CURVE_ARC_SAMPLES times per segment, that maps
+ * distances along the curve back to parameters. Batches of parameters or distances are evaluated
+ * 8 per SIMD step; evenly spaced samples are generated by forward differencing, 3 adds per point
+ * and axis.
+ */
+
+//! Arc-length table entries per segment
+#ifndef MATH_CURVE_ARC_SAMPLES
+#define MATH_CURVE_ARC_SAMPLES 16
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                        EXCEPTIONS
+//---------------------------------------------------------------------------------------------
+struct CurveControlPointsE : public runtime_error
+{
+    CurveControlPointsE() : runtime_error("Math error: Wrong number of control points for the curve.\n")
+    {};
+};
+
+//---------------------------------------------------------------------------------------------
+//                                          CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class CubicCurve
+ * @brief Piecewise cubic curve with an arc-length table, made by Bezier(), CatmullRom() or
+ *        BSpline(). Parameters outside [0, Segments()] are clamped to it
+ * @param Segments() Number of cubic segments
+ * @param Length() Length of the whole curve, as measured by the arc-length table
+ */
+struct CubicCurve
+{
+protected:
+    vector<Vector3> coefficients;   // a, b, c and d of every segment
+    vector<float> arcLength;        // length up to parameter i/MATH_CURVE_ARC_SAMPLES
+
+    explicit CubicCurve(vector<Vector3>&& segmentCoefficients);
+    // Segment holding parameter u, and the parameter within it
+    int Locate(float u, float& t) const;
+    // Length of segment s between parameters t0 and t1
+    float SegmentLength(int s, float t0, float t1) const;
+public:
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Creates a piecewise Bezier curve
+     * @param control 3*Segments() + 1 points: segment s is control[3*s] to control[3*s + 3]
+     * @param count Number of points, 3*k + 1 with k at least 1
+     * @throw CurveControlPointsE for any other count
+     */
+    static CubicCurve Bezier(const Point3 *control, int count);
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Creates a uniform Catmull-Rom spline through points[0] at u = 0 to points[count - 1]
+     *        at u = count - 1
+     * @param points The points to pass through
+     * @param count Number of points, at least 2
+     * @throw CurveControlPointsE for fewer points
+     */
+    static CubicCurve CatmullRom(const Point3 *points, int count);
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Creates a uniform cubic B-spline of count - 3 segments
+     * @param control The control points
+     * @param count Number of points, at least 4
+     * @throw CurveControlPointsE for fewer points
+     */
+    static CubicCurve BSpline(const Point3 *control, int count);
+
+    int Segments(void) const {return int(coefficients.size()/4);}
+    float Length(void) const {return arcLength.back();}
+
+    //! @public @memberof CubicCurve
+    //! @brief [Point3] The point at parameter u
+    Point3 Evaluate(float u) const;
+    //! @public @memberof CubicCurve
+    //! @brief [Vector3] The derivative with respect to u at parameter u, the tangent
+    Vector3 Derivative(float u) const;
+    //! @public @memberof CubicCurve
+    //! @brief [float] Length of the curve from parameter 0 to u
+    float LengthAt(float u) const;
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Inverts LengthAt(), from the arc-length table refined by one Newton step
+     * @param s Distance along the curve, clamped to [0, Length()]
+     * @return [float] The parameter u at which LengthAt(u) is s
+     */
+    float ParameterAtLength(float s) const;
+    //! @public @memberof CubicCurve
+    //! @brief [Point3] The point at distance s along the curve, for constant speed motion
+    Point3 EvaluateAtLength(float s) const {return Evaluate(ParameterAtLength(s));}
+
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Evaluates count parameters, 8 per packet, into out (count elements)
+     * @note Packets whose parameters all fall in one segment load it once, so sorted parameters
+     *       are the fastest; others load the segment of every parameter
+     */
+    void Evaluate(const float *u, int count, const SoASpan<Point3>& out) const;
+    //! @public @memberof CubicCurve
+    //! @brief Evaluates the points at count distances along the curve into out (count elements).
+    //!        Only the arc-length table search runs per distance, its Newton step 8 per packet
+    void EvaluateAtLength(const float *s, int count, const SoASpan<Point3>& out) const;
+    /*!
+     * @public @memberof CubicCurve
+     * @brief Samples the curve at evenly spaced parameters by forward differencing: 8 interleaved
+     *        difference tables per segment, advanced by adds and restarted from the cubic every
+     *        256 samples so that rounding does not pile up
+     * @param steps Samples per segment, at least 1
+     * @param out Segments()*steps + 1 elements, element s*steps + k the point at u = s + k/steps
+     * @note Samples are within about 1e-6 of Evaluate(), relative to the size of the curve
+     */
+    void SampleUniform(int steps, const SoASpan<Point3>& out) const;
+};
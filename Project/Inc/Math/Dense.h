@@ -0,0 +1,309 @@
+#pragma once
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Core.h"
+#include "Math\Parallel.h"
+
+using namespace std;
+
+/*!
+ * Dense linear algebra on matrices whose size is only known at runtime, for solvers (least
+ * squares fits, constraint systems, FEM, regression) that outgrow the fixed 2x2 to 4x4 types of
+ * Matrices.h. Storage is column-major like Mat, with every column padded to a multiple of
+ * MATH_BATCH_WIDTH floats so that the kernels run whole SIMD packets down the columns.
+ * Products and factorizations are cache blocked, and large ones are split across worker threads
+ * (see ParallelFor()). Factorizations never throw: they record a status flag that callers check
+ * before trusting Solve(), Det() or Inverse().
+ */
+
+//! Smallest number of floating-point operations a dense kernel hands to a worker thread
+#ifndef MATH_DENSE_PARALLEL_FLOPS
+#define MATH_DENSE_PARALLEL_FLOPS (1 << 22)
+#endif
+//! Number of columns factored together by the blocked LU and Cholesky decompositions
+#ifndef MATH_DENSE_BLOCK
+#define MATH_DENSE_BLOCK 32
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                          CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class MatrixX
+ * @brief Runtime-sized dense matrix of floats, column-major. Element (i,j) is stored at
+ *        Col(j)[i]; consecutive columns are Stride() floats apart.
+ * @param Rows() Number of rows
+ * @param Cols() Number of columns
+ * @param Stride() Distance in floats between consecutive columns, a multiple of MATH_BATCH_WIDTH
+ */
+struct MatrixX
+{
+protected:
+    float *data;
+    int rows;
+    int cols;
+    int stride;
+
+    static int RoundStride(int n) {return (n + MATH_BATCH_WIDTH - 1) / MATH_BATCH_WIDTH * MATH_BATCH_WIDTH;}
+    void Allocate(int r, int c)
+    {
+        rows = r; cols = c; stride = RoundStride(r);
+        data = (stride*cols > 0) ? static_cast<float *>(AlignedAlloc(size_t(stride)*cols*sizeof(float))) : nullptr;
+        if (data) memset(data, 0, size_t(stride)*cols*sizeof(float));
+    }
+public:
+    //! @public @memberof MatrixX
+    //! @brief Creates an empty 0x0 matrix
+    MatrixX() {data = nullptr; rows = cols = stride = 0;}
+    //! @public @memberof MatrixX
+    //! @brief Creates an r x c matrix filled with zeros
+    MatrixX(int r, int c) {Allocate(r, c);}
+    //! @public @memberof MatrixX
+    //! @brief Creates an r x c matrix from r*c values listed row by row, like the Mat constructors
+    MatrixX(int r, int c, const float *rowMajor)
+    {
+        Allocate(r, c);
+        for (int i=0; i<r; i++)
+            for (int j=0; j<c; j++) (*this)(i,j) = rowMajor[i*c + j];
+    }
+    //! @public @memberof MatrixX
+    //! @brief Copies a fixed size matrix, e.g. a Matrix4
+    template<int R, int C>
+    explicit MatrixX(const Mat<float, R, C>& M)
+    {
+        Allocate(R, C);
+        for (int j=0; j<C; j++)
+            for (int i=0; i<R; i++) (*this)(i,j) = M(i,j);
+    }
+    MatrixX(const MatrixX& M)
+    {
+        Allocate(M.rows, M.cols);
+        if (data) memcpy(data, M.data, size_t(stride)*cols*sizeof(float));
+    }
+    MatrixX(MatrixX&& M) noexcept {data = M.data; rows = M.rows; cols = M.cols; stride = M.stride; M.data = nullptr; M.rows = M.cols = M.stride = 0;}
+    MatrixX& operator =(MatrixX M) {swap(data, M.data); swap(rows, M.rows); swap(cols, M.cols); swap(stride, M.stride); return (*this);}
+    ~MatrixX() {AlignedFree(data);}
+
+    //! @public @memberof MatrixX
+    //! @brief Returns the r x c matrix with element (i,j) set to f(i,j)
+    template<typename F>
+    static MatrixX Generate(int r, int c, F f)
+    {
+        MatrixX M(r, c);
+        for (int j=0; j<c; j++)
+            for (int i=0; i<r; i++) M(i,j) = f(i, j);
+        return M;
+    }
+    //! @public @memberof MatrixX
+    //! @brief Returns the n x n identity matrix
+    static MatrixX Identity(int n) {return Generate(n, n, [](int i, int j) {return float(i == j);});}
+    //! @public @memberof MatrixX
+    //! @brief Returns the r x c zero matrix
+    static MatrixX Zero(int r, int c) {return MatrixX(r, c);}
+
+    int Rows(void) const {return rows;}
+    int Cols(void) const {return cols;}
+    int Stride(void) const {return stride;}
+    //! @public @memberof MatrixX
+    //! @brief True for square matrices, including the empty one
+    bool IsSquare(void) const {return rows == cols;}
+
+    float& operator ()(int i, int j) {return data[j*stride + i];}
+    const float& operator ()(int i, int j) const {return data[j*stride + i];}
+    //! @public @memberof MatrixX
+    //! @brief [float*] Pointer to the first element of column j. Padding rows are kept at zero
+    float *Col(int j) {return data + j*stride;}
+    const float *Col(int j) const {return data + j*stride;}
+
+    //! @public @memberof MatrixX
+    //! @brief Adds or subtracts M element by element; leaves the matrix unchanged if the sizes differ
+    MatrixX& operator +=(const MatrixX& M);
+    MatrixX& operator -=(const MatrixX& M);
+    MatrixX& operator *=(float sc);
+    //! @public @memberof MatrixX
+    //! @brief Compares every element with the same tolerance as CloseFloat(). Matrices of
+    //!        different sizes are never equal
+    const bool operator ==(const MatrixX& M) const;
+    const bool operator !=(const MatrixX& M) const {return !((*this) == M);}
+
+    const string ToString(void) const
+    {
+        string s;
+        for (int i=0; i<rows; i++)
+        {
+            s += "\t[";
+            for (int j=0; j<cols; j++) s += to_string((*this)(i,j)) + ((j != cols - 1) ? ", " : "");
+            s += "]\n";
+        }
+        return s;
+    }
+    const void Print(void) const {cout << "MatrixX" << rows << "x" << cols << ": \n" << (*this).ToString();}
+};
+
+/*!
+ * @class LUDecomposition
+ * @brief P*A = L*U factorization of a square matrix by Gaussian elimination with partial
+ *        (row) pivoting, blocked by MATH_DENSE_BLOCK columns
+ * @param LU Unit lower triangle L below the diagonal, upper triangle U on and above it
+ * @param pivot Row i of P*A is row pivot[i] of A
+ * @param sign Determinant of P, +1 or -1
+ * @param singular Set when a pivot is negligible next to the largest element of A, in which
+ *                 case Solve(), Inverse() and Det() are not meaningful (Det() yields 0)
+ */
+struct LUDecomposition
+{
+    MatrixX LU;
+    vector<int> pivot;
+    int sign = 1;
+    bool singular = true;
+
+    LUDecomposition() = default;
+    explicit LUDecomposition(const MatrixX& A) {Factor(A);}
+    /*!
+     * @brief Factors A, replacing any previous factorization
+     * @param A The square matrix to factor
+     * @return [bool] True if A is square and nonsingular
+     */
+    bool Factor(const MatrixX& A);
+    //! @brief Solves A*X = B for every column of B
+    MatrixX Solve(const MatrixX& B) const;
+    //! @brief Solves A*x = b
+    vector<float> Solve(const vector<float>& b) const;
+    //! @brief Returns the inverse of A
+    MatrixX Inverse(void) const;
+    //! @brief Returns the determinant of A, 0 when singular
+    float Det(void) const;
+    //! @brief Returns the unit lower triangular factor
+    MatrixX L(void) const;
+    //! @brief Returns the upper triangular factor
+    MatrixX U(void) const;
+};
+
+/*!
+ * @class CholeskyDecomposition
+ * @brief A = L*L^T factorization of a symmetric positive definite matrix, blocked by
+ *        MATH_DENSE_BLOCK columns. Only the lower triangle of A is read.
+ * @param L Lower triangular factor, zero above the diagonal
+ * @param positiveDefinite Cleared when A is not square or a pivot is not positive, in which case
+ *                         Solve() and Det() are not meaningful (Det() yields 0)
+ */
+struct CholeskyDecomposition
+{
+    MatrixX L;
+    bool positiveDefinite = false;
+
+    CholeskyDecomposition() = default;
+    explicit CholeskyDecomposition(const MatrixX& A) {Factor(A);}
+    /*!
+     * @brief Factors A, replacing any previous factorization
+     * @param A The symmetric matrix to factor, only its lower triangle is read
+     * @return [bool] True if A is square and positive definite
+     */
+    bool Factor(const MatrixX& A);
+    //! @brief Solves A*X = B for every column of B
+    MatrixX Solve(const MatrixX& B) const;
+    //! @brief Solves A*x = b
+    vector<float> Solve(const vector<float>& b) const;
+    //! @brief Returns the determinant of A, 0 when not positive definite
+    float Det(void) const;
+};
+
+/*!
+ * @class QRDecomposition
+ * @brief A = Q*R factorization of an m x n matrix (m >= n) by Householder reflections, for least
+ *        squares problems and rank tests
+ * @param QR R on and above the diagonal, the Householder vectors below it (their leading 1 is
+ *           implied)
+ * @param tau Scale of every reflection H = I - tau*v*v^T
+ * @param fullRank Cleared when m < n or a diagonal element of R is negligible next to the largest
+ *                 element of A, in which case Solve() is not meaningful
+ */
+struct QRDecomposition
+{
+    MatrixX QR;
+    vector<float> tau;
+    bool fullRank = false;
+
+    QRDecomposition() = default;
+    explicit QRDecomposition(const MatrixX& A) {Factor(A);}
+    /*!
+     * @brief Factors A, replacing any previous factorization
+     * @param A The matrix to factor, with at least as many rows as columns
+     * @return [bool] True if A has full column rank
+     */
+    bool Factor(const MatrixX& A);
+    //! @brief Returns the least squares solution X minimizing |A*X - B| for every column of B
+    MatrixX Solve(const MatrixX& B) const;
+    //! @brief Returns the least squares solution x minimizing |A*x - b|
+    vector<float> Solve(const vector<float>& b) const;
+    //! @brief Returns the m x n factor Q with orthonormal columns
+    MatrixX Q(void) const;
+    //! @brief Returns the n x n upper triangular factor R
+    MatrixX R(void) const;
+};
+
+//---------------------------------------------------------------------------------------------
+//                                         OPERATORS
+//---------------------------------------------------------------------------------------------
+
+//! @brief [MatrixX] Element by element sum or difference, empty if the sizes differ
+MatrixX operator +(const MatrixX& A, const MatrixX& B);
+MatrixX operator -(const MatrixX& A, const MatrixX& B);
+MatrixX operator -(const MatrixX& A);
+MatrixX operator *(const MatrixX& A, float sc);
+MatrixX operator *(float sc, const MatrixX& A);
+/*!
+ * @brief Multiplies two matrices with the blocked SIMD kernel
+ * @param A Left matrix, m x k
+ * @param B Right matrix, k x n
+ * @return [MatrixX] The m x n product, empty if the inner sizes differ
+ */
+MatrixX operator *(const MatrixX& A, const MatrixX& B);
+/*!
+ * @brief Multiplies a matrix by a column vector
+ * @param A The m x n matrix
+ * @param x Vector of n elements
+ * @return [vector<float>] A*x, empty if the sizes differ
+ */
+vector<float> operator *(const MatrixX& A, const vector<float>& x);
+
+//---------------------------------------------------------------------------------------------
+//                                         FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+//! @brief Returns the transpose of a matrix
+MatrixX Transpose(const MatrixX& A);
+/*!
+ * @brief Computes A^T*B without forming the transpose
+ * @param A Matrix of m x k
+ * @param B Matrix of m x n
+ * @return [MatrixX] The k x n product, empty if the row counts differ
+ */
+MatrixX TransposeTimes(const MatrixX& A, const MatrixX& B);
+/*!
+ * @brief Calculates the determinant of a square matrix by LU decomposition
+ * @param A The matrix
+ * @return [float] The determinant, 0 for singular or non square matrices
+ */
+float Det(const MatrixX& A);
+/*!
+ * @brief Inverts a square matrix by LU decomposition without throwing
+ * @param A The matrix to invert
+ * @param inv Receives the inverse, or the zero matrix of A's size when A is singular
+ * @param det Receives the determinant of A, 0 when singular
+ * @return [bool] True if A is square and invertible
+ */
+bool TryInverse(const MatrixX& A, MatrixX& inv, float& det);
+/*!
+ * @brief Solves the square system A*X = B by LU decomposition without throwing
+ * @param A The square coefficient matrix
+ * @param B The right hand sides, one per column
+ * @param X Receives the solution, or the zero matrix when A is singular
+ * @return [bool] True if A is square, invertible and has as many rows as B
+ */
+bool TrySolve(const MatrixX& A, const MatrixX& B, MatrixX& X);
@@ -0,0 +1,316 @@
+#pragma once
+#include "Math\Core.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                  LAZY EXPRESSION HELPERS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * Opt-in expression templates over VecN<T,N> and Mat<T,R,C>. Wrapping an operand in Lazy()
+ * makes the operators below build a small expression tree instead of a temporary per operation.
+ * Eval() then computes every component of the result in one pass, component by component:
+ *
+ *      Vector3 r = Eval(Lazy(v1) - Lazy(v2)*s + CrossProduct(Lazy(a), Lazy(b))*t);
+ *
+ * Every component goes through exactly the operations, in the same order, as the eager
+ * operators of Core.h (including v/s computed as v*(1/s)), so the results are bit for bit the
+ * ones of the eager expression. Inner products are reductions and are computed eagerly with
+ * InnerProduct(), which keeps the SSE summation order of Vector4.
+ *
+ * @note Bit compatibility assumes the compiler does not fuse a*b + c into a single FMA in one
+ *       of the two forms only. The build tasks pass -ffp-contract=off for that reason; GCC
+ *       otherwise contracts under -march=native, and the two forms then agree only to rounding.
+ * @warning Expression nodes keep references to their Lazy() operands. Evaluate an expression
+ *          in the statement that builds it; do not store it past the lifetime of its operands.
+ */
+
+//! Component operations of the expression nodes
+struct ExprAdd {template<typename T> static constexpr T Apply(T a, T b) {return a + b;}};
+struct ExprSub {template<typename T> static constexpr T Apply(T a, T b) {return a - b;}};
+struct ExprMul {template<typename T> static constexpr T Apply(T a, T b) {return a * b;}};
+struct ExprDiv {template<typename T> static constexpr T Apply(T a, T b) {return a / b;}};
+
+//---------------------------------------------------------------------------------------------
+//                                        CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class VecExpr
+ * @brief Base of every vector expression node (CRTP). E::Eval(i) yields component i
+ */
+template<typename E, typename T, int N>
+struct VecExpr
+{
+    typedef T Scalar;
+    static const int Size = N;
+    //! @public @memberof VecExpr
+    //! @brief Yields component i of the expression
+    constexpr T Eval(int i) const {return static_cast<const E&>(*this).Eval(i);}
+};
+
+/*!
+ * @class VecRef
+ * @brief Leaf of a vector expression, refers to a vector
+ */
+template<typename T, int N>
+struct VecRef : VecExpr<VecRef<T, N>, T, N>
+{
+    const VecN<T, N>& v;
+    constexpr explicit VecRef(const VecN<T, N>& vec) : v(vec) {}
+    constexpr T Eval(int i) const {return v[i];}
+};
+
+/*!
+ * @class VecBinary
+ * @brief Componentwise operation between two vector expressions
+ */
+template<typename Op, typename A, typename B, typename T, int N>
+struct VecBinary : VecExpr<VecBinary<Op, A, B, T, N>, T, N>
+{
+    A a;
+    B b;
+    constexpr VecBinary(const A& e1, const B& e2) : a(e1), b(e2) {}
+    constexpr T Eval(int i) const {return Op::Apply(a.Eval(i), b.Eval(i));}
+};
+
+/*!
+ * @class VecScale
+ * @brief Vector expression multiplied by a scalar
+ */
+template<typename A, typename T, int N>
+struct VecScale : VecExpr<VecScale<A, T, N>, T, N>
+{
+    A a;
+    T s;
+    constexpr VecScale(const A& e, T scalar) : a(e), s(scalar) {}
+    constexpr T Eval(int i) const {return a.Eval(i) * s;}
+};
+
+/*!
+ * @class VecQuotient
+ * @brief Vector expression divided by a scalar. Integer vectors divide every component, floating
+ *        point vectors multiply by the reciprocal, like the eager operator
+ */
+template<typename A, typename T, int N>
+struct VecQuotient : VecExpr<VecQuotient<A, T, N>, T, N>
+{
+    A a;
+    T s;
+    constexpr VecQuotient(const A& e, T scalar) : a(e), s(is_floating_point<T>::value ? T(1)/scalar : scalar) {}
+    constexpr T Eval(int i) const
+    {
+        if constexpr (is_floating_point<T>::value) return a.Eval(i) * s;
+        else return a.Eval(i) / s;
+    }
+};
+
+/*!
+ * @class VecNegate
+ * @brief Negated vector expression. Float Vector4 negation matches the SSE eager operator (0 - x)
+ */
+template<typename A, typename T, int N>
+struct VecNegate : VecExpr<VecNegate<A, T, N>, T, N>
+{
+    A a;
+    constexpr explicit VecNegate(const A& e) : a(e) {}
+    constexpr T Eval(int i) const
+    {
+        if constexpr (VecTraits<T, N>::Simd) return T(0) - a.Eval(i);
+        else return -a.Eval(i);
+    }
+};
+
+/*!
+ * @class VecCross
+ * @brief Cross product of two 3D vector expressions. Each operand component is evaluated twice,
+ *        so operands should be leaves or short expressions
+ */
+template<typename A, typename B, typename T>
+struct VecCross : VecExpr<VecCross<A, B, T>, T, 3>
+{
+    A a;
+    B b;
+    constexpr VecCross(const A& e1, const B& e2) : a(e1), b(e2) {}
+    constexpr T Eval(int i) const
+    {
+        int j = (i + 1) % 3, k = (i + 2) % 3;
+        return a.Eval(j)*b.Eval(k) - a.Eval(k)*b.Eval(j);
+    }
+};
+
+/*!
+ * @class MatExpr
+ * @brief Base of every matrix expression node (CRTP). E::Eval(i, j) yields row i, column j
+ */
+template<typename E, typename T, int R, int C>
+struct MatExpr
+{
+    typedef T Scalar;
+    static const int Rows = R;
+    static const int Columns = C;
+    //! @public @memberof MatExpr
+    //! @brief Yields the coefficient at row i, column j of the expression
+    constexpr T Eval(int i, int j) const {return static_cast<const E&>(*this).Eval(i, j);}
+};
+
+/*!
+ * @class MatRef
+ * @brief Leaf of a matrix expression, refers to a matrix
+ */
+template<typename T, int R, int C>
+struct MatRef : MatExpr<MatRef<T, R, C>, T, R, C>
+{
+    const Mat<T, R, C>& M;
+    constexpr explicit MatRef(const Mat<T, R, C>& A) : M(A) {}
+    constexpr T Eval(int i, int j) const {return M(i,j);}
+};
+
+/*!
+ * @class MatBinary
+ * @brief Coefficientwise sum or difference of two matrix expressions
+ */
+template<typename Op, typename A, typename B, typename T, int R, int C>
+struct MatBinary : MatExpr<MatBinary<Op, A, B, T, R, C>, T, R, C>
+{
+    A a;
+    B b;
+    constexpr MatBinary(const A& e1, const B& e2) : a(e1), b(e2) {}
+    constexpr T Eval(int i, int j) const {return Op::Apply(a.Eval(i,j), b.Eval(i,j));}
+};
+
+/*!
+ * @class MatScale
+ * @brief Matrix expression multiplied by a scalar (sc * M, like Mat::operator*=)
+ */
+template<typename A, typename T, int R, int C>
+struct MatScale : MatExpr<MatScale<A, T, R, C>, T, R, C>
+{
+    A a;
+    T s;
+    constexpr MatScale(const A& e, T scalar) : a(e), s(scalar) {}
+    constexpr T Eval(int i, int j) const {return s * a.Eval(i,j);}
+};
+
+/*!
+ * @class MatTimesVec
+ * @brief Product of a matrix expression and a vector. The vector operand is evaluated once when
+ *        the node is built, since every row reads all of its components
+ */
+template<typename A, typename T, int R, int C>
+struct MatTimesVec : VecExpr<MatTimesVec<A, T, R, C>, T, R>
+{
+    A a;
+    VecN<T, C> v;
+    constexpr MatTimesVec(const A& e, const VecN<T, C>& vec) : a(e), v(vec) {}
+    constexpr T Eval(int i) const {return VecSum<C>([&](auto k) {return a.Eval(i, k)*Component(v, k);});}
+};
+
+//---------------------------------------------------------------------------------------------
+//                                    INLINE FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * LEAVES AND EVALUATION * * * * * //
+
+//! @brief Starts a lazy expression from a vector
+//! @param v The vector, referenced by the expression
+//! @return [VecRef<T,N>] Leaf expression
+template<typename T, int N>
+constexpr VecRef<T, N> Lazy(const VecN<T, N>& v) {return VecRef<T, N>(v);}
+//! @brief Starts a lazy expression from a matrix
+//! @param M The matrix, referenced by the expression
+//! @return [MatRef<T,R,C>] Leaf expression
+template<typename T, int R, int C>
+constexpr MatRef<T, R, C> Lazy(const Mat<T, R, C>& M) {return MatRef<T, R, C>(M);}
+//! @brief Computes a vector expression in one pass over the components
+//! @param e The expression
+//! @return [VecN<T,N>] The vector
+template<typename E, typename T, int N>
+constexpr VecN<T, N> Eval(const VecExpr<E, T, N>& e) {return VecGenerate<T, N>([&](auto i) {return e.Eval(i);});}
+//! @brief Computes a matrix expression in one pass over the coefficients
+//! @param e The expression
+//! @return [Mat<T,R,C>] The matrix
+template<typename E, typename T, int R, int C>
+constexpr Mat<T, R, C> Eval(const MatExpr<E, T, R, C>& e) {return Mat<T, R, C>::Generate([&](auto i, auto j) {return e.Eval(i, j);});}
+
+// * * * * * VECTOR EXPRESSION OPERATORS * * * * * //
+
+template<typename A, typename B, typename T, int N>
+constexpr VecBinary<ExprAdd, A, B, T, N> operator +(const VecExpr<A, T, N>& a, const VecExpr<B, T, N>& b)
+{return VecBinary<ExprAdd, A, B, T, N>(static_cast<const A&>(a), static_cast<const B&>(b));}
+template<typename A, typename T, int N>
+constexpr VecBinary<ExprAdd, A, VecRef<T, N>, T, N> operator +(const VecExpr<A, T, N>& a, const VecN<T, N>& b) {return a + Lazy(b);}
+template<typename B, typename T, int N>
+constexpr VecBinary<ExprAdd, VecRef<T, N>, B, T, N> operator +(const VecN<T, N>& a, const VecExpr<B, T, N>& b) {return Lazy(a) + b;}
+template<typename A, typename B, typename T, int N>
+constexpr VecBinary<ExprSub, A, B, T, N> operator -(const VecExpr<A, T, N>& a, const VecExpr<B, T, N>& b)
+{return VecBinary<ExprSub, A, B, T, N>(static_cast<const A&>(a), static_cast<const B&>(b));}
+template<typename A, typename T, int N>
+constexpr VecBinary<ExprSub, A, VecRef<T, N>, T, N> operator -(const VecExpr<A, T, N>& a, const VecN<T, N>& b) {return a - Lazy(b);}
+template<typename B, typename T, int N>
+constexpr VecBinary<ExprSub, VecRef<T, N>, B, T, N> operator -(const VecN<T, N>& a, const VecExpr<B, T, N>& b) {return Lazy(a) - b;}
+template<typename A, typename T, int N>
+constexpr VecNegate<A, T, N> operator -(const VecExpr<A, T, N>& a) {return VecNegate<A, T, N>(static_cast<const A&>(a));}
+template<typename A, typename T, int N>
+constexpr VecScale<A, T, N> operator *(const VecExpr<A, T, N>& a, typename CoreIdentity<T>::Type s)
+{return VecScale<A, T, N>(static_cast<const A&>(a), s);}
+template<typename A, typename T, int N>
+constexpr VecScale<A, T, N> operator *(typename CoreIdentity<T>::Type s, const VecExpr<A, T, N>& a) {return a * s;}
+template<typename A, typename T, int N>
+constexpr VecQuotient<A, T, N> operator /(const VecExpr<A, T, N>& a, typename CoreIdentity<T>::Type s)
+{return VecQuotient<A, T, N>(static_cast<const A&>(a), s);}
+
+//! @brief Calculates the inner product of two vector expressions (evaluated eagerly)
+template<typename A, typename B, typename T, int N>
+constexpr T operator *(const VecExpr<A, T, N>& a, const VecExpr<B, T, N>& b) {return InnerProduct(Eval(a), Eval(b));}
+template<typename A, typename T, int N>
+constexpr T operator *(const VecExpr<A, T, N>& a, const VecN<T, N>& b) {return InnerProduct(Eval(a), b);}
+template<typename B, typename T, int N>
+constexpr T operator *(const VecN<T, N>& a, const VecExpr<B, T, N>& b) {return InnerProduct(a, Eval(b));}
+
+//! @brief Generates the lazy cross product of two 3D vector expressions
+template<typename A, typename B, typename T>
+constexpr VecCross<A, B, T> CrossProduct(const VecExpr<A, T, 3>& a, const VecExpr<B, T, 3>& b)
+{return VecCross<A, B, T>(static_cast<const A&>(a), static_cast<const B&>(b));}
+
+// * * * * * MATRIX EXPRESSION OPERATORS * * * * * //
+
+template<typename A, typename B, typename T, int R, int C>
+constexpr MatBinary<ExprAdd, A, B, T, R, C> operator +(const MatExpr<A, T, R, C>& a, const MatExpr<B, T, R, C>& b)
+{return MatBinary<ExprAdd, A, B, T, R, C>(static_cast<const A&>(a), static_cast<const B&>(b));}
+template<typename A, typename T, int R, int C>
+constexpr MatBinary<ExprAdd, A, MatRef<T, R, C>, T, R, C> operator +(const MatExpr<A, T, R, C>& a, const Mat<T, R, C>& b)
+{return a + Lazy(b);}
+template<typename B, typename T, int R, int C>
+constexpr MatBinary<ExprAdd, MatRef<T, R, C>, B, T, R, C> operator +(const Mat<T, R, C>& a, const MatExpr<B, T, R, C>& b)
+{return Lazy(a) + b;}
+template<typename A, typename B, typename T, int R, int C>
+constexpr MatBinary<ExprSub, A, B, T, R, C> operator -(const MatExpr<A, T, R, C>& a, const MatExpr<B, T, R, C>& b)
+{return MatBinary<ExprSub, A, B, T, R, C>(static_cast<const A&>(a), static_cast<const B&>(b));}
+template<typename A, typename T, int R, int C>
+constexpr MatBinary<ExprSub, A, MatRef<T, R, C>, T, R, C> operator -(const MatExpr<A, T, R, C>& a, const Mat<T, R, C>& b)
+{return a - Lazy(b);}
+template<typename B, typename T, int R, int C>
+constexpr MatBinary<ExprSub, MatRef<T, R, C>, B, T, R, C> operator -(const Mat<T, R, C>& a, const MatExpr<B, T, R, C>& b)
+{return Lazy(a) - b;}
+template<typename A, typename T, int R, int C>
+constexpr MatScale<A, T, R, C> operator -(const MatExpr<A, T, R, C>& a) {return MatScale<A, T, R, C>(static_cast<const A&>(a), T(-1));}
+template<typename A, typename T, int R, int C>
+constexpr MatScale<A, T, R, C> operator *(typename CoreIdentity<T>::Type s, const MatExpr<A, T, R, C>& a)
+{return MatScale<A, T, R, C>(static_cast<const A&>(a), s);}
+template<typename A, typename T, int R, int C>
+constexpr MatScale<A, T, R, C> operator *(const MatExpr<A, T, R, C>& a, typename CoreIdentity<T>::Type s) {return s * a;}
+template<typename A, typename T, int R, int C>
+constexpr MatScale<A, T, R, C> operator /(const MatExpr<A, T, R, C>& a, typename CoreIdentity<T>::Type s)
+{
+    static_assert(is_floating_point<T>::value, "Lazy matrix division requires a floating-point matrix");
+    return MatScale<A, T, R, C>(static_cast<const A&>(a), T(1)/s);
+}
+//! @brief Multiplies a matrix expression by a vector or vector expression
+template<typename A, typename T, int R, int C>
+constexpr MatTimesVec<A, T, R, C> operator *(const MatExpr<A, T, R, C>& a, const VecN<T, C>& v)
+{return MatTimesVec<A, T, R, C>(static_cast<const A&>(a), v);}
+template<typename A, typename B, typename T, int R, int C>
+constexpr MatTimesVec<A, T, R, C> operator *(const MatExpr<A, T, R, C>& a, const VecExpr<B, T, C>& v)
+{return MatTimesVec<A, T, R, C>(static_cast<const A&>(a), Eval(v));}
@@ -58,6 +58,33 @@ struct Point3 : Vector3
     void Print(void) {cout << "Point3: " << (*this).ToString() << "\n";}
     Vector3 operator -= (const Point3& p) {return Vector3(x-p.x, y-p.y, z-p.z);}
 };
+/*!
+ * @class Point3d @extends Vector3d
+ * @brief 3D Point data structure in double precision (double x, double y, double z), for world
+ *        positions far from the origin where a float Point3 loses sub-millimetre precision.
+ *        Converted to float relative to a camera or cell origin with Rebase()
+ * @param x First coordinate
+ * @param y Second coordinate
+ * @param z Third coordinate
+ * @param Zero() Creates a zero point (0.0, 0.0, 0.0)
+ */
+struct Point3d : Vector3d
+{
+    //! @public @memberof Point3d
+    //! @brief Creates an empty Point3d structure
+    Point3d() = default;
+    //! @public @memberof Point3d
+    //! @brief Creates a Point3d structure
+    Point3d(double x, double y, double z) : Vector3d(x,y,z) {}
+    //! @public @memberof Point3d
+    //! @brief Widens a float Point3 structure
+    explicit Point3d(const Point3& p) : Vector3d(p.x, p.y, p.z) {}
+    //! @public @memberof Point3d
+    //! @brief Creates a zero point (0.0, 0.0, 0.0)
+    const Point3d Zero(void) const {return Point3d(0.0, 0.0, 0.0);}
+    const string ToString() const {return "("+to_string(x)+", "+to_string(y)+", "+to_string(z)+")";}
+    void Print(void) {cout << "Point3d: " << (*this).ToString() << "\n";}
+};
 /*!
  * @class Point4 @extends Vector4
  * @brief 4D Point data structure (float x, float y, float z, float w)
@@ -346,6 +373,21 @@ inline Point3 operator *(float sc, const Point3& p)
 inline Point3 operator /(const Point3& p, float sc)
     {return (1.0f/sc)*p;}
 
+// * * * * * 3D DOUBLE PRECISION POINTS * * * * * //
+
+inline Point3d operator +(const Point3d& p0, const Point3d& p1)
+    {return (Point3d(p0.x + p1.x, p0.y + p1.y, p0.z + p1.z));}
+inline Point3d operator +(const Point3d& p, const Vector3d& v)
+    {return (Point3d(p.x + v.x, p.y + v.y, p.z + v.z));}
+inline Vector3d operator -(const Point3d& p0, const Point3d& p1)
+    {return (Vector3d(p0.x - p1.x, p0.y - p1.y, p0.z - p1.z));}
+inline Point3d operator *(const Point3d& p, double sc)
+    {return Point3d(p.x*sc, p.y*sc, p.z*sc);}
+inline Point3d operator *(double sc, const Point3d& p)
+    {return p*sc;}
+inline Point3d operator /(const Point3d& p, double sc)
+    {return (1.0/sc)*p;}
+
 // * * * * * 4D POINTS * * * * * //
 
 inline Point4 operator +(const Point4& p0, const Point4& p1)
@@ -403,6 +445,31 @@ inline Point3 toPoint(const Vector3& v) {return Point3(v.x, v.y, v.z);}
  * @return [Point3] The point
  */
 inline Point4 toPoint(const Vector4& v) {return Point4(v.x, v.y, v.z, v.w);}
+/*!
+ * @brief Converts a Vector3d structure to a Point3d structure
+ * @param v The vector to be converted to a point
+ * @return [Point3d] The point
+ */
+inline Point3d toPoint(const Vector3d& v) {return Point3d(v.x, v.y, v.z);}
+
+// * * * * * ORIGIN REBASING * * * * * //
+
+/*!
+ * @brief Converts a double precision world position to float, relative to an origin (camera, cell...)
+ * @param p The world position
+ * @param origin The world position of the new origin
+ * @return [Point3] p - origin, subtracted in double precision and rounded once to float
+ */
+inline Point3 Rebase(const Point3d& p, const Point3d& origin)
+    {return Point3(float(p.x - origin.x), float(p.y - origin.y), float(p.z - origin.z));}
+/*!
+ * @brief Converts a float position relative to an origin back to a double precision world position
+ * @param p The position relative to origin
+ * @param origin The world position of the origin
+ * @return [Point3d] origin + p
+ */
+inline Point3d ToWorld(const Point3& p, const Point3d& origin)
+    {return Point3d(origin.x + p.x, origin.y + p.y, origin.z + p.z);}
 
 // * * * * * 3D NORMAL VECTOR FROM TRIANGLE VERTICES * * * * * //
 
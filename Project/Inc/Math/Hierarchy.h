@@ -0,0 +1,109 @@
+#pragma once
+#include <climits>
+#include <cstdint>
+#include <vector>
+#include "Math\Helpers.h"
+#include "Math\Matrices.h"
+#include "Math\Parallel.h"
+
+using namespace std;
+
+/*!
+ * Scene graphs of Transform4 nodes, each placed relative to its parent. The local transforms,
+ * parents and world transforms live in flat arrays sorted by depth, so that every parent is
+ * stored before its children and all the nodes of one depth level are contiguous. Update() walks
+ * the levels from the root down: a level only reads the world transforms of the level above it,
+ * so its nodes are split across worker threads (see ParallelFor()), and only the subtrees below
+ * a changed node are recomputed.
+ */
+
+//! Smallest number of nodes of one depth level that a hierarchy update hands to a worker thread
+#ifndef MATH_HIERARCHY_PARALLEL_GRAIN
+#define MATH_HIERARCHY_PARALLEL_GRAIN (1 << 13)
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                          CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class TransformHierarchy
+ * @brief Flat, depth-sorted hierarchy of Transform4 nodes with dirty flags. Nodes are named by
+ *        the index AddNode() returned, which never changes; their storage order is private.
+ *        The world transform of a node is GetWorld(parent)*GetLocal(node), or GetLocal(node)
+ *        for a root, as of the last Update().
+ * @param Size() Number of nodes
+ * @param Levels() Number of depth levels, 1 + the largest depth
+ */
+struct TransformHierarchy
+{
+protected:
+    // Depth-sorted storage, indexed by slot
+    vector<Transform4> local;
+    vector<Transform4> world;
+    vector<int> parent;         // slot of the parent, NoParent for roots
+    vector<int> depth;
+    vector<uint8_t> dirty;      // local transform changed since the last Update()
+    vector<int> node;           // node of every slot
+    vector<int> slot;           // slot of every node
+    vector<int> levels;         // levels[d] is the first slot of depth d, levels[Levels()] == Size()
+    int levelCount;
+    bool sorted;                // nodes added out of depth order wait for Sort(), levels with them
+    int firstDirty;             // smallest depth holding a dirty node, INT_MAX when clean
+
+    void Sort(void);
+public:
+    //! Parent of the root nodes
+    static const int NoParent = -1;
+
+    //! @public @memberof TransformHierarchy
+    //! @brief Creates an empty hierarchy
+    TransformHierarchy() {levels.assign(1, 0); levelCount = 0; sorted = true; firstDirty = INT_MAX;}
+
+    //! @public @memberof TransformHierarchy
+    //! @brief Reserves storage for count nodes
+    void Reserve(int count);
+    /*!
+     * @public @memberof TransformHierarchy
+     * @brief Adds a node, dirty until the next Update()
+     * @param localTransform The transform of the node relative to its parent
+     * @param parentNode An existing node, or NoParent for a root
+     * @return [int] The index naming the new node, Size() - 1, or NoParent (nothing added) when
+     *         parentNode is not an existing node
+     * @note Adding nodes level by level (breadth first) keeps the storage sorted. Other orders
+     *       are sorted once, by the next Update()
+     */
+    int AddNode(const Transform4& localTransform, int parentNode = NoParent);
+
+    int Size(void) const {return int(local.size());}
+    int Levels(void) const {return levelCount;}
+    int GetParent(int n) const {const int p = parent[slot[n]]; return (p == NoParent) ? NoParent : node[p];}
+    int GetDepth(int n) const {return depth[slot[n]];}
+    const Transform4& GetLocal(int n) const {return local[slot[n]];}
+    //! @public @memberof TransformHierarchy
+    //! @brief [Transform4] World transform of node n as of the last Update()
+    const Transform4& GetWorld(int n) const {return world[slot[n]];}
+
+    //! @public @memberof TransformHierarchy
+    //! @brief Replaces the local transform of node n and marks its subtree for the next Update()
+    void SetLocal(int n, const Transform4& localTransform) {local[slot[n]] = localTransform; MarkDirty(n);}
+    //! @public @memberof TransformHierarchy
+    //! @brief Marks the subtree of node n for recomputation by the next Update()
+    void MarkDirty(int n) {const int s = slot[n]; dirty[s] = 1; firstDirty = min(firstDirty, depth[s]);}
+    //! @public @memberof TransformHierarchy
+    //! @brief True if GetWorld(n) is out of date: n or one of its ancestors changed since the
+    //!        last Update(). Walks the ancestors
+    bool IsDirty(int n) const;
+
+    /*!
+     * @public @memberof TransformHierarchy
+     * @brief Recomputes the world transforms of the dirty nodes and their descendants, level by
+     *        level from the shallowest dirty one, and clears the dirty flags
+     * @note Clean levels above the first dirty node are not visited, and a clean hierarchy
+     *       returns at once
+     */
+    void Update(void);
+    //! @public @memberof TransformHierarchy
+    //! @brief Recomputes every world transform
+    void UpdateAll(void);
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+#include "Math\Parallel.h"
+
+using namespace std;
+
+/*!
+ * Inverse kinematics for many chains at once, such as the legs or arms of a crowd. A chain is a
+ * line of jointCount joints whose first joint, the root, stays in place; its last joint, the end
+ * effector, is pulled towards the chain's target while every bone (the segment from joint j to
+ * joint j + 1) keeps its length. All the chains of a call have the same number of joints.
+ *
+ * Joints are one SoA stream of jointCount*chains points, joint j of chain c at [j*chains + c],
+ * so that one load gives joint j of 8 neighbouring chains. The solvers work 8 chains per SIMD
+ * step and split the chains across worker threads (see ParallelFor()):
+ *
+ *  CCD        Cyclic coordinate descent: from the last bone to the root, rotates the rest of the
+ *             chain about each joint so that the end effector points at the target
+ *  FABRIK     Forward and backward reaching: moves the end effector onto the target and drags
+ *             the joints after it, then puts the root back and drags them the other way
+ *
+ * Both run at most a fixed number of iterations and return the solved joints in place, along
+ * with the rotation of every bone.
+ */
+
+//! Smallest number of chains an IK solver hands to a worker thread
+#ifndef MATH_IK_PARALLEL_GRAIN
+#define MATH_IK_PARALLEL_GRAIN (1 << 9)
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @brief Solves chains by cyclic coordinate descent
+ * @param jointCount Joints per chain, at least 2
+ * @param iterations Largest number of sweeps from the last bone to the root
+ * @param tolerance Distance from its target under which an end effector counts as reached
+ * @param joints The jointCount*targets.count joints, replaced by the solved ones
+ * @param targets The target of every chain
+ * @param rotations The (jointCount - 1)*targets.count bone rotations, bone j of chain c at
+ *        [j*targets.count + c]: the shortest arc from the direction of the bone before solving
+ *        to its direction after, in world space
+ * @note Each group of 8 chains stops iterating once all of them are within tolerance, so a
+ *       chain may run more sweeps than it needs alone. Unreachable targets end with the chain
+ *       stretched towards them
+ */
+void SolveCCD(int jointCount, int iterations, float tolerance, const SoASpan<Point3>& joints,
+              const SoASpan<const Point3>& targets, const SoASpan<Quaternion>& rotations);
+/*!
+ * @brief Solves chains by forward and backward reaching (FABRIK)
+ * @param jointCount Joints per chain, at least 2
+ * @param iterations Largest number of forward and backward passes
+ * @param tolerance Distance from its target under which an end effector counts as reached
+ * @param joints The jointCount*targets.count joints, replaced by the solved ones
+ * @param targets The target of every chain
+ * @param rotations The (jointCount - 1)*targets.count bone rotations, as for SolveCCD()
+ * @note Stops like SolveCCD(). Bone lengths are measured once, from the input joints, and every
+ *       pass restores them
+ */
+void SolveFABRIK(int jointCount, int iterations, float tolerance, const SoASpan<Point3>& joints,
+                 const SoASpan<const Point3>& targets, const SoASpan<Quaternion>& rotations);
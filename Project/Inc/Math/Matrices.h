@@ -4,6 +4,7 @@
 #include <iostream>
 #include <string>
 #include "Math\Helpers.h"
+#include "Math\Core.h"
 #include "Math\Vectors.h"
 #include "Math\Geometry.h"
 
@@ -31,328 +32,8 @@ struct NonOrthogonalE : public runtime_error
 //---------------------------------------------------------------------------------------------
 
 
-/*!
- * @class Matrix2
- * @brief 2D square matrix data structure. Uses float values as matrix coefficients
- * @param M(i,j) Float accessed through the ith row and jth column
- * @param M[j] Vector2 accessed through jth column
- */
-struct Matrix2
-{
-protected:
-    float m[2][2];
-public:
-    //! @public @memberof Matrix2
-    //! @brief Creates an empty Matrix2 structure
-    Matrix2() = default;
-    //! @public @memberof Matrix2
-    //! @brief Creates an Matrix2 structure with 4 float matrix coefficients
-    Matrix2(float a00, float a01, float a10, float a11)
-    {
-        m[0][0] = a00; m[0][1] = a10;
-        m[1][0] = a01; m[1][1] = a11;
-    }
-    //! @public @memberof Matrix2
-    //! @brief Creates an Matrix2 structure with 2 Vector2 components as columns
-    Matrix2(const Vector2& a, const Vector2& b)
-    {
-        m[0][0] = a.x; m[0][1] = a.y;
-        m[1][0] = b.x; m[1][1] = b.y;
-    }
-    // [float] Operator for access to ith row and jth column
-    float& operator ()(int i, int j) {return (m[j][i]);}
-    // [const float] Operator for access to ith row and jth column
-    const float& operator ()(int i, int j) const {return (m[j][i]);}
-    // [Vector3] Operator for access to jth column
-    Vector2& operator [](int j) {return (*reinterpret_cast<Vector2 *>(m[j]));}
-    // [const Vector3] Operator for access to jth column
-    const Vector2& operator [](int j) const {return (*reinterpret_cast<const Vector2 *>(m[j]));}
-    Matrix2& operator += (const Matrix2& A)
-    {
-        m[0][0] += A(0,0); m[0][1] += A(1,0);
-        m[1][0] += A(0,1); m[1][1] += A(1,1);
-        return (*this);
-    }
-    Matrix2& operator -= (const Matrix2& A)
-    {
-        m[0][0] -= A(0,0); m[0][1] -= A(1,0);
-        m[1][0] -= A(0,1); m[1][1] -= A(1,1);
-        return (*this);
-    }
-    Matrix2& operator *= (float sc)
-    {
-        m[0][0] *= sc; m[0][1] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc;
-        return (*this);
-    }
-    Matrix2& operator /= (float sc)
-    {
-        sc = 1.0f/sc;
-        m[0][0] *= sc; m[0][1] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc;
-        return (*this);
-    }
-    const bool operator == (const Matrix2& A) const
-    {
-        return (*reinterpret_cast<const Vector2*>(m[0])==A[0]
-        && *reinterpret_cast<const Vector2*>(m[1])==A[1]);
-    }
-    const bool operator != (const Matrix2& A) const
-    {
-        return !(*this == A);
-    }
-    //! @brief Returns the ith row as a Vector2 structure
-    const Vector2 Row(int i) const
-    {
-        return Vector2(m[0][i], m[1][i]);
-    }
-    //! @brief Returns the jth row as a Vector2 structure
-    const Vector2 Col(int j) const
-    {
-        return Vector2(m[j][0], m[j][1]);
-    }
-    //! @brief Returns a 2x2 identity matrix
-    const Matrix2 Identity(void) const
-    {return Matrix2(1.0f, 0.0f,
-                    0.0f, 1.0f);}
-    //! @brief Returns a 2x2 zero matrix
-    const Matrix2 Zero(void) const
-    {return Matrix2(0.0f, 0.0f,
-                    0.0f, 0.0f);}
-    string ToString(void)
-    {
-        string s;
-        s += "\t[" + to_string(m[0][0]) + ", " + to_string(m[1][0]) + "]\n";
-        s += "\t[" + to_string(m[0][1]) + ", " + to_string(m[1][1]) + "]\n";
-        return s;
-    }
-    void Print(void) {cout << "Matrix2: \n" << (*this).ToString();}
-};
-/*!
- * @class Matrix3
- * @brief 3D square matrix data structure. Uses float values as matrix coefficients
- * @param M(i,j) Float accessed through the ith row and jth column
- * @param M[j] Vector3 accessed through jth column
- */
-struct Matrix3
-{
-protected:
-    float m[3][3];
-
-public:
-    //! @public @memberof Matrix3
-    //! @brief Construct an empty Matrix3 structure
-    Matrix3() = default;
-    //! @public @memberof Matrix3
-    //! @brief Construct a Matrix3 structure with 9 float matrix coefficients
-    Matrix3(float a00, float a01, float a02,
-            float a10, float a11, float a12,
-            float a20, float a21, float a22)
-    {m[0][0] = a00; m[0][1] = a10; m[0][2] = a20;
-    m[1][0] = a01; m[1][1] = a11; m[1][2] = a21;
-    m[2][0] = a02; m[2][1] = a12; m[2][2] = a22;}
-    //! @public @memberof Matrix3
-    //! @brief Construct a Matrix3 structure with 3 Vector3 components as columns
-    Matrix3(const Vector3& a, const Vector3& b, const Vector3& c)
-    {m[0][0] = a.x; m[0][1] = a.y; m[0][2] = a.z;
-    m[1][0] = b.x; m[1][1] = b.y; m[1][2] = b.z;
-    m[2][0] = c.x; m[2][1] = c.y; m[2][2] = c.z;}
-    // [float] Operator for access to ith row and jth column
-    float& operator ()(int i, int j) {return (m[j][i]);}
-    // [const float] Operator for access to ith row and jth column
-    const float& operator ()(int i, int j) const {return (m[j][i]);}
-    // [Vector3] Operator for access to jth column
-    Vector3& operator [](int j) {return (*reinterpret_cast<Vector3 *>(m[j]));}
-    // [const Vector3] Operator for access to jth
-    const Vector3& operator [](int j) const {return (*reinterpret_cast<const Vector3 *>(m[j]));}
-    Matrix3& operator +=(const Matrix3& A)
-    {
-        m[0][0] += A(0,0); m[0][1] += A(1,0); m[0][2] += A(2,0);
-        m[1][0] += A(0,1); m[1][1] += A(1,1); m[1][2] += A(2,1);
-        m[2][0] += A(0,2); m[2][1] += A(1,2); m[2][2] += A(2,2);
-        return (*this);
-    }
-    Matrix3& operator -=(const Matrix3& A)
-    {
-        m[0][0] -= A(0,0); m[0][1] -= A(1,0); m[0][2] -= A(2,0);
-        m[1][0] -= A(0,1); m[1][1] -= A(1,1); m[1][2] -= A(2,1);
-        m[2][0] -= A(0,2); m[2][1] -= A(1,2); m[2][2] -= A(2,2);
-        return (*this);
-    }
-    Matrix3& operator *=(float sc)
-    {
-        m[0][0] *= sc; m[0][1] *= sc; m[0][2] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc; m[1][2] *= sc;
-        m[2][0] *= sc; m[2][1] *= sc; m[2][2] *= sc;
-        return (*this);
-    }
-    Matrix3& operator /=(float sc)
-    {
-        sc = 1.0f/sc;
-        m[0][0] *= sc; m[0][1] *= sc; m[0][2] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc; m[1][2] *= sc;
-        m[2][0] *= sc; m[2][1] *= sc; m[2][2] *= sc;
-        return (*this);
-    }
-    const bool operator ==(const Matrix3& A) const
-    {
-        return (*reinterpret_cast<const Vector3*>(m[0])==A[0]
-        && *reinterpret_cast<const Vector3*>(m[1])==A[1]
-        && *reinterpret_cast<const Vector3*>(m[2])==A[2]);
-    }
-    const bool operator != (const Matrix3& A) const
-    {
-        return !(*this == A);
-    }
-    //! @brief Returns the ith row as a Vector2 structure
-    const Vector3 Row(int i) const
-    {
-        return Vector3(m[0][i], m[1][i], m[2][i]);
-    }
-    //! @brief Returns the jth row as a Vector2 structure
-    const Vector3 Col(int j) const
-    {
-        return Vector3(m[j][0], m[j][1], m[j][2]);
-    }
-    //! @brief Returns a 3x3 identity matrix
-    const Matrix3 Identity(void) const
-    {
-        return Matrix3( 1.0f, 0.0f, 0.0f,
-                        0.0f, 1.0f, 0.0f,
-                        0.0f, 0.0f, 1.0f);
-    }
-    //! @brief Returns a 3x3 zero matrix
-    const Matrix3 Zero(void) const
-    {
-        return Matrix3( 0.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f);
-    }
-    string ToString(void)
-    {
-        string s;
-        s += "\t[" + to_string(m[0][0]) + ", " + to_string(m[1][0]) + ", " + to_string(m[2][0]) + "]\n";
-        s += "\t[" + to_string(m[0][1]) + ", " + to_string(m[1][1]) + ", " + to_string(m[2][1]) + "]\n";
-        s += "\t[" + to_string(m[0][2]) + ", " + to_string(m[1][2]) + ", " + to_string(m[2][2]) + "]\n";
-        return s;
-    }
-    void Print(void) {cout << "Matrix3: \n" << (*this).ToString();}
-};
-/*!
- * @class Matrix4
- * @brief 4D square matrix data structure. Uses float values as matrix coefficients
- * @param M(i,j) Float accessed throught the ith row and jth column
- * @param M[j] Vector4 accessed throught the jth column
- */
-struct Matrix4
-{
-protected:
-    float m[4][4];
-public:
-    //! @public @memberof Matrix4
-    //! @brief Construct an empty Matrix4 structure
-    Matrix4() = default;
-    //! @public @memberof Matrix4
-    //! @brief Construct a Matrix4 structure with 16 matrix coefficients
-    Matrix4(float a00, float a01, float a02, float a03,
-            float a10, float a11, float a12, float a13,
-            float a20, float a21, float a22, float a23,
-            float a30, float a31, float a32, float a33)
-    {m[0][0] = a00; m[0][1] = a10; m[0][2] = a20; m[0][3] = a30;
-    m[1][0] = a01; m[1][1] = a11; m[1][2] = a21; m[1][3] = a31;
-    m[2][0] = a02; m[2][1] = a12; m[2][2] = a22; m[2][3] = a32;
-    m[3][0] = a03; m[3][1] = a13; m[3][2] = a23; m[3][3] = a33;}
-    //! @public @memberof Matrix4
-    //! @brief Construct a Matrix4 structure with 4 Vector4 components as columns
-    Matrix4(const Vector4& a, const Vector4& b, const Vector4& c, const Vector4& d)
-    {m[0][0] = a.x; m[0][1] = a.y; m[0][2] = a.z; m[0][3] = a.w;
-    m[1][0] = b.x; m[1][1] = b.y; m[1][2] = b.z; m[1][3] = b.w;
-    m[2][0] = c.x; m[2][1] = c.y; m[2][2] = c.z; m[2][3] = c.w;
-    m[3][0] = d.x; m[3][1] = d.y; m[3][2] = d.z; m[3][3] = d.w;}
-    // [float] Operator for access to ith row and jth column
-    float& operator ()(int i, int j) {return (m[j][i]);}
-    // [const float] Operator for access to ith row and jth column
-    const float& operator ()(int i, int j) const {return (m[j][i]);}
-    // [Vector4] Operator for access to jth column
-    Vector4& operator [](int j) {return (*reinterpret_cast<Vector4 *>(m[j]));}
-    // [const Vector4] Operator for access to jth column
-    const Vector4& operator [](int j) const {return (*reinterpret_cast<const Vector4 *>(m[j]));}
-    Matrix4& operator +=(const Matrix4& A)
-    {
-        m[0][0] += A(0,0); m[0][1] += A(1,0); m[0][2] += A(2,0); m[0][3] += A(3,0);
-        m[1][0] += A(0,1); m[1][1] += A(1,1); m[1][2] += A(2,1); m[1][3] += A(3,1);
-        m[2][0] += A(0,2); m[2][1] += A(1,2); m[2][2] += A(2,2); m[2][3] += A(3,2);
-        m[3][0] += A(0,3); m[3][1] += A(1,3); m[3][2] += A(2,3); m[3][3] += A(3,3);
-        return (*this);
-    }
-    Matrix4& operator -=(const Matrix4& A)
-    {
-        m[0][0] -= A(0,0); m[0][1] -= A(1,0); m[0][2] -= A(2,0); m[0][3] -= A(3,0);
-        m[1][0] -= A(0,1); m[1][1] -= A(1,1); m[1][2] -= A(2,1); m[1][3] -= A(3,1);
-        m[2][0] -= A(0,2); m[2][1] -= A(1,2); m[2][2] -= A(2,2); m[2][3] -= A(3,2);
-        m[3][0] -= A(0,3); m[3][1] -= A(1,3); m[3][2] -= A(2,3); m[3][3] -= A(3,3);
-        return (*this);
-    }
-    Matrix4& operator *=(float sc)
-    {
-        m[0][0] *= sc; m[0][1] *= sc; m[0][2] *= sc; m[0][3] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc; m[1][2] *= sc; m[1][3] *= sc;
-        m[2][0] *= sc; m[2][1] *= sc; m[2][2] *= sc; m[2][3] *= sc;
-        m[3][0] *= sc; m[3][1] *= sc; m[3][2] *= sc; m[3][3] *= sc;
-        return (*this);
-    }
-    Matrix4& operator /=(float sc)
-    {
-        sc = 1.0f/sc;
-        m[0][0] *= sc; m[0][1] *= sc; m[0][2] *= sc; m[0][3] *= sc;
-        m[1][0] *= sc; m[1][1] *= sc; m[1][2] *= sc; m[1][3] *= sc;
-        m[2][0] *= sc; m[2][1] *= sc; m[2][2] *= sc; m[2][3] *= sc;
-        m[3][0] *= sc; m[3][1] *= sc; m[3][2] *= sc; m[3][3] *= sc;
-        return (*this);
-    }
-    const bool operator ==(const Matrix4& A) const
-    {
-        return (*reinterpret_cast<const Vector4*>(m[0])==A[0]
-        && *reinterpret_cast<const Vector4*>(m[1])==A[1]
-        && *reinterpret_cast<const Vector4*>(m[2])==A[2]
-        && *reinterpret_cast<const Vector4*>(m[3])==A[3]);
-    }
-    const bool operator != (const Matrix4& A) const
-    {
-        return !(*this == A);
-    }
-    //! @brief Returns the ith row as a Vector2 structure
-    const Vector4 Row(int i) const
-    {
-        return Vector4(m[0][i], m[1][i], m[2][i], m[3][i]);
-    }
-    //! @brief Returns the jth row as a Vector2 structure
-    const Vector4 Col(int j) const
-    {
-        return Vector4(m[j][0], m[j][1], m[j][2], m[j][3]);
-    }
-    //! @brief Returns a 4x4 identity matrix
-    const Matrix4 Identity(void) const
-    {
-        return Matrix4( 1.0f, 0.0f, 0.0f, 0.0f,
-                        0.0f, 1.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 1.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f, 1.0f);
-    }
-    //! @brief Returns a 4x4 zero matrix
-    const Matrix4 Zero(void) const
-    {
-        return Matrix4( 0.0f, 0.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f, 0.0f,
-                        0.0f, 0.0f, 0.0f, 0.0f);
-    }
-    string ToString(void);
-    void Print(void)
-    {
-        cout << "Matrix4: \n" << (*this).ToString();
-    }
-};
+//! @note Matrix2, Matrix3 and Matrix4 are aliases of Mat<float,N,N> (see Core.h)
+
 /*!
  * @class Transform3 @extends Matrix3
  * @brief 3D square matrix for transfrom data structure. This is to be used to transform Matrix2 structures,
@@ -568,15 +249,83 @@ struct Transform4 : Matrix4
     }
     const Transform4 Zero() const
     {
-        Vector3 v;
-        Point3 p;
-        return Transform4(v.Zero(), v.Zero(), v.Zero(), p.Zero());
+        const Vector3 v(0.0f, 0.0f, 0.0f);
+        return Transform4(v, v, v, Point3(0.0f, 0.0f, 0.0f));
     }
 	void Print(void)
     {
         cout << "Transform4: \n" << (*this).ToString();
     }
 };
+/*!
+ * @class Transform4d @extends Matrix4d
+ * @brief Double precision Transform4 for world-space placement: a 3x3 linear part on the first three
+ *        columns and a Point3d translation on the last one. The 4th row is always (0,0,0,1).
+ *        Converted to a float Transform4 relative to a camera or cell origin with Rebase()
+ * @param T(i,j) Double accessed throught the ith row and jth column.
+ * @param T[j] Vector3d accessed through the jth column. The last entry in the Transform's column is ignored.
+ */
+struct Transform4d : Matrix4d
+{
+    //! @public @memberof Transform4d
+    //! @brief Constructs an empty Transform4d structure
+    Transform4d() = default;
+    //! @public @memberof Transform4d
+    //!@brief Constructs a Transform4d structure with 12 double components
+    Transform4d(double t00, double t01, double t02, double t03,
+                double t10, double t11, double t12, double t13,
+                double t20, double t21, double t22, double t23)
+    {
+        m[0][0] = t00; m[0][1] = t10; m[0][2] = t20;
+        m[1][0] = t01; m[1][1] = t11; m[1][2] = t21;
+        m[2][0] = t02; m[2][1] = t12; m[2][2] = t22;
+        m[3][0] = t03; m[3][1] = t13; m[3][2] = t23;
+
+        m[0][3] = 0.0; m[1][3] = 0.0; m[2][3] = 0.0; m[3][3] = 1.0;
+    }
+    //! @public @memberof Transform4d
+    //! @brief Constructs a Transform4d structure with 3 Vector3d components and one Point3d component
+    Transform4d(const Vector3d& v0, const Vector3d& v1, const Vector3d& v2, const Point3d& p)
+    {
+        m[0][0] = v0.x; m[0][1] = v0.y; m[0][2] = v0.z;
+        m[1][0] = v1.x; m[1][1] = v1.y; m[1][2] = v1.z;
+        m[2][0] = v2.x; m[2][1] = v2.y; m[2][2] = v2.z;
+
+        m[3][0] = p.x; m[3][1] = p.y; m[3][2] = p.z;
+
+        m[0][3] = 0.0; m[1][3] = 0.0; m[2][3] = 0.0; m[3][3] = 1.0;
+    }
+    //! @public @memberof Transform4d
+    //! @brief Widens a float Transform4 structure
+    explicit Transform4d(const Transform4& T)
+    {
+        for (int j=0; j<4; j++) for (int i=0; i<4; i++) m[j][i] = T(i,j);
+    }
+    //! @public @memberof Transform4d
+    //! @brief [Vector3d] Operator for access to the jth column of this Transform4d structure, neglecting its fourth row.
+    Vector3d& operator [](int j) {return (*reinterpret_cast<Vector3d *>(m[j]));}
+    //! @public @memberof Transform4d
+    //! @brief [const Vector3d] Operator for access to the jth column of this Transform4d structure, neglecting its fourth row.
+    const Vector3d& operator [](int j) const {return (*reinterpret_cast<const Vector3d *>(m[j]));}
+    //! @public @memberof Transform4d
+    //! @brief Gets the translation vector of this Transform4d as a Point3d structure
+    const Point3d& GetTranslation(void) const {return (*reinterpret_cast<const Point3d *>(m[3]));}
+    //! @public @memberof Transform4d
+    //! @brief Sets the translation vector of this Transform4d using a Point3d structure
+    void SetTranslation(const Point3d& p) {m[3][0] = p.x; m[3][1] = p.y; m[3][2] = p.z;}
+    const bool operator ==(const Transform4d& T) const
+    {
+        return ((*this)[0] == T[0] && (*this)[1] == T[1] && (*this)[2] == T[2] && (*this)[3] == T[3]);
+    }
+    const Transform4d Identity() const
+    {
+        return Transform4d(Vector3d(1,0,0), Vector3d(0,1,0), Vector3d(0,0,1), Point3d(0,0,0));
+    }
+    void Print(void)
+    {
+        cout << "Transform4d: \n" << (*this).ToString();
+    }
+};
 /*!
  * @class Quaternion
  * @brief Very useful data structures to represent simple and complex rotations and orientations.
@@ -635,96 +384,104 @@ struct Quaternion
     string ToString(void) {return "(" + to_string(x) + ", " + to_string(y) + ", " + to_string(z) + ", " + to_string(w) + ")";}
     void Print(void) {cout << "Quaternion: " << ToString() << endl;}
 };
+/*!
+ * @class UnitQuaternion @extends Quaternion
+ * @brief Quaternion of unit length, which represents a rotation. Every constructor yields a unit
+ *        quaternion, so GetRotation() and SetRotation() skip the magnitude check, square root and
+ *        divide of Quaternion and run without branches.
+ * @note Products of unit quaternions drift from unit length by about 1e-7 per multiplication.
+ *       Renormalize long chains through UnitQuaternion(const Quaternion&)
+ */
+struct UnitQuaternion : Quaternion
+{
+    //! @public @memberof UnitQuaternion
+    //! @brief Constructs the identity rotation
+    UnitQuaternion() : Quaternion(0.0f, 0.0f, 0.0f, 1.0f) {}
+    //! @public @memberof UnitQuaternion
+    //! @brief Constructs the unit quaternion of q's direction, q must not be zero
+    explicit UnitQuaternion(const Quaternion& q) {const float sc = 1.0f/q.Magnitude(); x = q.x*sc; y = q.y*sc; z = q.z*sc; w = q.w*sc;}
+    //! @public @memberof UnitQuaternion
+    //! @brief Constructs the unit quaternion of a rotation matrix, see SetRotation()
+    explicit UnitQuaternion(const Matrix3& M) {SetRotation(M);}
+    //! @public @memberof UnitQuaternion
+    //! @brief [UnitQuaternion] Wraps a quaternion already of unit length, e.g. the rotation of
+    //!        DecomposeTRS(), without normalizing it
+    static UnitQuaternion FromNormalized(const Quaternion& q) {UnitQuaternion u; u.x = q.x; u.y = q.y; u.z = q.z; u.w = q.w; return u;}
+    /*!
+     * @public @memberof UnitQuaternion
+     * @brief Gets the rotation matrix of this quaternion
+     * @return [Matrix3] The rotation matrix, without renormalizing the quaternion
+     */
+    Matrix3 GetRotation(void) const
+    {
+        const float x2 = x*x, y2 = y*y, z2 = z*z;
+        const float xy = x*y, xz = x*z, yz = y*z;
+        const float wx = w*x, wy = w*y, wz = w*z;
+        return (Matrix3(
+            1.0f - 2.0f*(y2 + z2), 2.0f*(xy - wz), 2.0f*(xz + wy),
+            2.0f*(xy + wz), 1.0f - 2.0f*(x2 + z2), 2.0f*(yz - wx),
+            2.0f*(xz - wy), 2.0f*(yz + wx), 1.0f - 2.0f*(x2 + y2)));
+    }
+    /*!
+     * @public @memberof UnitQuaternion
+     * @brief Sets this quaternion from a rotation matrix, picking the same case (and sign) as
+     *        Quaternion::SetRotation() through selects. The picked component is at least 1/2, so
+     *        one reciprocal square root (InvSqrtFast()) replaces the square root and divide
+     * @param M The rotation matrix. Other matrices give a quaternion of non-unit length
+     */
+    void SetRotation(const Matrix3& M);
+};
+/*!
+ * @class DualQuaternion
+ * @brief Rigid transform, a rotation followed by a translation, as the dual quaternion
+ *        real + e*dual with e^2 = 0. real is the unit rotation and dual = (t, 0)*real/2 for the
+ *        translation t. Blends of dual quaternions stay rigid once renormalized, unlike blends of
+ *        matrices, which is what dual quaternion skinning relies on
+ * @param real The rotation
+ * @param dual Half the translation times the rotation
+ * @param GetTranslation() Recovers t = 2*dual*conjugate(real), real of unit length
+ */
+struct DualQuaternion
+{
+    Quaternion real, dual;
+
+    //! @public @memberof DualQuaternion
+    //! @brief Constructs the identity transform
+    DualQuaternion() : real(0.0f, 0.0f, 0.0f, 1.0f), dual(0.0f, 0.0f, 0.0f, 0.0f) {}
+    //! @public @memberof DualQuaternion
+    //! @brief Constructs a dual quaternion from its real and dual parts
+    DualQuaternion(const Quaternion& r, const Quaternion& d) : real(r), dual(d) {}
+    //! @public @memberof DualQuaternion
+    //! @brief Constructs the rotation q followed by the translation t
+    DualQuaternion(const UnitQuaternion& q, const Vector3& t) : real(q)
+    {
+        const Vector3 u = q.GetVector();
+        const Vector3 v = 0.5f*(q.w*t + CrossProduct(t, u));
+        dual = Quaternion(v, -0.5f*(t*u));
+    }
+    /*!
+     * @public @memberof DualQuaternion
+     * @brief Constructs the rigid part of a transform
+     * @param T The transform. Its scale, see DecomposeTRS(), is dropped; a degenerate T gives
+     *        its translation with no rotation
+     */
+    explicit DualQuaternion(const Transform4& T);
+    //! @public @memberof DualQuaternion
+    //! @brief [UnitQuaternion] The rotation, real of unit length
+    UnitQuaternion GetRotation(void) const {return UnitQuaternion::FromNormalized(real);}
+    const Vector3 GetTranslation(void) const
+    {
+        const Vector3 u = real.GetVector(), v = dual.GetVector();
+        return 2.0f*(real.w*v - dual.w*u + CrossProduct(u, v));
+    }
+};
 //---------------------------------------------------------------------------------------------
 //                                        INLINE FUNCTIONS
 //---------------------------------------------------------------------------------------------
 
 // * * * * * OPERATORS * * * * * //
 
-//Matrix2
-
-inline Matrix2 operator +(const Matrix2& A, const Matrix2& B)
-{return (Matrix2(A(0,0)+B(0,0), A(0,1)+B(0,1),
-                A(1,0)+B(1,0), A(1,1)+B(1,1)));}
-inline Matrix2 operator *(const Matrix2& M, float sc)
-{return (Matrix2(M(0,0)*sc, M(0,1)*sc, M(1,0)*sc, M(1,1)*sc));}
-inline Matrix2 operator *(float sc, const Matrix2& M) {return (M*sc);}
-inline Matrix2 operator /(const Matrix2& M, float sc) {return ((1.0f/sc) * M);}
-inline Matrix2 operator *(const Matrix2& A, const Matrix2& B)
-{return (Matrix2(A(0,0)*B(0,0) + A(0,1)*B(1,0),
-                A(0,0)*B(0,1) + A(0,1)*B(1,1),
-                A(1,0)*B(0,0) + A(1,1)*B(1,0),
-                A(1,0)*B(0,1) + A(1,1)*B(1,1)));}
-inline Vector2 operator *(const Matrix2& M, const Vector2& v)
-{return (Vector2(M(0,0)*v.x + M(0,1)*v.y,
-                M(1,0)*v.x + M(1,1)*v.y));}
-inline Matrix2 operator -(const Matrix2& A, const Matrix2& B) {return (A + (-1.0f*B));}
-
-// Matrix3
-
-inline Matrix3 operator +(const Matrix3& A, const Matrix3& B)
-{return (Matrix3(A(0,0)+B(0,0), A(0,1)+B(0,1), A(0,2)+B(0,2),
-                A(1,0)+B(1,0), A(1,1)+B(1,1), A(1,2)+B(1,2),
-                A(2,0)+B(2,0), A(2,1)+B(2,1), A(2,2)+B(2,2)));}
-inline Matrix3 operator *(float sc, const Matrix3& M)
-{return (Matrix3(sc*M(0,0), sc*M(0,1), sc*M(0,2),
-                sc*M(1,0), sc*M(1,1), sc*M(1,2),
-                sc*M(2,0), sc*M(2,1), sc*M(2,2)));}
-inline Matrix3 operator *(const Matrix3& M, float sc) {return (sc*M);}
-inline Matrix3 operator /(const Matrix3& M, float sc) {return ((1.0f/sc)*M);}
-inline Matrix3 operator -(const Matrix3& A, const Matrix3& B) {return (A + (-1.0f * B));}
-inline Matrix3 operator *(const Matrix3& A, const Matrix3& B)
-{return (Matrix3(A(0,0)*B(0,0) + A(0,1)*B(1,0) + A(0,2)*B(2,0),
-                A(0,0)*B(0,1) + A(0,1)*B(1,1) + A(0,2)*B(2,1),
-                A(0,0)*B(0,2) + A(0,1)*B(1,2) + A(0,2)*B(2,2),
-                A(1,0)*B(0,0) + A(1,1)*B(1,0) + A(1,2)*B(2,0),
-                A(1,0)*B(0,1) + A(1,1)*B(1,1) + A(1,2)*B(2,1),
-                A(1,0)*B(0,2) + A(1,1)*B(1,2) + A(1,2)*B(2,2),
-                A(2,0)*B(0,0) + A(2,1)*B(1,0) + A(2,2)*B(2,0),
-                A(2,0)*B(0,1) + A(2,1)*B(1,1) + A(2,2)*B(2,1),
-                A(2,0)*B(0,2) + A(2,1)*B(1,2) + A(2,2)*B(2,2)));}
-inline Vector3 operator *(const Matrix3& M, const Vector3& v)
-{return (Vector3(M(0,0)*v.x + M(0,1)*v.y + M(0,2)*v.z,
-                M(1,0)*v.x + M(1,1)*v.y + M(1,2)*v.z,
-                M(2,0)*v.x + M(2,1)*v.y + M(2,2)*v.z));}
-
-// Matrix4
-
-inline Matrix4 operator +(const Matrix4& A, const Matrix4& B)
-{return (Matrix4(A(0,0)+B(0,0), A(0,1)+B(0,1), A(0,2)+B(0,2), A(0,3)+B(0,3),
-                A(1,0)+B(1,0), A(1,1)+B(1,1), A(1,2)+B(1,2), A(1,3)+B(1,3),
-                A(2,0)+B(2,0), A(2,1)+B(2,1), A(2,2)+B(2,2), A(2,3)+B(2,3),
-                A(3,0)+B(3,0), A(3,1)+B(3,1), A(3,2)+B(3,2), A(3,3)+B(3,3)));}
-inline Matrix4 operator *(const Matrix4& A, const Matrix4& B)
-{return (Matrix4(A(0,0)*B(0,0) + A(0,1)*B(1,0) + A(0,2)*B(2,0) + A(0,3)*B(3,0),
-                A(0,0)*B(0,1) + A(0,1)*B(1,1) + A(0,2)*B(2,1) + A(0,3)*B(3,1),
-                A(0,0)*B(0,2) + A(0,1)*B(1,2) + A(0,2)*B(2,2) + A(0,3)*B(3,2),
-                A(0,0)*B(0,3) + A(0,1)*B(1,3) + A(0,2)*B(2,3) + A(0,3)*B(3,3),
-                A(1,0)*B(0,0) + A(1,1)*B(1,0) + A(1,2)*B(2,0) + A(1,3)*B(3,0),
-                A(1,0)*B(0,1) + A(1,1)*B(1,1) + A(1,2)*B(2,1) + A(1,3)*B(3,1),
-                A(1,0)*B(0,2) + A(1,1)*B(1,2) + A(1,2)*B(2,2) + A(1,3)*B(3,2),
-                A(1,0)*B(0,3) + A(1,1)*B(1,3) + A(1,2)*B(2,3) + A(1,3)*B(3,3),
-                A(2,0)*B(0,0) + A(2,1)*B(1,0) + A(2,2)*B(2,0) + A(2,3)*B(3,0),
-                A(2,0)*B(0,1) + A(2,1)*B(1,1) + A(2,2)*B(2,1) + A(2,3)*B(3,1),
-                A(2,0)*B(0,2) + A(2,1)*B(1,2) + A(2,2)*B(2,2) + A(2,3)*B(3,2),
-                A(2,0)*B(0,3) + A(2,1)*B(1,3) + A(2,2)*B(2,3) + A(2,3)*B(3,3),
-                A(3,0)*B(0,0) + A(3,1)*B(1,0) + A(3,2)*B(2,0) + A(3,3)*B(3,0),
-                A(3,0)*B(0,1) + A(3,1)*B(1,1) + A(3,2)*B(2,1) + A(3,3)*B(3,1),
-                A(3,0)*B(0,2) + A(3,1)*B(1,2) + A(3,2)*B(2,2) + A(3,3)*B(3,2),
-                A(3,0)*B(0,3) + A(3,1)*B(1,3) + A(3,2)*B(2,3) + A(3,3)*B(3,3)));}
-inline Vector4 operator *(const Matrix4& M, const Vector4& v)
-{return (Vector4(M(0,0)*v.x + M(0,1)*v.y + M(0,2)*v.z + M(0,3)*v.w,
-                M(1,0)*v.x + M(1,1)*v.y + M(1,2)*v.z + M(1,3)*v.w,
-                M(2,0)*v.x + M(2,1)*v.y + M(2,2)*v.z + M(2,3)*v.w,
-                M(3,0)*v.x + M(3,1)*v.y + M(3,2)*v.z + M(3,3)*v.w));}
-inline Matrix4 operator *(float sc, const Matrix4& M)
-{return (Matrix4(sc*M(0,0), sc*M(0,1), sc*M(0,2), sc*M(0,3),
-                sc*M(1,0), sc*M(1,1), sc*M(1,2), sc*M(1,3),
-                sc*M(2,0), sc*M(2,1), sc*M(2,2), sc*M(2,3),
-                sc*M(3,0), sc*M(3,1), sc*M(3,2), sc*M(3,3)));}
-inline Matrix4 operator *(const Matrix4& M, float sc) {return (sc*M);}
-inline Matrix4 operator /(const Matrix4& M, float sc) {return ((1.0f/sc)*M);}
-inline Matrix4 operator -(const Matrix4& A, const Matrix4& B) {return (A + (-1.0f * B));}
+//! @note Matrix2, Matrix3 and Matrix4 operators are the Mat templates in Core.h
 
 // Transform3
 
@@ -779,6 +536,23 @@ inline Transform4 operator *(float sc, const Transform4& T)
 inline Transform4 operator *(const Transform4& T, float sc) {return (sc*T);}
 inline Transform4 operator /(const Transform4& T, float sc) {return (1.0f/sc) * T;}
 inline Transform4 operator -(const Transform4& A, const Transform4& B) {return A + (-1.0f*B);}
+#if MATH_SIMD_SSE && !MATH_SIMD_AVX
+inline Transform4 operator *(const Transform4& A, const Transform4& B)
+{
+    // Column j of A*B combines the first three columns of A with column j of B, in the scalar
+    // order; the translation column also adds the translation of A. The 4th row stays (0,0,0,1).
+    // With AVX the compiler vectorizes the scalar form below better
+    __m128 a0 = _mm_load_ps(&A(0,0)), a1 = _mm_load_ps(&A(0,1)), a2 = _mm_load_ps(&A(0,2));
+    Transform4 P;
+    for (int j=0; j<4; j++)
+    {
+        __m128 b = _mm_load_ps(&B(0,j));
+        __m128 r = SimdMulAdd(a2, SimdSplat<2>(b), SimdMulAdd(a1, SimdSplat<1>(b), _mm_mul_ps(a0, SimdSplat<0>(b))));
+        _mm_store_ps(&P(0,j), (j == 3) ? _mm_add_ps(r, _mm_load_ps(&A(0,3))) : r);
+    }
+    return P;
+}
+#else
 inline Transform4 operator *(const Transform4& A, const Transform4& B)
 {return (Transform4(
     A(0,0)*B(0,0) + A(0,1)*B(1,0) + A(0,2)*B(2,0),
@@ -793,6 +567,7 @@ inline Transform4 operator *(const Transform4& A, const Transform4& B)
     A(2,0)*B(0,1) + A(2,1)*B(1,1) + A(2,2)*B(2,1),
     A(2,0)*B(0,2) + A(2,1)*B(1,2) + A(2,2)*B(2,2),
     A(2,0)*B(0,3) + A(2,1)*B(1,3) + A(2,2)*B(2,3) + A(2,3)));}
+#endif
 inline Vector3 operator *(const Vector3& n, const Transform4& T)
 {return (Vector3(
     n.x*T(0,0) + n.y*T(1,0) + n.z*T(2,0),
@@ -827,6 +602,29 @@ inline Plane operator *(const Transform4& T, const Plane& f)
     T(2,0)*f.x + T(2,1)*f.y + T(2,2)*f.z + T(2,3)*f.w,
     T(3,3)*f.w);}
 
+// Transform4d
+
+inline Transform4d operator *(const Transform4d& A, const Transform4d& B)
+{return (Transform4d(
+    A(0,0)*B(0,0) + A(0,1)*B(1,0) + A(0,2)*B(2,0),
+    A(0,0)*B(0,1) + A(0,1)*B(1,1) + A(0,2)*B(2,1),
+    A(0,0)*B(0,2) + A(0,1)*B(1,2) + A(0,2)*B(2,2),
+    A(0,0)*B(0,3) + A(0,1)*B(1,3) + A(0,2)*B(2,3) + A(0,3),
+    A(1,0)*B(0,0) + A(1,1)*B(1,0) + A(1,2)*B(2,0),
+    A(1,0)*B(0,1) + A(1,1)*B(1,1) + A(1,2)*B(2,1),
+    A(1,0)*B(0,2) + A(1,1)*B(1,2) + A(1,2)*B(2,2),
+    A(1,0)*B(0,3) + A(1,1)*B(1,3) + A(1,2)*B(2,3) + A(1,3),
+    A(2,0)*B(0,0) + A(2,1)*B(1,0) + A(2,2)*B(2,0),
+    A(2,0)*B(0,1) + A(2,1)*B(1,1) + A(2,2)*B(2,1),
+    A(2,0)*B(0,2) + A(2,1)*B(1,2) + A(2,2)*B(2,2),
+    A(2,0)*B(0,3) + A(2,1)*B(1,3) + A(2,2)*B(2,3) + A(2,3)));}
+// Applies the full affine transform, translation included, to a world position
+inline Point3d operator *(const Transform4d& T, const Point3d& p)
+{return (Point3d(
+    T(0,0)*p.x + T(0,1)*p.y + T(0,2)*p.z + T(0,3),
+    T(1,0)*p.x + T(1,1)*p.y + T(1,2)*p.z + T(1,3),
+    T(2,0)*p.x + T(2,1)*p.y + T(2,2)*p.z + T(2,3)));}
+
 // Quaternions
 
 inline Quaternion operator +(const Quaternion& a, const Quaternion& b)
@@ -843,55 +641,15 @@ inline Quaternion operator *(const Quaternion& q1, const Quaternion& q2)
     q1.w*q2.z + q1.x*q2.y - q1.y*q2.x + q1.z*q2.w,
     q1.w*q2.w - q1.x*q2.x - q1.y*q2.y - q1.z*q2.z
 ));}
+// Unit quaternions: the rotation q2 followed by q1, not renormalized
+inline UnitQuaternion operator *(const UnitQuaternion& q1, const UnitQuaternion& q2)
+{return (UnitQuaternion::FromNormalized(static_cast<const Quaternion&>(q1)*static_cast<const Quaternion&>(q2)));}
+// Dual quaternions: the transform b followed by a
+inline DualQuaternion operator *(const DualQuaternion& a, const DualQuaternion& b)
+{return (DualQuaternion(a.real*b.real, a.real*b.dual + a.dual*b.real));}
 // * * * * * METHODS * * * * * //
 
-// Diagonals
-
-/*!
- * @brief Returns the diagonal of the matrix
- * @param M Matrix to get the diagonal of
- * @return [Vector2] Diagonal of the matrix
- */
-inline Vector2 Diagonal(const Matrix2& M) {return Vector2(M(0,0), M(1,1));}
-/*!
- * @brief Returns the diagonal of the matrix
- * @param M Matrix to get the diagonal of
- * @return [Vector2] Diagonal of the matrix
- */
-inline Vector3 Diagonal(const Matrix3& M) {return Vector3(M(0,0), M(1,1), M(2,2));}
-/*!
- * @brief Returns the diagonal of the matrix
- * @param M Matrix to get the diagonal of
- * @return [Vector2] Diagonal of the matrix
- */
-inline Vector4 Diagonal(const Matrix4& M) {return Vector4(M(0,0), M(1,1), M(2,2), M(3,3));}
-
-
-// Transpose
-
-/*! @brief Calculates the transpose of a 2x2 matrix
- *  @param[in] M 2x2 matrix to transpose
- *  @return [Matrix2] Transposed 2x2 matrix
- */
-inline Matrix2 Transpose(const Matrix2& M)
-{return (Matrix2(M(0,0), M(1,0), M(0,1), M(1,1)));}
-/*! @brief Calculates the transpose of a 3x3 matrix
- *  @param[in] M 3x3 matrix to transpose
- *  @return [Matrix3] Transposed 3x3 matrix
- */
-inline Matrix3 Transpose(const Matrix3& M)
-{return (Matrix3(M(0,0), M(1,0), M(2,0),
-                M(0,1), M(1,1), M(2,1),
-                M(0,2), M(1,2), M(2,2)));}
-/*! @brief Calculates the transpose of a 4x4 matrix
- *  @param[in] M 4x4 matrix to transpose
- *  @return [Matrix4] Transposed 4x4 matrix
- */
-inline Matrix4 Transpose(const Matrix4& M)
-{return (Matrix4( M(0,0), M(1,0), M(2,0), M(3,0),
-                M(0,1), M(1,1), M(2,1), M(3,1),
-                M(0,2), M(1,2), M(2,2), M(3,2),
-                M(0,3), M(1,3), M(2,3), M(3,3)));}
+//! @note Diagonal, Transpose and Trace are the Mat templates in Core.h
 
 //! REF  @note These functions are not inlined, but are used
 //! immediately after they are declared, so they should go here
@@ -942,24 +700,6 @@ inline float Det(const Matrix3& M)
  */
 float Det(const Matrix4& M);
 
-// Trace
-
-/*! @brief Calculates the trace of a 2x2 matrix
- *  @param[in] M 2x2 matrix to find the trace for
- *  @return [float] Trace of 2x2 matrix
- */
-inline float Trace(const Matrix2& M) {return (M(0,0) + M(1,1));}
-/*! @brief Calculates the trace of a 3x3 matrix
- *  @param[in] M 3x3 matrix to find the trace for
- *  @return [float] Trace of 3x3 matrix
- */
-inline float Trace(const Matrix3& M)  {return (M(0,0) + M(1,1) + M(2,2));}
-/*! @brief Calculates the trace of a 4x4 matrix
- *  @param[in] M 4x4 matrix to find the trace for
- *  @return [float] Trace of 4x4 matrix
- */
-inline float Trace(const Matrix4& M) {return (M(0,0) + M(1,1) + M(2,2) + M(3,3));}
-
 // Inverse
 
 /*! @brief Calculates the inverse of a 2x2 matrix
@@ -994,6 +734,50 @@ Transform3 Inverse(const Transform3& T);
  */
 Transform4 Inverse(const Transform4& T);
 
+// Exception-free inverse
+
+//! @note The TryInverse functions never throw or print. They compute the determinant and the
+//!       inverse in one pass and report singular matrices through their return value, writing
+//!       the zero matrix instead. A matrix is singular when its determinant is zero or so close
+//!       to zero (or so large) that scaling by its reciprocal is not finite. Valid results are
+//!       the ones of Inverse().
+
+/*! @brief Calculates the inverse and the determinant of a 2x2 matrix without throwing
+ *  @param[in] M 2x2 matrix to invert
+ *  @param[out] inv Inverse of M, or the zero matrix when M is singular
+ *  @param[out] det Determinant of M
+ *  @return [bool] False if M is singular
+ */
+bool TryInverse(const Matrix2& M, Matrix2& inv, float& det) noexcept;
+/*! @brief Calculates the inverse and the determinant of a 3x3 matrix without throwing
+ *  @param[in] M 3x3 matrix to invert
+ *  @param[out] inv Inverse of M, or the zero matrix when M is singular
+ *  @param[out] det Determinant of M
+ *  @return [bool] False if M is singular
+ */
+bool TryInverse(const Matrix3& M, Matrix3& inv, float& det) noexcept;
+/*! @brief Calculates the inverse and the determinant of a 4x4 matrix without throwing
+ *  @param[in] M 4x4 matrix to invert
+ *  @param[out] inv Inverse of M, or the zero matrix when M is singular
+ *  @param[out] det Determinant of M
+ *  @return [bool] False if M is singular
+ */
+bool TryInverse(const Matrix4& M, Matrix4& inv, float& det) noexcept;
+/*! @brief Generates the inverse of a 2D transform and its determinant without throwing
+ *  @param T Transform to invert
+ *  @param[out] inv Inverted transform, or the zero transform when T is singular
+ *  @param[out] det Determinant of the 2x2 part of T
+ *  @return [bool] False if T is singular
+ */
+bool TryInverse(const Transform3& T, Transform3& inv, float& det) noexcept;
+/*! @brief Generates the inverse of a 3D transform and its determinant without throwing
+ *  @param T Transform to invert
+ *  @param[out] inv Inverted transform, or the zero transform when T is singular
+ *  @param[out] det Determinant of the 3x3 part of T
+ *  @return [bool] False if T is singular
+ */
+bool TryInverse(const Transform4& T, Transform4& inv, float& det) noexcept;
+
 // Adjugate
 
 /*! @brief Calculates the adjugate of a 2x2 matrix
@@ -1005,11 +789,12 @@ inline Matrix2 Adjugate(const Matrix2& M)
 /*! @brief Calculates the adjugate of a 3x3 matrix
  *  @param[in] M 3x3 matrix to find the adjugate for
  *  @return [Matrix3] Adjugate of 3x3 matrix
+ *  @note Computed without the determinant, so singular matrices are handled too
  */
 Matrix3 Adjugate(const Matrix3& M);
 /*! @brief Calculates the adjugate of a 4x4 matrix
  *  @param[in] M 4x4 matrix to find the adjugate for
- *  @return [Matrix4] Adjugate of 4x4 matrix
+ *  @return [Matrix4] Adjugate of 4x4 matrix, the transpose of Cofactor(M)
  */
 Matrix4 Adjugate(const Matrix4& M);
 
@@ -1028,8 +813,40 @@ inline Matrix3 Cofactor(const Matrix3& M) {return (Transpose(Adjugate(M)));}
 /*! @brief Calculates the cofactor of a 4x4 matrix
  *  @param[in] M 4x4 matrix to find the cofactor for
  *  @return [Matrix4] Cofactor of 4x4 matrix
+ *  @note Built from cross products of the columns without dividing by the determinant, so
+ *        singular matrices are handled too
  */
-inline Matrix4 Cofactor(const Matrix4& M) {return (Transpose(Adjugate(M)));}
+#if MATH_SIMD_SSE
+inline Matrix4 Cofactor(const Matrix4& M)
+{
+    // With columns a, b, c, d (first three rows) and x, y, z, w on the 4th row, the columns of the
+    // cofactor matrix are built from s = a x b, t = c x d, u = a*y - b*x and v = c*w - d*z.
+    // The 4th lane of every intermediate is zero, and the 4th row is inserted last
+    __m128 a = _mm_load_ps(&M(0,0)), b = _mm_load_ps(&M(0,1)), c = _mm_load_ps(&M(0,2)), d = _mm_load_ps(&M(0,3));
+    __m128 x = SimdSplat<3>(a), y = SimdSplat<3>(b), z = SimdSplat<3>(c), w = SimdSplat<3>(d);
+    __m128 s = SimdCrossProduct(a, b), t = SimdCrossProduct(c, d);
+    __m128 u = _mm_sub_ps(_mm_mul_ps(a, y), _mm_mul_ps(b, x));
+    __m128 v = _mm_sub_ps(_mm_mul_ps(c, w), _mm_mul_ps(d, z));
+    __m128 last = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1)), zero = _mm_setzero_ps();
+    Matrix4 C = Matrix4::Zero();
+    _mm_store_ps(&C(0,0), _mm_or_ps(_mm_add_ps(SimdCrossProduct(b, v), _mm_mul_ps(t, y)), _mm_and_ps(last, _mm_sub_ps(zero, SimdDot4(b, t)))));
+    _mm_store_ps(&C(0,1), _mm_or_ps(_mm_sub_ps(SimdCrossProduct(v, a), _mm_mul_ps(t, x)), _mm_and_ps(last, SimdDot4(a, t))));
+    _mm_store_ps(&C(0,2), _mm_or_ps(_mm_add_ps(SimdCrossProduct(d, u), _mm_mul_ps(s, w)), _mm_and_ps(last, _mm_sub_ps(zero, SimdDot4(d, s)))));
+    _mm_store_ps(&C(0,3), _mm_or_ps(_mm_sub_ps(SimdCrossProduct(u, c), _mm_mul_ps(s, z)), _mm_and_ps(last, SimdDot4(c, s))));
+    return C;
+}
+#else
+inline Matrix4 Cofactor(const Matrix4& M)
+{
+    // Same construction as the SIMD path, one 3D column at a time
+    Vector3 a(M(0,0), M(1,0), M(2,0)), b(M(0,1), M(1,1), M(2,1)), c(M(0,2), M(1,2), M(2,2)), d(M(0,3), M(1,3), M(2,3));
+    float x = M(3,0), y = M(3,1), z = M(3,2), w = M(3,3);
+    Vector3 s = CrossProduct(a, b), t = CrossProduct(c, d), u = a*y - b*x, v = c*w - d*z;
+    Vector3 r0 = CrossProduct(b, v) + t*y, r1 = CrossProduct(v, a) - t*x, r2 = CrossProduct(d, u) + s*w, r3 = CrossProduct(u, c) - s*z;
+    return Matrix4(Vector4(r0.x, r0.y, r0.z, 0.0f - b*t), Vector4(r1.x, r1.y, r1.z, a*t),
+                   Vector4(r2.x, r2.y, r2.z, 0.0f - d*s), Vector4(r3.x, r3.y, r3.z, c*s));
+}
+#endif
 
 // Scaling
 
@@ -1090,6 +907,40 @@ Matrix4 Scale(float sc, const Vector4& a);
 
 // Quaternion Normalization
 inline Quaternion Normalize(const Quaternion& q) {return (q/q.Magnitude());}
+// Inverse rotation of a unit quaternion, its conjugate
+inline UnitQuaternion Inverse(const UnitQuaternion& q) {return (UnitQuaternion::FromNormalized(Quaternion(-q.x, -q.y, -q.z, q.w)));}
+// Unit quaternion rotation in the cross-product form v + w*t + u x t, t = 2*(u x v), cheaper than
+// Transform(const Vector3&, const Quaternion&) and than building q.GetRotation()
+inline Vector3 Transform(const Vector3& v, const UnitQuaternion& q)
+{
+    const Vector3 u = q.GetVector();
+    const Vector3 t = 2.0f*CrossProduct(u, v);
+    return (v + q.w*t + CrossProduct(u, t));
+}
+// Dual quaternion normalization: both parts over the magnitude of the real one, as after blending
+inline DualQuaternion Normalize(const DualQuaternion& q) {const float sc = 1.0f/q.real.Magnitude(); return (DualQuaternion(q.real*sc, q.dual*sc));}
+// Rigid transform of a point by a dual quaternion of unit real part, the rotation then the translation
+inline Point3 Transform(const Point3& p, const DualQuaternion& q)
+{
+    const Vector3 r = Transform(p, q.GetRotation()) + q.GetTranslation();
+    return (Point3(r.x, r.y, r.z));
+}
+
+// Origin rebasing
+
+/*!
+ * @brief Converts a double precision world transform to float, relative to an origin (camera, cell...)
+ * @param T The world transform
+ * @param origin The world position of the new origin
+ * @return [Transform4] T with its translation rebased like Rebase(Point3d, Point3d), the linear part rounded to float
+ */
+inline Transform4 Rebase(const Transform4d& T, const Point3d& origin)
+{
+    return Transform4(
+        float(T(0,0)), float(T(0,1)), float(T(0,2)), float(T(0,3) - origin.x),
+        float(T(1,0)), float(T(1,1)), float(T(1,2)), float(T(1,3) - origin.y),
+        float(T(2,0)), float(T(2,1)), float(T(2,2)), float(T(2,3) - origin.z));
+}
 
 // Orthogonality check
 
@@ -1264,6 +1115,143 @@ Line TransformLine(const Line& L, const Transform4& T);
  * @brief Transforms a Vector3 structure using a Quaternion structure
  * @param v The Vector3 to transform
  * @param q The quaternion
- * @return [Vector3] (v) transformed by (q)
+ * @return [Vector3] q*v*q^-1 scaled by |q|^2: (v) rotated by (q), and scaled by its squared
+ *         magnitude when q is not of unit length
+ */
+Vector3 Transform(const Vector3& v, const Quaternion& q);
+// TRS
+
+//! Smallest |det| of the 3x3 part, relative to the cube of its Frobenius norm, that DecomposeTRS() decomposes
+#ifndef MATH_TRS_MIN_DETERMINANT
+#define MATH_TRS_MIN_DETERMINANT 1e-12f
+#endif
+//! Largest change of an element between two polar iterations at which DecomposeTRS() stops
+#ifndef MATH_TRS_TOLERANCE
+#define MATH_TRS_TOLERANCE 1e-6f
+#endif
+//! Most polar iterations run by DecomposeTRS(), reached only for nearly singular transforms
+#ifndef MATH_TRS_MAX_ITERATIONS
+#define MATH_TRS_MAX_ITERATIONS 20
+#endif
+
+/*!
+ * @brief Splits a transform into translation, rotation and scale, T = Translate(t)*Rotate(q)*Scale(s),
+ *        through the polar decomposition of its 3x3 part
+ * @param T The transform
+ * @param translation Receives the translation of T
+ * @param rotation Receives the unit quaternion of the rotation nearest to the 3x3 part
+ * @param scale Receives the scale along the rotated axes. A mirrored transform (negative
+ *              determinant) keeps its reflection in the sign of scale.x
+ * @return [bool] False if the 3x3 part is singular, e.g. a zero scale, in which case rotation is
+ *         the identity and scale holds the column lengths
+ * @note Shear does not survive the round trip: ComposeTRS() rebuilds T exactly only when its
+ *       columns are orthogonal
+ */
+bool DecomposeTRS(const Transform4& T, Point3& translation, Quaternion& rotation, Vector3& scale) noexcept;
+/*!
+ * @brief Builds the transform Translate(t)*Rotate(q)*Scale(s)
+ * @param translation The translation
+ * @param rotation The rotation, need not be of unit length
+ * @param scale The scale along the rotated axes
+ * @return [Transform4] The transform, columns R*s.x, R*s.y, R*s.z and the translation
+ */
+Transform4 ComposeTRS(const Point3& translation, const Quaternion& rotation, const Vector3& scale) noexcept;
+
+// Eigen decomposition
+
+//! Number of cyclic Jacobi sweeps run by DiagonalizeSymmetric(), each zeroing the three
+//! off-diagonal elements in turn
+#ifndef MATH_JACOBI_SWEEPS
+#define MATH_JACOBI_SWEEPS 4
+#endif
+
+/*!
+ * @brief Diagonalizes a symmetric matrix, M = R*D*R^T, with a fixed number of cyclic Jacobi
+ *        sweeps (MATH_JACOBI_SWEEPS), for inertia tensors, covariance matrices and quadrics
+ * @param M The symmetric matrix. Only its symmetric part (M + M^T)/2 is diagonalized
+ * @param rotation Receives the eigenvectors as the columns of a rotation matrix (determinant +1)
+ * @param values Receives the eigenvalues in decreasing order, values[i] belonging to column i of
+ *               rotation
+ * @note Symmetric matrices are always diagonalizable, so this never fails or throws
+ *       NonDiagonalizableE
+ */
+void DiagonalizeSymmetric(const Matrix3& M, Matrix3& rotation, Vector3& values) noexcept;
+/*!
+ * @brief Diagonalizes a symmetric matrix like DiagonalizeSymmetric(const Matrix3&, Matrix3&, Vector3&)
+ * @param M The symmetric matrix
+ * @param rotation Receives the unit quaternion of the eigenvector rotation
+ * @param values Receives the eigenvalues in decreasing order, values[i] belonging to the ith
+ *               column of rotation.GetRotation()
+ */
+void DiagonalizeSymmetric(const Matrix3& M, Quaternion& rotation, Vector3& values) noexcept;
+
+// Singular value decomposition
+
+//! Number of cyclic one-sided Jacobi sweeps run by SVD(), each orthogonalizing the three pairs
+//! of columns in turn
+#ifndef MATH_SVD_SWEEPS
+#define MATH_SVD_SWEEPS 4
+#endif
+
+/*!
+ * @brief Factors a matrix into two rotations and a scale, M = U*Scale(sigma)*V^T, for polar
+ *        decomposition (the nearest rotation is U*V^T), shape matching and point set registration
+ * @param M The matrix
+ * @param U Receives the left singular vectors as the columns of a rotation (determinant +1)
+ * @param sigma Receives the singular values, sigma.x >= sigma.y >= |sigma.z|. sigma.z is negative
+ *              when M is mirrored (negative determinant)
+ * @param V Receives the right singular vectors as the columns of a rotation (determinant +1)
+ * @note After McAdams et al., "Computing the Singular Value Decomposition of 3x3 matrices with
+ *       minimal branching and elementary floating point operations" (2011), but with one-sided
+ *       Jacobi sweeps on the columns of M rather than on M^T*M, which keeps ill-conditioned
+ *       matrices accurate. Every rotation angle comes from reciprocal square roots, with no
+ *       arctangent, square root or divide, and the sweep count is fixed. U*Scale(sigma)*V^T is
+ *       within about 3e-6*sigma.x of M
+ */
+void SVD(const Matrix3& M, Matrix3& U, Vector3& sigma, Matrix3& V) noexcept;
+/*!
+ * @brief Factors a matrix like SVD(const Matrix3&, Matrix3&, Vector3&, Matrix3&)
+ * @param M The matrix
+ * @param U Receives the unit quaternion of the left rotation
+ * @param sigma Receives the singular values
+ * @param V Receives the unit quaternion of the right rotation
  */
-Vector3 Transform(const Vector3& v, const Quaternion& q);
\ No newline at end of file
+void SVD(const Matrix3& M, Quaternion& U, Vector3& sigma, Quaternion& V) noexcept;
+
+// Interpolation
+
+//! Cosine of the angle between the quaternions above which Slerp() blends linearly, as sin(theta)
+//! is then too small to divide by
+#ifndef MATH_SLERP_THRESHOLD
+#define MATH_SLERP_THRESHOLD 0.9995f
+#endif
+
+/*!
+ * @brief Normalized linear interpolation along the shorter arc, the cheapest blend of two rotations
+ * @param a The rotation at t = 0
+ * @param b The rotation at t = 1, negated first when a*b < 0
+ * @param t The blend weight, usually in [0, 1]
+ * @return [Quaternion] The unit quaternion of (1 - t)*a + t*b. The angular velocity is not constant
+ */
+Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t) noexcept;
+/*!
+ * @brief Spherical linear interpolation along the shorter arc, at constant angular velocity
+ * @param a The unit rotation at t = 0
+ * @param b The unit rotation at t = 1, negated first when a*b < 0
+ * @param t The blend weight, usually in [0, 1]
+ * @return [Quaternion] (sin((1 - t)*theta)*a + sin(t*theta)*b)/sin(theta), theta the angle
+ *         between a and b. Nlerp() when cos(theta) > MATH_SLERP_THRESHOLD
+ */
+Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t) noexcept;
+/*!
+ * @brief Spherical linear interpolation like Slerp(), without acos, sin or divide
+ * @param a The unit rotation at t = 0
+ * @param b The unit rotation at t = 1, negated first when a*b < 0
+ * @param t The blend weight in [0, 1]
+ * @return [Quaternion] The interpolated rotation, every component within 4e-5 of Slerp()'s
+ * @note After Eberly, "A Fast and Accurate Algorithm for Computing SLERP" (2011): both weights
+ *       sin(t*theta)/sin(theta) are 8 terms of their series in cos(theta) - 1, the last term
+ *       scaled to spread the truncation error. Each weight is within 2e-5 of the exact one over
+ *       the whole range, so the result is not renormalized
+ */
+Quaternion SlerpFast(const Quaternion& a, const Quaternion& b, float t) noexcept;
@@ -0,0 +1,435 @@
+#pragma once
+#include "Math\Simd.h"
+#include "Math\Vectors.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+
+using namespace std;
+
+//! @note Packet types hold 4 or 8 math structures component-wise (x lanes, y lanes...), so one
+//!       operator processes every lane at once. F is the lane type, Floatx4 or Floatx8. Lane i of
+//!       every result is the scalar operator applied to lane i of the operands, up to rounding
+//!       differences when the compiler contracts or reorders floating point operations. Masks are
+//!       packets of the lane type with every bit of a lane set or cleared (CmpLess, CmpEqual...).
+
+//---------------------------------------------------------------------------------------------
+//                                         CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class Vector3xN
+ * @brief F::Width Vector3 structures, one lane each
+ * @param x Packet of the x components
+ * @param y Packet of the y components
+ * @param z Packet of the z components
+ */
+template<typename F>
+struct Vector3xN
+{
+    static const int Width = F::Width;
+    F x, y, z;
+
+    //! @public @memberof Vector3xN
+    //! @brief Constructs an empty packet
+    Vector3xN() = default;
+    //! @public @memberof Vector3xN
+    //! @brief Constructs a packet from 3 component packets
+    Vector3xN(const F& a, const F& b, const F& c) {x = a; y = b; z = c;}
+    //! @public @memberof Vector3xN
+    //! @brief Constructs a packet with every lane set to v
+    explicit Vector3xN(const Vector3& v) {x = F::Broadcast(v.x); y = F::Broadcast(v.y); z = F::Broadcast(v.z);}
+    //! @public @memberof Vector3xN
+    //! @brief Loads the Width elements of a span starting at element i
+    static Vector3xN Load(const SoASpan<const Vector3>& s, int i) {return Vector3xN(F::Load(s[0] + i), F::Load(s[1] + i), F::Load(s[2] + i));}
+    //! @public @memberof Vector3xN
+    //! @brief Stores the lanes into the Width elements of a span starting at element i
+    void Store(const SoASpan<Vector3>& s, int i) const {x.Store(s[0] + i); y.Store(s[1] + i); z.Store(s[2] + i);}
+    //! @public @memberof Vector3xN
+    //! @brief Yields lane i as a Vector3 structure
+    Vector3 Lane(int i) const {return Vector3(x.Lane(i), y.Lane(i), z.Lane(i));}
+    Vector3xN& operator +=(const Vector3xN& v) {x = x + v.x; y = y + v.y; z = z + v.z; return (*this);}
+    Vector3xN& operator -=(const Vector3xN& v) {x = x - v.x; y = y - v.y; z = z - v.z; return (*this);}
+    Vector3xN& operator *=(const F& sc) {x = x * sc; y = y * sc; z = z * sc; return (*this);}
+    Vector3xN& operator /=(const F& sc) {F inv = F::Broadcast(1.0f) / sc; return ((*this) *= inv);}
+};
+
+/*!
+ * @class Vector4xN
+ * @brief F::Width Vector4 structures, one lane each
+ * @param x Packet of the x components
+ * @param y Packet of the y components
+ * @param z Packet of the z components
+ * @param w Packet of the w components
+ */
+template<typename F>
+struct Vector4xN
+{
+    static const int Width = F::Width;
+    F x, y, z, w;
+
+    //! @public @memberof Vector4xN
+    //! @brief Constructs an empty packet
+    Vector4xN() = default;
+    //! @public @memberof Vector4xN
+    //! @brief Constructs a packet from 4 component packets
+    Vector4xN(const F& a, const F& b, const F& c, const F& d) {x = a; y = b; z = c; w = d;}
+    //! @public @memberof Vector4xN
+    //! @brief Constructs a packet with every lane set to v
+    explicit Vector4xN(const Vector4& v) {x = F::Broadcast(v.x); y = F::Broadcast(v.y); z = F::Broadcast(v.z); w = F::Broadcast(v.w);}
+    //! @public @memberof Vector4xN
+    //! @brief Loads the Width elements of a span starting at element i
+    static Vector4xN Load(const SoASpan<const Vector4>& s, int i)
+        {return Vector4xN(F::Load(s[0] + i), F::Load(s[1] + i), F::Load(s[2] + i), F::Load(s[3] + i));}
+    //! @public @memberof Vector4xN
+    //! @brief Stores the lanes into the Width elements of a span starting at element i
+    void Store(const SoASpan<Vector4>& s, int i) const {x.Store(s[0] + i); y.Store(s[1] + i); z.Store(s[2] + i); w.Store(s[3] + i);}
+    //! @public @memberof Vector4xN
+    //! @brief Yields lane i as a Vector4 structure
+    Vector4 Lane(int i) const {return Vector4(x.Lane(i), y.Lane(i), z.Lane(i), w.Lane(i));}
+    Vector4xN& operator +=(const Vector4xN& v) {x = x + v.x; y = y + v.y; z = z + v.z; w = w + v.w; return (*this);}
+    Vector4xN& operator -=(const Vector4xN& v) {x = x - v.x; y = y - v.y; z = z - v.z; w = w - v.w; return (*this);}
+    Vector4xN& operator *=(const F& sc) {x = x * sc; y = y * sc; z = z * sc; w = w * sc; return (*this);}
+    Vector4xN& operator /=(const F& sc) {F inv = F::Broadcast(1.0f) / sc; return ((*this) *= inv);}
+};
+
+/*!
+ * @class Point3xN @extends Vector3xN
+ * @brief F::Width Point3 structures, one lane each
+ */
+template<typename F>
+struct Point3xN : Vector3xN<F>
+{
+    //! @public @memberof Point3xN
+    //! @brief Constructs an empty packet
+    Point3xN() = default;
+    //! @public @memberof Point3xN
+    //! @brief Constructs a packet from 3 component packets
+    Point3xN(const F& a, const F& b, const F& c) : Vector3xN<F>(a, b, c) {}
+    //! @public @memberof Point3xN
+    //! @brief Constructs a packet of points from a packet of position vectors
+    explicit Point3xN(const Vector3xN<F>& v) : Vector3xN<F>(v) {}
+    //! @public @memberof Point3xN
+    //! @brief Constructs a packet with every lane set to p
+    explicit Point3xN(const Point3& p) : Vector3xN<F>(p) {}
+    //! @public @memberof Point3xN
+    //! @brief Loads the Width elements of a span starting at element i
+    static Point3xN Load(const SoASpan<const Point3>& s, int i) {return Point3xN(F::Load(s[0] + i), F::Load(s[1] + i), F::Load(s[2] + i));}
+    //! @public @memberof Point3xN
+    //! @brief Stores the lanes into the Width elements of a span starting at element i
+    void Store(const SoASpan<Point3>& s, int i) const {this->x.Store(s[0] + i); this->y.Store(s[1] + i); this->z.Store(s[2] + i);}
+    //! @public @memberof Point3xN
+    //! @brief Yields lane i as a Point3 structure
+    Point3 Lane(int i) const {return Point3(this->x.Lane(i), this->y.Lane(i), this->z.Lane(i));}
+};
+
+/*!
+ * @class QuaternionxN
+ * @brief F::Width Quaternion structures, one lane each
+ * @param x, y, z Packets of the vector components
+ * @param w Packet of the scalar components
+ */
+template<typename F>
+struct QuaternionxN
+{
+    static const int Width = F::Width;
+    F x, y, z, w;
+
+    //! @public @memberof QuaternionxN
+    //! @brief Constructs an empty packet
+    QuaternionxN() = default;
+    //! @public @memberof QuaternionxN
+    //! @brief Constructs a packet from 4 component packets
+    QuaternionxN(const F& a, const F& b, const F& c, const F& sc) {x = a; y = b; z = c; w = sc;}
+    //! @public @memberof QuaternionxN
+    //! @brief Constructs a packet from a vector packet and a scalar packet
+    QuaternionxN(const Vector3xN<F>& v, const F& sc) {x = v.x; y = v.y; z = v.z; w = sc;}
+    //! @public @memberof QuaternionxN
+    //! @brief Constructs a packet with every lane set to q
+    explicit QuaternionxN(const Quaternion& q) {x = F::Broadcast(q.x); y = F::Broadcast(q.y); z = F::Broadcast(q.z); w = F::Broadcast(q.w);}
+    //! @public @memberof QuaternionxN
+    //! @brief Loads the Width elements of a span starting at element i
+    static QuaternionxN Load(const SoASpan<const Quaternion>& s, int i)
+        {return QuaternionxN(F::Load(s[0] + i), F::Load(s[1] + i), F::Load(s[2] + i), F::Load(s[3] + i));}
+    //! @public @memberof QuaternionxN
+    //! @brief Stores the lanes into the Width elements of a span starting at element i
+    void Store(const SoASpan<Quaternion>& s, int i) const {x.Store(s[0] + i); y.Store(s[1] + i); z.Store(s[2] + i); w.Store(s[3] + i);}
+    //! @public @memberof QuaternionxN
+    //! @brief Yields lane i as a Quaternion structure
+    Quaternion Lane(int i) const {return Quaternion(x.Lane(i), y.Lane(i), z.Lane(i), w.Lane(i));}
+    //! @public @memberof QuaternionxN
+    //! @brief Gets the vector components of every lane
+    const Vector3xN<F> GetVector(void) const {return Vector3xN<F>(x, y, z);}
+    const F Magnitude(void) const {return Sqrt(x*x + y*y + z*z + w*w);}
+};
+
+typedef Vector3xN<Floatx4> Vector3x4;
+typedef Vector3xN<Floatx8> Vector3x8;
+typedef Vector4xN<Floatx4> Vector4x4;
+typedef Vector4xN<Floatx8> Vector4x8;
+typedef Point3xN<Floatx4> Point3x4;
+typedef Point3xN<Floatx8> Point3x8;
+typedef QuaternionxN<Floatx4> Quaternionx4;
+typedef QuaternionxN<Floatx8> Quaternionx8;
+
+//---------------------------------------------------------------------------------------------
+//                                      INLINE FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * OPERATORS * * * * * //
+
+// Vector3xN
+
+template<typename F>
+inline Vector3xN<F> operator +(const Vector3xN<F>& a, const Vector3xN<F>& b) {return Vector3xN<F>(a.x + b.x, a.y + b.y, a.z + b.z);}
+template<typename F>
+inline Vector3xN<F> operator -(const Vector3xN<F>& a, const Vector3xN<F>& b) {return Vector3xN<F>(a.x - b.x, a.y - b.y, a.z - b.z);}
+template<typename F>
+inline Vector3xN<F> operator -(const Vector3xN<F>& v) {F zero = F::Zero(); return Vector3xN<F>(zero - v.x, zero - v.y, zero - v.z);}
+template<typename F>
+inline Vector3xN<F> operator *(const Vector3xN<F>& v, const F& sc) {return Vector3xN<F>(v.x * sc, v.y * sc, v.z * sc);}
+template<typename F>
+inline Vector3xN<F> operator *(const F& sc, const Vector3xN<F>& v) {return Vector3xN<F>(sc * v.x, sc * v.y, sc * v.z);}
+template<typename F>
+inline Vector3xN<F> operator *(const Vector3xN<F>& v, float sc) {return v * F::Broadcast(sc);}
+template<typename F>
+inline Vector3xN<F> operator *(float sc, const Vector3xN<F>& v) {return F::Broadcast(sc) * v;}
+template<typename F>
+inline Vector3xN<F> operator /(const Vector3xN<F>& v, const F& sc) {return (F::Broadcast(1.0f) / sc) * v;}
+template<typename F>
+inline Vector3xN<F> operator /(const Vector3xN<F>& v, float sc) {return (1.0f / sc) * v;}
+// [F] Operator for the inner product of every lane
+template<typename F>
+inline F operator *(const Vector3xN<F>& a, const Vector3xN<F>& b) {return a.x*b.x + a.y*b.y + a.z*b.z;}
+
+// Vector4xN
+
+template<typename F>
+inline Vector4xN<F> operator +(const Vector4xN<F>& a, const Vector4xN<F>& b) {return Vector4xN<F>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);}
+template<typename F>
+inline Vector4xN<F> operator -(const Vector4xN<F>& a, const Vector4xN<F>& b) {return Vector4xN<F>(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);}
+template<typename F>
+inline Vector4xN<F> operator -(const Vector4xN<F>& v) {F zero = F::Zero(); return Vector4xN<F>(zero - v.x, zero - v.y, zero - v.z, zero - v.w);}
+template<typename F>
+inline Vector4xN<F> operator *(const Vector4xN<F>& v, const F& sc) {return Vector4xN<F>(v.x * sc, v.y * sc, v.z * sc, v.w * sc);}
+template<typename F>
+inline Vector4xN<F> operator *(const F& sc, const Vector4xN<F>& v) {return Vector4xN<F>(sc * v.x, sc * v.y, sc * v.z, sc * v.w);}
+template<typename F>
+inline Vector4xN<F> operator *(const Vector4xN<F>& v, float sc) {return v * F::Broadcast(sc);}
+template<typename F>
+inline Vector4xN<F> operator *(float sc, const Vector4xN<F>& v) {return F::Broadcast(sc) * v;}
+template<typename F>
+inline Vector4xN<F> operator /(const Vector4xN<F>& v, const F& sc) {return (F::Broadcast(1.0f) / sc) * v;}
+template<typename F>
+inline Vector4xN<F> operator /(const Vector4xN<F>& v, float sc) {return (1.0f / sc) * v;}
+// [F] Operator for the inner product of every lane
+template<typename F>
+inline F operator *(const Vector4xN<F>& a, const Vector4xN<F>& b) {return a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;}
+
+// Point3xN
+
+template<typename F>
+inline Point3xN<F> operator +(const Point3xN<F>& p0, const Point3xN<F>& p1) {return Point3xN<F>(p0.x + p1.x, p0.y + p1.y, p0.z + p1.z);}
+template<typename F>
+inline Vector3xN<F> operator -(const Point3xN<F>& p0, const Point3xN<F>& p1) {return Vector3xN<F>(p0.x - p1.x, p0.y - p1.y, p0.z - p1.z);}
+template<typename F>
+inline Point3xN<F> operator *(const Point3xN<F>& p, float sc) {return Point3xN<F>(p.x * sc, p.y * sc, p.z * sc);}
+template<typename F>
+inline Point3xN<F> operator *(float sc, const Point3xN<F>& p) {return Point3xN<F>(sc * p.x, sc * p.y, sc * p.z);}
+template<typename F>
+inline Point3xN<F> operator /(const Point3xN<F>& p, float sc) {return (1.0f / sc) * p;}
+
+// Planes
+
+template<typename F>
+inline F operator *(const Plane& f, const Vector3xN<F>& v) {return F::Broadcast(f.x)*v.x + F::Broadcast(f.y)*v.y + F::Broadcast(f.z)*v.z;}
+template<typename F>
+inline F operator *(const Vector3xN<F>& v, const Plane& f) {return (f*v);}
+template<typename F>
+inline F operator *(const Plane& f, const Point3xN<F>& q)
+    {return F::Broadcast(f.x)*q.x + F::Broadcast(f.y)*q.y + F::Broadcast(f.z)*q.z + F::Broadcast(f.w);}
+template<typename F>
+inline F operator *(const Point3xN<F>& q, const Plane& f) {return (f*q);}
+
+// Matrices
+
+template<typename F>
+inline Vector3xN<F> operator *(const Matrix3& M, const Vector3xN<F>& v)
+{return (Vector3xN<F>(
+    F::Broadcast(M(0,0))*v.x + F::Broadcast(M(0,1))*v.y + F::Broadcast(M(0,2))*v.z,
+    F::Broadcast(M(1,0))*v.x + F::Broadcast(M(1,1))*v.y + F::Broadcast(M(1,2))*v.z,
+    F::Broadcast(M(2,0))*v.x + F::Broadcast(M(2,1))*v.y + F::Broadcast(M(2,2))*v.z));}
+template<typename F>
+inline Vector4xN<F> operator *(const Matrix4& M, const Vector4xN<F>& v)
+{return (Vector4xN<F>(
+    F::Broadcast(M(0,0))*v.x + F::Broadcast(M(0,1))*v.y + F::Broadcast(M(0,2))*v.z + F::Broadcast(M(0,3))*v.w,
+    F::Broadcast(M(1,0))*v.x + F::Broadcast(M(1,1))*v.y + F::Broadcast(M(1,2))*v.z + F::Broadcast(M(1,3))*v.w,
+    F::Broadcast(M(2,0))*v.x + F::Broadcast(M(2,1))*v.y + F::Broadcast(M(2,2))*v.z + F::Broadcast(M(2,3))*v.w,
+    F::Broadcast(M(3,0))*v.x + F::Broadcast(M(3,1))*v.y + F::Broadcast(M(3,2))*v.z + F::Broadcast(M(3,3))*v.w));}
+// Transforms a packet of normals by the transpose of T, like Vector3*Transform4
+template<typename F>
+inline Vector3xN<F> operator *(const Vector3xN<F>& n, const Transform4& T)
+{return (Vector3xN<F>(
+    n.x*F::Broadcast(T(0,0)) + n.y*F::Broadcast(T(1,0)) + n.z*F::Broadcast(T(2,0)),
+    n.x*F::Broadcast(T(0,1)) + n.y*F::Broadcast(T(1,1)) + n.z*F::Broadcast(T(2,1)),
+    n.x*F::Broadcast(T(0,2)) + n.y*F::Broadcast(T(1,2)) + n.z*F::Broadcast(T(2,2))));}
+template<typename F>
+inline Vector3xN<F> operator *(const Transform4& T, const Vector3xN<F>& v)
+{return (Vector3xN<F>(
+    F::Broadcast(T(0,0))*v.x + F::Broadcast(T(0,1))*v.y + F::Broadcast(T(0,2))*v.z,
+    F::Broadcast(T(1,0))*v.x + F::Broadcast(T(1,1))*v.y + F::Broadcast(T(1,2))*v.z,
+    F::Broadcast(T(2,0))*v.x + F::Broadcast(T(2,1))*v.y + F::Broadcast(T(2,2))*v.z));}
+//! @note Like Transform4*Point3, only the 3x3 part of T is applied
+template<typename F>
+inline Point3xN<F> operator *(const Transform4& T, const Point3xN<F>& p)
+{return (Point3xN<F>(
+    F::Broadcast(T(0,0))*p.x + F::Broadcast(T(0,1))*p.y + F::Broadcast(T(0,2))*p.z,
+    F::Broadcast(T(1,0))*p.x + F::Broadcast(T(1,1))*p.y + F::Broadcast(T(1,2))*p.z,
+    F::Broadcast(T(2,0))*p.x + F::Broadcast(T(2,1))*p.y + F::Broadcast(T(2,2))*p.z));}
+
+// QuaternionxN
+
+template<typename F>
+inline QuaternionxN<F> operator +(const QuaternionxN<F>& a, const QuaternionxN<F>& b)
+    {return (QuaternionxN<F>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w));}
+template<typename F>
+inline QuaternionxN<F> operator *(const F& sc, const QuaternionxN<F>& q) {return (QuaternionxN<F>(sc*q.x, sc*q.y, sc*q.z, sc*q.w));}
+template<typename F>
+inline QuaternionxN<F> operator *(const QuaternionxN<F>& q, const F& sc) {return sc*q;}
+template<typename F>
+inline QuaternionxN<F> operator *(float sc, const QuaternionxN<F>& q) {return F::Broadcast(sc)*q;}
+template<typename F>
+inline QuaternionxN<F> operator *(const QuaternionxN<F>& q, float sc) {return F::Broadcast(sc)*q;}
+template<typename F>
+inline QuaternionxN<F> operator /(const QuaternionxN<F>& q, const F& sc) {return (F::Broadcast(1.0f)/sc)*q;}
+template<typename F>
+inline QuaternionxN<F> operator /(const QuaternionxN<F>& q, float sc) {return (1.0f/sc)*q;}
+template<typename F>
+inline QuaternionxN<F> operator -(const QuaternionxN<F>& a, const QuaternionxN<F>& b) {return (a + (-1.0f * b));}
+template<typename F>
+inline QuaternionxN<F> operator *(const QuaternionxN<F>& q1, const QuaternionxN<F>& q2)
+{return (QuaternionxN<F>(
+    q1.w*q2.x + q1.x*q2.w + q1.y*q2.z - q1.z*q2.y,
+    q1.w*q2.y - q1.x*q2.z + q1.y*q2.w + q1.z*q2.x,
+    q1.w*q2.z + q1.x*q2.y - q1.y*q2.x + q1.z*q2.w,
+    q1.w*q2.w - q1.x*q2.x - q1.y*q2.y - q1.z*q2.z
+));}
+
+// * * * * * METHODS * * * * * //
+
+//! @brief Calculates the magnitude of every lane
+template<typename F>
+inline F Magnitude(const Vector3xN<F>& v) {return Sqrt(v*v);}
+//! @brief Calculates the magnitude of every lane
+template<typename F>
+inline F Magnitude(const Vector4xN<F>& v) {return Sqrt(v*v);}
+//! @brief Normalizes every lane
+//! @warning Zero lanes become NaN, there is no ZeroMagnitudeE check
+template<typename F>
+inline Vector3xN<F> Normalize(const Vector3xN<F>& v) {return (v / Magnitude(v));}
+//! @brief Normalizes every lane
+//! @warning Zero lanes become NaN, there is no ZeroMagnitudeE check
+template<typename F>
+inline Vector4xN<F> Normalize(const Vector4xN<F>& v) {return (v / Magnitude(v));}
+//! @brief Normalizes every lane
+template<typename F>
+inline QuaternionxN<F> Normalize(const QuaternionxN<F>& q) {return (q / q.Magnitude());}
+//! @brief Approximates 1/Magnitude of every lane within MATH_RSQRT_MAX_RELATIVE_ERROR
+template<typename F>
+inline F InvMagnitudeFast(const Vector3xN<F>& v) {return InvSqrtFast(v*v);}
+//! @brief Approximates 1/Magnitude of every lane within MATH_RSQRT_MAX_RELATIVE_ERROR
+template<typename F>
+inline F InvMagnitudeFast(const Vector4xN<F>& v) {return InvSqrtFast(v*v);}
+//! @brief Normalizes every lane with InvMagnitudeFast
+template<typename F>
+inline Vector3xN<F> NormalizeFast(const Vector3xN<F>& v) {return (v * InvMagnitudeFast(v));}
+//! @brief Normalizes every lane with InvMagnitudeFast
+template<typename F>
+inline Vector4xN<F> NormalizeFast(const Vector4xN<F>& v) {return (v * InvMagnitudeFast(v));}
+//! @brief Generates the cross product of every lane
+template<typename F>
+inline Vector3xN<F> CrossProduct(const Vector3xN<F>& v1, const Vector3xN<F>& v2)
+{
+    return (Vector3xN<F>(v1.y*v2.z - v1.z*v2.y,
+                         v1.z*v2.x - v1.x*v2.z,
+                         v1.x*v2.y - v1.y*v2.x));
+}
+//! @brief Calculates (v1 x v2) * v3 for every lane
+template<typename F>
+inline F ScalarTripleProduct(const Vector3xN<F>& v1, const Vector3xN<F>& v2, const Vector3xN<F>& v3) {return (CrossProduct(v1, v2) * v3);}
+/*!
+ * @brief Calculates the angle between the vectors of every lane
+ * @return [F] The angles in radians, within MATH_ACOS_MAX_ABSOLUTE_ERROR of the scalar Angle
+ * @note The cosine is clamped to [-1, 1]. Lanes with a zero vector are NaN
+ */
+template<typename F>
+inline F Angle(const Vector3xN<F>& v1, const Vector3xN<F>& v2)
+{
+    F one = F::Broadcast(1.0f);
+    return Acos(Max(Min((v1 * v2) / (Magnitude(v1) * Magnitude(v2)), one), -one));
+}
+//! @brief Projects v1 onto v2 in every lane
+//! @warning Lanes where v2 is zero become NaN, see TryProjection for the masked batch kernel
+template<typename F>
+inline Vector3xN<F> Projection(const Vector3xN<F>& v1, const Vector3xN<F>& v2) {return (((v1 * v2) / (v2 * v2)) * v2);}
+//! @brief Rejects v1 from v2 in every lane
+template<typename F>
+inline Vector3xN<F> Rejection(const Vector3xN<F>& v1, const Vector3xN<F>& v2) {return (v1 - Projection(v1, v2));}
+/*!
+ * @brief Rotates every lane of a vector packet by the matching lane of a quaternion packet
+ * @param v The vectors
+ * @param q The unit quaternions
+ * @return [Vector3xN] v transformed by q, lane by lane like Transform(Vector3, Quaternion)
+ */
+template<typename F>
+inline Vector3xN<F> Transform(const Vector3xN<F>& v, const QuaternionxN<F>& q)
+{
+    Vector3xN<F> u = q.GetVector();
+    F uDotU = u * u;
+    return (v*(q.w*q.w - uDotU) + u*(u*v)*2.0f + CrossProduct(u, v)*q.w*2.0f);
+}
+//! @brief Rotates every lane of a vector packet by one quaternion
+template<typename F>
+inline Vector3xN<F> Transform(const Vector3xN<F>& v, const Quaternion& q) {return Transform(v, QuaternionxN<F>(q));}
+/*!
+ * @brief Rotates every lane of a vector packet by the matching lane of a unit quaternion packet,
+ *        in the cross-product form of Transform(const Vector3&, const UnitQuaternion&)
+ * @param v The vectors
+ * @param q The quaternions, of unit length
+ * @return [Vector3xN] v + w*t + u x t, t = 2*(u x v), for every lane
+ */
+template<typename F>
+inline Vector3xN<F> Rotate(const Vector3xN<F>& v, const QuaternionxN<F>& q)
+{
+    const Vector3xN<F> u = q.GetVector();
+    const Vector3xN<F> t = CrossProduct(u, v)*2.0f;
+    return (v + t*q.w + CrossProduct(u, t));
+}
+
+// * * * * * LANE SELECTION * * * * * //
+
+//! @brief Picks lane i of a where lane i of mask is set, and of b elsewhere
+template<typename F>
+inline Vector3xN<F> Select(const F& mask, const Vector3xN<F>& a, const Vector3xN<F>& b)
+    {return Vector3xN<F>(Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z));}
+//! @brief Picks lane i of a where lane i of mask is set, and of b elsewhere
+template<typename F>
+inline Vector4xN<F> Select(const F& mask, const Vector4xN<F>& a, const Vector4xN<F>& b)
+    {return Vector4xN<F>(Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z), Select(mask, a.w, b.w));}
+//! @brief Picks lane i of a where lane i of mask is set, and of b elsewhere
+template<typename F>
+inline Point3xN<F> Select(const F& mask, const Point3xN<F>& a, const Point3xN<F>& b)
+    {return Point3xN<F>(Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z));}
+//! @brief Picks lane i of a where lane i of mask is set, and of b elsewhere
+template<typename F>
+inline QuaternionxN<F> Select(const F& mask, const QuaternionxN<F>& a, const QuaternionxN<F>& b)
+    {return QuaternionxN<F>(Select(mask, a.x, b.x), Select(mask, a.y, b.y), Select(mask, a.z, b.z), Select(mask, a.w, b.w));}
+//! @brief Linear blend a + t*(b - a) of every lane
+template<typename F>
+inline Vector3xN<F> Blend(const Vector3xN<F>& a, const Vector3xN<F>& b, const F& t) {return a + (b - a)*t;}
+//! @brief Linear blend a + t*(b - a) of every lane
+template<typename F>
+inline Vector4xN<F> Blend(const Vector4xN<F>& a, const Vector4xN<F>& b, const F& t) {return a + (b - a)*t;}
+//! @brief Linear blend a + t*(b - a) of every lane
+template<typename F>
+inline Point3xN<F> Blend(const Point3xN<F>& a, const Point3xN<F>& b, const F& t) {return Point3xN<F>(a + (b - a)*t);}
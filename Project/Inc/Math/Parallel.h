@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "Math\Simd.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                      WORKER THREADS
+//---------------------------------------------------------------------------------------------
+
+//! Largest number of threads a batch kernel splits its work across
+#ifndef MATH_MAX_THREADS
+#define MATH_MAX_THREADS 16
+#endif
+
+/*!
+ * @brief Yields the number of threads batch kernels may use: the hardware concurrency, at least 1
+ *        and at most MATH_MAX_THREADS
+ * @return [int] Number of worker threads, including the calling thread
+ */
+inline int MathThreadCount(void)
+{
+    static const int count = max(1, min(int(thread::hardware_concurrency()), MATH_MAX_THREADS));
+    return count;
+}
+
+/*!
+ * @brief Splits the range [0, count) into contiguous chunks and runs f(first, last) on each chunk,
+ *        one chunk per thread. Chunks hold at least grain elements and start on a multiple of
+ *        MATH_BATCH_WIDTH, so every chunk but the last runs whole SIMD packets. The calling thread
+ *        runs the first chunk and waits for the others.
+ * @param count Number of elements
+ * @param grain Smallest number of elements worth a thread of its own
+ * @param f Callable taking (int first, int last), must be safe to run concurrently on disjoint chunks
+ * @note Small ranges (count < 2*grain) and single core machines run f(0, count) on the calling
+ *       thread without creating any thread. Chunks whose thread cannot be created also run on
+ *       the calling thread, so ParallelFor() throws only what f throws.
+ */
+template<typename F>
+void ParallelFor(int count, int grain, F f)
+{
+    int threads = min(MathThreadCount(), count / max(grain, 1));
+    if (threads < 2)
+    {
+        if (count > 0) f(0, count);
+        return;
+    }
+    int chunk = (count / threads + MATH_BATCH_WIDTH - 1) / MATH_BATCH_WIDTH * MATH_BATCH_WIDTH;
+    vector<thread> workers;
+    int first = chunk;
+    try
+    {
+        workers.reserve(threads - 1);
+        for (; first < count; first += chunk) workers.emplace_back(f, first, min(first + chunk, count));
+    }
+    catch (...)
+    {
+        // No thread (system_error) or no memory for one: the chunks from first on stay here
+    }
+    f(0, min(chunk, count));
+    for (; first < count; first += chunk) f(first, min(first + chunk, count));
+    for (thread& w : workers) w.join();
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+
+using namespace std;
+
+/*!
+ * World-space authority is kept in double precision (Point3d, Transform4d) so that positions far
+ * from the origin keep sub-millimetre precision, while per-frame math runs in float relative to a
+ * camera or cell origin. The kernels below rebase whole arrays at once: every value is subtracted
+ * from the origin in double precision and rounded once to float, exactly like the single element
+ * Rebase() functions of Geometry.h and Matrices.h.
+ */
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @brief Rebases an array of world positions into float positions relative to an origin
+ * @param in The count world positions
+ * @param count Number of positions
+ * @param origin The world position of the new origin
+ * @param out Receives the count rebased positions, may not alias in
+ */
+void Rebase(const Point3d *in, int count, const Point3d& origin, Point3 *out);
+/*!
+ * @brief Rebases an array of world positions into SoA float positions relative to an origin
+ * @param in The out.count world positions
+ * @param origin The world position of the new origin
+ * @param out Receives the rebased positions
+ */
+void Rebase(const Point3d *in, const Point3d& origin, const SoASpan<Point3>& out);
+/*!
+ * @brief Rebases an array of world transforms into float transforms relative to an origin
+ * @param in The count world transforms
+ * @param count Number of transforms
+ * @param origin The world position of the new origin
+ * @param out Receives the count rebased transforms, may not alias in
+ */
+void Rebase(const Transform4d *in, int count, const Point3d& origin, Transform4 *out);
@@ -0,0 +1,511 @@
+#pragma once
+
+//---------------------------------------------------------------------------------------------
+//                                    SIMD BACKEND SELECTION
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * The SIMD backend is selected at compile time from the instruction sets the compiler is
+ * allowed to target. Every SIMD code path in the math library has a portable scalar fallback
+ * that is used when the backend is unavailable, or when MATH_SIMD_DISABLE is defined.
+ *
+ *  MATH_SIMD_SSE   SSE2 (every x86-64 target), 4-wide float registers (__m128)
+ *  MATH_SIMD_AVX   AVX (-mavx), 8-wide float registers (__m256)
+ *  MATH_SIMD_AVX2  AVX2 (-mavx2), 8-wide integer registers
+ *  MATH_SIMD_FMA   Fused multiply-add (-mfma)
+ *  MATH_SIMD_F16C  Half-precision conversions (-mf16c)
+ *
+ *  Batch kernels are written against Floatx8, an 8 lane float packet that maps onto one __m256
+ *  with AVX, two __m128 with SSE2 only, and a plain float array with the scalar backend.
+ *
+ * @note Define MATH_SIMD_DISABLE before including any math header (or pass -DMATH_SIMD_DISABLE)
+ *       to force the scalar layout and code paths.
+ */
+#if !defined(MATH_SIMD_DISABLE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define MATH_SIMD_SSE 1
+#else
+    #define MATH_SIMD_SSE 0
+#endif
+
+#if MATH_SIMD_SSE && defined(__AVX__)
+    #define MATH_SIMD_AVX 1
+#else
+    #define MATH_SIMD_AVX 0
+#endif
+#if MATH_SIMD_AVX && defined(__AVX2__)
+    #define MATH_SIMD_AVX2 1
+#else
+    #define MATH_SIMD_AVX2 0
+#endif
+#if MATH_SIMD_AVX && defined(__FMA__)
+    #define MATH_SIMD_FMA 1
+#else
+    #define MATH_SIMD_FMA 0
+#endif
+#if MATH_SIMD_AVX && defined(__F16C__)
+    #define MATH_SIMD_F16C 1
+#else
+    #define MATH_SIMD_F16C 0
+#endif
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <new>
+
+#if MATH_SIMD_SSE
+    #include <immintrin.h>
+    //! Alignment required by types that are loaded straight into a SIMD register
+    #define MATH_SIMD_ALIGN alignas(16)
+#else
+    #define MATH_SIMD_ALIGN
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                        SSE HELPERS
+//---------------------------------------------------------------------------------------------
+
+#if MATH_SIMD_SSE
+
+/*!
+ * @brief Adds the four lanes of a register together
+ * @param v The register to reduce
+ * @return [__m128] The sum of all four lanes, broadcast to every lane
+ */
+inline __m128 SimdHorizontalSum(__m128 v)
+{
+    __m128 s = _mm_add_ps(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(s, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+/*!
+ * @brief Four lane inner product
+ * @param a First register
+ * @param b Second register
+ * @return [__m128] a*b broadcast to every lane
+ */
+inline __m128 SimdDot4(__m128 a, __m128 b) {return SimdHorizontalSum(_mm_mul_ps(a, b));}
+/*!
+ * @brief Multiply-add of every lane, fused when the FMA backend is available
+ * @return [__m128] a*b + c
+ */
+#if MATH_SIMD_FMA
+inline __m128 SimdMulAdd(__m128 a, __m128 b, __m128 c) {return _mm_fmadd_ps(a, b, c);}
+#else
+inline __m128 SimdMulAdd(__m128 a, __m128 b, __m128 c) {return _mm_add_ps(_mm_mul_ps(a, b), c);}
+#endif
+//! @brief Broadcasts lane K of a register to every lane
+template<int K>
+inline __m128 SimdSplat(__m128 v) {return _mm_shuffle_ps(v, v, _MM_SHUFFLE(K, K, K, K));}
+/*!
+ * @brief Cross product of the first three lanes of two registers
+ * @return [__m128] (a x b, a.w*b.w - a.w*b.w), so the 4th lane is zero for finite inputs
+ */
+inline __m128 SimdCrossProduct(__m128 a, __m128 b)
+{
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+/*!
+ * @brief Splits 4 packed 3-component structures (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) into
+ *        one register per component
+ * @param a,b,c The 12 floats, in memory order
+ * @param x,y,z Receive (x0 x1 x2 x3), (y0 y1 y2 y3) and (z0 z1 z2 z3)
+ */
+inline void SimdDeinterleave3(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z)
+{
+    x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+/*!
+ * @brief Packs one register per component back into 4 packed 3-component structures, the inverse
+ *        of SimdDeinterleave3()
+ * @param x,y,z The components of the 4 structures
+ * @param a,b,c Receive the 12 floats, in memory order
+ */
+inline void SimdInterleave3(__m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c)
+{
+    a = _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+    b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0));
+    c = _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+}
+/*!
+ * @brief Divides every lane of a register by the square root of the broadcast value len2.
+ *        Mirrors the scalar Normalize(), which multiplies by (1.0f / Magnitude(vec)).
+ * @param v The register to scale
+ * @param len2 Squared length, broadcast to every lane
+ * @return [__m128] v / sqrt(len2)
+ */
+inline __m128 SimdScaleByInvSqrt(__m128 v, __m128 len2)
+{
+    return _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(len2)));
+}
+
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                     ALIGNED ALLOCATION
+//---------------------------------------------------------------------------------------------
+
+//! Alignment of every batch (SoA) stream, wide enough for one AVX register
+#define MATH_BATCH_ALIGNMENT 32
+//! Number of float lanes processed by one step of a batch kernel
+#define MATH_BATCH_WIDTH 8
+
+/*!
+ * @brief Allocates memory aligned to MATH_BATCH_ALIGNMENT bytes
+ * @param bytes Number of bytes to allocate
+ * @return [void*] Pointer to the allocated block. Must be released with AlignedFree()
+ */
+inline void *AlignedAlloc(size_t bytes) {return ::operator new(bytes, std::align_val_t(MATH_BATCH_ALIGNMENT));}
+/*!
+ * @brief Releases memory obtained from AlignedAlloc()
+ * @param p Pointer to the block, may be null
+ */
+inline void AlignedFree(void *p) {::operator delete(p, std::align_val_t(MATH_BATCH_ALIGNMENT));}
+
+//---------------------------------------------------------------------------------------------
+//                                      8 LANE FLOAT PACKET
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class Floatx8
+ * @brief Eight float lanes processed together. Comparisons yield lane masks (all bits set for
+ *        true lanes) that can be combined with And/Or/AndNot and consumed by Select/MoveMask.
+ */
+struct Floatx8
+{
+    static const int Width = 8;
+#if MATH_SIMD_AVX
+    __m256 v;
+#elif MATH_SIMD_SSE
+    __m128 lo, hi;
+#else
+    float f[8];
+#endif
+
+#if MATH_SIMD_AVX
+    //! @brief Loads 8 floats from unaligned memory
+    static Floatx8 Load(const float *p) {Floatx8 r; r.v = _mm256_loadu_ps(p); return r;}
+    //! @brief Broadcasts a float to every lane
+    static Floatx8 Broadcast(float s) {Floatx8 r; r.v = _mm256_set1_ps(s); return r;}
+    //! @brief Stores the 8 lanes to unaligned memory
+    void Store(float *p) const {_mm256_storeu_ps(p, v);}
+#elif MATH_SIMD_SSE
+    static Floatx8 Load(const float *p) {Floatx8 r; r.lo = _mm_loadu_ps(p); r.hi = _mm_loadu_ps(p + 4); return r;}
+    static Floatx8 Broadcast(float s) {Floatx8 r; r.lo = r.hi = _mm_set1_ps(s); return r;}
+    void Store(float *p) const {_mm_storeu_ps(p, lo); _mm_storeu_ps(p + 4, hi);}
+#else
+    static Floatx8 Load(const float *p) {Floatx8 r; memcpy(r.f, p, sizeof(r.f)); return r;}
+    static Floatx8 Broadcast(float s) {Floatx8 r; for (int i=0; i<8; i++) r.f[i] = s; return r;}
+    void Store(float *p) const {memcpy(p, f, sizeof(f));}
+#endif
+    //! @brief Yields a packet with every lane set to zero
+    static Floatx8 Zero(void) {return Broadcast(0.0f);}
+    //! @brief Yields lane i of this packet
+    float Lane(int i) const {float t[8]; Store(t); return t[i];}
+};
+
+#if MATH_SIMD_AVX
+
+inline Floatx8 SimdPacket(__m256 v) {Floatx8 r; r.v = v; return r;}
+inline Floatx8 operator +(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_add_ps(a.v, b.v));}
+inline Floatx8 operator -(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_sub_ps(a.v, b.v));}
+inline Floatx8 operator *(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_mul_ps(a.v, b.v));}
+inline Floatx8 operator /(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_div_ps(a.v, b.v));}
+inline Floatx8 operator -(const Floatx8& a) {return SimdPacket(_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)));}
+#if MATH_SIMD_FMA
+inline Floatx8 MulAdd(const Floatx8& a, const Floatx8& b, const Floatx8& c) {return SimdPacket(_mm256_fmadd_ps(a.v, b.v, c.v));}
+#else
+inline Floatx8 MulAdd(const Floatx8& a, const Floatx8& b, const Floatx8& c) {return SimdPacket(_mm256_add_ps(_mm256_mul_ps(a.v, b.v), c.v));}
+#endif
+inline Floatx8 Sqrt(const Floatx8& a) {return SimdPacket(_mm256_sqrt_ps(a.v));}
+inline Floatx8 Min(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_min_ps(a.v, b.v));}
+inline Floatx8 Max(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_max_ps(a.v, b.v));}
+inline Floatx8 Abs(const Floatx8& a) {return SimdPacket(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v));}
+inline Floatx8 Round(const Floatx8& a) {return SimdPacket(_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC));}
+inline Floatx8 CmpLess(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ));}
+inline Floatx8 CmpLessEqual(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ));}
+inline Floatx8 CmpGreater(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ));}
+inline Floatx8 CmpEqual(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ));}
+inline Floatx8 And(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_and_ps(a.v, b.v));}
+inline Floatx8 Or(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_or_ps(a.v, b.v));}
+inline Floatx8 AndNot(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_andnot_ps(a.v, b.v));}
+inline Floatx8 Select(const Floatx8& mask, const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm256_blendv_ps(b.v, a.v, mask.v));}
+inline int MoveMask(const Floatx8& mask) {return _mm256_movemask_ps(mask.v);}
+
+#elif MATH_SIMD_SSE
+
+inline Floatx8 SimdPacket(__m128 lo, __m128 hi) {Floatx8 r; r.lo = lo; r.hi = hi; return r;}
+inline Floatx8 operator +(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi));}
+inline Floatx8 operator -(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi));}
+inline Floatx8 operator *(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi));}
+inline Floatx8 operator /(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi));}
+inline Floatx8 operator -(const Floatx8& a)
+    {__m128 s = _mm_set1_ps(-0.0f); return SimdPacket(_mm_xor_ps(a.lo, s), _mm_xor_ps(a.hi, s));}
+inline Floatx8 MulAdd(const Floatx8& a, const Floatx8& b, const Floatx8& c) {return (a*b) + c;}
+inline Floatx8 Sqrt(const Floatx8& a) {return SimdPacket(_mm_sqrt_ps(a.lo), _mm_sqrt_ps(a.hi));}
+inline Floatx8 Min(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi));}
+inline Floatx8 Max(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi));}
+inline Floatx8 Abs(const Floatx8& a)
+    {__m128 s = _mm_set1_ps(-0.0f); return SimdPacket(_mm_andnot_ps(s, a.lo), _mm_andnot_ps(s, a.hi));}
+// SSE2 has no rounding instruction; the round trip through int32 is exact for |a| < 2^31
+inline Floatx8 Round(const Floatx8& a)
+    {return SimdPacket(_mm_cvtepi32_ps(_mm_cvtps_epi32(a.lo)), _mm_cvtepi32_ps(_mm_cvtps_epi32(a.hi)));}
+inline Floatx8 CmpLess(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_cmplt_ps(a.lo, b.lo), _mm_cmplt_ps(a.hi, b.hi));}
+inline Floatx8 CmpLessEqual(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_cmple_ps(a.lo, b.lo), _mm_cmple_ps(a.hi, b.hi));}
+inline Floatx8 CmpGreater(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_cmpgt_ps(a.lo, b.lo), _mm_cmpgt_ps(a.hi, b.hi));}
+inline Floatx8 CmpEqual(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_cmpeq_ps(a.lo, b.lo), _mm_cmpeq_ps(a.hi, b.hi));}
+inline Floatx8 And(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_and_ps(a.lo, b.lo), _mm_and_ps(a.hi, b.hi));}
+inline Floatx8 Or(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_or_ps(a.lo, b.lo), _mm_or_ps(a.hi, b.hi));}
+inline Floatx8 AndNot(const Floatx8& a, const Floatx8& b) {return SimdPacket(_mm_andnot_ps(a.lo, b.lo), _mm_andnot_ps(a.hi, b.hi));}
+inline Floatx8 Select(const Floatx8& mask, const Floatx8& a, const Floatx8& b)
+    {return Or(And(mask, a), AndNot(mask, b));}
+inline int MoveMask(const Floatx8& mask) {return _mm_movemask_ps(mask.lo) | (_mm_movemask_ps(mask.hi) << 4);}
+
+#else
+
+//! @brief Lane mask value for a boolean (all bits set when true)
+inline float SimdLaneMask(bool b) {uint32_t u = b ? 0xFFFFFFFFu : 0u; float f; memcpy(&f, &u, 4); return f;}
+//! @brief Raw bits of a float lane
+inline uint32_t SimdLaneBits(float f) {uint32_t u; memcpy(&u, &f, 4); return u;}
+//! @brief Float lane from raw bits
+inline float SimdLaneFloat(uint32_t u) {float f; memcpy(&f, &u, 4); return f;}
+
+#define MATH_X8_LANEWISE(expr) Floatx8 r; for (int i=0; i<8; i++) r.f[i] = (expr); return r;
+inline Floatx8 operator +(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] + b.f[i])}
+inline Floatx8 operator -(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] - b.f[i])}
+inline Floatx8 operator *(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] * b.f[i])}
+inline Floatx8 operator /(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] / b.f[i])}
+inline Floatx8 operator -(const Floatx8& a) {MATH_X8_LANEWISE(-a.f[i])}
+inline Floatx8 MulAdd(const Floatx8& a, const Floatx8& b, const Floatx8& c) {MATH_X8_LANEWISE(a.f[i] * b.f[i] + c.f[i])}
+inline Floatx8 Sqrt(const Floatx8& a) {MATH_X8_LANEWISE(sqrtf(a.f[i]))}
+inline Floatx8 Min(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] < b.f[i] ? a.f[i] : b.f[i])}
+inline Floatx8 Max(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(a.f[i] > b.f[i] ? a.f[i] : b.f[i])}
+inline Floatx8 Abs(const Floatx8& a) {MATH_X8_LANEWISE(fabsf(a.f[i]))}
+inline Floatx8 Round(const Floatx8& a) {MATH_X8_LANEWISE(nearbyintf(a.f[i]))}
+inline Floatx8 CmpLess(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneMask(a.f[i] < b.f[i]))}
+inline Floatx8 CmpLessEqual(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneMask(a.f[i] <= b.f[i]))}
+inline Floatx8 CmpGreater(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneMask(a.f[i] > b.f[i]))}
+inline Floatx8 CmpEqual(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneMask(a.f[i] == b.f[i]))}
+inline Floatx8 And(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneFloat(SimdLaneBits(a.f[i]) & SimdLaneBits(b.f[i])))}
+inline Floatx8 Or(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneFloat(SimdLaneBits(a.f[i]) | SimdLaneBits(b.f[i])))}
+inline Floatx8 AndNot(const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneFloat(~SimdLaneBits(a.f[i]) & SimdLaneBits(b.f[i])))}
+inline Floatx8 Select(const Floatx8& mask, const Floatx8& a, const Floatx8& b) {MATH_X8_LANEWISE(SimdLaneBits(mask.f[i]) ? a.f[i] : b.f[i])}
+#undef MATH_X8_LANEWISE
+inline int MoveMask(const Floatx8& mask)
+    {int m = 0; for (int i=0; i<8; i++) m |= int(SimdLaneBits(mask.f[i]) >> 31) << i; return m;}
+
+#endif
+
+inline Floatx8 operator *(const Floatx8& a, float s) {return a * Floatx8::Broadcast(s);}
+inline Floatx8 operator *(float s, const Floatx8& a) {return Floatx8::Broadcast(s) * a;}
+
+//---------------------------------------------------------------------------------------------
+//                                      4 LANE FLOAT PACKET
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class Floatx4
+ * @brief Four float lanes processed together, the SSE counterpart of Floatx8 with the same
+ *        member and free functions. Maps onto one __m128, or a plain float array with the
+ *        scalar backend.
+ */
+struct Floatx4
+{
+    static const int Width = 4;
+#if MATH_SIMD_SSE
+    __m128 v;
+
+    //! @brief Loads 4 floats from unaligned memory
+    static Floatx4 Load(const float *p) {Floatx4 r; r.v = _mm_loadu_ps(p); return r;}
+    //! @brief Broadcasts a float to every lane
+    static Floatx4 Broadcast(float s) {Floatx4 r; r.v = _mm_set1_ps(s); return r;}
+    //! @brief Stores the 4 lanes to unaligned memory
+    void Store(float *p) const {_mm_storeu_ps(p, v);}
+#else
+    float f[4];
+
+    static Floatx4 Load(const float *p) {Floatx4 r; memcpy(r.f, p, sizeof(r.f)); return r;}
+    static Floatx4 Broadcast(float s) {Floatx4 r; for (int i=0; i<4; i++) r.f[i] = s; return r;}
+    void Store(float *p) const {memcpy(p, f, sizeof(f));}
+#endif
+    //! @brief Yields a packet with every lane set to zero
+    static Floatx4 Zero(void) {return Broadcast(0.0f);}
+    //! @brief Yields lane i of this packet
+    float Lane(int i) const {float t[4]; Store(t); return t[i];}
+};
+
+#if MATH_SIMD_SSE
+
+inline Floatx4 SimdPacket4(__m128 v) {Floatx4 r; r.v = v; return r;}
+inline Floatx4 operator +(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_add_ps(a.v, b.v));}
+inline Floatx4 operator -(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_sub_ps(a.v, b.v));}
+inline Floatx4 operator *(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_mul_ps(a.v, b.v));}
+inline Floatx4 operator /(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_div_ps(a.v, b.v));}
+inline Floatx4 operator -(const Floatx4& a) {return SimdPacket4(_mm_xor_ps(a.v, _mm_set1_ps(-0.0f)));}
+#if MATH_SIMD_FMA
+inline Floatx4 MulAdd(const Floatx4& a, const Floatx4& b, const Floatx4& c) {return SimdPacket4(_mm_fmadd_ps(a.v, b.v, c.v));}
+#else
+inline Floatx4 MulAdd(const Floatx4& a, const Floatx4& b, const Floatx4& c) {return (a*b) + c;}
+#endif
+inline Floatx4 Sqrt(const Floatx4& a) {return SimdPacket4(_mm_sqrt_ps(a.v));}
+inline Floatx4 Min(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_min_ps(a.v, b.v));}
+inline Floatx4 Max(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_max_ps(a.v, b.v));}
+inline Floatx4 Abs(const Floatx4& a) {return SimdPacket4(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v));}
+inline Floatx4 Round(const Floatx4& a) {return SimdPacket4(_mm_cvtepi32_ps(_mm_cvtps_epi32(a.v)));}
+inline Floatx4 CmpLess(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_cmplt_ps(a.v, b.v));}
+inline Floatx4 CmpLessEqual(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_cmple_ps(a.v, b.v));}
+inline Floatx4 CmpGreater(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_cmpgt_ps(a.v, b.v));}
+inline Floatx4 CmpEqual(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_cmpeq_ps(a.v, b.v));}
+inline Floatx4 And(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_and_ps(a.v, b.v));}
+inline Floatx4 Or(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_or_ps(a.v, b.v));}
+inline Floatx4 AndNot(const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_andnot_ps(a.v, b.v));}
+#if MATH_SIMD_AVX
+inline Floatx4 Select(const Floatx4& mask, const Floatx4& a, const Floatx4& b) {return SimdPacket4(_mm_blendv_ps(b.v, a.v, mask.v));}
+#else
+inline Floatx4 Select(const Floatx4& mask, const Floatx4& a, const Floatx4& b) {return Or(And(mask, a), AndNot(mask, b));}
+#endif
+inline int MoveMask(const Floatx4& mask) {return _mm_movemask_ps(mask.v);}
+
+#else
+
+#define MATH_X4_LANEWISE(expr) Floatx4 r; for (int i=0; i<4; i++) r.f[i] = (expr); return r;
+inline Floatx4 operator +(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] + b.f[i])}
+inline Floatx4 operator -(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] - b.f[i])}
+inline Floatx4 operator *(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] * b.f[i])}
+inline Floatx4 operator /(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] / b.f[i])}
+inline Floatx4 operator -(const Floatx4& a) {MATH_X4_LANEWISE(-a.f[i])}
+inline Floatx4 MulAdd(const Floatx4& a, const Floatx4& b, const Floatx4& c) {MATH_X4_LANEWISE(a.f[i] * b.f[i] + c.f[i])}
+inline Floatx4 Sqrt(const Floatx4& a) {MATH_X4_LANEWISE(sqrtf(a.f[i]))}
+inline Floatx4 Min(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] < b.f[i] ? a.f[i] : b.f[i])}
+inline Floatx4 Max(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(a.f[i] > b.f[i] ? a.f[i] : b.f[i])}
+inline Floatx4 Abs(const Floatx4& a) {MATH_X4_LANEWISE(fabsf(a.f[i]))}
+inline Floatx4 Round(const Floatx4& a) {MATH_X4_LANEWISE(nearbyintf(a.f[i]))}
+inline Floatx4 CmpLess(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneMask(a.f[i] < b.f[i]))}
+inline Floatx4 CmpLessEqual(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneMask(a.f[i] <= b.f[i]))}
+inline Floatx4 CmpGreater(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneMask(a.f[i] > b.f[i]))}
+inline Floatx4 CmpEqual(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneMask(a.f[i] == b.f[i]))}
+inline Floatx4 And(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneFloat(SimdLaneBits(a.f[i]) & SimdLaneBits(b.f[i])))}
+inline Floatx4 Or(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneFloat(SimdLaneBits(a.f[i]) | SimdLaneBits(b.f[i])))}
+inline Floatx4 AndNot(const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneFloat(~SimdLaneBits(a.f[i]) & SimdLaneBits(b.f[i])))}
+inline Floatx4 Select(const Floatx4& mask, const Floatx4& a, const Floatx4& b) {MATH_X4_LANEWISE(SimdLaneBits(mask.f[i]) ? a.f[i] : b.f[i])}
+#undef MATH_X4_LANEWISE
+inline int MoveMask(const Floatx4& mask)
+    {int m = 0; for (int i=0; i<4; i++) m |= int(SimdLaneBits(mask.f[i]) >> 31) << i; return m;}
+
+#endif
+
+inline Floatx4 operator *(const Floatx4& a, float s) {return a * Floatx4::Broadcast(s);}
+inline Floatx4 operator *(float s, const Floatx4& a) {return Floatx4::Broadcast(s) * a;}
+
+//---------------------------------------------------------------------------------------------
+//                                 FAST RECIPROCAL SQUARE ROOT
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * The Fast variants replace sqrt + divide with the hardware reciprocal square root estimate
+ * (about 12 bits) refined by one Newton-Raphson step, y' = y * (1.5 - 0.5 * x * y * y).
+ * Measured over every float in [1, 4) the result is within 2.8e-7 of 1/sqrt(x), and the
+ * bound below leaves room for the rounding of the surrounding multiplies. The scalar backend
+ * has no estimate instruction and computes 1/sqrt(x) exactly.
+ * @note Zero, negative, infinite and NaN inputs yield NaN.
+ */
+//! Maximum relative error of InvSqrtFast() and of every Fast function built on it
+#define MATH_RSQRT_MAX_RELATIVE_ERROR 5.0e-7f
+
+#if MATH_SIMD_SSE
+/*!
+ * @brief Approximates 1/sqrt(x) in every lane of a register
+ * @param x The register
+ * @return [__m128] 1/sqrt(x) within MATH_RSQRT_MAX_RELATIVE_ERROR
+ */
+inline __m128 SimdInvSqrtFast(__m128 x)
+{
+    __m128 y = _mm_rsqrt_ps(x);
+    __m128 xyy = _mm_mul_ps(_mm_mul_ps(x, y), y);
+    return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_set1_ps(0.5f), xyy)));
+}
+#endif
+/*!
+ * @brief Approximates 1/sqrt(x)
+ * @param x The value, must be positive
+ * @return [float] 1/sqrt(x) within MATH_RSQRT_MAX_RELATIVE_ERROR
+ */
+#if MATH_SIMD_SSE
+inline float InvSqrtFast(float x) {return _mm_cvtss_f32(SimdInvSqrtFast(_mm_set_ss(x)));}
+#else
+inline float InvSqrtFast(float x) {return (x > 0.0f && x < INFINITY) ? 1.0f / sqrtf(x) : NAN;}
+#endif
+/*!
+ * @brief Approximates 1/sqrt(x) in every lane of a packet
+ * @param x The packet, every lane must be positive
+ * @return [Floatx8] 1/sqrt(x) within MATH_RSQRT_MAX_RELATIVE_ERROR
+ */
+#if MATH_SIMD_AVX
+inline Floatx8 InvSqrtFast(const Floatx8& x)
+{
+    Floatx8 y = SimdPacket(_mm256_rsqrt_ps(x.v));
+    return y * (Floatx8::Broadcast(1.5f) - Floatx8::Broadcast(0.5f) * ((x * y) * y));
+}
+#elif MATH_SIMD_SSE
+inline Floatx8 InvSqrtFast(const Floatx8& x) {return SimdPacket(SimdInvSqrtFast(x.lo), SimdInvSqrtFast(x.hi));}
+#else
+inline Floatx8 InvSqrtFast(const Floatx8& x) {Floatx8 r; for (int i=0; i<8; i++) r.f[i] = InvSqrtFast(x.f[i]); return r;}
+#endif
+#if MATH_SIMD_SSE
+inline Floatx4 InvSqrtFast(const Floatx4& x) {return SimdPacket4(SimdInvSqrtFast(x.v));}
+#else
+inline Floatx4 InvSqrtFast(const Floatx4& x) {Floatx4 r; for (int i=0; i<4; i++) r.f[i] = InvSqrtFast(x.f[i]); return r;}
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                     INVERSE COSINE
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * Branchless arc cosine of a packet. asin(s) is approximated by s + s*z*P(z) with a degree 4
+ * polynomial (Cephes asinf coefficients), z = s*s. Inputs above 0.5 in magnitude are reduced
+ * with acos(x) = 2*asin(sqrt((1 - x) / 2)), which keeps the result accurate near -1 and 1.
+ * Measured against the double precision acos the error stays below 3.1e-7 (about one float ulp
+ * of PI) with every backend.
+ */
+//! Maximum absolute error in radians of Acos(Floatx8) over [-1, 1]
+#define MATH_ACOS_MAX_ABSOLUTE_ERROR 5.0e-7f
+
+// Arc cosine written once against the packet interface, F is Floatx4 or Floatx8
+template<typename F>
+inline F SimdAcos(const F& x)
+{
+    F zero = F::Zero(), half = F::Broadcast(0.5f);
+    F a = Abs(x);
+    F big = CmpGreater(a, half);
+    F z = Select(big, half - half * a, a * a);
+    F s = Select(big, Sqrt(z), a);
+    F p = F::Broadcast(4.2163199048e-2f);
+    p = p * z + F::Broadcast(2.4181311049e-2f);
+    p = p * z + F::Broadcast(4.5470025998e-2f);
+    p = p * z + F::Broadcast(7.4953002686e-2f);
+    p = p * z + F::Broadcast(1.6666752422e-1f);
+    p = s + s * z * p;
+    // |x| <= 0.5: PI/2 - asin(x); x > 0.5: 2*asin(s); x < -0.5: PI - 2*asin(s)
+    F negative = CmpLess(x, zero);
+    F small = F::Broadcast(1.57079632679f) - Select(negative, -p, p);
+    F large = Select(negative, F::Broadcast(3.14159265359f) - (p + p), p + p);
+    return Select(big, large, small);
+}
+/*!
+ * @brief Calculates the arc cosine of every lane of a packet
+ * @param x The packet, every lane in [-1, 1]
+ * @return [Floatx8] acos(x) in [0, PI] within MATH_ACOS_MAX_ABSOLUTE_ERROR
+ */
+inline Floatx8 Acos(const Floatx8& x) {return SimdAcos(x);}
+/*!
+ * @brief Calculates the arc cosine of every lane of a packet
+ * @param x The packet, every lane in [-1, 1]
+ * @return [Floatx4] acos(x) in [0, PI] within MATH_ACOS_MAX_ABSOLUTE_ERROR
+ */
+inline Floatx4 Acos(const Floatx4& x) {return SimdAcos(x);}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+#include "Math\Parallel.h"
+
+using namespace std;
+
+/*!
+ * Skinning of vertex streams by a palette of bone transforms. Every vertex is bound to
+ * MATH_SKINNING_INFLUENCES bones: bones[MATH_SKINNING_INFLUENCES*i + k] is the palette index of
+ * influence k of vertex i and weights[i][k] its weight. Positions and normals are SoA streams;
+ * 8 vertices are skinned per SIMD step, each of them gathering its own palette entries, and
+ * meshes of at least 2*MATH_SKINNING_PARALLEL_GRAIN vertices are split across worker threads
+ * (see ParallelFor()). Output streams must hold positions.count elements and must not overlap
+ * the inputs. An empty normals span (count 0) skips the normals.
+ *
+ *  Linear blend          Transforms by the weighted sum of the palette matrices. Cheap, but
+ *                        twisting joints lose volume (the "candy wrapper")
+ *  Dual quaternion       Transforms by the renormalized weighted sum of palette dual quaternions,
+ *                        which stays rigid. Rotations and translations only
+ */
+
+//! Number of bones influencing each vertex
+#define MATH_SKINNING_INFLUENCES 4
+
+//! Smallest number of vertices a skinning kernel hands to a worker thread
+#ifndef MATH_SKINNING_PARALLEL_GRAIN
+#define MATH_SKINNING_PARALLEL_GRAIN (1 << 12)
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @brief Linear blend skinning: vertex i is transformed by the sum of weights[i][k]*palette[b]
+ *        over its influences b
+ * @param palette The bone transforms, usually world transform times inverse bind pose
+ * @param bones MATH_SKINNING_INFLUENCES palette indices per vertex
+ * @param weights The weights of the influences, which should add up to 1
+ * @param positions The bind pose positions
+ * @param normals The bind pose normals, or an empty span
+ * @param outPositions The skinned positions
+ * @param outNormals The skinned normals, of unit length
+ * @note Normals go through the blended matrix itself, not its inverse transpose, which is exact
+ *       for rotations and uniform scales
+ */
+void SkinLinear(const Transform4 *palette, const uint16_t *bones, const SoASpan<const Vector4>& weights,
+                const SoASpan<const Point3>& positions, const SoASpan<const Vector3>& normals,
+                const SoASpan<Point3>& outPositions, const SoASpan<Vector3>& outNormals);
+/*!
+ * @brief Dual quaternion skinning: vertex i is transformed by the sum of weights[i][k]*palette[b]
+ *        over its influences b, negating the dual quaternions whose rotation is in the other
+ *        hemisphere from that of the first influence, then normalized (see Normalize())
+ * @param palette The bone transforms, with unit rotations (see DualQuaternion(const Transform4&))
+ * @param bones MATH_SKINNING_INFLUENCES palette indices per vertex
+ * @param weights The weights of the influences, not all zero
+ * @param positions The bind pose positions
+ * @param normals The bind pose normals, or an empty span
+ * @param outPositions The skinned positions
+ * @param outNormals The skinned normals, rotated
+ */
+void SkinDualQuaternion(const DualQuaternion *palette, const uint16_t *bones, const SoASpan<const Vector4>& weights,
+                        const SoASpan<const Point3>& positions, const SoASpan<const Vector3>& normals,
+                        const SoASpan<Point3>& outPositions, const SoASpan<Vector3>& outNormals);
@@ -0,0 +1,360 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Vectors.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                        CLASSES
+//---------------------------------------------------------------------------------------------
+
+/*!
+ * @class SoATraits
+ * @brief Describes how a POD math structure (Vector3, Point3, Plane, Quaternion, Matrix4...) is
+ *        split into float streams. Every float of the structure becomes one stream, in memory order.
+ * @param Components Number of float streams of the structure
+ */
+template<typename T>
+struct SoATraits
+{
+    static_assert(is_trivially_copyable<T>::value, "SoA element types must be trivially copyable");
+    static_assert(sizeof(T) % sizeof(float) == 0, "SoA element types must be made of floats");
+    static const int Components = int(sizeof(T) / sizeof(float));
+};
+
+/*!
+ * @class SoASpan
+ * @brief Non-owning view over count elements stored as structure-of-arrays. stream[k] points to
+ *        the kth component of the first element. A span of const T only gives read access.
+ * @param stream One pointer per component stream
+ * @param count Number of elements in the span
+ */
+template<typename T>
+struct SoASpan
+{
+    typedef typename remove_const<T>::type Element;
+    typedef typename conditional<is_const<T>::value, const float, float>::type Float;
+    static const int Components = SoATraits<Element>::Components;
+
+    Float *stream[Components];
+    int count;
+
+    //! @public @memberof SoASpan
+    //! @brief Creates an empty span
+    SoASpan() {for (int k=0; k<Components; k++) stream[k] = nullptr; count = 0;}
+    //! @public @memberof SoASpan
+    //! @brief Creates a span of n elements whose kth stream starts at base + k*pitch
+    SoASpan(Float *base, int pitch, int n) {for (int k=0; k<Components; k++) stream[k] = base + k*pitch; count = n;}
+    //! @public @memberof SoASpan
+    //! @brief Read-only view of a mutable span
+    operator SoASpan<const Element>() const
+    {
+        SoASpan<const Element> s;
+        for (int k=0; k<Components; k++) s.stream[k] = stream[k];
+        s.count = count;
+        return s;
+    }
+    // [Float*] Operator for access to the kth component stream
+    Float *operator [](int k) const {return stream[k];}
+    //! @public @memberof SoASpan
+    //! @brief Yields the sub-span of n elements starting at element first
+    SoASpan Sub(int first, int n) const
+    {
+        SoASpan s = (*this);
+        for (int k=0; k<Components; k++) s.stream[k] += first;
+        s.count = n;
+        return s;
+    }
+    //! @public @memberof SoASpan
+    //! @brief Reinterprets the span as a span of another structure with the same streams,
+    //!        e.g. a span of Point3 as a span of Vector3
+    template<typename U>
+    SoASpan<U> As(void) const
+    {
+        static_assert(SoASpan<U>::Components == Components, "Structures must have the same number of components");
+        SoASpan<U> s;
+        for (int k=0; k<Components; k++) s.stream[k] = stream[k];
+        s.count = count;
+        return s;
+    }
+    //! @public @memberof SoASpan
+    //! @brief Gathers element i from the streams
+    Element Get(int i) const
+    {
+        float f[Components];
+        for (int k=0; k<Components; k++) f[k] = stream[k][i];
+        Element e;
+        memcpy(static_cast<void *>(&e), f, sizeof(Element));
+        return e;
+    }
+    //! @public @memberof SoASpan
+    //! @brief Scatters e into element i of the streams
+    void Set(int i, const Element& e) const
+    {
+        float f[Components];
+        memcpy(f, static_cast<const void *>(&e), sizeof(Element));
+        for (int k=0; k<Components; k++) stream[k][i] = f[k];
+    }
+};
+
+/*!
+ * @class StridedSpan
+ * @brief Non-owning view over count array-of-structures elements placed stride bytes apart, e.g.
+ *        the positions of an interleaved vertex buffer. A span of const T only gives read access.
+ * @param data Address of the first element
+ * @param count Number of elements in the span
+ * @param stride Distance in bytes between consecutive elements, sizeof(T) for a packed array
+ */
+template<typename T>
+struct StridedSpan
+{
+    typedef typename remove_const<T>::type Element;
+    typedef typename conditional<is_const<T>::value, const char, char>::type Byte;
+
+    T *data;
+    int count;
+    int stride;
+
+    //! @public @memberof StridedSpan
+    //! @brief Creates an empty span
+    StridedSpan() {data = nullptr; count = 0; stride = int(sizeof(T));}
+    //! @public @memberof StridedSpan
+    //! @brief Creates a span of n elements starting at p, strideBytes apart (packed by default)
+    StridedSpan(T *p, int n, int strideBytes = int(sizeof(T))) {data = p; count = n; stride = strideBytes;}
+    //! @public @memberof StridedSpan
+    //! @brief Creates a span over every element of a vector
+    StridedSpan(vector<Element>& v) {data = v.data(); count = int(v.size()); stride = int(sizeof(T));}
+    //! @public @memberof StridedSpan
+    //! @brief Creates a read-only span over every element of a vector
+    StridedSpan(const vector<Element>& v) {data = v.data(); count = int(v.size()); stride = int(sizeof(T));}
+    //! @public @memberof StridedSpan
+    //! @brief Read-only view of a mutable span
+    operator StridedSpan<const Element>() const {return StridedSpan<const Element>(data, count, stride);}
+    // [T&] Operator for access to element i
+    T& operator [](int i) const {return *reinterpret_cast<T *>(reinterpret_cast<Byte *>(data) + size_t(i)*stride);}
+    //! @public @memberof StridedSpan
+    //! @brief Yields the sub-span of n elements starting at element first
+    StridedSpan Sub(int first, int n) const {return StridedSpan(&(*this)[first], n, stride);}
+};
+
+/*!
+ * @class SoA
+ * @brief Growable structure-of-arrays container. An SoA<Vector3> keeps all x components in one
+ *        stream, all y components in another, etc. Every stream is 32-byte aligned and its capacity
+ *        is a multiple of MATH_BATCH_WIDTH, so batch kernels can run whole SIMD packets over it.
+ *        Works for any POD math structure made of floats (see SoATraits).
+ * @param Size() Number of elements
+ * @param Stream(k) Pointer to the kth component stream. X(), Y(), Z(), W() name the first four
+ * @param Span() Non-owning view used by the batch kernels
+ */
+template<typename T>
+struct SoA
+{
+    static const int Components = SoATraits<T>::Components;
+protected:
+    float *data;
+    int size;
+    int capacity;
+
+    static int RoundCapacity(int n) {return (n + MATH_BATCH_WIDTH - 1) / MATH_BATCH_WIDTH * MATH_BATCH_WIDTH;}
+public:
+    //! @public @memberof SoA
+    //! @brief Creates an empty SoA container
+    SoA() {data = nullptr; size = 0; capacity = 0;}
+    //! @public @memberof SoA
+    //! @brief Creates an SoA container of n uninitialized elements
+    explicit SoA(int n) {data = nullptr; size = 0; capacity = 0; Resize(n);}
+    //! @public @memberof SoA
+    //! @brief Creates an SoA container holding a copy of an array of structures
+    explicit SoA(const vector<T>& v) {data = nullptr; size = 0; capacity = 0; FromVector(v);}
+    SoA(const SoA& a)
+    {
+        data = nullptr; size = 0; capacity = 0;
+        Reserve(a.size);
+        for (int k=0; k<Components; k++) memcpy(Stream(k), a.Stream(k), a.size*sizeof(float));
+        size = a.size;
+    }
+    SoA(SoA&& a) noexcept {data = a.data; size = a.size; capacity = a.capacity; a.data = nullptr; a.size = a.capacity = 0;}
+    SoA& operator =(SoA a) {swap(data, a.data); swap(size, a.size); swap(capacity, a.capacity); return (*this);}
+    ~SoA() {AlignedFree(data);}
+
+    //! @public @memberof SoA
+    //! @brief Number of elements stored
+    int Size(void) const {return size;}
+    //! @public @memberof SoA
+    //! @brief Number of elements that fit before the streams are reallocated
+    int Capacity(void) const {return capacity;}
+    //! @public @memberof SoA
+    //! @brief Grows every stream so that at least n elements fit, keeping the stored elements
+    void Reserve(int n)
+    {
+        if (n <= capacity) return;
+        int newCapacity = RoundCapacity(n);
+        float *newData = static_cast<float *>(AlignedAlloc(size_t(newCapacity) * Components * sizeof(float)));
+        for (int k=0; k<Components; k++)
+            if (size > 0) memcpy(newData + k*newCapacity, data + k*capacity, size*sizeof(float));
+        AlignedFree(data);
+        data = newData;
+        capacity = newCapacity;
+    }
+    //! @public @memberof SoA
+    //! @brief Changes the number of elements. New elements are uninitialized
+    void Resize(int n) {Reserve(n); size = n;}
+    //! @public @memberof SoA
+    //! @brief Removes every element, keeping the capacity
+    void Clear(void) {size = 0;}
+    //! @public @memberof SoA
+    //! @brief Appends an element, doubling the capacity when full
+    void PushBack(const T& e)
+    {
+        if (size == capacity) Reserve(capacity < MATH_BATCH_WIDTH ? MATH_BATCH_WIDTH : 2*capacity);
+        size++;
+        Set(size - 1, e);
+    }
+    //! @public @memberof SoA
+    //! @brief Gathers element i from the streams
+    T Get(int i) const {return Span().Get(i);}
+    //! @public @memberof SoA
+    //! @brief Scatters e into element i of the streams
+    void Set(int i, const T& e) {Span().Set(i, e);}
+
+    // [float*] Pointer to the kth component stream
+    float *Stream(int k) {return data + k*capacity;}
+    // [const float*] Pointer to the kth component stream
+    const float *Stream(int k) const {return data + k*capacity;}
+    float *X(void) {return Stream(0);}
+    float *Y(void) {static_assert(Components > 1, "No Y stream"); return Stream(1);}
+    float *Z(void) {static_assert(Components > 2, "No Z stream"); return Stream(2);}
+    float *W(void) {static_assert(Components > 3, "No W stream"); return Stream(3);}
+    const float *X(void) const {return Stream(0);}
+    const float *Y(void) const {static_assert(Components > 1, "No Y stream"); return Stream(1);}
+    const float *Z(void) const {static_assert(Components > 2, "No Z stream"); return Stream(2);}
+    const float *W(void) const {static_assert(Components > 3, "No W stream"); return Stream(3);}
+
+    //! @public @memberof SoA
+    //! @brief Yields a view over every element
+    SoASpan<T> Span(void) {return SoASpan<T>(data, capacity, size);}
+    //! @public @memberof SoA
+    //! @brief Yields a read-only view over every element
+    SoASpan<const T> Span(void) const {return SoASpan<const T>(data, capacity, size);}
+    operator SoASpan<T>() {return Span();}
+    operator SoASpan<const T>() const {return Span();}
+
+    //! @public @memberof SoA
+    //! @brief Replaces the contents with an array of structures
+    void FromVector(const vector<T>& v)
+    {
+        Resize(int(v.size()));
+        for (int i=0; i<size; i++) Set(i, v[i]);
+    }
+    //! @public @memberof SoA
+    //! @brief Copies the contents into an array of structures
+    vector<T> ToVector(void) const
+    {
+        vector<T> v(size);
+        for (int i=0; i<size; i++) v[i] = Get(i);
+        return v;
+    }
+};
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+//! @note Batch functions run MATH_BATCH_WIDTH elements per step (one AVX register, two SSE
+//!       registers, or the scalar fallback) and finish the remaining elements one at a time.
+//!       They process a.count elements; every output must hold at least that many.
+//!       Spans of Point3 can be passed through SoASpan::As<Vector3>().
+//! @note Validity masks hold one bit per element, element i in bit (i % 8) of byte i / 8, so a
+//!       mask for n elements needs (n + 7) / 8 bytes. Unused bits of the last byte are cleared.
+
+// * * * * * INNER PRODUCTS * * * * * //
+
+//! @brief Calculates the inner product of every pair of Vector3 structures
+//! @param a First vectors
+//! @param b Second vectors
+//! @param out a[i] * b[i] for every element
+void InnerProduct(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, float *out);
+
+// * * * * * 3D CROSS PRODUCT * * * * * //
+
+//! @brief Generates the cross product of every pair of Vector3 structures
+//! @param a First vectors
+//! @param b Second vectors
+//! @param out a[i] x b[i] for every element
+void CrossProduct(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out);
+
+// * * * * * MAGNITUDES * * * * * //
+
+//! @brief Yields the magnitude of every Vector3 structure
+//! @param a The vectors
+//! @param out Magnitude(a[i]) for every element
+void Magnitude(const SoASpan<const Vector3>& a, float *out);
+
+// * * * * * NORMALIZATION * * * * * //
+
+//! @brief Normalizes every Vector3 structure. May be run in place (out == a)
+//! @param a The vectors
+//! @param out Normalize(a[i]) for every element
+void Normalize(const SoASpan<const Vector3>& a, const SoASpan<Vector3>& out);
+
+// * * * * * FAST NORMALIZATION * * * * * //
+
+//! @brief Approximates the reciprocal magnitude of every Vector3 structure
+//! @param a The vectors
+//! @param out InvMagnitudeFast(a[i]) for every element, within MATH_RSQRT_MAX_RELATIVE_ERROR
+void InvMagnitudeFast(const SoASpan<const Vector3>& a, float *out);
+//! @brief Approximately normalizes every Vector3 structure. May be run in place (out == a)
+//! @param a The vectors
+//! @param out NormalizeFast(a[i]) for every element, within MATH_RSQRT_MAX_RELATIVE_ERROR
+void NormalizeFast(const SoASpan<const Vector3>& a, const SoASpan<Vector3>& out);
+
+// * * * * * PROJECTIONS * * * * * //
+
+//! @brief Projects every a[i] onto b[i]
+//! @param a Vectors to project
+//! @param b Vectors to project onto
+//! @param out a[i] projected onto b[i]
+//! @warning Elements where b[i] is a zero vector yield NaN components
+void Projection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out);
+
+// * * * * * REJECTIONS * * * * * //
+
+//! @brief Rejects every a[i] from b[i]
+//! @param a Vectors to reject
+//! @param b Vectors to reject from
+//! @param out a[i] rejected from b[i]
+//! @warning Elements where b[i] is a zero vector yield NaN components
+void Rejection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out);
+
+// * * * * * EXCEPTION-FREE VARIANTS * * * * * //
+
+//! @brief Projects every a[i] onto b[i] without throwing or branching on the data
+//! @param a Vectors to project
+//! @param b Vectors to project onto
+//! @param out TryProjection(a[i], b[i]) for every element: zero where b[i] is a zero vector
+//! @param valid Validity mask, bit i set when b[i] is not a zero vector
+//! @return [bool] True if every element is valid
+bool TryProjection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out, uint8_t *valid) noexcept;
+//! @brief Rejects every a[i] from b[i] without throwing or branching on the data
+//! @param a Vectors to reject
+//! @param b Vectors to reject from
+//! @param out TryRejection(a[i], b[i]) for every element: a[i] where b[i] is a zero vector
+//! @param valid Validity mask, bit i set when b[i] is not a zero vector
+//! @return [bool] True if every element is valid
+bool TryRejection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out, uint8_t *valid) noexcept;
+//! @brief Calculates the angle (in radians) between every a[i] and b[i] without throwing or
+//!        branching on the data. Full packets use Acos(Floatx8), so results may differ from
+//!        TryAngle() by MATH_ACOS_MAX_ABSOLUTE_ERROR
+//! @param a First vectors
+//! @param b Second vectors
+//! @param out Angle between a[i] and b[i], 0 where it is undefined
+//! @param valid Validity mask, bit i set when both magnitudes are non-zero and finite
+//! @return [bool] True if every element is valid
+bool TryAngle(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, float *out, uint8_t *valid) noexcept;
@@ -0,0 +1,263 @@
+#pragma once
+#include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Geometry.h"
+#include "Math\Matrices.h"
+#include "Math\SoA.h"
+#include "Math\Parallel.h"
+
+using namespace std;
+
+/*!
+ * Batch counterparts of the Transform4 and Matrix4 operators of Matrices.h, for skinning, culling
+ * and physics code that moves whole arrays through one transform. Every function reads in.count
+ * elements, either from a StridedSpan (array of structures, optionally interleaved) or from a
+ * SoASpan, and writes them to out, which must hold at least as many elements. The matrix is
+ * broadcast once and MATH_BATCH_WIDTH elements are transformed per step. Arrays of at least
+ * 2*MATH_TRANSFORM_PARALLEL_GRAIN elements are split across worker threads (see ParallelFor()).
+ * Input and output may be the same elements (in place), but must not otherwise overlap.
+ * Unit quaternions and rotation matrices are converted the same way, SoA spans 8 elements per
+ * SIMD step. Arrays of matrices are inverted 4 matrices per SIMD step, and arrays of transforms
+ * are split into translation, rotation and scale 8 transforms per step. Symmetric Matrix3 arrays
+ * are diagonalized, Matrix3 arrays factored by SVD and rotation pairs interpolated 8 per step.
+ */
+
+//! Smallest number of elements a batch transform hands to a worker thread
+#ifndef MATH_TRANSFORM_PARALLEL_GRAIN
+#define MATH_TRANSFORM_PARALLEL_GRAIN (1 << 15)
+#endif
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * TRANSFORM4 * * * * * //
+
+/*!
+ * @brief Transforms every point by T, translation included
+ * @param T The transform
+ * @param in The points
+ * @param out T*in[i] + T.GetTranslation() for every element
+ * @note Unlike operator *(const Transform4&, const Point3&), which only applies the 3x3 part of T
+ */
+void TransformPoints(const Transform4& T, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out);
+void TransformPoints(const Transform4& T, const SoASpan<const Point3>& in, const SoASpan<Point3>& out);
+/*!
+ * @brief Transforms every direction vector by the 3x3 part of T
+ * @param T The transform
+ * @param in The vectors
+ * @param out T*in[i] for every element
+ */
+void TransformVectors(const Transform4& T, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformVectors(const Transform4& T, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+/*!
+ * @brief Transforms every normal vector as a row vector, like operator *(const Vector3&, const Transform4&)
+ * @param T The inverse of the transform applied to the surface, e.g. Inverse(H) for normals of a
+ *          mesh transformed by H
+ * @param in The normals
+ * @param out in[i]*T for every element. Normals are not renormalized
+ */
+void TransformNormals(const Transform4& T, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformNormals(const Transform4& T, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+/*!
+ * @brief Transforms every plane as a row vector, like operator *(const Plane&, const Transform4&)
+ * @param T The inverse of the transform applied to the planes, e.g. Inverse(H) to carry planes by H
+ * @param in The planes
+ * @param out in[i]*T for every element
+ */
+void TransformPlanes(const Transform4& T, const StridedSpan<const Plane>& in, const StridedSpan<Plane>& out);
+void TransformPlanes(const Transform4& T, const SoASpan<const Plane>& in, const SoASpan<Plane>& out);
+
+// * * * * * MATRIX4 * * * * * //
+
+/*!
+ * @brief Transforms every point by a projective matrix, dividing by the resulting w
+ * @param M The matrix
+ * @param in The points, extended with w = 1
+ * @param out The x, y and z components of M*(in[i], 1), divided by its w component
+ * @warning Points mapped to w = 0 yield infinite or NaN components
+ */
+void TransformPoints(const Matrix4& M, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out);
+void TransformPoints(const Matrix4& M, const SoASpan<const Point3>& in, const SoASpan<Point3>& out);
+/*!
+ * @brief Transforms every direction vector by the upper-left 3x3 part of M
+ * @param M The matrix
+ * @param in The vectors
+ * @param out The x, y and z components of M*(in[i], 0)
+ */
+void TransformVectors(const Matrix4& M, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformVectors(const Matrix4& M, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+/*!
+ * @brief Transforms every normal vector as a row vector by the upper-left 3x3 part of M
+ * @param M The inverse of the matrix applied to the surface
+ * @param in The normals
+ * @param out The x, y and z components of (in[i], 0)*M. Normals are not renormalized
+ */
+void TransformNormals(const Matrix4& M, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformNormals(const Matrix4& M, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+/*!
+ * @brief Transforms every plane as a row vector by M
+ * @param M The inverse of the matrix applied to the planes
+ * @param in The planes
+ * @param out in[i]*M, all four components, for every element
+ */
+void TransformPlanes(const Matrix4& M, const StridedSpan<const Plane>& in, const StridedSpan<Plane>& out);
+void TransformPlanes(const Matrix4& M, const SoASpan<const Plane>& in, const SoASpan<Plane>& out);
+
+// * * * * * ROTATIONS * * * * * //
+
+/*!
+ * @brief Converts unit quaternions to rotation matrices like UnitQuaternion::GetRotation()
+ * @param in The unit quaternions
+ * @param out The rotation matrix of every quaternion
+ * @note Strided spans run the scalar function per element, SoA spans 8 elements per SIMD step
+ */
+void QuaternionsToRotations(const StridedSpan<const UnitQuaternion>& in, const StridedSpan<Matrix3>& out);
+void QuaternionsToRotations(const SoASpan<const UnitQuaternion>& in, const SoASpan<Matrix3>& out);
+/*!
+ * @brief Converts rotation matrices to unit quaternions like UnitQuaternion::SetRotation()
+ * @param in The rotation matrices
+ * @param out The unit quaternion of every matrix
+ */
+void RotationsToQuaternions(const StridedSpan<const Matrix3>& in, const StridedSpan<UnitQuaternion>& out);
+void RotationsToQuaternions(const SoASpan<const Matrix3>& in, const SoASpan<UnitQuaternion>& out);
+
+// * * * * * QUATERNION ROTATION * * * * * //
+
+/*!
+ * @brief Rotates every vector by one unit quaternion like Transform(const Vector3&, const UnitQuaternion&)
+ * @param q The rotation
+ * @param in The vectors
+ * @param out The rotated vectors
+ * @note The cross-product form costs 18 multiplies per element against 9 for TransformVectors()
+ *       with q.GetRotation(). It pays off when each element has its own rotation
+ */
+void TransformVectors(const UnitQuaternion& q, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformVectors(const UnitQuaternion& q, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+//! @brief Rotates every point about the origin by one unit quaternion
+void TransformPoints(const UnitQuaternion& q, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out);
+void TransformPoints(const UnitQuaternion& q, const SoASpan<const Point3>& in, const SoASpan<Point3>& out);
+/*!
+ * @brief Rotates every vector by its own unit quaternion, e.g. the bone offsets of a skeleton by
+ *        the joint orientations
+ * @param q The rotations, at least in.count of them
+ * @param in The vectors
+ * @param out Transform(in[i], q[i]) for every element
+ */
+void TransformVectors(const StridedSpan<const UnitQuaternion>& q, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out);
+void TransformVectors(const SoASpan<const UnitQuaternion>& q, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out);
+//! @brief Rotates every point about the origin by its own unit quaternion
+void TransformPoints(const StridedSpan<const UnitQuaternion>& q, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out);
+void TransformPoints(const SoASpan<const UnitQuaternion>& q, const SoASpan<const Point3>& in, const SoASpan<Point3>& out);
+
+// * * * * * INVERSION * * * * * //
+
+/*!
+ * @brief Inverts an array of matrices without throwing or branching on the data
+ * @param in The count matrices
+ * @param count Number of matrices
+ * @param out TryInverse(in[i]) for every element: the zero matrix where in[i] is singular. May be
+ *            run in place (out == in)
+ * @param det Receives the determinant of every matrix, may be null
+ * @param valid Validity mask (see SoA.h), bit i set when in[i] is invertible
+ * @return [bool] True if every matrix is invertible
+ */
+bool TryInverse(const Matrix4 *in, int count, Matrix4 *out, float *det, uint8_t *valid) noexcept;
+/*!
+ * @brief Inverts an array of transforms without throwing or branching on the data
+ * @param in The count transforms
+ * @param count Number of transforms
+ * @param out TryInverse(in[i]) for every element: the zero transform where in[i] is singular. May
+ *            be run in place (out == in)
+ * @param det Receives the determinant of the 3x3 part of every transform, may be null
+ * @param valid Validity mask (see SoA.h), bit i set when in[i] is invertible
+ * @return [bool] True if every transform is invertible
+ */
+bool TryInverse(const Transform4 *in, int count, Transform4 *out, float *det, uint8_t *valid) noexcept;
+
+// * * * * * TRS * * * * * //
+
+/*!
+ * @brief Splits an array of transforms into translation, rotation and scale like DecomposeTRS(),
+ *        8 transforms per SIMD step
+ * @param in The count transforms
+ * @param count Number of transforms
+ * @param translation Receives the translation of every transform
+ * @param rotation Receives the unit rotation quaternion of every transform
+ * @param scale Receives the scale of every transform, negative x for mirrored ones
+ * @param valid Validity mask (see SoA.h), bit i set when the 3x3 part of in[i] is not singular
+ * @return [bool] True if every transform was decomposed
+ */
+bool DecomposeTRS(const Transform4 *in, int count, Point3 *translation, Quaternion *rotation, Vector3 *scale, uint8_t *valid) noexcept;
+/*!
+ * @brief Builds an array of transforms Translate(t)*Rotate(q)*Scale(s) like ComposeTRS()
+ * @param translation The count translations
+ * @param rotation The count rotations, need not be of unit length
+ * @param scale The count scales
+ * @param count Number of transforms
+ * @param out Receives the transforms
+ */
+void ComposeTRS(const Point3 *translation, const Quaternion *rotation, const Vector3 *scale, int count, Transform4 *out) noexcept;
+
+// * * * * * EIGEN DECOMPOSITION * * * * * //
+
+/*!
+ * @brief Diagonalizes an array of symmetric matrices like DiagonalizeSymmetric(), 8 matrices per
+ *        SIMD step, e.g. the inertia tensors of every body of a scene
+ * @param in The count symmetric matrices
+ * @param count Number of matrices
+ * @param rotation Receives the eigenvector rotation of every matrix
+ * @param values Receives the eigenvalues of every matrix, in decreasing order
+ */
+void DiagonalizeSymmetric(const Matrix3 *in, int count, Matrix3 *rotation, Vector3 *values) noexcept;
+void DiagonalizeSymmetric(const Matrix3 *in, int count, Quaternion *rotation, Vector3 *values) noexcept;
+
+// * * * * * SINGULAR VALUE DECOMPOSITION * * * * * //
+
+/*!
+ * @brief Factors an array of matrices like SVD(), 8 matrices per SIMD step, e.g. the deformation
+ *        gradients of every cluster of a soft body
+ * @param in The count matrices
+ * @param count Number of matrices
+ * @param U Receives the left rotation of every matrix
+ * @param sigma Receives the singular values of every matrix
+ * @param V Receives the right rotation of every matrix
+ */
+void SVD(const Matrix3 *in, int count, Matrix3 *U, Vector3 *sigma, Matrix3 *V) noexcept;
+void SVD(const Matrix3 *in, int count, Quaternion *U, Vector3 *sigma, Quaternion *V) noexcept;
+
+// * * * * * INTERPOLATION * * * * * //
+
+/*!
+ * @brief Blends an array of rotation pairs like Nlerp(), 8 pairs per SIMD step, e.g. the key
+ *        frames around the sample time of every joint of a skeleton
+ * @param a The count rotations at t = 0
+ * @param b The count rotations at t = 1
+ * @param t The count blend weights
+ * @param count Number of pairs
+ * @param out Receives the blended rotations. May be run in place (out == a or out == b)
+ * @note Runs the operations of the scalar Nlerp(), so the results are the same bit for bit
+ *       (in builds that do not contract a*b + c into FMA)
+ */
+void Nlerp(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept;
+/*!
+ * @brief Blends an array of unit rotation pairs like Slerp(), 8 pairs per SIMD step
+ * @param a The count rotations at t = 0
+ * @param b The count rotations at t = 1
+ * @param t The count blend weights in [0, 1]
+ * @param count Number of pairs
+ * @param out Receives the blended rotations. May be run in place
+ * @note The weights are the series of SlerpFast() to 16 terms rather than acos and sin, which
+ *       agrees with Slerp() to float rounding (1e-6)
+ */
+void Slerp(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept;
+/*!
+ * @brief Blends an array of unit rotation pairs like SlerpFast(), 8 pairs per SIMD step, every
+ *        component within 4e-5 of Slerp()'s
+ * @param a The count rotations at t = 0
+ * @param b The count rotations at t = 1
+ * @param t The count blend weights in [0, 1]
+ * @param count Number of pairs
+ * @param out Receives the blended rotations. May be run in place
+ */
+void SlerpFast(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept;
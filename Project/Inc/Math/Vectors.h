@@ -4,6 +4,8 @@
 #include <stdexcept>
 #include <string>
 #include "Math\Helpers.h"
+#include "Math\Simd.h"
+#include "Math\Core.h"
 
 using namespace std;
 
@@ -21,120 +23,60 @@ struct ZeroMagnitudeE : public runtime_error
 //                                        CLASSES
 //---------------------------------------------------------------------------------------------
 
-/*! @class Vector2
- *  @brief 2D Vector data structure
- *  @param x First component
- *  @param y Second component
- *  @param Zero() Creates a zero vector (0.0f, 0.0f)
- */
-struct Vector2
-{
-    float x, y;
-    //! @public @memberof Vector2
-    //! @brief Creates an empty Vector2 data structure
-    Vector2() = default;
-    //! @public @memberof Vector2
-    //! @brief Creates a Vector2 data structure (float x, float y)
-    Vector2(float a, float b) {x = a; y = b;}
-
-    Vector2& operator +=(const Vector2& vec) {x += vec.x; y += vec.y; return (*this);}
-    Vector2& operator -=(const Vector2& vec) {x -= vec.x; y -= vec.y; return (*this);}
-    float operator *=(const Vector2& vec) {return x * vec.x + y * vec.y;}
-    Vector2& operator *=(float scalar) {x *= scalar; y *= scalar; return (*this);}
-    Vector2& operator /=(float scalar) {float sc = (1.0f/scalar); x *= sc; y *= sc; return (*this);}
-    const bool operator ==(const Vector2& vec) const {return (CloseFloat(x,vec.x) && CloseFloat(y, vec.y));}
-    const bool operator !=(const Vector2& vec) const {return !((*this)==vec);}
-    float& operator [](int i) {return ((&x)[i]);}
-    const float& operator [](int i) const {return ((&x)[i]);}
-    //! @public @memberof Vector2
-    //! @brief Creates a 2D vector (0.0f, 0.0f)
-    const Vector2 Zero(void) const {return Vector2(0.0f, 0.0f);}
-    //! @public @memberof Vector2
-    //! @brief Yields this Vector2 as a string representation
-    const string ToString(void) const {return "(" + to_string(x) + ", " + to_string(y) + ")";}
-    //! @public @memberof Vector2
-    //! @brief Prints this Vector2
-    const void Print(void) const {cout << "Vector2: " << (*this).ToString() << "\n";}
-};
+//! @note Vector2, Vector3 and Vector4 are aliases of VecN<float,N> (see Core.h)
 
-/*! @class Vector3
- *  @brief 3D Vector data structure (float x, float y, float z)
+/*! @class Vector3A
+ *  @brief Padded 3D Vector data structure (float x, float y, float z). Always 16 bytes, and
+ *         16-byte aligned under SIMD so that it can be loaded straight into a SIMD register. The
+ *         fourth (pad) component is zero from every constructor and kept at zero by every
+ *         operation, as the SIMD dot product sums all four lanes.
  *  @param x First component
  *  @param y Second component
  *  @param z Third component
  *  @param Zero() Creates a zero vector (0.0f, 0.0f, 0.0f)
  */
-struct Vector3
+struct MATH_SIMD_ALIGN Vector3A
 {
-    float x, y, z;
-    //! @public @memberof Vector3
-    //! @brief Creates an empty Vector3 data structure
-    Vector3() = default;
-    //! @public @memberof Vector3
-    //! @brief Creates a Vector3 data structure (float x, float y, float z)
-    Vector3(float a, float b, float c) {x = a;  y = b;  z = c;}
-
-    Vector3& operator +=(const Vector3& vec) {x += vec.x; y += vec.y; z += vec.z; return (*this);}
-    Vector3& operator -=(const Vector3& vec) {x -= vec.x; y -= vec.y; z -= vec.z; return (*this);}
-    float operator *=(const Vector3& vec) {return x * vec.x + y * vec.y + z * vec.z;}
-    Vector3& operator *=(float scalar) {x *= scalar; y *= scalar; z *= scalar; return (*this);}
-    Vector3& operator /=(float scalar)
-    {float sc = (1.0f/scalar); x *= sc; y *= sc; z *= sc; return (*this);}
-    const bool operator ==(const Vector3& vec) const {return (CloseFloat(x, vec.x) && CloseFloat(y, vec.y) && CloseFloat(z, vec.z));}
-    const bool operator !=(const Vector3& vec) const {return !((*this) == vec);}
+    float x, y, z, pad;
+    //! @public @memberof Vector3A
+    //! @brief Creates a Vector3A data structure with unset components and a zero pad
+    Vector3A() {pad = 0.0f;}
+    //! @public @memberof Vector3A
+    //! @brief Creates a Vector3A data structure (float x, float y, float z)
+    Vector3A(float a, float b, float c) {x = a; y = b; z = c; pad = 0.0f;}
+    //! @public @memberof Vector3A
+    //! @brief Creates a Vector3A data structure from the components of a Vector3
+    explicit Vector3A(const Vector3& v) {x = v.x; y = v.y; z = v.z; pad = 0.0f;}
+
+#if MATH_SIMD_SSE
+    Vector3A& operator +=(const Vector3A& vec) {_mm_store_ps(&x, _mm_add_ps(_mm_load_ps(&x), _mm_load_ps(&vec.x))); return (*this);}
+    Vector3A& operator -=(const Vector3A& vec) {_mm_store_ps(&x, _mm_sub_ps(_mm_load_ps(&x), _mm_load_ps(&vec.x))); return (*this);}
+    float operator *=(const Vector3A& vec) {return _mm_cvtss_f32(SimdDot4(_mm_load_ps(&x), _mm_load_ps(&vec.x)));}
+    Vector3A& operator *=(float scalar) {_mm_store_ps(&x, _mm_mul_ps(_mm_load_ps(&x), _mm_set1_ps(scalar))); return (*this);}
+    Vector3A& operator /=(float scalar) {_mm_store_ps(&x, _mm_mul_ps(_mm_load_ps(&x), _mm_set1_ps(1.0f/scalar))); return (*this);}
+#else
+    Vector3A& operator +=(const Vector3A& vec) {x += vec.x; y += vec.y; z += vec.z; return (*this);}
+    Vector3A& operator -=(const Vector3A& vec) {x -= vec.x; y -= vec.y; z -= vec.z; return (*this);}
+    float operator *=(const Vector3A& vec) {return x * vec.x + y * vec.y + z * vec.z;}
+    Vector3A& operator *=(float scalar) {x *= scalar; y *= scalar; z *= scalar; return (*this);}
+    Vector3A& operator /=(float scalar) {float sc = (1.0f/scalar); x *= sc; y *= sc; z *= sc; return (*this);}
+#endif
+    const bool operator ==(const Vector3A& vec) const {return (CloseFloat(x, vec.x) && CloseFloat(y, vec.y) && CloseFloat(z, vec.z));}
+    const bool operator !=(const Vector3A& vec) const {return !((*this) == vec);}
     float& operator [](int i) {return ((&x)[i]);}
     const float& operator [](int i) const {return ((&x)[i]);}
-    //! @public @memberof Vector3
-    //! @brief Creates a 3D vector (0.0f, 0.0f, 0.0f)
-    const Vector3 Zero(void) const {return Vector3(0.0f, 0.0f, 0.0f);}
-    //! @public @memberof Vector3
-    //! @brief Yields this Vector3 as a string representation
+    //! @public @memberof Vector3A
+    //! @brief Creates a padded 3D vector (0.0f, 0.0f, 0.0f)
+    const Vector3A Zero(void) const {return Vector3A(0.0f, 0.0f, 0.0f);}
+    //! @public @memberof Vector3A
+    //! @brief Yields the components of this Vector3A as an unpadded Vector3
+    const Vector3 ToVector3(void) const {return Vector3(x, y, z);}
+    //! @public @memberof Vector3A
+    //! @brief Yields this Vector3A as a string representation
     const string ToString(void) const {return "(" + to_string(x) + ", " + to_string(y) + ", " + to_string(z) + ")";}
-    //! @public @memberof Vector3
-    //! @brief Prints this Vector3
-    const void Print(void) const {cout << "Vector3: " << (*this).ToString() << "\n";}
-
-};
-
-/*! @class Vector4
- *  @brief 3D Vector data structure (float w, float x, float y, float z)
- *  @param x First component
- *  @param y Second component
- *  @param z Third component
- *  @param w Fourth component
- *  @param Zero() Creates a zero vector (0.0f, 0.0f, 0.0f, 0.0f)
- *
- */
-struct Vector4
-{
-    float x, y, z, w;
-    //! @public @memberof Vector4
-    //! @brief Creates an empty Vector4 data structure
-    Vector4() = default;
-    //! @public @memberof Vector4
-    //! @brief Creates a Vector4 data structure (float x, float y, float z, float w)
-    Vector4(float a, float b, float c, float n) {x = a; y = b; z = c; w = n;}
-
-    Vector4& operator +=(const Vector4& vec) {x += vec.x; y += vec.y; z += vec.z; w += vec.w; return (*this);}
-    Vector4& operator -=(const Vector4& vec) {x -= vec.x; y -= vec.y; z -= vec.z; w -= vec.w; return (*this);}
-    Vector4& operator *=(float scalar) {x *= scalar; y *= scalar; z *= scalar; w *= scalar; return (*this);}
-    float operator *=(const Vector4& vec) {return x * vec.x + y * vec.y + z * vec.z + w * vec.w;}
-    Vector4& operator /=(float scalar) {float sc = (1.0f/scalar); x *= sc; y *= sc; z *= sc; w *= sc; return (*this);}
-    const bool operator ==(const Vector4& vec) const {return (CloseFloat (x, vec.x) && CloseFloat(y, vec.y) && CloseFloat(z, vec.z) && CloseFloat(w, vec.w));}
-    const bool operator !=(const Vector4& vec) const {return (!((*this) == (vec)));}
-    float& operator [](int i) {return ((&x)[i]);}
-    const float& operator [](int i) const {return ((&x)[i]);}
-    //! @public @memberof Vector4
-    //! @brief Creates a 4D vector (0.0f, 0.0f, 0.0f, 0.0f)
-    const Vector4 Zero(void) const {return Vector4(0.0f, 0.0f, 0.0f, 0.0f);}
-    //! @public @memberof Vector4
-    //! @brief Yields this Vector4 as a string representation
-    const string ToString(void) const
-    {return "(" + to_string(x) + ", " + to_string(y) +
-            ", " + to_string(z) + ", " + to_string(w) + ")";}
-    //! @public @memberof Vector4
-    //! @brief Prints this Vector4
-    const void Print(void) const {cout << "Vector4: " << (*this).ToString() << "\n";}
+    //! @public @memberof Vector3A
+    //! @brief Prints this Vector3A
+    const void Print(void) const {cout << "Vector3A: " << (*this).ToString() << "\n";}
 };
 
 //---------------------------------------------------------------------------------------------
@@ -153,135 +95,160 @@ inline double Power(double base, int exponent) {return Power(base, exponent, 1.0
 
 // * * * * * INNER PRODUCTS * * * * * //
 
-//! @brief Calculates inner product for two Vector2 structures. This is the function that is used by the
+//! @note InnerProduct for Vector2, Vector3 and Vector4 is the VecN template in Core.h
+//! @brief Calculates inner product for two Vector3A structures. This is the function that is used by the
 //!        dot product operator.
 //! @param v1 First vector
 //! @param v2 Second vector
 //! @return [float] Value of their innner product.
-inline float InnerProduct(const Vector2& v1, const Vector2& v2) {return (v1.x * v2.x) + (v1.y * v2.y);}
-//! @brief Calculates inner product for two Vector3 structures. This is the function that is used by the
-//!        dot product operator.
-//! @param v1 First vector
-//! @param v2 Second vector
-//! @return [float] Value of their innner product.
-inline float InnerProduct(const Vector3& v1, const Vector3& v2) {return ((v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z));}
-//! @brief Calculates inner product for two Vector4 structures. This is the function that is used by the
-//!        dot product operator.
-//! @param v1 First vector
-//! @param v2 Second vector
-//! @return [float] Value of their innner product.
-inline float InnerProduct(const Vector4& v1, const Vector4& v2) {return ((v1.x*v2.x) + (v1.y*v2.y) + (v1.z*v2.z) + (v1.w*v2.w));}
+#if MATH_SIMD_SSE
+inline float InnerProduct(const Vector3A& v1, const Vector3A& v2) {return _mm_cvtss_f32(SimdDot4(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));}
+#else
+inline float InnerProduct(const Vector3A& v1, const Vector3A& v2) {return ((v1.x * v2.x) + (v1.y * v2.y) + (v1.z * v2.z));}
+#endif
 
 // * * * * * OPERATORS * * * * * //
 
-// VECTOR2
-
-inline Vector2 operator +(const Vector2& v1, const Vector2& v2) {return (Vector2(v1.x + v2.x, v1.y + v2.y));}
-inline Vector2 operator -(const Vector2& v1, const Vector2& v2) {return (Vector2(v1.x - v2.x, v1.y - v2.y));}
-inline Vector2 operator *(const Vector2& vec, float scalar) {return (Vector2(vec.x * scalar, vec.y * scalar));}
-inline Vector2 operator *(float scalar, const Vector2& vec) {return (vec * scalar);}
-inline float operator *(const Vector2& a, const Vector2& b) {return InnerProduct(a,b);}
-inline Vector2 operator /(const Vector2& vec, float scalar) {scalar = 1.0f/scalar; return (scalar*vec);}
-inline Vector2 operator -(const Vector2& vec) {return (Vector2(-vec.x, -vec.y));}
-
-// VECTOR3
-
-inline Vector3 operator +(const Vector3& v1, const Vector3& v2) {return (Vector3(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z));}
-inline Vector3 operator -(const Vector3& v1, const Vector3& v2) {return (Vector3(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z));}
-inline Vector3 operator *(const Vector3& vec, float scalar) {return (Vector3(vec.x * scalar, vec.y * scalar, vec.z * scalar));}
-inline Vector3 operator *(float scalar, const Vector3& vec) {return (vec * scalar);}
-inline float operator *(const Vector3& a, const Vector3& b){return InnerProduct(a,b);}
-inline Vector3 operator /(const Vector3& vec, float scalar) {scalar = 1.0f/scalar; return (scalar * vec);}
-inline Vector3 operator -(const Vector3& vec) {return (Vector3(-vec.x, -vec.y, -vec.z));}
-
-//  VECTOR4
-
-inline Vector4 operator +(const Vector4& v1, const Vector4& v2) {return (Vector4(v1.x+v2.x, v1.y+v2.y, v1.z+v2.z, v1.w+v2.w));}
-inline Vector4 operator -(const Vector4& v1, const Vector4& v2) {return (Vector4(v1.x-v2.x, v1.y-v2.y, v1.z-v2.z, v1.w-v2.w));}
-inline Vector4 operator *(const Vector4& vec, float scalar) {return (Vector4(vec.x*scalar, vec.y*scalar, vec.z*scalar, vec.w*scalar));}
-inline Vector4 operator *(float scalar, const Vector4& vec) {return (vec * scalar);}
-inline float operator *(const Vector4& a, const Vector4& b) {return InnerProduct(a,b);}
-inline Vector4 operator /(const Vector4& vec, float scalar) {scalar = 1.0f/scalar; return (scalar * vec);}
-inline Vector4 operator -(const Vector4& vec) {return (Vector4(-vec.x, -vec.y, -vec.z, -vec.w));}
+//! @note Vector2, Vector3 and Vector4 operators are the VecN templates in Core.h
+
+// VECTOR3A
+
+#if MATH_SIMD_SSE
+//! @brief Stores a SIMD register into a Vector3A structure
+inline Vector3A SimdToVector3A(__m128 v) {Vector3A r; _mm_store_ps(&r.x, v); return r;}
+inline Vector3A operator +(const Vector3A& v1, const Vector3A& v2) {return SimdToVector3A(_mm_add_ps(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));}
+inline Vector3A operator -(const Vector3A& v1, const Vector3A& v2) {return SimdToVector3A(_mm_sub_ps(_mm_load_ps(&v1.x), _mm_load_ps(&v2.x)));}
+inline Vector3A operator *(const Vector3A& vec, float scalar) {return SimdToVector3A(_mm_mul_ps(_mm_load_ps(&vec.x), _mm_set1_ps(scalar)));}
+inline Vector3A operator -(const Vector3A& vec) {return SimdToVector3A(_mm_sub_ps(_mm_setzero_ps(), _mm_load_ps(&vec.x)));}
+#else
+inline Vector3A operator +(const Vector3A& v1, const Vector3A& v2) {return (Vector3A(v1.x + v2.x, v1.y + v2.y, v1.z + v2.z));}
+inline Vector3A operator -(const Vector3A& v1, const Vector3A& v2) {return (Vector3A(v1.x - v2.x, v1.y - v2.y, v1.z - v2.z));}
+inline Vector3A operator *(const Vector3A& vec, float scalar) {return (Vector3A(vec.x * scalar, vec.y * scalar, vec.z * scalar));}
+inline Vector3A operator -(const Vector3A& vec) {return (Vector3A(-vec.x, -vec.y, -vec.z));}
+#endif
+inline Vector3A operator *(float scalar, const Vector3A& vec) {return (vec * scalar);}
+inline float operator *(const Vector3A& a, const Vector3A& b) {return InnerProduct(a,b);}
+inline Vector3A operator /(const Vector3A& vec, float scalar) {scalar = 1.0f/scalar; return (scalar * vec);}
 
 // * * * * * MAGNITUDES * * * * * //
 
-//! @brief Yields the magnitude of a Vector2 structure
-//! @param vec The vector to find the magnitude for
-//! @return [float] Value of the magnitude
-inline float Magnitude(const Vector2& vec) {return sqrt((vec.x * vec.x) + (vec.y * vec.y));}
-//! @brief Yields the magnitude of a Vector3 structure
+//! @note Magnitude for Vector2, Vector3 and Vector4 is the VecN template in Core.h
+
+#if MATH_SIMD_SSE
+//! @brief Yields the magnitude of a Vector4 structure
 //! @param vec The vector to find the magnitude for
 //! @return [float] Value of the magnitude
-inline float Magnitude(const Vector3& vec) {return sqrt((vec.x*vec.x) + (vec.y*vec.y) + (vec.z*vec.z));}
-//! @brief Yields the magnitude of a Vector4 structure
+inline float Magnitude(const Vector4& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return _mm_cvtss_f32(_mm_sqrt_ss(SimdDot4(v, v)));}
+#endif
+//! @brief Yields the magnitude of a Vector3A structure
 //! @param vec The vector to find the magnitude for
 //! @return [float] Value of the magnitude
-inline float Magnitude(const Vector4& vec) {return sqrt((vec.x*vec.x) + (vec.y*vec.y) + (vec.z*vec.z) + (vec.w*vec.w));}
+#if MATH_SIMD_SSE
+inline float Magnitude(const Vector3A& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return _mm_cvtss_f32(_mm_sqrt_ss(SimdDot4(v, v)));}
+#else
+inline float Magnitude(const Vector3A& vec) {return sqrt((vec.x*vec.x) + (vec.y*vec.y) + (vec.z*vec.z));}
+#endif
 
 // * * * * * NORMALIZATION * * * * * //
 
-//! @brief Normalizes a Vector2 structure
-//! @param vec The vector to normalize
-//! @return [Vector2] Normalized vector
-inline Vector2 Normalize(const Vector2& vec) {return (vec / Magnitude(vec));}
-//! @brief Normalizes a Vector3 structure
-//! @param vec The vector to normalize
-//! @return [Vector3] Normalized vector
-inline Vector3 Normalize(const Vector3& vec) {return (vec / Magnitude(vec));}
+//! @note Normalize for Vector2, Vector3 and Vector4 is the VecN template in Core.h
+
+#if MATH_SIMD_SSE
 //! @brief Normalizes a Vector4 structure
 //! @param vec The vector to normalize
 //! @return [Vector4] Normalized vector
-inline Vector4 Normalize(const Vector4& vec) {return (vec / Magnitude(vec));}
+inline Vector4 Normalize(const Vector4& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return SimdToVector4(SimdScaleByInvSqrt(v, SimdDot4(v, v)));}
+#endif
+//! @brief Normalizes a Vector3A structure
+//! @param vec The vector to normalize
+//! @return [Vector3A] Normalized vector
+#if MATH_SIMD_SSE
+inline Vector3A Normalize(const Vector3A& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return SimdToVector3A(SimdScaleByInvSqrt(v, SimdDot4(v, v)));}
+#else
+inline Vector3A Normalize(const Vector3A& vec) {return (vec / Magnitude(vec));}
+#endif
+
+// * * * * * FAST NORMALIZATION * * * * * //
+
+//! @note The Fast functions trade the exact sqrt and divide of Magnitude/Normalize for
+//!       InvSqrtFast(). Results are within MATH_RSQRT_MAX_RELATIVE_ERROR of the exact ones.
+//!       A zero vector yields NaN.
+
+//! @brief Approximates the reciprocal magnitude of a Vector2, Vector3 or Vector4 structure
+//! @param vec The vector to find the reciprocal magnitude for
+//! @return [float] Approximation of 1 / Magnitude(vec)
+template<int N>
+inline float InvMagnitudeFast(const VecN<float, N>& vec) {return InvSqrtFast(InnerProduct(vec, vec));}
+#if MATH_SIMD_SSE
+inline float InvMagnitudeFast(const Vector4& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return _mm_cvtss_f32(SimdInvSqrtFast(SimdDot4(v, v)));}
+#endif
+//! @brief Approximates the reciprocal magnitude of a Vector3A structure
+//! @param vec The vector to find the reciprocal magnitude for
+//! @return [float] Approximation of 1 / Magnitude(vec)
+#if MATH_SIMD_SSE
+inline float InvMagnitudeFast(const Vector3A& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return _mm_cvtss_f32(SimdInvSqrtFast(SimdDot4(v, v)));}
+#else
+inline float InvMagnitudeFast(const Vector3A& vec) {return InvSqrtFast((vec.x*vec.x) + (vec.y*vec.y) + (vec.z*vec.z));}
+#endif
+//! @brief Approximately normalizes a Vector2, Vector3 or Vector4 structure
+//! @param vec The vector to normalize
+//! @return [VecN<float,N>] Vector of magnitude 1 within MATH_RSQRT_MAX_RELATIVE_ERROR
+template<int N>
+inline VecN<float, N> NormalizeFast(const VecN<float, N>& vec) {return (vec * InvMagnitudeFast(vec));}
+#if MATH_SIMD_SSE
+inline Vector4 NormalizeFast(const Vector4& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return SimdToVector4(_mm_mul_ps(v, SimdInvSqrtFast(SimdDot4(v, v))));}
+#endif
+//! @brief Approximately normalizes a Vector3A structure
+//! @param vec The vector to normalize
+//! @return [Vector3A] Vector of magnitude 1 within MATH_RSQRT_MAX_RELATIVE_ERROR
+#if MATH_SIMD_SSE
+inline Vector3A NormalizeFast(const Vector3A& vec)
+    {__m128 v = _mm_load_ps(&vec.x); return SimdToVector3A(_mm_mul_ps(v, SimdInvSqrtFast(SimdDot4(v, v))));}
+#else
+inline Vector3A NormalizeFast(const Vector3A& vec) {return (vec * InvMagnitudeFast(vec));}
+#endif
 
-// * * * * * SWAP * * * * * //
-/*!
- * @brief Swaps the values of two vectors
- * @param v1 First vector
- * @param v2 Second vector
- */
-inline void Swap(Vector2 *v1, Vector2 *v2)
-{
-    Vector2 tmp = *v1;
-    *v1 = *v2;
-    *v2 = tmp;
-}
-/*!
- * @brief Swaps the values of two vectors
- * @param v1 First vector
- * @param v2 Second vector
- */
-inline void Swap(Vector3 *v1, Vector3 *v2)
+// * * * * * PADDED CROSS PRODUCT * * * * * //
+
+//! @brief Generates the cross product between two Vector3A structures
+//! @param v1 First vector
+//! @param v2 Second vector
+//! @return [Vector3A] The cross product v1 x v2
+#if MATH_SIMD_SSE
+inline Vector3A CrossProduct(const Vector3A& v1, const Vector3A& v2)
 {
-    Vector3 tmp = *v1;
-    *v1 = *v2;
-    *v2 = tmp;
+    // (y1*z2 - z1*y2, z1*x2 - x1*z2, x1*y2 - y1*x2), the pad lane stays 0
+    __m128 a = _mm_load_ps(&v1.x);
+    __m128 b = _mm_load_ps(&v2.x);
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+    return SimdToVector3A(_mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1)));
 }
-/*!
- * @brief Swaps the values of two vectors
- * @param v1 First vector
- * @param v2 Second vector
- */
-inline void Swap(Vector4 *v1, Vector4 *v2)
+#else
+inline Vector3A CrossProduct(const Vector3A& v1, const Vector3A& v2)
 {
-    Vector4 tmp = *v1;
-    *v1 = *v2;
-    *v2 = tmp;
+    return (Vector3A(v1.y*v2.z - v1.z*v2.y,
+                     v1.z*v2.x - v1.x*v2.z,
+                     v1.x*v2.y - v1.y*v2.x));
 }
+#endif
+
+// * * * * * SWAP * * * * * //
+
+//! @note Swap for Vector2, Vector3 and Vector4 is the VecN template in Core.h
 
 //---------------------------------------------------------------------------------------------
 //                                          FUNCTIONS
 //---------------------------------------------------------------------------------------------
 
-// * * * * * 3D CROSS PRODUCT * * * * * //
-
-//! @class Vector3
-//! @brief Generates the cross product between two Vector3 structures
-//! @param v1 First vector
-//! @param v2 Second vector
-//! @return [Vector3] The cross product v1 x v2
-Vector3 CrossProduct(const Vector3& v1,const Vector3& v2);
-
 // * * * * * 3D SCALAR TRIPLE PRODUCT * * * * * //
 //! @brief Calculates the scalar triple product for three Vector3 structures
 //! @param v1 First vector
@@ -363,4 +330,51 @@ inline Vector3 Rejection(const Vector3& v1, const Vector3& v2) {return (v1 - Pro
 //! @param v2 Second vector
 //! @return [Vector4] v1 rejected onto v2
 //! @warning If v2 is a zero vector, this function will return an exception
-inline Vector4 Rejection(const Vector4& v1, const Vector4& v2) {return (v1 - Projection(v1, v2));}
\ No newline at end of file
+inline Vector4 Rejection(const Vector4& v1, const Vector4& v2) {return (v1 - Projection(v1, v2));}
+// * * * * * EXCEPTION-FREE VARIANTS * * * * * //
+
+//! @note The Try functions never throw or print. They report degenerate inputs through their
+//!       return value and write a defined result instead: a zero projection, a rejection equal
+//!       to v1 and an angle of 0. Valid results are the ones of the throwing functions.
+
+//! @brief Projects the first vector onto the second without throwing
+//! @param v1 First vector
+//! @param v2 Second vector
+//! @param out v1 projected onto v2, or the zero vector when v2 is a zero vector
+//! @return [bool] False if v2 is a zero vector (or too small for v2 * v2 to be non-zero)
+template<int N>
+inline bool TryProjection(const VecN<float, N>& v1, const VecN<float, N>& v2, VecN<float, N>& out) noexcept
+{
+    float d = v2 * v2;
+    if (!(d > 0.0f)) {out = VecN<float, N>::Zero(); return false;}
+    out = ((v1 * v2) / d) * v2;
+    return true;
+}
+//! @brief Rejects the first vector from the second without throwing
+//! @param v1 First vector
+//! @param v2 Second vector
+//! @param out v1 rejected from v2, or v1 when v2 is a zero vector
+//! @return [bool] False if v2 is a zero vector (or too small for v2 * v2 to be non-zero)
+template<int N>
+inline bool TryRejection(const VecN<float, N>& v1, const VecN<float, N>& v2, VecN<float, N>& out) noexcept
+{
+    VecN<float, N> p;
+    bool valid = TryProjection(v1, v2, p);
+    out = v1 - p;
+    return valid;
+}
+//! @brief Calculates the angle (in radians) between two vectors without throwing. The cosine is
+//!        clamped to [-1, 1], so nearly parallel vectors yield 0 or PI rather than NaN
+//! @param v1 The first vector
+//! @param v2 The second vector
+//! @param out Angle between the vectors, or 0 when the angle is undefined
+//! @return [bool] False if either vector is a zero vector or the magnitudes are not finite
+template<int N>
+inline bool TryAngle(const VecN<float, N>& v1, const VecN<float, N>& v2, float& out) noexcept
+{
+    float m = Magnitude(v1) * Magnitude(v2);
+    if (!(m > 0.0f && m < INFINITY)) {out = 0.0f; return false;}
+    float c = (v1 * v2) / m;
+    out = acos(c < -1.0f ? -1.0f : (c > 1.0f ? 1.0f : c));
+    return true;
+}
@@ -1,10 +1,25 @@
 #pragma once
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include "Math\Core.h"
 #include "Math\Vectors.h"
 #include "Math\Geometry.h"
 #include "Math\Matrices.h"
+#include "Math\SoA.h"
+#include "Math\Compression.h"
+#include "Math\Expressions.h"
+#include "Math\Packets.h"
+#include "Math\Rebase.h"
+#include "Math\Transforms.h"
+#include "Math\Dense.h"
+#include "Math\Hierarchy.h"
+#include "Math\Animation.h"
+#include "Math\Skinning.h"
+#include "Math\Kinematics.h"
+#include "Math\Curves.h"
 
 using namespace std;
 
@@ -318,6 +333,36 @@ public:
         b = &s;
         IS_EQUAL(a, b);
         counter.SetCount(a == b);
+        // Scalar layout: three packed floats
+        IS_EQUAL(sizeof(Vector3), 3*sizeof(float));
+        counter.SetCount(sizeof(Vector3) == 3*sizeof(float));
+        IS_EQUAL(&s[2], &s.x + 2);
+        counter.SetCount(&s[2] == &s.x + 2);
+        // Padded layout: 16 bytes, 16-byte aligned under SIMD, zero pad lane
+        Vector3A u(1.0f, 2.0f, 3.0f), v[2];
+        IS_EQUAL(sizeof(Vector3A), 16);
+        counter.SetCount(sizeof(Vector3A) == 16);
+#if MATH_SIMD_SSE
+        IS_EQUAL(alignof(Vector3A), 16);
+        counter.SetCount(alignof(Vector3A) == 16);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(&u) % 16, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(&u) % 16 == 0);
+#endif
+        IS_EQUAL(reinterpret_cast<uintptr_t>(&v[1]) - reinterpret_cast<uintptr_t>(&v[0]), 16);
+        counter.SetCount(reinterpret_cast<uintptr_t>(&v[1]) - reinterpret_cast<uintptr_t>(&v[0]) == 16);
+        IS_EQUAL(&u[2], &u.x + 2);
+        counter.SetCount(&u[2] == &u.x + 2);
+        IS_EQUAL(u.pad, 0.0f);
+        counter.SetCount(u.pad == 0.0f);
+        // A default-constructed vector filled component by component reduces like a constructed one
+        Vector3A w;
+        for (int i=0; i<3; i++) w[i] = u[i];
+        IS_EQUAL(w.pad, 0.0f);
+        counter.SetCount(w.pad == 0.0f);
+        IS_EQUAL(w*w, 14.0f);
+        counter.SetCount(w*w == 14.0f);
+        IS_EQUAL(u.ToVector3(), s);
+        counter.SetCount(u.ToVector3() == s);
         cout << "Testing of Vector3 memory placement complete!\n";
         pass = counter.GetCountPass();
         fail = counter.GetCountFail();
@@ -430,6 +475,69 @@ public:
         counter.SetCountClose(p.y, 18.0f/25.0f);
         IS_CLOSE(p.z, -3.0f/5.0f);
         counter.SetCountClose(p.z, -3.0f/5.0f);
+
+        // Padded Vector3A must agree with Vector3
+        Vector3A ta(t), xa(x);
+        IS_EQUAL((ta+xa).ToVector3(), t+x);
+        counter.SetCount((ta+xa).ToVector3() == t+x);
+        IS_EQUAL((ta-xa).ToVector3(), t-x);
+        counter.SetCount((ta-xa).ToVector3() == t-x);
+        IS_EQUAL((2.0f*ta).ToVector3(), 2.0f*t);
+        counter.SetCount((2.0f*ta).ToVector3() == 2.0f*t);
+        IS_EQUAL((ta/2.0f).ToVector3(), t/2.0f);
+        counter.SetCount((ta/2.0f).ToVector3() == t/2.0f);
+        IS_EQUAL((-ta).ToVector3(), -t);
+        counter.SetCount((-ta).ToVector3() == -t);
+        IS_EQUAL((ta*xa), (t*x));
+        counter.SetCount((ta*xa) == (t*x));
+        IS_CLOSE(Magnitude(ta), Magnitude(t));
+        counter.SetCountClose(Magnitude(ta), Magnitude(t));
+        IS_EQUAL(Normalize(ta).ToVector3(), Normalize(t));
+        counter.SetCount(Normalize(ta).ToVector3() == Normalize(t));
+        IS_EQUAL(CrossProduct(ta,xa).ToVector3(), CrossProduct(t,x));
+        counter.SetCount(CrossProduct(ta,xa).ToVector3() == CrossProduct(t,x));
+        IS_EQUAL(CrossProduct(ta,xa).pad, 0.0f);
+        counter.SetCount(CrossProduct(ta,xa).pad == 0.0f);
+
+        // Fast variants must stay within the documented error of the exact ones
+        float invErr = 0.0f, normErr = 0.0f, normErrA = 0.0f;
+        for (int i=1; i<=2000; i++)
+        {
+            float s = powf(10.0f, float(i % 13) - 6.0f);
+            Vector3 v(s*sinf(0.37f*i), s*cosf(1.13f*i), s*(0.5f - float(i % 7)/7.0f));
+            float e = 1.0f / Magnitude(v);
+            invErr = max(invErr, fabsf(InvMagnitudeFast(v) - e) / e);
+            normErr = max(normErr, Magnitude(NormalizeFast(v) - Normalize(v)));
+            normErrA = max(normErrA, Magnitude(NormalizeFast(Vector3A(v)).ToVector3() - Normalize(v)));
+        }
+        IS_TRUE(invErr <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        counter.SetCount(invErr <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        IS_TRUE(normErr <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        counter.SetCount(normErr <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        IS_TRUE(normErrA <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        counter.SetCount(normErrA <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+
+        // Exception-free variants: same results when valid, defined results otherwise
+        Vector3 zero(0.0f, 0.0f, 0.0f), r;
+        float angle = -1.0f;
+        IS_TRUE(TryProjection(t, x, r) && r == Projection(t, x));
+        counter.SetCount(TryProjection(t, x, r) && r == Projection(t, x));
+        IS_TRUE(TryRejection(t, x, r) && r == Rejection(t, x));
+        counter.SetCount(TryRejection(t, x, r) && r == Rejection(t, x));
+        IS_TRUE(TryAngle(t, x, angle) && angle == Angle(t, x));
+        counter.SetCount(TryAngle(t, x, angle) && angle == Angle(t, x));
+        IS_FALSE(TryProjection(t, zero, r)); counter.SetCount(!TryProjection(t, zero, r));
+        IS_EQUAL(r, zero); counter.SetCount(r == zero);
+        IS_FALSE(TryRejection(t, zero, r)); counter.SetCount(!TryRejection(t, zero, r));
+        IS_EQUAL(r, t); counter.SetCount(r == t);
+        IS_FALSE(TryAngle(zero, x, angle)); counter.SetCount(!TryAngle(zero, x, angle));
+        IS_EQUAL(angle, 0.0f); counter.SetCount(angle == 0.0f);
+        IS_FALSE(TryAngle(t, Vector3(INFINITY, 0.0f, 0.0f), angle));
+        counter.SetCount(!TryAngle(t, Vector3(INFINITY, 0.0f, 0.0f), angle));
+        // Rounding can push the cosine of parallel vectors past 1; the result is clamped, not NaN
+        Vector3 w(0.1f, 0.7f, 0.3f);
+        IS_TRUE(TryAngle(w, w*3.0f, angle) && angle >= 0.0f && angle < 1e-3f);
+        counter.SetCount(TryAngle(w, w*3.0f, angle) && angle >= 0.0f && angle < 1e-3f);
         cout << "Testing of Vector3 methods complete!\n";
         pass = counter.GetCountPass();
         fail = counter.GetCountFail();
@@ -519,6 +627,23 @@ public:
         b = &s;
         IS_EQUAL(a, b);
         counter.SetCount(a == b);
+        IS_EQUAL(sizeof(Vector4), 4*sizeof(float));
+        counter.SetCount(sizeof(Vector4) == 4*sizeof(float));
+        IS_EQUAL(&s[3], &s.x + 3);
+        counter.SetCount(&s[3] == &s.x + 3);
+#if MATH_SIMD_SSE
+        // SIMD layout: Vector4 and the columns of Matrix4 are loaded as aligned __m128
+        Matrix4 M;
+        IS_EQUAL(alignof(Vector4), 16);
+        counter.SetCount(alignof(Vector4) == 16);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(&t) % 16, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(&t) % 16 == 0);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(&M[1]) % 16, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(&M[1]) % 16 == 0);
+#else
+        IS_EQUAL(alignof(Vector4), alignof(float));
+        counter.SetCount(alignof(Vector4) == alignof(float));
+#endif
         cout << "Testing of Vector4 memory placement complete!\n";
         cout << "-Total Tests: " << to_string(counter.GetTotal()) << endl;
         cout << "-Tests Passed: " << to_string(counter.GetCountPass()) << endl;
@@ -590,6 +715,11 @@ public:
         counter.SetCountClose(n.z, 1.0f/sqrtf(10.0f));
         IS_CLOSE(n.w, 2.0f/sqrtf(10.0f));
         counter.SetCountClose(n.w, 2.0f/sqrtf(10.0f));
+        n = NormalizeFast(t);
+        IS_TRUE(Magnitude(n - Normalize(t)) <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        counter.SetCount(Magnitude(n - Normalize(t)) <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        IS_TRUE(fabsf(InvMagnitudeFast(t)*sqrtf(10.0f) - 1.0f) <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+        counter.SetCount(fabsf(InvMagnitudeFast(t)*sqrtf(10.0f) - 1.0f) <= MATH_RSQRT_MAX_RELATIVE_ERROR);
 
         Swap(&t, &x);
         IS_NOTEQUAL(t, Vector4(1.0f, 2.0f, 1.0f, 2.0f));
@@ -2264,6 +2394,14 @@ public:
         counter.SetCount(Adjugate(A) == Matrix3(-3.0f, 6.0f, -3.0f, 6.0f, -12.0f, 6.0f, -3.0f, 6.0f, -3.0f));
         IS_EQUAL(Cofactor(A), Transpose(Matrix3(-3.0f, 6.0f, -3.0f, 6.0f, -12.0f, 6.0f, -3.0f, 6.0f, -3.0f)));
         counter.SetCount(Cofactor(A) == Transpose(Matrix3(-3.0f, 6.0f, -3.0f, 6.0f, -12.0f, 6.0f, -3.0f, 6.0f, -3.0f)));
+        Matrix3 I3;
+        float d3;
+        IS_TRUE(TryInverse(B, I3, d3)); counter.SetCount(TryInverse(B, I3, d3));
+        IS_EQUAL(d3, 33.0f); counter.SetCount(d3 == 33.0f);
+        IS_EQUAL(I3, Inverse(B)); counter.SetCount(I3 == Inverse(B));
+        IS_FALSE(TryInverse(A, I3, d3)); counter.SetCount(!TryInverse(A, I3, d3));
+        IS_EQUAL(d3, 0.0f); counter.SetCount(d3 == 0.0f);
+        IS_EQUAL(I3, A.Zero()); counter.SetCount(I3 == A.Zero());
         IS_EQUAL(Scale(3.0f, 4.0f, 2.0f), Matrix3(3.0f, 0.0f, 0.0f, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 2.0f));
         counter.SetCount(Scale(3.0f, 4.0f, 2.0f) == Matrix3(3.0f, 0.0f, 0.0f, 0.0f, 4.0f, 0.0f, 0.0f, 0.0f, 2.0f));
 
@@ -2314,6 +2452,80 @@ public:
         IS_EQUAL(Involution(Vector3(1.0f, 2.0f, 3.0f)), R);
         counter.SetCount(Involution(Vector3(1.0f, 2.0f, 3.0f)) == R);
 
+        // Symmetric eigen decomposition: S = R*D*R^T with R a rotation and D sorted decreasingly
+        Matrix3 S(4.0f, 1.0f, -2.0f, 1.0f, 2.0f, 0.5f, -2.0f, 0.5f, 3.0f);
+        Vector3 d;
+        DiagonalizeSymmetric(S, R, d);
+        IS_EQUAL(R*Scale(d.x, d.y, d.z)*Transpose(R), S);
+        counter.SetCount(R*Scale(d.x, d.y, d.z)*Transpose(R) == S);
+        IS_TRUE(IsOrthogonal(R) && CloseFloat(Det(R), 1.0f));
+        counter.SetCount(IsOrthogonal(R) && CloseFloat(Det(R), 1.0f));
+        IS_TRUE(d.x >= d.y && d.y >= d.z && CloseFloat(d.x + d.y + d.z, 9.0f));
+        counter.SetCount(d.x >= d.y && d.y >= d.z && CloseFloat(d.x + d.y + d.z, 9.0f));
+        Quaternion qs;
+        DiagonalizeSymmetric(S, qs, d);
+        IS_EQUAL(qs.GetRotation(), R);
+        counter.SetCount(qs.GetRotation() == R);
+        // Only the symmetric part of the input is used
+        DiagonalizeSymmetric(S + Matrix3(0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 2.0f, 0.0f, -2.0f, 0.0f), R, d);
+        IS_EQUAL(R*Scale(d.x, d.y, d.z)*Transpose(R), S);
+        counter.SetCount(R*Scale(d.x, d.y, d.z)*Transpose(R) == S);
+        // Diagonal input is sorted by a signed permutation
+        DiagonalizeSymmetric(Scale(-1.0f, 5.0f, 2.0f), R, d);
+        IS_EQUAL(d, Vector3(5.0f, 2.0f, -1.0f)); counter.SetCount(d == Vector3(5.0f, 2.0f, -1.0f));
+        IS_TRUE(CloseFloat(Det(R), 1.0f) && CloseFloat(fabsf(R(1, 0)), 1.0f) && CloseFloat(fabsf(R(2, 1)), 1.0f));
+        counter.SetCount(CloseFloat(Det(R), 1.0f) && CloseFloat(fabsf(R(1, 0)), 1.0f) && CloseFloat(fabsf(R(2, 1)), 1.0f));
+        // Repeated eigenvalues, the zero matrix and a large magnitude
+        const Matrix3 Rr = RotateAboutAxis(0.7f, Vector3(1.0f, -2.0f, 0.5f));
+        S = Rr*Scale(3.0f, 3.0f, -1.0f)*Transpose(Rr);
+        DiagonalizeSymmetric(S, R, d);
+        IS_EQUAL(d, Vector3(3.0f, 3.0f, -1.0f)); counter.SetCount(d == Vector3(3.0f, 3.0f, -1.0f));
+        IS_TRUE(IsOrthogonal(R) && R*Scale(d.x, d.y, d.z)*Transpose(R) == S);
+        counter.SetCount(IsOrthogonal(R) && R*Scale(d.x, d.y, d.z)*Transpose(R) == S);
+        DiagonalizeSymmetric(Matrix3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f), R, d);
+        IS_TRUE(d == Vector3(0.0f, 0.0f, 0.0f) && R == R.Identity());
+        counter.SetCount(d == Vector3(0.0f, 0.0f, 0.0f) && R == R.Identity());
+        S = Rr*Scale(4.0e6f, -1.0e6f, 2.5e5f)*Transpose(Rr);
+        DiagonalizeSymmetric(S, R, d);
+        bool big = fabsf(d.x - 4.0e6f) < 4.0f && fabsf(d.y - 2.5e5f) < 4.0f && fabsf(d.z + 1.0e6f) < 4.0f && IsOrthogonal(R);
+        IS_TRUE(big); counter.SetCount(big);
+
+        // Singular value decomposition: M = U*Scale(sigma)*V^T with U and V rotations
+        Matrix3 U, V;
+        Vector3 sg;
+        SVD(B, U, sg, V);
+        IS_EQUAL(U*Scale(sg.x, sg.y, sg.z)*Transpose(V), B);
+        counter.SetCount(U*Scale(sg.x, sg.y, sg.z)*Transpose(V) == B);
+        IS_TRUE(IsOrthogonal(U) && IsOrthogonal(V) && CloseFloat(Det(U), 1.0f) && CloseFloat(Det(V), 1.0f));
+        counter.SetCount(IsOrthogonal(U) && IsOrthogonal(V) && CloseFloat(Det(U), 1.0f) && CloseFloat(Det(V), 1.0f));
+        IS_TRUE(sg.x >= sg.y && sg.y >= fabsf(sg.z) && CloseFloat(sg.x*sg.y*sg.z/Det(B), 1.0f));
+        counter.SetCount(sg.x >= sg.y && sg.y >= fabsf(sg.z) && CloseFloat(sg.x*sg.y*sg.z/Det(B), 1.0f));
+        Quaternion qu, qv;
+        SVD(B, qu, sg, qv);
+        IS_TRUE(qu.GetRotation() == U && qv.GetRotation() == V);
+        counter.SetCount(qu.GetRotation() == U && qv.GetRotation() == V);
+        // Mirrored: the reflection goes to sigma.z. Polar decomposition of a rotated scale
+        SVD(Rr*Scale(3.0f, -0.5f, 2.0f), U, sg, V);
+        IS_EQUAL(sg, Vector3(3.0f, 2.0f, -0.5f)); counter.SetCount(sg == Vector3(3.0f, 2.0f, -0.5f));
+        SVD(Rr*Scale(3.0f, 0.5f, 2.0f), U, sg, V);
+        IS_EQUAL(U*Transpose(V), Rr); counter.SetCount(U*Transpose(V) == Rr);
+        // Rank deficient, zero and ill-conditioned matrices
+        S = Matrix3(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, -1.0f, -2.0f, -3.0f);
+        SVD(S, U, sg, V);
+        IS_TRUE(CloseFloat(sg.x, sqrtf(84.0f)) && CloseFloat(sg.y, 0.0f) && U*Scale(sg.x, sg.y, sg.z)*Transpose(V) == S);
+        counter.SetCount(CloseFloat(sg.x, sqrtf(84.0f)) && CloseFloat(sg.y, 0.0f) && U*Scale(sg.x, sg.y, sg.z)*Transpose(V) == S);
+        SVD(Matrix3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f), U, sg, V);
+        IS_TRUE(sg == Vector3(0.0f, 0.0f, 0.0f) && U == U.Identity() && V == V.Identity());
+        counter.SetCount(sg == Vector3(0.0f, 0.0f, 0.0f) && U == U.Identity() && V == V.Identity());
+        const Matrix3 Rv = RotateAboutAxis(-1.1f, Vector3(0.5f, 1.0f, -2.0f));
+        SVD(Rr*Scale(1.0f, 1.0e-3f, 1.0e-6f)*Transpose(Rv), U, sg, V);
+        bool ill = fabsf(sg.x - 1.0f) < 3e-6f && fabsf(sg.y - 1.0e-3f) < 3e-6f && fabsf(sg.z - 1.0e-6f) < 3e-6f;
+        ill = ill && U*Scale(sg.x, sg.y, sg.z)*Transpose(V) == Rr*Scale(1.0f, 1.0e-3f, 1.0e-6f)*Transpose(Rv);
+        IS_TRUE(ill); counter.SetCount(ill);
+        SVD(1.0e20f*B, U, sg, V);
+        IS_TRUE(U*Scale(1.0e-20f*sg.x, 1.0e-20f*sg.y, 1.0e-20f*sg.z)*Transpose(V) == B);
+        counter.SetCount(U*Scale(1.0e-20f*sg.x, 1.0e-20f*sg.y, 1.0e-20f*sg.z)*Transpose(V) == B);
+
         Print("Testing Matrix3 methods complete!");
         Print("-Total Tests: " + to_string(counter.GetTotal()));
         Print("-Tests Passed: " + to_string(counter.GetCountPass()));
@@ -2583,16 +2795,29 @@ public:
         counter.SetCount(Cofactor(M) == M.Zero());
 
         R = Adjugate(A);
-        expectedR = (-1.0f)*Matrix4(104.0f, -12.000004f, -29.999998f, 211.99997f,
-                                    -455.0f, 460.99994f, -72.999985f, -518.99994f,
-                                    -757.0f, 432.99997f, -142.99999f, -568.99994f,
-                                    41.0f, -99.0f, 160.99997f, 115.000015f);
+        expectedR = (-1.0f)*Matrix4(104.0f, -12.0f, -30.0f, 212.0f,
+                                    -455.0f, 461.0f, -73.0f, -519.0f,
+                                    -757.0f, 433.0f, -143.0f, -569.0f,
+                                    41.0f, -99.0f, 161.0f, 115.0f);
 
         IS_EQUAL(R, expectedR);
         counter.SetCount(R == expectedR);
         R = Cofactor(A);
-        IS_EQUAL(R, Transpose(expectedR));
-        counter.SetCount(R == Transpose(expectedR));
+        Matrix4 expectedC = (-1.0f)*Transpose(Matrix4(104.0f, -12.0f, -30.0f, 212.0f,
+                                                      -455.0f, 461.0f, -73.0f, -519.0f,
+                                                      -757.0f, 433.0f, -143.0f, -569.0f,
+                                                      41.0f, -99.0f, 161.0f, 115.0f));
+        IS_EQUAL(R, expectedC);
+        counter.SetCount(R == expectedC);
+        float d4;
+        IS_TRUE(TryInverse(A, R, d4)); counter.SetCount(TryInverse(A, R, d4));
+        IS_EQUAL(d4, -1634.0f); counter.SetCount(d4 == -1634.0f);
+        IS_EQUAL(R, Inverse(A)); counter.SetCount(R == Inverse(A));
+        IS_FALSE(TryInverse(M, R, d4)); counter.SetCount(!TryInverse(M, R, d4));
+        IS_EQUAL(d4, 0.0f); counter.SetCount(d4 == 0.0f);
+        IS_EQUAL(R, M.Zero()); counter.SetCount(R == M.Zero());
+        // A determinant whose reciprocal overflows is reported as singular too
+        IS_FALSE(TryInverse(1e-12f*Matrix4::Identity(), R, d4)); counter.SetCount(!TryInverse(1e-12f*Matrix4::Identity(), R, d4));
         IS_EQUAL(Scale(3.0f, 2.0f, -3.0f, -2.0f), Matrix4(3.0f, 0.0f, 0.0f, 0.0f,
                                                             0.0f, 2.0f, 0.0f, 0.0f,
                                                             0.0f, 0.0f, -3.0f, 0.0f,
@@ -2626,6 +2851,39 @@ public:
         IS_EQUAL(R, -1.0f*expectedR);
         counter.SetCount(R == -1.0f*expectedR);
 
+        // Column kernels against the scalar definitions over a family of matrices. Without FMA the
+        // products are summed in the same order and match bit for bit
+        bool exact = true, close = true;
+        for (int n=0; n<16; n++)
+        {
+            Matrix4 P = Matrix4::Generate([&](int i, int j) {return float(((i*7 + j*3 + n*5) % 11) - 5) * (1.0f + 0.125f*n);});
+            Matrix4 Q = Matrix4::Generate([&](int i, int j) {return float(((i*3 + j*5 + n) % 7) - 3) * 0.5f;});
+            Vector4 u(1.5f - n, 0.25f*n, -2.0f, 3.0f);
+            Matrix4 PQ = P*Q, PT = Transpose(P), PC = Cofactor(P);
+            Vector4 Pu = P*u;
+            for (int i=0; i<4; i++)
+            {
+                float pu = P(i,0)*u.x + P(i,1)*u.y + P(i,2)*u.z + P(i,3)*u.w;
+                exact = exact && (Pu[i] == pu || MATH_SIMD_FMA);
+                close = close && fabsf(Pu[i] - pu) <= 1e-5f*fabsf(pu) + 1e-5f;
+                for (int j=0; j<4; j++)
+                {
+                    float pq = P(i,0)*Q(0,j) + P(i,1)*Q(1,j) + P(i,2)*Q(2,j) + P(i,3)*Q(3,j);
+                    exact = exact && (PQ(i,j) == pq || MATH_SIMD_FMA) && PT(i,j) == P(j,i);
+                    close = close && fabsf(PQ(i,j) - pq) <= 1e-5f*fabsf(pq) + 1e-5f;
+                    // Cofactor (i,j) from the 3x3 minor, computed in double
+                    int r[3], c[3];
+                    for (int k=0, a=0, b=0; k<4; k++) {if (k != i) r[a++] = k; if (k != j) c[b++] = k;}
+                    double minor = 0.0;
+                    for (int k=0; k<3; k++)
+                        minor += double(P(r[0],c[k])) * (double(P(r[1],c[(k+1)%3]))*P(r[2],c[(k+2)%3]) - double(P(r[1],c[(k+2)%3]))*P(r[2],c[(k+1)%3]));
+                    double cof = ((i + j) % 2 ? -minor : minor);
+                    close = close && fabs(PC(i,j) - cof) <= 1e-5*fabs(cof) + 1e-3;
+                }
+            }
+        }
+        IS_TRUE(exact); counter.SetCount(exact);
+        IS_TRUE(close); counter.SetCount(close);
 
 
         Print("Testing Matrix4 methods complete!");
@@ -3114,6 +3372,13 @@ struct TestTransform4
         A = copyA;
         IS_EQUAL(A*B, Transform4(-2.0f, 30.0f, -2.0f, 18.5f, -22.0f, 90.0f, -12.0f, 34.5f, -42.0f, 150.0f, -22.0f, 50.5f));
         counter.SetCount(A*B == Transform4(-2.0f, 30.0f, -2.0f, 18.5f, -22.0f, 90.0f, -12.0f, 34.5f, -42.0f, 150.0f, -22.0f, 50.5f));
+        Transform4 AB = A*B;
+        IS_EQUAL(AB.Row(3), Vector4(0.0f, 0.0f, 0.0f, 1.0f)); counter.SetCount(AB.Row(3) == Vector4(0.0f, 0.0f, 0.0f, 1.0f));
+        bool same = true;
+        for (int i=0; i<3; i++)
+            for (int j=0; j<4; j++)
+                same = same && (AB(i,j) == A(i,0)*B(0,j) + A(i,1)*B(1,j) + A(i,2)*B(2,j) + (j == 3 ? A(i,3) : 0.0f) || MATH_SIMD_FMA);
+        IS_TRUE(same); counter.SetCount(same);
         IS_EQUAL(A*v, Vector3(6.0f, 14.0f, 22.0f));
         counter.SetCount(A*v == Vector3(6.0f, 14.0f, 22.0f));
         IS_EQUAL(v*A, Vector3(18.0f, 20.0f, 22.0f));
@@ -3132,6 +3397,14 @@ struct TestTransform4
         counter.SetCount(Inverse(B) == Transform4(-0.0455882f, -0.00882353f, 0.160294f, -0.749265f,
                                                 0.0161765f, 0.0676471f, 0.104412f, -0.588971f,
                                                 -0.211765f, 0.0235294f, -0.0941176f, -0.835294f));
+        Transform4 IB;
+        float dB;
+        IS_TRUE(TryInverse(B, IB, dB)); counter.SetCount(TryInverse(B, IB, dB));
+        IS_EQUAL(IB, Inverse(B)); counter.SetCount(IB == Inverse(B));
+        IS_CLOSE(dB*(IB[0]*CrossProduct(IB[1], IB[2])), 1.0f); counter.SetCount(fabs(dB*(IB[0]*CrossProduct(IB[1], IB[2])) - 1.0f) < 1e-5);
+        IS_FALSE(TryInverse(Transform4(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 0.0f, 1.0f, 0.0f), IB, dB));
+        counter.SetCount(!TryInverse(Transform4(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 0.0f, 1.0f, 0.0f), IB, dB));
+        IS_EQUAL(IB, B.Zero()); counter.SetCount(IB == B.Zero());
         IS_EQUAL(Reflection(f), Transform4(0.724138f, -0.413793f, -0.551724f, -3.713907f,
                                             -0.413793f, 0.379310f, -0.827586f, -5.570860f,
                                             -0.551724f, -0.827586f, -0.103448f, -7.427814f));
@@ -3140,6 +3413,38 @@ struct TestTransform4
                                                     -0.551724f, -0.827586f, -0.103448f, -7.427814f));
         IS_EQUAL(TransformLine(L, B), Line(-13.0f, 26.5f, 4.0f, -119.0f, -56.0f, -313.25f));
         counter.SetCount(TransformLine(L, B) == Line(-13.0f, 26.5f, 4.0f, -119.0f, -56.0f, -313.25f));
+        // TRS round trips, mirrored ones included
+        Quaternion q = Normalize(Quaternion(0.2f, -0.4f, 0.3f, 0.8f)), rq;
+        Point3 t(1.0f, -2.0f, 3.0f), rt;
+        Vector3 sc(2.0f, 0.5f, 3.0f), rs;
+        Transform4 TRS = ComposeTRS(t, q, sc);
+        IS_EQUAL(TRS, Transform4(q.GetRotation()*Matrix3(2.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 3.0f), t));
+        counter.SetCount(TRS == Transform4(q.GetRotation()*Matrix3(2.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f, 3.0f), t));
+        IS_EQUAL(ComposeTRS(t, 2.0f*q, sc), TRS); counter.SetCount(ComposeTRS(t, 2.0f*q, sc) == TRS);
+        IS_TRUE(DecomposeTRS(TRS, rt, rq, rs)); counter.SetCount(DecomposeTRS(TRS, rt, rq, rs));
+        IS_EQUAL(rt, t); counter.SetCount(rt == t);
+        IS_EQUAL(rs, sc); counter.SetCount(rs == sc);
+        IS_TRUE(rq == q || rq == -1.0f*q); counter.SetCount(rq == q || rq == -1.0f*q);
+        Transform4 mirror = ComposeTRS(t, q, Vector3(2.0f, -0.5f, 3.0f));
+        IS_TRUE(DecomposeTRS(mirror, rt, rq, rs)); counter.SetCount(DecomposeTRS(mirror, rt, rq, rs));
+        IS_EQUAL(rs, Vector3(-2.0f, 0.5f, 3.0f)); counter.SetCount(rs == Vector3(-2.0f, 0.5f, 3.0f));
+        IS_EQUAL(ComposeTRS(rt, rq, rs), mirror); counter.SetCount(ComposeTRS(rt, rq, rs) == mirror);
+        IS_CLOSE(rq.Magnitude(), 1.0f); counter.SetCount(fabs(rq.Magnitude() - 1.0f) < 1e-6);
+        // Large scale ratios still converge
+        Transform4 thin = ComposeTRS(t, q, Vector3(1000.0f, 0.01f, 1.0f));
+        bool ok = DecomposeTRS(thin, rt, rq, rs) && fabsf(rs.x - 1000.0f) < 1e-2f && fabsf(rs.y - 0.01f) < 1e-5f && (rq == q || rq == -1.0f*q);
+        IS_TRUE(ok); counter.SetCount(ok);
+        // A sheared transform yields the nearest rotation
+        Transform4 shear(1.0f, 0.5f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+        DecomposeTRS(shear, rt, rq, rs);
+        Matrix3 R = rq.GetRotation();
+        IS_EQUAL(Transpose(R)*R, Matrix3::Identity()); counter.SetCount(Transpose(R)*R == Matrix3::Identity());
+        IS_TRUE(fabsf(R(0,1) + R(1,0)) < 1e-6f && R(1,0) < 0.0f); counter.SetCount(fabsf(R(0,1) + R(1,0)) < 1e-6f && R(1,0) < 0.0f);
+        // Zero scale
+        IS_FALSE(DecomposeTRS(ComposeTRS(t, q, Vector3(2.0f, 0.0f, 3.0f)), rt, rq, rs));
+        counter.SetCount(!DecomposeTRS(ComposeTRS(t, q, Vector3(2.0f, 0.0f, 3.0f)), rt, rq, rs));
+        IS_EQUAL(rq, Quaternion(0.0f, 0.0f, 0.0f, 1.0f)); counter.SetCount(rq == Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        IS_EQUAL(rs, Vector3(2.0f, 0.0f, 3.0f)); counter.SetCount(rs == Vector3(2.0f, 0.0f, 3.0f));
 
 
         Print("Testing Transform4 methods complete!");
@@ -3306,8 +3611,76 @@ struct TestQuaternion
         counter.SetCount(p*q == Quaternion(23.0f, -27.0f, -11.0f, 31.0f));
 
         Vector3 v(3.0f, -1.0f, 2.0f);
-        IS_EQUAL(Transform(v, p), Vector3(182.0f, -194.0f, 176.0f));
-        counter.SetCount(Transform(v, p) == Vector3(182.0f, -194.0f, 176.0f));
+        IS_EQUAL(Transform(v, p), Vector3(-254.0f, -52.0f, -134.0f));
+        counter.SetCount(Transform(v, p) == Vector3(-254.0f, -52.0f, -134.0f));
+        UnitQuaternion up(p);
+        IS_TRUE(Transform(v, up) == up.GetRotation()*v && Transform(v, up) == Transform(v, p)/(p.Magnitude()*p.Magnitude()));
+        counter.SetCount(Transform(v, up) == up.GetRotation()*v && Transform(v, up) == Transform(v, p)/(p.Magnitude()*p.Magnitude()));
+
+        // Unit quaternions: one rotation per SetRotation() case, the largest component positive
+        UnitQuaternion id;
+        IS_TRUE(id == Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        counter.SetCount(id == Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        UnitQuaternion u(q);
+        IS_TRUE(CloseFloat(u.Magnitude(), 1.0f) && u == Normalize(q));
+        counter.SetCount(CloseFloat(u.Magnitude(), 1.0f) && u == Normalize(q));
+        const UnitQuaternion cases[4] = {UnitQuaternion(Quaternion(0.2f, -0.3f, 0.1f, 0.9f)),
+            UnitQuaternion(Quaternion(0.9f, 0.2f, -0.3f, 0.1f)), UnitQuaternion(Quaternion(-0.1f, 0.9f, 0.3f, 0.2f)),
+            UnitQuaternion(Quaternion(0.3f, 0.1f, 0.9f, -0.2f))};
+        for (int i=0; i<4; i++)
+        {
+            Quaternion general = cases[i];
+            const Matrix3 R = cases[i].GetRotation();
+            IS_TRUE(R == general.GetRotation());
+            counter.SetCount(R == general.GetRotation());
+            IS_TRUE(UnitQuaternion(R) == cases[i]);
+            counter.SetCount(UnitQuaternion(R) == cases[i]);
+            Quaternion fromR;
+            fromR.SetRotation(R);
+            IS_TRUE(UnitQuaternion(R) == fromR);
+            counter.SetCount(UnitQuaternion(R) == fromR);
+            IS_TRUE(fabsf(UnitQuaternion(R).Magnitude() - 1.0f) < 1e-6f);
+            counter.SetCount(fabsf(UnitQuaternion(R).Magnitude() - 1.0f) < 1e-6f);
+        }
+        const UnitQuaternion uv = cases[0]*cases[1];
+        IS_TRUE(uv == Quaternion(cases[0])*Quaternion(cases[1]));
+        counter.SetCount(uv == Quaternion(cases[0])*Quaternion(cases[1]));
+        IS_TRUE(uv.GetRotation() == cases[0].GetRotation()*cases[1].GetRotation());
+        counter.SetCount(uv.GetRotation() == cases[0].GetRotation()*cases[1].GetRotation());
+        IS_TRUE(cases[2]*Inverse(cases[2]) == id);
+        counter.SetCount(cases[2]*Inverse(cases[2]) == id);
+
+        // Interpolation: a quarter turn about z blends to an eighth turn, either sign of b
+        const float h = sqrtf(0.5f);
+        const Quaternion qa(0.0f, 0.0f, 0.0f, 1.0f), qb(0.0f, 0.0f, h, h);
+        const Quaternion eighth(0.0f, 0.0f, sinf(0.125f*PI), cosf(0.125f*PI));
+        IS_TRUE(Slerp(qa, qb, 0.5f) == eighth && Slerp(qa, -1.0f*qb, 0.5f) == eighth);
+        counter.SetCount(Slerp(qa, qb, 0.5f) == eighth && Slerp(qa, -1.0f*qb, 0.5f) == eighth);
+        IS_TRUE(Nlerp(qa, qb, 0.5f) == eighth && SlerpFast(qa, qb, 0.5f) == eighth);
+        counter.SetCount(Nlerp(qa, qb, 0.5f) == eighth && SlerpFast(qa, qb, 0.5f) == eighth);
+        IS_TRUE(Slerp(qa, qb, 0.0f) == qa && Slerp(qa, qb, 1.0f) == qb);
+        counter.SetCount(Slerp(qa, qb, 0.0f) == qa && Slerp(qa, qb, 1.0f) == qb);
+        IS_TRUE(SlerpFast(qa, qb, 0.0f) == qa && SlerpFast(qa, qb, 1.0f) == qb);
+        counter.SetCount(SlerpFast(qa, qb, 0.0f) == qa && SlerpFast(qa, qb, 1.0f) == qb);
+        const Quaternion third(0.0f, 0.0f, sinf(PI/12.0f), cosf(PI/12.0f));
+        IS_TRUE(Slerp(qa, qb, 1.0f/3.0f) == third && !(Nlerp(qa, qb, 1.0f/3.0f) == third));
+        counter.SetCount(Slerp(qa, qb, 1.0f/3.0f) == third && !(Nlerp(qa, qb, 1.0f/3.0f) == third));
+        IS_TRUE(Slerp(qa, qa, 0.3f) == qa);
+        counter.SetCount(Slerp(qa, qa, 0.3f) == qa);
+        // The documented bound of SlerpFast(), over angles up to a half turn and the whole range of t
+        const Vector3 axis = Normalize(Vector3(0.3f, -0.5f, 0.8f));
+        float worst = 0.0f;
+        for (int i=0; i<=64; i++)
+        {
+            const float angle = PI*i/64.0f;
+            const Quaternion qd = Quaternion(sinf(0.5f*angle)*axis, cosf(0.5f*angle))*cases[0];
+            for (int j=0; j<=32; j++)
+            {
+                const Quaternion e = SlerpFast(cases[0], qd, j/32.0f) - Slerp(cases[0], qd, j/32.0f);
+                worst = fmaxf(worst, fmaxf(fmaxf(fabsf(e.x), fabsf(e.y)), fmaxf(fabsf(e.z), fabsf(e.w))));
+            }
+        }
+        IS_LESS(worst, 4e-5f); counter.SetCount(worst < 4e-5f);
 
         Print("Testing Quaternion methods complete!");
         Print("-Total Tests: " + to_string(counter.GetTotal()));
@@ -3335,4 +3708,2394 @@ struct TestQuaternion
         counter.ResetAccumulator();
         cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
     }
-};
\ No newline at end of file
+};
+struct TestCore
+{
+    Counter counter;
+    // Constant expressions: these fail to compile if the templates stop folding
+    static constexpr Vector3 a = Vector3(1.0f, 2.0f, 3.0f);
+    static constexpr Vector3 b = Vector3(4.0f, 5.0f, 6.0f);
+    static constexpr Vector4 c = Vector4(1.0f, 2.0f, 3.0f, 4.0f);
+    static constexpr Matrix3 R = Matrix3::RotationZ(0.0f, 1.0f);
+    static constexpr Matrix4 I = Matrix4::Identity();
+    static_assert(a + b == Vector3(5.0f, 7.0f, 9.0f), "constexpr Vector3 addition");
+    static_assert(InnerProduct(a, b) == 32.0f, "constexpr inner product");
+    static_assert(CrossProduct(a, b) == Vector3(-3.0f, 6.0f, -3.0f), "constexpr cross product");
+    static_assert((c*2.0f - c) == c, "constexpr Vector4 arithmetic");
+    static_assert(I*c == c, "constexpr Matrix4 identity");
+    static_assert(R*Vector3(1.0f, 0.0f, 0.0f) == Vector3(0.0f, 1.0f, 0.0f), "constexpr axis rotation");
+    static_assert(Transpose(R)*R == Matrix3::Identity(), "constexpr matrix product");
+    static_assert(Trace(Matrix3::Identity()) == 3.0f, "constexpr trace");
+    static_assert(Vector3i(7, 8, 9) / 2 == Vector3i(3, 4, 4), "constexpr integer division");
+
+    void Initialize(void)
+    {
+        Print("Testing VecN/Mat initialization...");
+
+        Vector3d d(1.0, 2.0, 3.0);
+        IS_EQUAL(d.z, 3.0); counter.SetCount(d.z == 3.0);
+        Vector4i v(1, 2, 3, 4);
+        IS_EQUAL(v.w, 4); counter.SetCount(v.w == 4);
+        IS_EQUAL(Vector2d::Zero(), Vector2d(0.0, 0.0)); counter.SetCount(Vector2d::Zero() == Vector2d(0.0, 0.0));
+        Matrix3x4 A(1.0f, 2.0f, 3.0f, 4.0f,
+                    5.0f, 6.0f, 7.0f, 8.0f,
+                    9.0f, 10.0f, 11.0f, 12.0f);
+        IS_EQUAL(A(1,3), 8.0f); counter.SetCount(A(1,3) == 8.0f);
+        IS_EQUAL(A[3], Vector3(4.0f, 8.0f, 12.0f)); counter.SetCount(A[3] == Vector3(4.0f, 8.0f, 12.0f));
+        Matrix3x4 B(Vector3(1.0f, 5.0f, 9.0f), Vector3(2.0f, 6.0f, 10.0f), Vector3(3.0f, 7.0f, 11.0f), Vector3(4.0f, 8.0f, 12.0f));
+        IS_EQUAL(A, B); counter.SetCount(A == B);
+        IS_EQUAL(Matrix4d::Identity()(2,2), 1.0); counter.SetCount(Matrix4d::Identity()(2,2) == 1.0);
+        IS_EQUAL(Matrix4d::Identity()(2,1), 0.0); counter.SetCount(Matrix4d::Identity()(2,1) == 0.0);
+        IS_EQUAL(I, Matrix4().Identity()); counter.SetCount(I == Matrix4().Identity());
+
+        Print("Testing VecN/Mat initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing VecN/Mat memory placement...");
+
+        IS_EQUAL(sizeof(Vector3d), 3*sizeof(double)); counter.SetCount(sizeof(Vector3d) == 3*sizeof(double));
+        IS_EQUAL(sizeof(Vector4i), 4*sizeof(int32_t)); counter.SetCount(sizeof(Vector4i) == 4*sizeof(int32_t));
+        IS_EQUAL(sizeof(Matrix3x4), 12*sizeof(float)); counter.SetCount(sizeof(Matrix3x4) == 12*sizeof(float));
+        IS_EQUAL(sizeof(Matrix4d), 16*sizeof(double)); counter.SetCount(sizeof(Matrix4d) == 16*sizeof(double));
+        IS_TRUE(is_trivially_copyable<Vector3>::value); counter.SetCount(is_trivially_copyable<Vector3>::value);
+        IS_TRUE(is_trivially_copyable<Matrix4>::value); counter.SetCount(is_trivially_copyable<Matrix4>::value);
+        IS_TRUE(is_standard_layout<Vector4>::value); counter.SetCount(is_standard_layout<Vector4>::value);
+        Matrix3x4 A = Matrix3x4::Zero();
+        IS_EQUAL(reinterpret_cast<const float *>(&A[3]) - reinterpret_cast<const float *>(&A), 9);
+        counter.SetCount(reinterpret_cast<const float *>(&A[3]) - reinterpret_cast<const float *>(&A) == 9);
+
+        Print("Testing VecN/Mat memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing VecN/Mat methods...");
+
+        // Runtime results must match the folded constants
+        Vector3 x = a, y = b;
+        IS_EQUAL(x + y, Vector3(5.0f, 7.0f, 9.0f)); counter.SetCount(x + y == Vector3(5.0f, 7.0f, 9.0f));
+        IS_EQUAL(CrossProduct(x, y), CrossProduct(a, b)); counter.SetCount(CrossProduct(x, y) == CrossProduct(a, b));
+        Vector4 w = c;
+        w *= 2.0f;
+        IS_EQUAL(w - c, c); counter.SetCount(w - c == c);
+
+        // Double and integer instantiations
+        Vector3d d(3.0, 4.0, 12.0);
+        IS_EQUAL(Magnitude(d), 13.0); counter.SetCount(Magnitude(d) == 13.0);
+        IS_TRUE(fabs(Magnitude(Normalize(d)) - 1.0) < 1e-15); counter.SetCount(fabs(Magnitude(Normalize(d)) - 1.0) < 1e-15);
+        Vector3i n(1, 2, 3), m(4, 5, 6);
+        IS_EQUAL(n*m, 32); counter.SetCount(n*m == 32);
+        IS_EQUAL(CrossProduct(n, m), Vector3i(-3, 6, -3)); counter.SetCount(CrossProduct(n, m) == Vector3i(-3, 6, -3));
+        Matrix3i P(0, -1, 0, 1, 0, 0, 0, 0, 1);
+        IS_EQUAL(P*P*n, Vector3i(-1, -2, 3)); counter.SetCount(P*P*n == Vector3i(-1, -2, 3));
+
+        // Affine 3x4 storage against the full Transform4
+        Transform4 T(1.0f, 0.0f, 0.0f, 1.0f,
+                     0.0f, 0.0f, -1.0f, 2.0f,
+                     0.0f, 1.0f, 0.0f, 3.0f);
+        Matrix3x4 A = Matrix3x4::Generate([&](int i, int j) {return T(i,j);});
+        Point3 p(1.0f, 2.0f, 3.0f);
+        Vector3 q = A*Vector4(p.x, p.y, p.z, 1.0f);
+        Vector4 r = T*Vector4(p.x, p.y, p.z, 1.0f);
+        IS_EQUAL(q, Vector3(r.x, r.y, r.z)); counter.SetCount(q == Vector3(r.x, r.y, r.z));
+        IS_EQUAL(q, Vector3(2.0f, -1.0f, 5.0f)); counter.SetCount(q == Vector3(2.0f, -1.0f, 5.0f));
+        Mat<float, 4, 3> At = Transpose(A);
+        IS_EQUAL(At(3,1), 2.0f); counter.SetCount(At(3,1) == 2.0f);
+
+        // Axis rotations agree with the angle based functions
+        float t = 0.7f;
+        IS_EQUAL(RotateAboutX(t), Matrix3::RotationX(cosf(t), sinf(t))); counter.SetCount(RotateAboutX(t) == Matrix3::RotationX(cosf(t), sinf(t)));
+        IS_EQUAL(RotateAboutY(t), Matrix3::RotationY(cosf(t), sinf(t))); counter.SetCount(RotateAboutY(t) == Matrix3::RotationY(cosf(t), sinf(t)));
+        Matrix3d Rd = Matrix3d::RotationZ(cos(0.7), sin(0.7));
+        IS_TRUE(IsOrthogonal(RotateAboutZ(t))); counter.SetCount(IsOrthogonal(RotateAboutZ(t)));
+        IS_EQUAL(Transpose(Rd)*Rd, Matrix3d::Identity()); counter.SetCount(Transpose(Rd)*Rd == Matrix3d::Identity());
+
+        Print("Testing VecN/Mat methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "           VECN/MAT UNIT TESTING          " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "      ALL VECN/MAT TESTS HAVE FINISHED      " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestExpressions
+{
+    Counter counter;
+    //! True when two objects hold exactly the same bits
+    template<typename T> bool SameBits(const T& a, const T& b) {return memcmp(&a, &b, sizeof(T)) == 0;}
+    void Methods(void)
+    {
+        Print("Testing lazy expressions...");
+
+        // Vector chains against the eager operators, bit for bit
+        Vector3 a(1.5f, -2.25f, 3.1f), b(0.3f, 7.0f, -1.7f), c(-4.2f, 0.01f, 9.9f);
+        float s = 0.7f, t = 3.0f;
+        Vector3 e3 = a - b*s + (c + a)/t - (-b) + s*c;
+        Vector3 l3 = Eval(Lazy(a) - Lazy(b)*s + (Lazy(c) + a)/t - (-Lazy(b)) + s*Lazy(c));
+        IS_TRUE(SameBits(e3, l3)); counter.SetCount(SameBits(e3, l3));
+        Vector3 ex = CrossProduct(a - b, c)*t + CrossProduct(a, b);
+        Vector3 lx = Eval(CrossProduct(Lazy(a) - b, Lazy(c))*t + CrossProduct(Lazy(a), Lazy(b)));
+        IS_TRUE(SameBits(ex, lx)); counter.SetCount(SameBits(ex, lx));
+        float ed = (a - b)*(c + b), ld = (Lazy(a) - b)*(Lazy(c) + b);
+        IS_TRUE(SameBits(ed, ld)); counter.SetCount(SameBits(ed, ld));
+
+        // Vector4 runs the eager operators on SSE registers, including 0 - x negation
+        Vector4 p(1.5f, 0.0f, -3.5f, 2.2f), q(0.25f, -0.0f, 8.0f, -1.1f);
+        Vector4 e4 = -(p - q*s)/t + (-q);
+        Vector4 l4 = Eval(-(Lazy(p) - Lazy(q)*s)/t + (-Lazy(q)));
+        IS_TRUE(SameBits(e4, l4)); counter.SetCount(SameBits(e4, l4));
+        float e4d = (p - q)*(p + q), l4d = (Lazy(p) - q)*(Lazy(p) + q);
+        IS_TRUE(SameBits(e4d, l4d)); counter.SetCount(SameBits(e4d, l4d));
+
+        // Other instantiations
+        Vector3d ad(1.0, 2.0, 3.0), bd(-0.1, 0.2, 0.3);
+        IS_TRUE(SameBits(ad/3.0 - bd*7.0, Eval(Lazy(ad)/3.0 - Lazy(bd)*7.0)));
+        counter.SetCount(SameBits(ad/3.0 - bd*7.0, Eval(Lazy(ad)/3.0 - Lazy(bd)*7.0)));
+        Vector3i ai(7, -9, 12), bi(2, 3, -5);
+        IS_EQUAL(Eval((Lazy(ai) + bi)/2 - Lazy(bi)*3), (ai + bi)/2 - bi*3);
+        counter.SetCount(Eval((Lazy(ai) + bi)/2 - Lazy(bi)*3) == (ai + bi)/2 - bi*3);
+
+        // Rejection and the quaternion rotation built from lazy expressions
+        Vector3 r = Eval(Lazy(a) - Lazy(b)*((a*b)/(b*b)));
+        IS_TRUE(SameBits(r, Rejection(a, b))); counter.SetCount(SameBits(r, Rejection(a, b)));
+        Quaternion qt(0.2f, -0.4f, 0.1f, 0.87f);
+        Vector3 u = qt.GetVector();
+        float uDotU = u.x*u.x + u.y*u.y + u.z*u.z;
+        Vector3 rot = c*(qt.w*qt.w - uDotU) + u*(u*c)*2.0f + CrossProduct(u, c)*qt.w*2.0f;
+        IS_TRUE(SameBits(rot, Transform(c, qt))); counter.SetCount(SameBits(rot, Transform(c, qt)));
+
+        // Matrix chains
+        Matrix3 A(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 10.0f);
+        Matrix3 B(0.5f, -1.0f, 0.25f, 3.0f, 0.1f, -2.0f, 1.0f, 1.0f, 1.0f);
+        Matrix3 E = A + B*s - (-A)/t;
+        Matrix3 L = Eval(Lazy(A) + Lazy(B)*s - (-Lazy(A))/t);
+        IS_TRUE(SameBits(E, L)); counter.SetCount(SameBits(E, L));
+        Vector3 ev = (A - B)*(a + b), lv = Eval((Lazy(A) - B)*(Lazy(a) + b));
+        IS_TRUE(SameBits(ev, lv)); counter.SetCount(SameBits(ev, lv));
+        // General matrices and vectors, whose products round, so that a fused multiply-add in
+        // the SSE path alone would show
+        bool same = true;
+        for (int i=0; i<1000; i++)
+        {
+            const Matrix4 M = Matrix4::Generate([&](int r, int c) {return sinf(1.7f*i + 3.1f*r + 0.37f*c);});
+            const Vector4 v(cosf(0.9f*i), sinf(2.3f*i + 1.0f), 1.0f/(1.5f + sinf(0.7f*i)), cosf(0.3f*i)*3.3f);
+            const Vector4 ev4 = M*v + q, lv4 = Eval(Lazy(M)*v + q);
+            const Vector4 sv4(M(0,0)*v.x + M(0,1)*v.y + M(0,2)*v.z + M(0,3)*v.w, M(1,0)*v.x + M(1,1)*v.y + M(1,2)*v.z + M(1,3)*v.w,
+                              M(2,0)*v.x + M(2,1)*v.y + M(2,2)*v.z + M(2,3)*v.w, M(3,0)*v.x + M(3,1)*v.y + M(3,2)*v.z + M(3,3)*v.w);
+            same = same && SameBits(ev4, lv4) && SameBits(M*v, sv4);
+        }
+        IS_TRUE(same); counter.SetCount(same);
+
+        Print("Testing lazy expressions complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "          EXPRESSION UNIT TESTING        " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "    ALL EXPRESSION TESTS HAVE FINISHED   " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+
+struct TestSoA
+{
+    Counter counter;
+    //! Deterministic, non-trivial test vectors (no zero vectors)
+    Vector3 Sample(int i) {return Vector3(1.0f + 0.5f*i, 2.0f - 0.25f*i, -3.0f + 0.125f*i*i);}
+    void Initialize(void)
+    {
+        Print("Testing SoA initialization...");
+
+        SoA<Vector3> a;
+        IS_EQUAL(a.Size(), 0); counter.SetCount(a.Size() == 0);
+        IS_EQUAL(a.Capacity(), 0); counter.SetCount(a.Capacity() == 0);
+
+        SoA<Vector3> b(13);
+        IS_EQUAL(b.Size(), 13); counter.SetCount(b.Size() == 13);
+        IS_EQUAL(b.Capacity() % MATH_BATCH_WIDTH, 0); counter.SetCount(b.Capacity() % MATH_BATCH_WIDTH == 0);
+
+        vector<Vector3> v;
+        for (int i=0; i<11; i++) v.push_back(Sample(i));
+        SoA<Vector3> c(v);
+        IS_EQUAL(c.Size(), 11); counter.SetCount(c.Size() == 11);
+        IS_EQUAL(c.Get(7), v[7]); counter.SetCount(c.Get(7) == v[7]);
+        vector<Vector3> w = c.ToVector();
+        bool same = (w.size() == v.size());
+        for (size_t i=0; same && i<v.size(); i++) same = (w[i] == v[i]);
+        IS_TRUE(same); counter.SetCount(same);
+
+        Print("Testing SoA initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void ValueChange(void)
+    {
+        Print("Testing SoA value change...");
+
+        SoA<Vector3> a;
+        for (int i=0; i<20; i++) a.PushBack(Sample(i));
+        IS_EQUAL(a.Size(), 20); counter.SetCount(a.Size() == 20);
+        IS_EQUAL(a.Get(19), Sample(19)); counter.SetCount(a.Get(19) == Sample(19));
+        IS_EQUAL(a.Get(0), Sample(0)); counter.SetCount(a.Get(0) == Sample(0));
+        a.Set(3, Vector3(9.0f, 8.0f, 7.0f));
+        IS_EQUAL(a.X()[3], 9.0f); counter.SetCount(a.X()[3] == 9.0f);
+        IS_EQUAL(a.Y()[3], 8.0f); counter.SetCount(a.Y()[3] == 8.0f);
+        IS_EQUAL(a.Z()[3], 7.0f); counter.SetCount(a.Z()[3] == 7.0f);
+
+        SoA<Vector3> b = a;
+        b.Z()[3] = -1.0f;
+        IS_EQUAL(a.Get(3), Vector3(9.0f, 8.0f, 7.0f)); counter.SetCount(a.Get(3) == Vector3(9.0f, 8.0f, 7.0f));
+        IS_EQUAL(b.Get(3), Vector3(9.0f, 8.0f, -1.0f)); counter.SetCount(b.Get(3) == Vector3(9.0f, 8.0f, -1.0f));
+
+        // Geometry.h and Matrices.h structures
+        SoA<Plane> f;
+        f.PushBack(Plane(1.0f, 2.0f, 3.0f, 4.0f));
+        IS_EQUAL(f.Get(0), Plane(1.0f, 2.0f, 3.0f, 4.0f)); counter.SetCount(f.Get(0) == Plane(1.0f, 2.0f, 3.0f, 4.0f));
+        IS_EQUAL(f.W()[0], 4.0f); counter.SetCount(f.W()[0] == 4.0f);
+        SoA<Quaternion> q;
+        q.PushBack(Quaternion(1.0f, 2.0f, 3.0f, 4.0f));
+        IS_EQUAL(q.Get(0), Quaternion(1.0f, 2.0f, 3.0f, 4.0f)); counter.SetCount(q.Get(0) == Quaternion(1.0f, 2.0f, 3.0f, 4.0f));
+        Matrix4 M(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+        SoA<Matrix4> m;
+        m.PushBack(M.Identity());
+        m.PushBack(M);
+        IS_EQUAL(m.Get(1), M); counter.SetCount(m.Get(1) == M);
+        IS_EQUAL(m.Stream(1)[1], M(1,0)); counter.SetCount(m.Stream(1)[1] == M(1,0));
+        SoA<Point3> p;
+        p.PushBack(Point3(1.0f, 2.0f, 3.0f));
+        IS_EQUAL(p.Span().As<Vector3>().Get(0), Vector3(1.0f, 2.0f, 3.0f));
+        counter.SetCount(p.Span().As<Vector3>().Get(0) == Vector3(1.0f, 2.0f, 3.0f));
+
+        Print("Testing SoA value change complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing SoA memory placement...");
+
+        SoA<Vector3> a(21);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(a.X()) % MATH_BATCH_ALIGNMENT, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(a.X()) % MATH_BATCH_ALIGNMENT == 0);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(a.Y()) % MATH_BATCH_ALIGNMENT, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(a.Y()) % MATH_BATCH_ALIGNMENT == 0);
+        IS_EQUAL(reinterpret_cast<uintptr_t>(a.Z()) % MATH_BATCH_ALIGNMENT, 0);
+        counter.SetCount(reinterpret_cast<uintptr_t>(a.Z()) % MATH_BATCH_ALIGNMENT == 0);
+        IS_EQUAL(a.Y() - a.X(), a.Capacity()); counter.SetCount(a.Y() - a.X() == a.Capacity());
+        SoASpan<Vector3> s = a.Span().Sub(8, 4);
+        IS_EQUAL(s[2], a.Z() + 8); counter.SetCount(s[2] == a.Z() + 8);
+        IS_EQUAL(s.count, 4); counter.SetCount(s.count == 4);
+        IS_EQUAL(SoATraits<Matrix4>::Components, 16); counter.SetCount(SoATraits<Matrix4>::Components == 16);
+        IS_EQUAL(SoATraits<Point3>::Components, 3); counter.SetCount(SoATraits<Point3>::Components == 3);
+
+        Print("Testing SoA memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing SoA batch methods...");
+
+        // 19 elements: two full packets and a scalar tail
+        const int n = 19;
+        SoA<Vector3> a(n), b(n), out(n);
+        float f[n];
+        for (int i=0; i<n; i++) {a.Set(i, Sample(i)); b.Set(i, Sample(n - i) + Vector3(0.5f, 0.0f, 1.0f));}
+
+        bool ok = true;
+        InnerProduct(a, b, f);
+        for (int i=0; i<n; i++) ok = ok && CloseFloat(f[i], a.Get(i)*b.Get(i));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        ok = true;
+        CrossProduct(a, b, out);
+        for (int i=0; i<n; i++) ok = ok && (out.Get(i) == CrossProduct(a.Get(i), b.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        ok = true;
+        Magnitude(a, f);
+        for (int i=0; i<n; i++) ok = ok && CloseFloat(f[i], Magnitude(a.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        ok = true;
+        Normalize(a, out);
+        for (int i=0; i<n; i++) ok = ok && (out.Get(i) == Normalize(a.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        ok = true;
+        Projection(a, b, out);
+        for (int i=0; i<n; i++) ok = ok && (out.Get(i) == Projection(a.Get(i), b.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        ok = true;
+        Rejection(a, b, out);
+        for (int i=0; i<n; i++) ok = ok && (out.Get(i) == Rejection(a.Get(i), b.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Fast variants within the documented error of the exact ones
+        float err = 0.0f;
+        InvMagnitudeFast(a, f);
+        for (int i=0; i<n; i++) err = max(err, fabsf(f[i]*Magnitude(a.Get(i)) - 1.0f));
+        IS_TRUE(err <= MATH_RSQRT_MAX_RELATIVE_ERROR); counter.SetCount(err <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+
+        err = 0.0f;
+        NormalizeFast(a, out);
+        for (int i=0; i<n; i++) err = max(err, Magnitude(out.Get(i) - Normalize(a.Get(i))));
+        IS_TRUE(err <= MATH_RSQRT_MAX_RELATIVE_ERROR); counter.SetCount(err <= MATH_RSQRT_MAX_RELATIVE_ERROR);
+
+        // Exception-free variants with zero vectors and a NaN in both the packets and the tail
+        SoA<Vector3> z = b;
+        for (int i : {0, 5, 9, 17}) z.Set(i, Vector3(0.0f, 0.0f, 0.0f));
+        z.Set(12, Vector3(NAN, 1.0f, 1.0f));
+        uint8_t valid[(n + 7) / 8];
+        const uint8_t expected[3] = {0xDE, 0xED, 0x05};
+        bool all = TryProjection(a, z, out, valid);
+        ok = !all && valid[0] == expected[0] && valid[1] == expected[1] && valid[2] == expected[2];
+        for (int i=0; i<n; i++)
+        {
+            Vector3 p;
+            bool v = TryProjection(a.Get(i), z.Get(i), p);
+            ok = ok && (v == bool(valid[i/8] >> (i%8) & 1)) && (out.Get(i) == p);
+            if (v) ok = ok && (out.Get(i) == Projection(a.Get(i), z.Get(i)));
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        all = TryRejection(a, z, out, valid);
+        ok = !all && valid[0] == expected[0] && valid[1] == expected[1] && valid[2] == expected[2];
+        for (int i=0; i<n; i++)
+        {
+            Vector3 p;
+            TryRejection(a.Get(i), z.Get(i), p);
+            ok = ok && (out.Get(i) == p);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        all = TryAngle(a, z, f, valid);
+        ok = !all && valid[0] == expected[0] && valid[1] == expected[1] && valid[2] == expected[2];
+        for (int i=0; i<n; i++)
+        {
+            float angle;
+            TryAngle(a.Get(i), z.Get(i), angle);
+            ok = ok && fabsf(f[i] - angle) <= 2.0f*MATH_ACOS_MAX_ABSOLUTE_ERROR;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        ok = TryAngle(a, b, f, valid) && valid[2] == 0x07;
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // In place, on a sub-span
+        ok = true;
+        SoA<Vector3> c = a;
+        Normalize(c.Span().Sub(2, 9), c.Span().Sub(2, 9));
+        for (int i=0; i<n; i++) ok = ok && (c.Get(i) == ((i >= 2 && i < 11) ? Normalize(a.Get(i)) : a.Get(i)));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Print("Testing SoA batch methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "              SOA UNIT TESTING           " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        ValueChange();
+        MemoryPlacement();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "        ALL SOA TESTS HAVE FINISHED      " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestCompression
+{
+    Counter counter;
+    //! Unit vector i of n spread over the sphere (Fibonacci lattice)
+    Vector3 Direction(int i, int n)
+    {
+        float z = 1.0f - (2.0f*i + 1.0f)/n, r = sqrtf(1.0f - z*z), phi = 2.39996323f*i;
+        return Normalize(Vector3(r*cosf(phi), r*sinf(phi), z));
+    }
+    //! Angle between two directions, in double precision so that tiny angles are resolved
+    double AngleBetween(const Vector3& a, const Vector3& b)
+    {
+        double cx = double(a.y)*b.z - double(a.z)*b.y, cy = double(a.z)*b.x - double(a.x)*b.z, cz = double(a.x)*b.y - double(a.y)*b.x;
+        return atan2(sqrt(cx*cx + cy*cy + cz*cz), double(a.x)*b.x + double(a.y)*b.y + double(a.z)*b.z);
+    }
+    //! Angle between a 4D direction and a nearby vector, from the chord between their unit vectors
+    double AngleBetween(const Vector4& a, const Vector4& b)
+    {
+        double la = 0.0, lb = 0.0, d = 0.0;
+        for (int k=0; k<4; k++) {la += double(a[k])*a[k]; lb += double(b[k])*b[k];}
+        for (int k=0; k<4; k++) {double t = a[k]/sqrt(la) - b[k]/sqrt(lb); d += t*t;}
+        return 2.0*asin(0.5*sqrt(d));
+    }
+    void Initialize(void)
+    {
+        Print("Testing packed vector initialization...");
+
+        Half3 h;
+        IS_TRUE(h.x == 0 && h.y == 0 && h.z == 0); counter.SetCount(h.x == 0 && h.y == 0 && h.z == 0);
+        Half4 g(1, 2, 3, 4);
+        IS_TRUE(g.x == 1 && g.w == 4); counter.SetCount(g.x == 1 && g.w == 4);
+        SNorm16x3 s(-32767, 0, 32767);
+        IS_TRUE(s.x == -32767 && s.z == 32767); counter.SetCount(s.x == -32767 && s.z == 32767);
+        Octahedral32 o;
+        IS_EQUAL(UnpackOctahedral32(o), Vector3(0.0f, 0.0f, 1.0f)); counter.SetCount(UnpackOctahedral32(o) == Vector3(0.0f, 0.0f, 1.0f));
+
+        Print("Testing packed vector initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing packed vector memory placement...");
+
+        IS_EQUAL(sizeof(Half3), 6); counter.SetCount(sizeof(Half3) == 6);
+        IS_EQUAL(sizeof(Half4), 8); counter.SetCount(sizeof(Half4) == 8);
+        IS_EQUAL(sizeof(SNorm16x3), 6); counter.SetCount(sizeof(SNorm16x3) == 6);
+        IS_EQUAL(sizeof(Octahedral32), 4); counter.SetCount(sizeof(Octahedral32) == 4);
+
+        Print("Testing packed vector memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing packed vector methods...");
+
+        // Half precision conversions, including rounding, overflow and subnormals
+        IS_EQUAL(FloatToHalf(1.0f), 0x3C00); counter.SetCount(FloatToHalf(1.0f) == 0x3C00);
+        IS_EQUAL(FloatToHalf(-2.0f), 0xC000); counter.SetCount(FloatToHalf(-2.0f) == 0xC000);
+        IS_EQUAL(FloatToHalf(65504.0f), 0x7BFF); counter.SetCount(FloatToHalf(65504.0f) == 0x7BFF);
+        IS_EQUAL(FloatToHalf(65520.0f), 0x7C00); counter.SetCount(FloatToHalf(65520.0f) == 0x7C00);
+        IS_EQUAL(FloatToHalf(1.0f + 1.0f/2048.0f), 0x3C00); counter.SetCount(FloatToHalf(1.0f + 1.0f/2048.0f) == 0x3C00);
+        IS_EQUAL(FloatToHalf(1.0f + 3.0f/2048.0f), 0x3C02); counter.SetCount(FloatToHalf(1.0f + 3.0f/2048.0f) == 0x3C02);
+        IS_EQUAL(FloatToHalf(5.9604645e-8f), 0x0001); counter.SetCount(FloatToHalf(5.9604645e-8f) == 0x0001);
+        IS_EQUAL(FloatToHalf(2.9802322e-8f), 0x0000); counter.SetCount(FloatToHalf(2.9802322e-8f) == 0x0000);
+        IS_TRUE(isnan(HalfToFloat(FloatToHalf(NAN)))); counter.SetCount(isnan(HalfToFloat(FloatToHalf(NAN))));
+        bool ok = true;
+        for (uint32_t h=0; h<0x10000u; h++)
+            if ((h & 0x7C00u) != 0x7C00u || (h & 0x03FFu) == 0) ok = ok && (FloatToHalf(HalfToFloat(uint16_t(h))) == h);
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Signed normalized conversions
+        IS_EQUAL(FloatToSNorm16(1.0f), 32767); counter.SetCount(FloatToSNorm16(1.0f) == 32767);
+        IS_EQUAL(FloatToSNorm16(-3.0f), -32767); counter.SetCount(FloatToSNorm16(-3.0f) == -32767);
+        IS_EQUAL(SNorm16ToFloat(-32768), -1.0f); counter.SetCount(SNorm16ToFloat(-32768) == -1.0f);
+        ok = true;
+        for (int s=-32767; s<=32767; s++) ok = ok && (FloatToSNorm16(SNorm16ToFloat(int16_t(s))) == s);
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Worst-case angular error over the sphere, the axes and the octahedron edges
+        const int n = 20000;
+        vector<Vector3> dirs;
+        for (int i=0; i<n; i++) dirs.push_back(Direction(i, n));
+        for (int k=0; k<3; k++)
+            for (float s : {-1.0f, 1.0f}) {Vector3 v(0.0f, 0.0f, 0.0f); v[k] = s; dirs.push_back(v);}
+        for (int i=0; i<=64; i++)
+        {
+            float t = i/64.0f;
+            dirs.push_back(Normalize(Vector3(t, 1.0f - t, 0.0f)));
+            dirs.push_back(Normalize(Vector3(-t, 0.0f, t - 1.0f)));
+        }
+        double eh = 0.0, eh4 = 0.0, es = 0.0, eo = 0.0;
+        for (const Vector3& v : dirs)
+        {
+            eh = max(eh, AngleBetween(v, UnpackHalf3(PackHalf3(v))));
+            Vector4 q = Normalize(Vector4(v.x, v.y, v.z, v.x - v.y));
+            eh4 = max(eh4, AngleBetween(q, UnpackHalf4(PackHalf4(q))));
+            es = max(es, AngleBetween(v, UnpackSNorm16x3(PackSNorm16x3(v))));
+            eo = max(eo, AngleBetween(v, UnpackOctahedral32(PackOctahedral32(v))));
+        }
+        IS_LESS(eh, MATH_HALF3_MAX_ANGULAR_ERROR); counter.SetCount(eh < MATH_HALF3_MAX_ANGULAR_ERROR);
+        IS_LESS(eh4, MATH_HALF4_MAX_ANGULAR_ERROR); counter.SetCount(eh4 < MATH_HALF4_MAX_ANGULAR_ERROR);
+        IS_LESS(es, MATH_SNORM16X3_MAX_ANGULAR_ERROR); counter.SetCount(es < MATH_SNORM16X3_MAX_ANGULAR_ERROR);
+        IS_LESS(eo, MATH_OCTAHEDRAL32_MAX_ANGULAR_ERROR); counter.SetCount(eo < MATH_OCTAHEDRAL32_MAX_ANGULAR_ERROR);
+        ok = true;
+        for (const Vector3& v : dirs) ok = ok && fabsf(Magnitude(UnpackOctahedral32(PackOctahedral32(v))) - 1.0f) < 1e-6f;
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Batch kernels against the single element functions: two full packets and a scalar tail
+        const int m = 19;
+        SoA<Vector3> a(m), out(m);
+        SoA<Vector4> a4(m), out4(m);
+        for (int i=0; i<m; i++)
+        {
+            Vector3 v = Direction(i, m);
+            a.Set(i, v);
+            a4.Set(i, Vector4(v.x, v.y, v.z, 100.0f*v.x));
+        }
+        Half3 h3[m];
+        PackHalf3(a, h3);
+        ok = true;
+        for (int i=0; i<m; i++) ok = ok && (h3[i].x == PackHalf3(a.Get(i)).x && h3[i].y == PackHalf3(a.Get(i)).y && h3[i].z == PackHalf3(a.Get(i)).z);
+        UnpackHalf3(h3, out);
+        for (int i=0; i<m; i++) ok = ok && (out.Get(i) == UnpackHalf3(h3[i]));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Half4 h4[m];
+        PackHalf4(a4, h4);
+        ok = true;
+        for (int i=0; i<m; i++) ok = ok && (h4[i].x == PackHalf4(a4.Get(i)).x && h4[i].w == PackHalf4(a4.Get(i)).w);
+        UnpackHalf4(h4, out4);
+        for (int i=0; i<m; i++) ok = ok && (out4.Get(i) == UnpackHalf4(h4[i]));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        SNorm16x3 s3[m];
+        PackSNorm16x3(a, s3);
+        ok = true;
+        for (int i=0; i<m; i++) ok = ok && (s3[i].x == PackSNorm16x3(a.Get(i)).x && s3[i].y == PackSNorm16x3(a.Get(i)).y && s3[i].z == PackSNorm16x3(a.Get(i)).z);
+        UnpackSNorm16x3(s3, out);
+        for (int i=0; i<m; i++) ok = ok && (out.Get(i) == UnpackSNorm16x3(s3[i]));
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Octahedral32 o[m];
+        PackOctahedral32(a, o);
+        ok = true;
+        for (int i=0; i<m; i++) ok = ok && (o[i].u == PackOctahedral32(a.Get(i)).u && o[i].v == PackOctahedral32(a.Get(i)).v);
+        IS_TRUE(ok); counter.SetCount(ok);
+        float err = 0.0f;
+        UnpackOctahedral32(o, out);
+        for (int i=0; i<m; i++) err = max(err, Magnitude(out.Get(i) - UnpackOctahedral32(o[i])));
+        IS_LESS(err, 1e-6f); counter.SetCount(err < 1e-6f);
+
+        Print("Testing packed vector methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    //! Rotation angle between two quaternions, twice the angle between them on the 4D sphere
+    double RotationBetween(const Quaternion& a, const Quaternion& b)
+    {
+        const float s = (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.0f) ? -1.0f : 1.0f;
+        return 2.0*AngleBetween(Vector4(a.x, a.y, a.z, a.w), Vector4(s*b.x, s*b.y, s*b.z, s*b.w));
+    }
+    void SmallestThree(void)
+    {
+        Print("Testing smallest three quaternions...");
+
+        // Rotations of every angle about directions spread over the sphere, the axes and ties
+        const int n = 20000;
+        vector<Quaternion> q;
+        for (int i=0; i<n; i++)
+        {
+            float t = float(PI)*fmodf(0.618034f*i, 1.0f);
+            q.push_back(Quaternion(Direction(i, n)*sinf(t), cosf(t)));
+        }
+        for (int k=0; k<4; k++)
+            for (float s : {-1.0f, 1.0f}) {Quaternion e(0.0f, 0.0f, 0.0f, 0.0f); (&e.x)[k] = s; q.push_back(e);}
+        q.push_back(Quaternion(0.5f, 0.5f, 0.5f, 0.5f));
+        q.push_back(Quaternion(-0.5f, 0.5f, -0.5f, 0.5f));
+        q.push_back(Quaternion(0.707106781f, 0.0f, -0.707106781f, 0.0f));
+
+        // Code layout: the index of the largest component, then the others from x to w
+        IS_EQUAL(SmallestThreeWidth(29, 0), 9); counter.SetCount(SmallestThreeWidth(29, 0) == 9);
+        IS_EQUAL(SmallestThreeWidth(48, 0), 16); counter.SetCount(SmallestThreeWidth(48, 0) == 16);
+        IS_EQUAL(SmallestThreeWidth(48, 2), 15); counter.SetCount(SmallestThreeWidth(48, 2) == 15);
+        uint64_t c = PackSmallestThree(Quaternion(0.0f, 0.0f, -1.0f, 0.0f), 32);
+        IS_EQUAL(c, 2u + (uint64_t(511) << 2) + (uint64_t(511) << 12) + (uint64_t(511) << 22));
+        counter.SetCount(c == 2u + (uint64_t(511) << 2) + (uint64_t(511) << 12) + (uint64_t(511) << 22));
+        Quaternion r = UnpackSmallestThree(c, 32);
+        IS_TRUE(r.x == 0.0f && r.y == 0.0f && r.z == 1.0f && r.w == 0.0f);
+        counter.SetCount(r.x == 0.0f && r.y == 0.0f && r.z == 1.0f && r.w == 0.0f);
+
+        // Worst-case rotation error against the bound of every size
+        bool ok = true;
+        for (int bits = MATH_SMALLEST_THREE_MIN_BITS; bits <= MATH_SMALLEST_THREE_MAX_BITS; bits++)
+        {
+            double e = 0.0;
+            for (const Quaternion& a : q)
+            {
+                uint64_t code = PackSmallestThree(a, bits);
+                ok = ok && (code >> bits) == 0;
+                e = max(e, RotationBetween(a, UnpackSmallestThree(code, bits)));
+            }
+            ok = ok && e < SmallestThreeMaxAngularError(bits);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        ok = true;
+        for (const Quaternion& a : q)
+        {
+            Quaternion b = UnpackSmallestThree(PackSmallestThree(a, 29), 29);
+            ok = ok && fabsf(b.x*b.x + b.y*b.y + b.z*b.z + b.w*b.w - 1.0f) < 1e-6f;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Bit streams: codes straddle byte boundaries and writes leave their neighbours alone
+        for (int bits : {29, 35, 48})
+        {
+            vector<uint8_t> stream(SmallestThreeStreamBytes(n, bits), 0xFF);
+            for (int i=0; i<n; i++) WriteSmallestThree(stream.data(), i, bits, PackSmallestThree(q[i], bits));
+            ok = true;
+            for (int i=0; i<n; i++) ok = ok && ReadSmallestThree(stream.data(), i, bits) == PackSmallestThree(q[i], bits);
+            IS_TRUE(ok); counter.SetCount(ok);
+        }
+        IS_EQUAL(SmallestThreeStreamBytes(8, 29), 36u); counter.SetCount(SmallestThreeStreamBytes(8, 29) == 36u);
+
+        // Batch kernels against the single element functions: two full packets and a scalar tail
+        const int m = 19;
+        SoA<Quaternion> a(m), out(m);
+        for (int i=0; i<m; i++) a.Set(i, q[(i*1031) % n]);
+        a.Set(3, q[n]); a.Set(11, q[n + 8]); a.Set(17, q[n + 9]);
+        for (int bits = MATH_SMALLEST_THREE_MIN_BITS; bits <= MATH_SMALLEST_THREE_MAX_BITS; bits++)
+        {
+            vector<uint8_t> stream(SmallestThreeStreamBytes(m, bits), 0xFF);
+            PackSmallestThree(a, bits, stream.data());
+            ok = true;
+            for (int i=0; i<m; i++) ok = ok && ReadSmallestThree(stream.data(), i, bits) == PackSmallestThree(a.Get(i), bits);
+            for (size_t b = (size_t(m)*bits + 7)/8; b < stream.size(); b++) ok = ok && stream[b] == 0;
+            UnpackSmallestThree(stream.data(), bits, out);
+            float err = 0.0f;
+            for (int i=0; i<m; i++)
+            {
+                Quaternion u = out.Get(i), v = UnpackSmallestThree(ReadSmallestThree(stream.data(), i, bits), bits);
+                err = max(err, max(max(fabsf(u.x - v.x), fabsf(u.y - v.y)), max(fabsf(u.z - v.z), fabsf(u.w - v.w))));
+            }
+            ok = ok && err < 1e-6f;
+            IS_TRUE(ok); counter.SetCount(ok);
+        }
+
+        Print("Testing smallest three quaternions complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "        PACKED VECTOR UNIT TESTING       " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        Methods();
+        SmallestThree();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "   ALL PACKED VECTOR TESTS HAVE FINISHED " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestPackets
+{
+    Counter counter;
+    //! Deterministic, non-trivial test vectors (no zero vectors)
+    Vector3 Sample(int i) {return Vector3(1.0f + 0.5f*i, 2.0f - 0.25f*i, -3.0f + 0.125f*i*i);}
+    Quaternion SampleRotation(int i) {return Normalize(Quaternion(0.5f - 0.1f*i, 0.25f*i, 1.0f, 0.75f + 0.05f*i));}
+    //! Runs every packet operator against the scalar operator, lane by lane
+    template<typename F>
+    void MethodsWidth(void)
+    {
+        typedef Vector3xN<F> V3; typedef Vector4xN<F> V4; typedef Point3xN<F> P3; typedef QuaternionxN<F> Q;
+        const int n = F::Width;
+        SoA<Vector3> sa(n), sb(n);
+        SoA<Vector4> s4(n);
+        SoA<Point3> sp(n);
+        SoA<Quaternion> sq(n);
+        float sc[8];
+        for (int i=0; i<n; i++)
+        {
+            sa.Set(i, Sample(i)); sb.Set(i, Sample(7 - i));
+            s4.Set(i, Vector4(Sample(i).x, Sample(i).y, Sample(i).z, 0.5f*i - 1.0f));
+            sp.Set(i, toPoint(Sample(i + 1)));
+            sq.Set(i, SampleRotation(i));
+            sc[i] = 0.5f + 0.25f*i;
+        }
+        V3 a = V3::Load(sa, 0), b = V3::Load(sb, 0);
+        V4 a4 = V4::Load(s4, 0);
+        P3 p = P3::Load(sp, 0);
+        Q q = Q::Load(sq, 0), r = Q::Load(sq, 0);
+        F s = F::Load(sc);
+        Matrix4 M(1.0f, 2.0f, 0.5f, -1.0f, 0.0f, 3.0f, 1.0f, 2.0f, -2.0f, 0.5f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f);
+        Matrix3 N(1.0f, 2.0f, 0.5f, 0.0f, 3.0f, 1.0f, -2.0f, 0.5f, 1.0f);
+        Transform4 T(1.0f, 2.0f, 0.5f, 4.0f, 0.0f, 3.0f, 1.0f, 5.0f, -2.0f, 0.5f, 1.0f, 6.0f);
+        Plane f(0.0f, 0.6f, 0.8f, -2.0f);
+        F dot = a*b, mag = Magnitude(a), ang = Angle(a, b), dist = f*p, triple = ScalarTripleProduct(a, b, V3(p));
+        V3 sum = a + b, diff = a - b, neg = -a, scaled = a*s, halved = a/2.0f, quot = a/s, cross = CrossProduct(a, b);
+        V3 unit = Normalize(a), fast = NormalizeFast(a), proj = Projection(a, b), rej = Rejection(a, b);
+        V3 nv = N*a, tv = T*a, tn = a*T, rot = Transform(a, q), rot1 = Transform(a, sq.Get(0)), rotU = Rotate(a, q);
+        V4 mv = M*a4, u4 = Normalize(a4);
+        P3 pp = p + p, ps = p*2.0f, tp = T*p;
+        V3 pd = p - P3(b);
+        Q qq = q*r, qs = q + r*s, qd = q - r, qn = Normalize(qq);
+        bool ok = true, okAngle = true, okFast = true;
+        for (int i=0; i<n; i++)
+        {
+            Vector3 va = sa.Get(i), vb = sb.Get(i);
+            Vector4 v4 = s4.Get(i);
+            Point3 pi = sp.Get(i);
+            Quaternion qi = sq.Get(i);
+            ok = ok && a.Lane(i) == va && p.Lane(i) == pi && q.Lane(i) == qi && CloseFloat(s.Lane(i), sc[i]);
+            ok = ok && CloseFloat(dot.Lane(i), va*vb) && CloseFloat(mag.Lane(i), Magnitude(va));
+            ok = ok && CloseFloat(dist.Lane(i), f*pi) && CloseFloat(triple.Lane(i), ScalarTripleProduct(va, vb, pi));
+            ok = ok && sum.Lane(i) == va + vb && diff.Lane(i) == va - vb && neg.Lane(i) == -va;
+            ok = ok && scaled.Lane(i) == va*sc[i] && halved.Lane(i) == va/2.0f && quot.Lane(i) == va/sc[i];
+            ok = ok && cross.Lane(i) == CrossProduct(va, vb) && unit.Lane(i) == Normalize(va);
+            ok = ok && proj.Lane(i) == Projection(va, vb) && rej.Lane(i) == Rejection(va, vb);
+            ok = ok && nv.Lane(i) == N*va && tv.Lane(i) == T*va && tn.Lane(i) == va*T;
+            ok = ok && rot.Lane(i) == Transform(va, qi) && rot1.Lane(i) == Transform(va, sq.Get(0));
+            ok = ok && rotU.Lane(i) == Transform(va, UnitQuaternion::FromNormalized(qi));
+            ok = ok && mv.Lane(i) == M*v4 && u4.Lane(i) == Normalize(v4);
+            ok = ok && pp.Lane(i) == pi + pi && ps.Lane(i) == pi*2.0f && tp.Lane(i) == T*pi && pd.Lane(i) == pi - toPoint(vb);
+            ok = ok && qq.Lane(i) == qi*qi && qs.Lane(i) == qi + qi*sc[i] && qd.Lane(i) == qi - qi && qn.Lane(i) == Normalize(qi*qi);
+            okAngle = okAngle && fabsf(ang.Lane(i) - Angle(va, vb)) < MATH_ACOS_MAX_ABSOLUTE_ERROR + 1e-6f;
+            okFast = okFast && Magnitude(fast.Lane(i) - Normalize(va)) < 4.0f*MATH_RSQRT_MAX_RELATIVE_ERROR;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        IS_TRUE(okAngle); counter.SetCount(okAngle);
+        IS_TRUE(okFast); counter.SetCount(okFast);
+
+        // Lane masks: select, blend and the compound operators
+        F mask = CmpLess(a.x, F::Broadcast(2.5f));
+        V3 sel = Select(mask, a, b), blend = Blend(a, b, F::Broadcast(0.25f));
+        Q qsel = Select(mask, q, qq);
+        V3 acc = a;
+        acc += b; acc -= a; acc *= s; acc /= s;
+        ok = true;
+        for (int i=0; i<n; i++)
+        {
+            bool lane = sa.Get(i).x < 2.5f;
+            ok = ok && (((MoveMask(mask) >> i) & 1) != 0) == lane;
+            ok = ok && sel.Lane(i) == (lane ? sa.Get(i) : sb.Get(i)) && qsel.Lane(i) == (lane ? sq.Get(i) : sq.Get(i)*sq.Get(i));
+            ok = ok && blend.Lane(i) == sa.Get(i) + (sb.Get(i) - sa.Get(i))*0.25f && acc.Lane(i) == sb.Get(i);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Store round trip through an SoA container
+        SoA<Vector3> out(n);
+        cross.Store(out, 0);
+        ok = true;
+        for (int i=0; i<n; i++) ok = ok && out.Get(i) == CrossProduct(sa.Get(i), sb.Get(i));
+        IS_TRUE(ok); counter.SetCount(ok);
+    }
+    void Initialize(void)
+    {
+        Print("Testing packet initialization...");
+
+        Vector3x8 a(Vector3(1.0f, 2.0f, 3.0f));
+        bool ok = true;
+        for (int i=0; i<8; i++) ok = ok && a.Lane(i) == Vector3(1.0f, 2.0f, 3.0f);
+        IS_TRUE(ok); counter.SetCount(ok);
+        Vector4x4 b(Floatx4::Broadcast(1.0f), Floatx4::Zero(), Floatx4::Broadcast(-1.0f), Floatx4::Broadcast(2.0f));
+        IS_EQUAL(b.Lane(3), Vector4(1.0f, 0.0f, -1.0f, 2.0f)); counter.SetCount(b.Lane(3) == Vector4(1.0f, 0.0f, -1.0f, 2.0f));
+        Point3x8 p(Point3(4.0f, 5.0f, 6.0f));
+        IS_EQUAL(p.Lane(7), Point3(4.0f, 5.0f, 6.0f)); counter.SetCount(p.Lane(7) == Point3(4.0f, 5.0f, 6.0f));
+        Quaternionx8 q(Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        IS_EQUAL(q.Lane(5), Quaternion(0.0f, 0.0f, 0.0f, 1.0f)); counter.SetCount(q.Lane(5) == Quaternion(0.0f, 0.0f, 0.0f, 1.0f));
+        IS_EQUAL(q.GetVector().Lane(2), Vector3()); counter.SetCount(q.GetVector().Lane(2) == Vector3());
+
+        Print("Testing packet initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing packet memory placement...");
+
+        IS_EQUAL(Vector3x4::Width, 4); counter.SetCount(Vector3x4::Width == 4);
+        IS_EQUAL(Vector3x8::Width, 8); counter.SetCount(Vector3x8::Width == 8);
+        IS_EQUAL(sizeof(Floatx4), 16); counter.SetCount(sizeof(Floatx4) == 16);
+        IS_EQUAL(sizeof(Floatx8), 32); counter.SetCount(sizeof(Floatx8) == 32);
+        IS_EQUAL(sizeof(Vector3x8), 3*sizeof(Floatx8)); counter.SetCount(sizeof(Vector3x8) == 3*sizeof(Floatx8));
+        IS_EQUAL(sizeof(Point3x8), sizeof(Vector3x8)); counter.SetCount(sizeof(Point3x8) == sizeof(Vector3x8));
+        IS_EQUAL(sizeof(Quaternionx8), 4*sizeof(Floatx8)); counter.SetCount(sizeof(Quaternionx8) == 4*sizeof(Floatx8));
+        IS_EQUAL(sizeof(Vector4x4), 4*sizeof(Floatx4)); counter.SetCount(sizeof(Vector4x4) == 4*sizeof(Floatx4));
+
+        Print("Testing packet memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing packet methods...");
+
+        MethodsWidth<Floatx4>();
+        MethodsWidth<Floatx8>();
+
+        Print("Testing packet methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "           PACKET UNIT TESTING          " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "     ALL PACKET TESTS HAVE FINISHED      " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestRebase
+{
+    Counter counter;
+    //! World positions tens of thousands of kilometres from the origin, a few metres apart
+    Point3d Sample(int i) {return Point3d(4.0e7 + 1.25*i + 0.001*i*i, -2.5e7 - 0.5*i, 1.0e6 + 0.003*i);}
+    void Initialize(void)
+    {
+        Print("Testing rebase initialization...");
+
+        Point3d p(1.0, 2.0, 3.0);
+        IS_EQUAL(p, Vector3d(1.0, 2.0, 3.0)); counter.SetCount(p == Vector3d(1.0, 2.0, 3.0));
+        Point3d q(Point3(0.5f, -1.0f, 2.0f));
+        IS_EQUAL(q, Point3d(0.5, -1.0, 2.0)); counter.SetCount(q == Point3d(0.5, -1.0, 2.0));
+        Transform4d T(Vector3d(1,0,0), Vector3d(0,1,0), Vector3d(0,0,1), Point3d(1.0e7, 2.0, 3.0));
+        IS_EQUAL(T.GetTranslation(), Point3d(1.0e7, 2.0, 3.0)); counter.SetCount(T.GetTranslation() == Point3d(1.0e7, 2.0, 3.0));
+        IS_EQUAL(T(3,3), 1.0); counter.SetCount(T(3,3) == 1.0);
+        Transform4 F(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f);
+        Transform4d G(F);
+        IS_EQUAL(G(1,3), 8.0); counter.SetCount(G(1,3) == 8.0);
+        IS_EQUAL(G(2,1), 10.0); counter.SetCount(G(2,1) == 10.0);
+
+        Print("Testing rebase initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing rebase memory placement...");
+
+        IS_EQUAL(sizeof(Point3d), 3*sizeof(double)); counter.SetCount(sizeof(Point3d) == 3*sizeof(double));
+        IS_EQUAL(sizeof(Transform4d), 16*sizeof(double)); counter.SetCount(sizeof(Transform4d) == 16*sizeof(double));
+        Transform4d T;
+        T.SetTranslation(Point3d(1.0, 2.0, 3.0));
+        IS_EQUAL(&T.GetTranslation().x, &T(0,3)); counter.SetCount(&T.GetTranslation().x == &T(0,3));
+
+        Print("Testing rebase memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing rebase methods...");
+
+        // Millimetre offsets survive 40000 km from the origin, where float alone cannot hold them
+        Point3d camera(4.0e7, -2.5e7, 1.0e6);
+        Point3d p = camera + Vector3d(0.001, -0.002, 12.345);
+        Point3 r = Rebase(p, camera);
+        IS_LESS(fabs(r.x - 0.001), 1e-7); counter.SetCount(fabs(r.x - 0.001) < 1e-7);
+        IS_LESS(fabs(r.z - 12.345), 1e-6); counter.SetCount(fabs(r.z - 12.345) < 1e-6);
+        IS_NOT_CLOSE(float(p.x) - float(camera.x), 0.001f); counter.SetCount(fabs((float(p.x) - float(camera.x)) - 0.001f) >= 1e-6);
+        Point3d back = ToWorld(r, camera);
+        IS_LESS(fabs(back.y - p.y), 1e-9); counter.SetCount(fabs(back.y - p.y) < 1e-9);
+
+        // Point operators
+        Point3d a(1.0, 2.0, 3.0), b(0.5, 0.5, 0.5);
+        IS_EQUAL(a + b, Point3d(1.5, 2.5, 3.5)); counter.SetCount(a + b == Point3d(1.5, 2.5, 3.5));
+        IS_EQUAL(a - b, Vector3d(0.5, 1.5, 2.5)); counter.SetCount(a - b == Vector3d(0.5, 1.5, 2.5));
+        IS_EQUAL(a*2.0, Point3d(2.0, 4.0, 6.0)); counter.SetCount(a*2.0 == Point3d(2.0, 4.0, 6.0));
+        IS_EQUAL(a/2.0, Point3d(0.5, 1.0, 1.5)); counter.SetCount(a/2.0 == Point3d(0.5, 1.0, 1.5));
+
+        // World transforms compose in double, then the rebased transform matches the float product
+        Transform4d A(0.0, -1.0, 0.0, 4.0e7, 1.0, 0.0, 0.0, -2.5e7, 0.0, 0.0, 1.0, 1.0e6);
+        Transform4d B(2.0, 0.0, 0.0, 1.5, 0.0, 2.0, 0.0, 0.25, 0.0, 0.0, 2.0, -3.0);
+        Transform4d C = A*B;
+        IS_EQUAL(C.GetTranslation(), Point3d(4.0e7 - 0.25, -2.5e7 + 1.5, 1.0e6 - 3.0));
+        counter.SetCount(C.GetTranslation() == Point3d(4.0e7 - 0.25, -2.5e7 + 1.5, 1.0e6 - 3.0));
+        IS_EQUAL(C*Point3d(1.0, 0.0, 0.0), Point3d(4.0e7 - 0.25, -2.5e7 + 3.5, 1.0e6 - 3.0));
+        counter.SetCount(C*Point3d(1.0, 0.0, 0.0) == Point3d(4.0e7 - 0.25, -2.5e7 + 3.5, 1.0e6 - 3.0));
+        Transform4 Cf = Rebase(C, camera);
+        Transform4 expected = Rebase(A, camera)*Transform4(2.0f, 0.0f, 0.0f, 1.5f, 0.0f, 2.0f, 0.0f, 0.25f, 0.0f, 0.0f, 2.0f, -3.0f);
+        IS_EQUAL(Cf, expected); counter.SetCount(Cf == expected);
+        IS_EQUAL(Cf(3,3), 1.0f); counter.SetCount(Cf(3,3) == 1.0f);
+
+        // Batch kernels against the single element functions: packets and a scalar tail
+        const int n = 19;
+        Point3d w[n];
+        for (int i=0; i<n; i++) w[i] = Sample(i);
+        Point3 aos[n];
+        Rebase(w, n, camera, aos);
+        SoA<Point3> soa(n);
+        Rebase(w, camera, soa);
+        bool ok = true;
+        for (int i=0; i<n; i++)
+        {
+            Point3 e = Rebase(w[i], camera);
+            ok = ok && memcmp(&aos[i], &e, sizeof(Point3)) == 0;
+            Point3 g = soa.Get(i);
+            ok = ok && memcmp(&g, &e, sizeof(Point3)) == 0;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Transform4d T[3] = {A, B, C};
+        Transform4 Tf[3];
+        Rebase(T, 3, camera, Tf);
+        ok = true;
+        for (int i=0; i<3; i++)
+        {
+            Transform4 e = Rebase(T[i], camera);
+            ok = ok && memcmp(&Tf[i], &e, sizeof(Transform4)) == 0;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Print("Testing rebase methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "           REBASE UNIT TESTING           " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "     ALL REBASE TESTS HAVE FINISHED      " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestBatchTransforms
+{
+    Counter counter;
+    //! Interleaved vertex, the positions and normals are read through strided spans
+    struct Vertex {Point3 p; Vector3 n; float uv[2];};
+    //! Sample data within a few units of the origin, so the absolute tolerance of == applies
+    Point3 SamplePoint(int i) {return Point3(0.25f*(i % 7) - 1.0f, 0.5f - 0.125f*(i % 5), 0.0625f*(i % 11));}
+    Vector3 SampleVector(int i) {return Vector3(0.5f - 0.0625f*(i % 13), 0.125f*(i % 3) + 0.25f, -0.75f + 0.25f*(i % 4));}
+    Plane SamplePlane(int i) {return Plane(SampleVector(i), 0.5f*(i % 6) - 1.25f);}
+    //! Largest absolute difference between two matrices
+    static float MaxDiff(const Matrix3& A, const Matrix3& B)
+    {
+        float d = 0.0f;
+        for (int j=0; j<3; j++)
+            for (int i=0; i<3; i++) d = max(d, fabsf(A(i,j) - B(i,j)));
+        return d;
+    }
+    void Initialize(void)
+    {
+        Print("Testing batch transform initialization...");
+
+        StridedSpan<Point3> e;
+        IS_TRUE(e.data == nullptr); counter.SetCount(e.data == nullptr);
+        IS_EQUAL(e.count, 0); counter.SetCount(e.count == 0);
+        IS_EQUAL(e.stride, int(sizeof(Point3))); counter.SetCount(e.stride == int(sizeof(Point3)));
+        vector<Point3> v = {Point3(1.0f, 2.0f, 3.0f), Point3(4.0f, 5.0f, 6.0f), Point3(7.0f, 8.0f, 9.0f)};
+        StridedSpan<Point3> s(v);
+        IS_EQUAL(s.count, 3); counter.SetCount(s.count == 3);
+        IS_EQUAL(s[2], Point3(7.0f, 8.0f, 9.0f)); counter.SetCount(s[2] == Point3(7.0f, 8.0f, 9.0f));
+        StridedSpan<const Point3> c = s.Sub(1, 2);
+        IS_EQUAL(c.count, 2); counter.SetCount(c.count == 2);
+        IS_EQUAL(c[0], Point3(4.0f, 5.0f, 6.0f)); counter.SetCount(c[0] == Point3(4.0f, 5.0f, 6.0f));
+
+        Print("Testing batch transform initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing batch transform memory placement...");
+
+        Vertex verts[4];
+        StridedSpan<Point3> p(&verts[0].p, 4, sizeof(Vertex));
+        StridedSpan<Vector3> n(&verts[0].n, 4, sizeof(Vertex));
+        IS_EQUAL(&p[3], &verts[3].p); counter.SetCount(&p[3] == &verts[3].p);
+        IS_EQUAL(&n[2], &verts[2].n); counter.SetCount(&n[2] == &verts[2].n);
+        IS_EQUAL(&p.Sub(1, 3)[1], &verts[2].p); counter.SetCount(&p.Sub(1, 3)[1] == &verts[2].p);
+
+        // Chunks cover the range once and start on packet boundaries
+        const int count = 1000;
+        vector<int> hits(count, 0);
+        bool aligned = true;
+        ParallelFor(count, 100, [&](int first, int last)
+        {
+            aligned = aligned && (first % MATH_BATCH_WIDTH == 0);
+            for (int i=first; i<last; i++) hits[i]++;
+        });
+        bool once = true;
+        for (int i=0; i<count; i++) once = once && hits[i] == 1;
+        IS_TRUE(once); counter.SetCount(once);
+        IS_TRUE(aligned); counter.SetCount(aligned);
+
+        Print("Testing batch transform memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    //! Runs every batch transform over n elements, in both layouts, against the scalar operators
+    bool CheckAll(const Transform4& T, const Matrix4& M, int n)
+    {
+        vector<Point3> p(n), po(n);
+        vector<Vector3> v(n), vo(n);
+        vector<Plane> f(n), fo(n);
+        for (int i=0; i<n; i++) {p[i] = SamplePoint(i); v[i] = SampleVector(i); f[i] = SamplePlane(i);}
+        SoA<Point3> ps(p), pso(n);
+        SoA<Vector3> vs(v), vso(n);
+        SoA<Plane> fs(f), fso(n);
+        bool ok = true;
+
+        TransformPoints(T, p, po);
+        TransformPoints(T, ps, pso);
+        for (int i=0; i<n; i++)
+        {
+            Point3 e = T*p[i] + T.GetTranslation();
+            ok = ok && po[i] == e && pso.Get(i) == e;
+        }
+        TransformVectors(T, v, vo);
+        TransformVectors(T, vs, vso);
+        for (int i=0; i<n; i++) ok = ok && vo[i] == T*v[i] && vso.Get(i) == T*v[i];
+        TransformNormals(T, v, vo);
+        TransformNormals(T, vs, vso);
+        for (int i=0; i<n; i++) ok = ok && vo[i] == v[i]*T && vso.Get(i) == v[i]*T;
+        TransformPlanes(T, f, fo);
+        TransformPlanes(T, fs, fso);
+        for (int i=0; i<n; i++) ok = ok && fo[i] == f[i]*T && fso.Get(i) == f[i]*T;
+
+        TransformPoints(M, p, po);
+        TransformPoints(M, ps, pso);
+        for (int i=0; i<n; i++)
+        {
+            Vector4 h = M*Vector4(p[i].x, p[i].y, p[i].z, 1.0f);
+            Point3 e(h.x/h.w, h.y/h.w, h.z/h.w);
+            ok = ok && po[i] == e && pso.Get(i) == e;
+        }
+        TransformVectors(M, v, vo);
+        TransformVectors(M, vs, vso);
+        for (int i=0; i<n; i++)
+        {
+            Vector4 h = M*Vector4(v[i].x, v[i].y, v[i].z, 0.0f);
+            ok = ok && vo[i] == Vector3(h.x, h.y, h.z) && vso.Get(i) == Vector3(h.x, h.y, h.z);
+        }
+        TransformNormals(M, v, vo);
+        TransformNormals(M, vs, vso);
+        for (int i=0; i<n; i++)
+        {
+            Vector4 h = Transpose(M)*Vector4(v[i].x, v[i].y, v[i].z, 0.0f);
+            ok = ok && vo[i] == Vector3(h.x, h.y, h.z) && vso.Get(i) == Vector3(h.x, h.y, h.z);
+        }
+        TransformPlanes(M, f, fo);
+        TransformPlanes(M, fs, fso);
+        for (int i=0; i<n; i++)
+        {
+            Vector4 h = Transpose(M)*Vector4(f[i].x, f[i].y, f[i].z, f[i].w);
+            ok = ok && fo[i] == Plane(h.x, h.y, h.z, h.w) && fso.Get(i) == Plane(h.x, h.y, h.z, h.w);
+        }
+        return ok;
+    }
+    void Methods(void)
+    {
+        Print("Testing batch transform methods...");
+
+        Transform4 T(0.0f, -1.5f, 0.0f, 2.0f, 1.5f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.5f, 0.25f);
+        Matrix4 M(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.5f, 0.25f, 0.0f, 0.0f, 0.25f, 2.0f);
+
+        // Full packets and a scalar tail
+        bool ok = CheckAll(T, M, 37);
+        IS_TRUE(ok); counter.SetCount(ok);
+        // Fewer elements than one packet
+        ok = CheckAll(T, M, 3);
+        IS_TRUE(ok); counter.SetCount(ok);
+        // Enough elements to be split across worker threads
+        ok = CheckAll(T, M, 2*MATH_TRANSFORM_PARALLEL_GRAIN + 13);
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Positions and normals of an interleaved vertex buffer, transformed in place
+        const int n = 21;
+        Vertex verts[n];
+        for (int i=0; i<n; i++) {verts[i].p = SamplePoint(i); verts[i].n = SampleVector(i); verts[i].uv[0] = float(i); verts[i].uv[1] = -float(i);}
+        StridedSpan<Point3> p(&verts[0].p, n, sizeof(Vertex));
+        StridedSpan<Vector3> nrm(&verts[0].n, n, sizeof(Vertex));
+        Transform4 H = Inverse(T);
+        TransformPoints(T, p, p);
+        TransformNormals(H, nrm, nrm);
+        ok = true;
+        for (int i=0; i<n; i++)
+        {
+            ok = ok && verts[i].p == T*SamplePoint(i) + T.GetTranslation();
+            ok = ok && verts[i].n == SampleVector(i)*H;
+            ok = ok && verts[i].uv[0] == float(i) && verts[i].uv[1] == -float(i);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        // Transformed normals stay perpendicular to transformed tangents
+        Vector3 t = T*Vector3(SampleVector(1).y, -SampleVector(1).x, 0.0f);
+        IS_LESS(fabs(verts[1].n*t), 1e-5); counter.SetCount(fabs(verts[1].n*t) < 1e-5);
+
+        // Strided output into a packed array
+        vector<Vector3> packed(n);
+        TransformVectors(T, StridedSpan<const Vector3>(&verts[0].n, n, sizeof(Vertex)), packed);
+        ok = true;
+        for (int i=0; i<n; i++) ok = ok && packed[i] == T*verts[i].n;
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Batch inversion against the scalar TryInverse, with singular entries in a packet and in the tail
+        const int m = 21;
+        vector<Matrix4> A(m), Ai(m);
+        vector<Transform4> B(m), Bi(m);
+        vector<float> da(m), db(m);
+        uint8_t va[(m + 7)/8], vb[(m + 7)/8];
+        for (int i=0; i<m; i++)
+        {
+            A[i] = Matrix4::Generate([&](int r, int c) {return float((r*5 + c*3 + i) % 9) - 4.0f + (r == c ? 6.0f : 0.0f);});
+            B[i] = Transform4(A[i](0,0), A[i](0,1), A[i](0,2), 1.0f, A[i](1,0), A[i](1,1), A[i](1,2), -2.0f, A[i](2,0), A[i](2,1), A[i](2,2), 0.5f*i);
+        }
+        A[3] = Matrix4::Zero();
+        A[19] = Matrix4(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f);
+        B[5] = Transform4(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 4.0f, 6.0f, 8.0f, 0.0f, 0.0f, 1.0f, 0.0f);
+        B[20] = Transform4(0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 2.0f, 0.0f, 0.0f, 0.0f, 3.0f);
+        bool allA = TryInverse(A.data(), m, Ai.data(), da.data(), va);
+        bool allB = TryInverse(B.data(), m, Bi.data(), db.data(), vb);
+        IS_FALSE(allA); counter.SetCount(!allA);
+        IS_FALSE(allB); counter.SetCount(!allB);
+        ok = true;
+        for (int i=0; i<m; i++)
+        {
+            Matrix4 ea; Transform4 eb; float fa, fb;
+            bool oka = TryInverse(A[i], ea, fa), okb = TryInverse(B[i], eb, fb);
+            ok = ok && oka == bool(va[i/8] & (1 << (i % 8))) && okb == bool(vb[i/8] & (1 << (i % 8)));
+            ok = ok && Ai[i] == ea && Bi[i] == eb && CloseFloat(da[i], fa) && CloseFloat(db[i], fb);
+            ok = ok && oka == (i != 3 && i != 19) && okb == (i != 5 && i != 20);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        IS_EQUAL(va[2] & 0xE0, 0); counter.SetCount((va[2] & 0xE0) == 0);
+        // In place, without determinants
+        vector<Transform4> C(B.begin(), B.begin() + 16);
+        ok = TryInverse(C.data(), 16, C.data(), nullptr, vb) == false;
+        for (int i=0; i<16; i++) ok = ok && C[i] == Bi[i];
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // TRS decomposition against the scalar functions, over full packets and a tail
+        const int k = 27;
+        vector<Transform4> trs(k), back(k);
+        vector<Point3> bt(k);
+        vector<Quaternion> bq(k);
+        vector<Vector3> bs(k);
+        uint8_t vt[(k + 7)/8];
+        for (int i=0; i<k; i++)
+        {
+            Quaternion q = Normalize(Quaternion(0.25f*(i % 5) - 0.5f, 0.5f - 0.125f*(i % 7), 0.1f*(i % 3), 1.0f - 0.0625f*i));
+            Vector3 s(0.5f + 0.25f*(i % 6), (i % 4 == 1) ? -1.5f : 1.0f + 0.5f*(i % 3), 2.0f - 0.125f*(i % 9));
+            trs[i] = ComposeTRS(SamplePoint(i), q, s);
+        }
+        trs[6] = ComposeTRS(SamplePoint(6), Quaternion(0.0f, 0.0f, 0.0f, 1.0f), Vector3(1.0f, 1.0f, 0.0f));
+        trs[13] = Transform4(1.0f, 0.5f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 2.0f, 0.0f, 0.0f, 1.0f, 3.0f);
+        bool allT = DecomposeTRS(trs.data(), k, bt.data(), bq.data(), bs.data(), vt);
+        IS_FALSE(allT); counter.SetCount(!allT);
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            Point3 et; Quaternion eq; Vector3 es;
+            bool e = DecomposeTRS(trs[i], et, eq, es);
+            ok = ok && e == bool(vt[i/8] & (1 << (i % 8))) && e == (i != 6);
+            ok = ok && bt[i] == et && bq[i] == eq && bs[i] == es;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        IS_EQUAL(vt[3] & 0xF8, 0); counter.SetCount((vt[3] & 0xF8) == 0);
+        ComposeTRS(bt.data(), bq.data(), bs.data(), k, back.data());
+        ok = true;
+        for (int i=0; i<k; i++) ok = ok && back[i] == ComposeTRS(bt[i], bq[i], bs[i]) && (i == 6 || i == 13 || back[i] == trs[i]);
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Symmetric eigen decomposition against the scalar functions, over full packets and a tail
+        vector<Matrix3> sym(k), br(k);
+        vector<Quaternion> bqe(k);
+        vector<Vector3> bd(k), bqd(k);
+        for (int i=0; i<k; i++)
+        {
+            const Matrix3 Q = RotateAboutAxis(0.3f*i, Vector3(1.0f + 0.5f*(i % 3), -0.25f*(i % 5), 1.0f));
+            sym[i] = Q*Scale(1.0f + 0.5f*(i % 7), -2.0f + 0.125f*i, 9.0f - 0.25f*(i % 4))*Transpose(Q);
+        }
+        sym[5] = Scale(2.0f, -3.0f, 7.0f);
+        sym[17] = Matrix3(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+        DiagonalizeSymmetric(sym.data(), k, br.data(), bd.data());
+        DiagonalizeSymmetric(sym.data(), k, bqe.data(), bqd.data());
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            Matrix3 er; Quaternion eq; Vector3 ed;
+            DiagonalizeSymmetric(sym[i], er, ed);
+            ok = ok && br[i] == er && bd[i] == ed && bqd[i] == ed;
+            DiagonalizeSymmetric(sym[i], eq, ed);
+            ok = ok && bqe[i] == eq && br[i]*Scale(ed.x, ed.y, ed.z)*Transpose(br[i]) == sym[i];
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Singular value decomposition against the scalar functions. U and V are unique only up to
+        // rotations within repeated or zero singular values, where the rank 1 gen[20] (and gen[17])
+        // lies; the already diagonal gen[9] makes every Jacobi rotation a tie. Sigma and
+        // U*Scale(sigma)*V^T are compared for all matrices, U and V only for the others
+        vector<Matrix3> gen(k), bu(k), bv(k);
+        vector<Quaternion> bqu(k), bqv(k);
+        vector<Vector3> bsg(k), bqsg(k);
+        for (int i=0; i<k; i++) gen[i] = sym[i]*RotateAboutAxis(0.2f*i - 1.0f, Vector3(0.5f, 1.0f, 0.25f*(i % 4))) + Scale(0.0f, 0.125f*(i % 3), 0.0f);
+        gen[9] = Scale(1.0f, -2.0f, 3.0f);
+        gen[20] = Matrix3(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f, 3.0f, 6.0f, 9.0f);
+        SVD(gen.data(), k, bu.data(), bsg.data(), bv.data());
+        SVD(gen.data(), k, bqu.data(), bqsg.data(), bqv.data());
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            Matrix3 eu, ev; Quaternion equ, eqv; Vector3 es;
+            SVD(gen[i], eu, es, ev);
+            const float tol = 1e-5f*max(1.0f, es.x), gap = 1e-3f*es.x;
+            const bool distinct = i != 9 && es.x - es.y > gap && es.y - fabsf(es.z) > gap && fabsf(es.z) > gap;
+            ok = ok && MaxDiff(Scale(bsg[i].x, bsg[i].y, bsg[i].z), Scale(es.x, es.y, es.z)) <= tol;
+            ok = ok && MaxDiff(Scale(bqsg[i].x, bqsg[i].y, bqsg[i].z), Scale(es.x, es.y, es.z)) <= tol;
+            ok = ok && MaxDiff(bu[i]*Scale(bsg[i].x, bsg[i].y, bsg[i].z)*Transpose(bv[i]), gen[i]) <= tol;
+            ok = ok && MaxDiff(bqu[i].GetRotation()*Scale(bqsg[i].x, bqsg[i].y, bqsg[i].z)*Transpose(bqv[i].GetRotation()), gen[i]) <= tol;
+            ok = ok && (!distinct || (bu[i] == eu && bv[i] == ev));
+            SVD(gen[i], equ, es, eqv);
+            ok = ok && (!distinct || (bqu[i] == equ && bqv[i] == eqv));
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Interpolation against the scalar functions, including pairs on opposite hemispheres
+        vector<Quaternion> ka(k), kb(k), kn(k), ks(k), kf(k);
+        vector<float> kt(k);
+        for (int i=0; i<k; i++)
+        {
+            ka[i] = Normalize(Quaternion(sinf(0.7f*i), cosf(1.3f*i), 0.5f, cosf(0.9f*i)));
+            kb[i] = Normalize(Quaternion(cosf(0.4f*i), 0.25f, sinf(1.1f*i), sinf(0.3f*i) - 0.5f));
+            kt[i] = (i % 9)/8.0f;
+        }
+        kb[4] = ka[4];
+        Nlerp(ka.data(), kb.data(), kt.data(), k, kn.data());
+        Slerp(ka.data(), kb.data(), kt.data(), k, ks.data());
+        SlerpFast(ka.data(), kb.data(), kt.data(), k, kf.data());
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            // The batch Nlerp() runs the same operations as the scalar one, bit for bit
+            const Quaternion en = Nlerp(ka[i], kb[i], kt[i]);
+            ok = ok && memcmp(&kn[i], &en, sizeof(Quaternion)) == 0 && ks[i] == Slerp(ka[i], kb[i], kt[i]);
+            ok = ok && kf[i] == SlerpFast(ka[i], kb[i], kt[i]);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        SlerpFast(ka.data(), kb.data(), kt.data(), k, ka.data());
+        ok = true;
+        for (int i=0; i<k; i++) ok = ok && ka[i] == kf[i];
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Rotation by quaternions against the Matrix3 path, packed, interleaved and SoA
+        const UnitQuaternion uq0(Quaternion(0.3f, -0.2f, 0.6f, 0.7f));
+        const Matrix3 R0 = uq0.GetRotation();
+        vector<UnitQuaternion> rq(k);
+        vector<Vector3> rv(k), rvo(k);
+        vector<Point3> rp(k), rpo(k);
+        vector<Vertex> rverts(k);
+        for (int i=0; i<k; i++)
+        {
+            rq[i] = UnitQuaternion(Quaternion(sinf(0.5f*i), 0.25f - cosf(0.8f*i), 0.5f, cosf(1.7f*i)));
+            rv[i] = SampleVector(i); rp[i] = SamplePoint(i);
+            rverts[i].p = rp[i]; rverts[i].n = rv[i];
+        }
+        SoA<UnitQuaternion> rqs(rq);
+        SoA<Vector3> rvs(rv), rvso(k);
+        SoA<Point3> rps(rp), rpso(k);
+        TransformVectors(uq0, rv, rvo);
+        TransformVectors(uq0, rvs, rvso);
+        TransformPoints(uq0, rp, rpo);
+        TransformPoints(uq0, rps, rpso);
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            ok = ok && rvo[i] == R0*rv[i] && rvso.Get(i) == R0*rv[i];
+            ok = ok && rpo[i] == R0*rp[i] && rpso.Get(i) == R0*rp[i];
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        TransformVectors(rq, rv, rvo);
+        TransformVectors(rqs, rvs, rvso);
+        TransformPoints(rq, rp, rpo);
+        TransformPoints(rqs, rps, rpso);
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            const Matrix3 Ri = rq[i].GetRotation();
+            ok = ok && rvo[i] == Ri*rv[i] && rvso.Get(i) == Ri*rv[i];
+            ok = ok && rpo[i] == Ri*rp[i] && rpso.Get(i) == Ri*rp[i];
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        StridedSpan<Vector3> rn(&rverts[0].n, k, sizeof(Vertex));
+        TransformVectors(rq, rn, rn);
+        ok = true;
+        for (int i=0; i<k; i++) ok = ok && rverts[i].n == rq[i].GetRotation()*rv[i] && rverts[i].p == rp[i];
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Unit quaternion and rotation matrix conversions, every SetRotation() case included
+        vector<UnitQuaternion> uq(k), uqo(k);
+        vector<Matrix3> rot(k), roto(k);
+        for (int i=0; i<k; i++)
+        {
+            uq[i] = UnitQuaternion(Quaternion(sinf(0.7f*i), cosf(1.3f*i), sinf(0.4f*i + 1.0f), cosf(0.9f*i)));
+            rot[i] = uq[i].GetRotation();
+        }
+        SoA<UnitQuaternion> uqs(uq), uqso(k);
+        SoA<Matrix3> rots(rot), rotso(k);
+        QuaternionsToRotations(uq, roto);
+        QuaternionsToRotations(uqs, rotso);
+        ok = true;
+        for (int i=0; i<k; i++) ok = ok && roto[i] == rot[i] && rotso.Get(i) == rot[i];
+        IS_TRUE(ok); counter.SetCount(ok);
+        RotationsToQuaternions(rot, uqo);
+        RotationsToQuaternions(rots, uqso);
+        ok = true;
+        for (int i=0; i<k; i++)
+        {
+            const UnitQuaternion e(rot[i]);
+            ok = ok && uqo[i] == e && uqso.Get(i) == e && (e == uq[i] || e == -1.0f*uq[i]);
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Print("Testing batch transform methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "       BATCH TRANSFORM UNIT TESTING        " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "  ALL BATCH TRANSFORM TESTS HAVE FINISHED  " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestTransformHierarchy
+{
+    Counter counter;
+    //! Deterministic local transform of node i: a rotation, a scale and a translation
+    static Transform4 Sample(int i)
+    {
+        return ComposeTRS(Point3(0.5f*(i % 5) - 1.0f, 0.25f*(i % 3), 1.0f - 0.125f*(i % 7)),
+            Quaternion(Vector3(0.25f*(i % 4), 1.0f, -0.5f*(i % 3)), 0.4f + 0.1f*(i % 9)), Vector3(1.0f, 0.75f + 0.125f*(i % 4), 1.0f));
+    }
+    //! World transforms by walking the nodes in index order, parents first
+    static vector<Transform4> Reference(const TransformHierarchy& H)
+    {
+        vector<Transform4> w(H.Size());
+        for (int i=0; i<H.Size(); i++)
+            w[i] = (H.GetParent(i) == TransformHierarchy::NoParent) ? H.GetLocal(i) : w[H.GetParent(i)]*H.GetLocal(i);
+        return w;
+    }
+    static bool MatchesReference(const TransformHierarchy& H)
+    {
+        vector<Transform4> w = Reference(H);
+        bool ok = true;
+        for (int i=0; i<H.Size(); i++) ok = ok && H.GetWorld(i) == w[i];
+        return ok;
+    }
+    void Initialize(void)
+    {
+        Print("Testing transform hierarchy initialization...");
+
+        TransformHierarchy H;
+        IS_EQUAL(H.Size(), 0); counter.SetCount(H.Size() == 0);
+        IS_EQUAL(H.Levels(), 0); counter.SetCount(H.Levels() == 0);
+        int r = H.AddNode(Sample(0));
+        int c = H.AddNode(Sample(1), r);
+        int g = H.AddNode(Sample(2), c);
+        IS_TRUE(r == 0 && c == 1 && g == 2); counter.SetCount(r == 0 && c == 1 && g == 2);
+        IS_TRUE(H.GetParent(g) == c && H.GetParent(r) == TransformHierarchy::NoParent);
+        counter.SetCount(H.GetParent(g) == c && H.GetParent(r) == TransformHierarchy::NoParent);
+        IS_TRUE(H.GetDepth(g) == 2 && H.Levels() == 3); counter.SetCount(H.GetDepth(g) == 2 && H.Levels() == 3);
+        IS_EQUAL(H.AddNode(Sample(3), 7), TransformHierarchy::NoParent);
+        counter.SetCount(H.AddNode(Sample(3), 7) == TransformHierarchy::NoParent && H.Size() == 3);
+        IS_TRUE(H.IsDirty(g)); counter.SetCount(H.IsDirty(g));
+
+        Print("Testing transform hierarchy initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing transform hierarchy methods...");
+
+        // Nodes added out of depth order are sorted by the first update, their indices unchanged
+        TransformHierarchy H;
+        int r0 = H.AddNode(Sample(0));
+        int c1 = H.AddNode(Sample(1), r0);
+        int g2 = H.AddNode(Sample(2), c1);
+        int r3 = H.AddNode(Sample(3));
+        int c4 = H.AddNode(Sample(4), r3);
+        int g5 = H.AddNode(Sample(5), c1);
+        H.Update();
+        IS_EQUAL(H.GetWorld(g2), Sample(0)*Sample(1)*Sample(2)); counter.SetCount(H.GetWorld(g2) == Sample(0)*Sample(1)*Sample(2));
+        IS_EQUAL(H.GetWorld(c4), Sample(3)*Sample(4)); counter.SetCount(H.GetWorld(c4) == Sample(3)*Sample(4));
+        IS_TRUE(H.GetParent(g5) == c1 && H.GetDepth(c4) == 1 && H.Levels() == 3);
+        counter.SetCount(H.GetParent(g5) == c1 && H.GetDepth(c4) == 1 && H.Levels() == 3);
+        IS_FALSE(H.IsDirty(g2)); counter.SetCount(!H.IsDirty(g2));
+
+        // Changing a node dirties its subtree only
+        H.SetLocal(c1, Sample(6));
+        IS_TRUE(H.IsDirty(g2) && H.IsDirty(g5) && !H.IsDirty(r0) && !H.IsDirty(c4));
+        counter.SetCount(H.IsDirty(g2) && H.IsDirty(g5) && !H.IsDirty(r0) && !H.IsDirty(c4));
+        H.Update();
+        IS_EQUAL(H.GetWorld(g5), Sample(0)*Sample(6)*Sample(5)); counter.SetCount(H.GetWorld(g5) == Sample(0)*Sample(6)*Sample(5));
+        IS_TRUE(MatchesReference(H) && !H.IsDirty(g5)); counter.SetCount(MatchesReference(H) && !H.IsDirty(g5));
+
+        // A larger forest, every node under a pseudo-random earlier one
+        TransformHierarchy F;
+        const int n = 3000;
+        for (int i=0; i<n; i++) F.AddNode(Sample(i), (i % 97 == 0) ? TransformHierarchy::NoParent : int((i*7919u) % i));
+        F.Update();
+        IS_TRUE(MatchesReference(F)); counter.SetCount(MatchesReference(F));
+        for (int i=5; i<n; i += 211) F.SetLocal(i, Sample(i + 1));
+        F.SetLocal(0, Sample(11));
+        F.Update();
+        IS_TRUE(MatchesReference(F)); counter.SetCount(MatchesReference(F));
+        // A clean update changes nothing, and a full one agrees with the incremental ones
+        vector<Transform4> before = Reference(F);
+        F.Update();
+        F.UpdateAll();
+        bool same = true;
+        for (int i=0; i<n; i++) same = same && F.GetWorld(i) == before[i];
+        IS_TRUE(same); counter.SetCount(same);
+
+        Print("Testing transform hierarchy methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "     TRANSFORM HIERARCHY UNIT TESTING      " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "  ALL TRANSFORM HIERARCHY TESTS HAVE FINISHED" << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+
+struct TestAnimationClip
+{
+    Counter counter;
+    static const int bones = 13, frames = 9;
+    vector<Quaternion> rotation;
+    vector<Point3> translation;
+    vector<Vector3> scale;
+    //! Deterministic keys of a 13 bone, 9 frame clip: bone 3 is constant and the rotation of
+    //! bone 5 flips hemisphere between frames
+    TestAnimationClip() : rotation(bones*frames), translation(bones*frames), scale(bones*frames)
+    {
+        for (int f=0; f<frames; f++)
+            for (int b=0; b<bones; b++)
+            {
+                const int i = f*bones + b, s = (b == 3) ? 0 : f;
+                const float a = 0.2f*s + 0.3f*b;
+                Vector3 axis = Normalize(Vector3(1.0f, 0.5f*(b % 3), -0.25f*b));
+                rotation[i] = Quaternion(axis*sinf(a), cosf(a));
+                if (b == 5 && f % 2) rotation[i] = Quaternion(-rotation[i].x, -rotation[i].y, -rotation[i].z, -rotation[i].w);
+                translation[i] = Point3(0.5f*s - 1.0f, 0.1f*b, 2.0f - 0.02f*s*s);
+                scale[i] = Vector3(1.0f, 1.0f + 0.05f*s, 2.0f - 0.01f*b*s);
+            }
+    }
+    //! Largest component difference between two quaternions, up to sign
+    static float QuaternionError(const Quaternion& a, const Quaternion& b)
+    {
+        const float s = (a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w < 0.0f) ? -1.0f : 1.0f;
+        return max(max(fabsf(a.x - s*b.x), fabsf(a.y - s*b.y)), max(fabsf(a.z - s*b.z), fabsf(a.w - s*b.w)));
+    }
+    static float VectorError(const Vector3& a, const Vector3& b) {return max(max(fabsf(a.x - b.x), fabsf(a.y - b.y)), fabsf(a.z - b.z));}
+    void Initialize(void)
+    {
+        Print("Testing animation clip initialization...");
+
+        AnimationClip E;
+        IS_TRUE(E.Bones() == 0 && E.Frames() == 0); counter.SetCount(E.Bones() == 0 && E.Frames() == 0);
+        IS_EQUAL(E.Bytes(), sizeof(AnimationClipHeader)); counter.SetCount(E.Bytes() == sizeof(AnimationClipHeader));
+        IS_EQUAL(sizeof(AnimationClipHeader), 32); counter.SetCount(sizeof(AnimationClipHeader) == 32);
+
+        AnimationClip A(bones, frames, 30.0f, rotation.data(), translation.data(), scale.data());
+        IS_TRUE(A.Bones() == bones && A.Frames() == frames); counter.SetCount(A.Bones() == bones && A.Frames() == frames);
+        IS_CLOSE(A.Duration(), 8.0f/30.0f); counter.SetCount(fabsf(A.Duration() - 8.0f/30.0f) < 1e-6f);
+        // Two groups: 32 bytes of header, 640 bytes of ranges and 160 bytes per frame per group
+        IS_EQUAL(A.Bytes(), 32u + 2*640u + frames*2*160u); counter.SetCount(A.Bytes() == 32u + 2*640u + frames*2*160u);
+
+        Print("Testing animation clip initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing animation clip methods...");
+
+        AnimationClip A(bones, frames, 30.0f, rotation.data(), translation.data(), scale.data());
+        Quaternion q;
+        Point3 p;
+        Vector3 s;
+        // Keys come back within half a step, 1/131070 of their track range, here at most 4
+        float eq = 0.0f, ev = 0.0f;
+        for (int f=0; f<frames; f++)
+            for (int b=0; b<bones; b++)
+            {
+                A.SampleBone(b, f/30.0f, q, p, s);
+                const int i = f*bones + b;
+                eq = max(eq, QuaternionError(q, rotation[i]));
+                ev = max(ev, max(VectorError(p, translation[i]), VectorError(s, scale[i])));
+            }
+        IS_LESS(eq, 1e-4f); counter.SetCount(eq < 1e-4f);
+        IS_LESS(ev, 1e-4f); counter.SetCount(ev < 1e-4f);
+
+        // Between keys: Nlerp() of the rotations along the short arc and lerp of the rest
+        eq = 0.0f; ev = 0.0f;
+        for (int b=0; b<bones; b++)
+        {
+            A.SampleBone(b, 4.25f/30.0f, q, p, s);
+            const int i = 4*bones + b, j = i + bones;
+            eq = max(eq, QuaternionError(q, Nlerp(rotation[i], rotation[j], 0.25f)));
+            ev = max(ev, VectorError(p, translation[i] + (translation[j] - translation[i])*0.25f));
+            ev = max(ev, VectorError(s, scale[i] + (scale[j] - scale[i])*0.25f));
+        }
+        IS_LESS(eq, 1e-4f); counter.SetCount(eq < 1e-4f);
+        IS_LESS(ev, 1e-4f); counter.SetCount(ev < 1e-4f);
+        bool ok = true;
+        A.SampleBone(3, 0.1f, q, p, s);
+        ok = ok && QuaternionError(q, rotation[3]) < 1e-6f && p == translation[3] && s == scale[3];
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // Times outside the clip are clamped to its ends
+        Quaternion q0, q1;
+        Point3 p0, p1;
+        Vector3 s0, s1;
+        A.SampleBone(7, -1.0f, q, p, s);
+        A.SampleBone(7, 0.0f, q0, p0, s0);
+        ok = QuaternionError(q, q0) == 0.0f && p == p0 && s == s0;
+        A.SampleBone(7, 10.0f, q, p, s);
+        A.SampleBone(7, A.Duration(), q1, p1, s1);
+        ok = ok && QuaternionError(q, q1) == 0.0f && p == p1 && s == s1;
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        // The pose sampler against the single bone one, with a padded last group
+        SoA<Quaternion> rq(bones);
+        SoA<Point3> rp(bones);
+        SoA<Vector3> rs(bones);
+        float err = 0.0f;
+        for (float t : {0.0f, 0.05f, 4.25f/30.0f, 1.0f})
+        {
+            A.SamplePose(t, rq, rp, rs);
+            for (int b=0; b<bones; b++)
+            {
+                A.SampleBone(b, t, q, p, s);
+                err = max(err, max(QuaternionError(q, rq.Get(b)), max(VectorError(p, rp.Get(b)), VectorError(s, rs.Get(b)))));
+            }
+        }
+        IS_LESS(err, 1e-6f); counter.SetCount(err < 1e-6f);
+
+        // A view of the bytes, as mapped from a file, samples like the clip
+        vector<uint32_t> file((A.Bytes() + 3)/4);
+        memcpy(file.data(), A.Data(), A.Bytes());
+        AnimationClip V;
+        IS_TRUE(V.View(file.data(), A.Bytes())); counter.SetCount(V.View(file.data(), A.Bytes()));
+        ok = V.Data() == reinterpret_cast<const uint8_t *>(file.data()) && V.Bones() == bones && V.Frames() == frames;
+        AnimationClip C = V;
+        for (int b=0; b<bones; b++)
+        {
+            A.SampleBone(b, 0.123f, q, p, s);
+            C.SampleBone(b, 0.123f, q0, p0, s0);
+            ok = ok && QuaternionError(q, q0) == 0.0f && p == p0 && s == s0;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        ok = !V.View(file.data(), A.Bytes() - 1) && V.Bones() == 0;
+        // Bones without any frame of keys
+        file[offsetof(AnimationClipHeader, frames)/4] = 0u;
+        ok = ok && !V.View(file.data(), A.Bytes()) && V.Bones() == 0;
+        file[0] ^= 1u;
+        ok = ok && !V.View(file.data(), A.Bytes());
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Print("Testing animation clip methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "        ANIMATION CLIP UNIT TESTING        " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "    ALL ANIMATION CLIP TESTS HAVE FINISHED " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+
+struct TestSkinning
+{
+    Counter counter;
+    static const int bones = 6;
+    vector<Transform4> palette;
+    vector<DualQuaternion> dq;
+    //! Rigid palette: bone b rotates about its own axis and translates
+    TestSkinning()
+    {
+        for (int b=0; b<bones; b++)
+        {
+            const float a = 0.4f + 0.5f*b;
+            Quaternion q(Normalize(Vector3(1.0f, 0.3f*b, -0.2f*(b % 3)))*sinf(a), cosf(a));
+            Point3 t(0.5f*b - 1.0f, 0.25f*(b % 2), 2.0f - 0.3f*b);
+            palette.push_back(ComposeTRS(t, q, Vector3(1.0f, 1.0f, 1.0f)));
+            dq.push_back(DualQuaternion(UnitQuaternion::FromNormalized(q), t));
+        }
+    }
+    //! Influences of vertex i: distinct bones, weights adding up to 1, some vertices on one bone
+    static void Influences(int i, uint16_t *b, Vector4& w)
+    {
+        for (int k=0; k<MATH_SKINNING_INFLUENCES; k++) b[k] = uint16_t((i + 2*k) % bones);
+        w = (i % 5 == 0) ? Vector4(1.0f, 0.0f, 0.0f, 0.0f) : Vector4(0.4f, 0.3f, 0.2f + 0.01f*(i % 7), 0.1f - 0.01f*(i % 7));
+    }
+    static Point3 Position(int i) {return Point3(0.1f*(i % 11) - 0.5f, 0.05f*(i % 13), 1.0f - 0.02f*(i % 17));}
+    static Vector3 Normal(int i) {return Normalize(Vector3(1.0f, 0.1f*(i % 9) - 0.4f, 0.5f));}
+    static float Error(const Vector3& a, const Vector3& b) {return max(max(fabsf(a.x - b.x), fabsf(a.y - b.y)), fabsf(a.z - b.z));}
+    //! T applied to a point, translation included (operator*(Transform4, Point3) leaves it out)
+    static Vector3 Apply(const Transform4& T, const Point3& p) {return Vector3(T*p) + Vector3(T.GetTranslation());}
+    void Initialize(void)
+    {
+        Print("Testing dual quaternion initialization...");
+
+        DualQuaternion I;
+        IS_TRUE(I.real == Quaternion(0.0f, 0.0f, 0.0f, 1.0f) && I.GetTranslation() == Vector3(0.0f, 0.0f, 0.0f));
+        counter.SetCount(I.real == Quaternion(0.0f, 0.0f, 0.0f, 1.0f) && I.GetTranslation() == Vector3(0.0f, 0.0f, 0.0f));
+        IS_EQUAL(sizeof(DualQuaternion), 32); counter.SetCount(sizeof(DualQuaternion) == 32);
+        DualQuaternion T(UnitQuaternion(), Vector3(1.0f, -2.0f, 3.0f));
+        IS_TRUE(T.GetTranslation() == Vector3(1.0f, -2.0f, 3.0f)); counter.SetCount(T.GetTranslation() == Vector3(1.0f, -2.0f, 3.0f));
+        DualQuaternion D(palette[3]);
+        bool ok = D.GetTranslation() == dq[3].GetTranslation();
+        const float dot = D.real.x*dq[3].real.x + D.real.y*dq[3].real.y + D.real.z*dq[3].real.z + D.real.w*dq[3].real.w;
+        ok = ok && fabsf(fabsf(dot) - 1.0f) < 1e-5f;
+        IS_TRUE(ok); counter.SetCount(ok);
+
+        Print("Testing dual quaternion initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing skinning methods...");
+
+        // Dual quaternions transform like the matrices they come from, products included
+        float err = 0.0f;
+        for (int i=0; i<50; i++)
+        {
+            const int a = i % bones, b = (i + 1) % bones;
+            err = max(err, Error(Transform(Position(i), dq[a]), Apply(palette[a], Position(i))));
+            err = max(err, Error(Transform(Position(i), dq[a]*dq[b]), Apply(palette[a]*palette[b], Position(i))));
+        }
+        IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+        DualQuaternion s(dq[2].real*2.0f, dq[2].dual*2.0f);
+        IS_TRUE(Transform(Position(4), Normalize(s)) == Transform(Position(4), dq[2]));
+        counter.SetCount(Transform(Position(4), Normalize(s)) == Transform(Position(4), dq[2]));
+
+        // Batch kernels against per-vertex references: whole packets, a partial one and one split
+        // across threads when the machine has several cores
+        for (int m : {37, 2*MATH_SKINNING_PARALLEL_GRAIN + 3})
+        {
+            vector<uint16_t> b(MATH_SKINNING_INFLUENCES*m);
+            SoA<Vector4> w(m);
+            SoA<Point3> p(m), op(m), dp(m);
+            SoA<Vector3> nrm(m), on(m), dn(m);
+            for (int i=0; i<m; i++)
+            {
+                Vector4 wi;
+                Influences(i, &b[MATH_SKINNING_INFLUENCES*i], wi);
+                w.Set(i, wi);
+                p.Set(i, Position(i));
+                nrm.Set(i, Normal(i));
+            }
+            SkinLinear(palette.data(), b.data(), w, p, nrm, op, on);
+            SkinDualQuaternion(dq.data(), b.data(), w, p, nrm, dp, dn);
+            float el = 0.0f, ed = 0.0f, eh = 0.0f;
+            for (int i=0; i<m; i++)
+            {
+                const uint16_t *bi = &b[MATH_SKINNING_INFLUENCES*i];
+                const Vector4 wi = w.Get(i);
+                Vector3 rp(0.0f, 0.0f, 0.0f), rn(0.0f, 0.0f, 0.0f);
+                DualQuaternion sum(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+                for (int k=0; k<MATH_SKINNING_INFLUENCES; k++)
+                {
+                    rp = rp + wi[k]*Apply(palette[bi[k]], Position(i));
+                    rn = rn + wi[k]*(palette[bi[k]]*Normal(i));
+                    const DualQuaternion& q = dq[bi[k]];
+                    const float sg = (q.real.x*dq[bi[0]].real.x + q.real.y*dq[bi[0]].real.y + q.real.z*dq[bi[0]].real.z + q.real.w*dq[bi[0]].real.w < 0.0f) ? -wi[k] : wi[k];
+                    sum = DualQuaternion(sum.real + sg*q.real, sum.dual + sg*q.dual);
+                }
+                el = max(el, max(Error(op.Get(i), rp), Error(on.Get(i), Normalize(rn))));
+                const DualQuaternion d = Normalize(sum);
+                ed = max(ed, max(Error(dp.Get(i), Transform(Position(i), d)), Error(dn.Get(i), Transform(Normal(i), d.GetRotation()))));
+                // Rigid vertices, on a single bone, skin alike either way
+                if (i % 5 == 0) eh = max(eh, max(Error(op.Get(i), dp.Get(i)), Error(on.Get(i), dn.Get(i))));
+            }
+            IS_LESS(el, 1e-5f); counter.SetCount(el < 1e-5f);
+            IS_LESS(ed, 1e-5f); counter.SetCount(ed < 1e-5f);
+            IS_LESS(eh, 1e-5f); counter.SetCount(eh < 1e-5f);
+        }
+
+        // Antipodal palette entries are the same transform, and positions alone skip the normals
+        vector<DualQuaternion> flipped(dq);
+        for (int j=1; j<bones; j += 2) flipped[j] = DualQuaternion(-1.0f*dq[j].real, -1.0f*dq[j].dual);
+        const int m = 19;
+        vector<uint16_t> b(MATH_SKINNING_INFLUENCES*m);
+        SoA<Vector4> w(m);
+        SoA<Point3> p(m), p0(m), p1(m);
+        for (int i=0; i<m; i++)
+        {
+            Vector4 wi;
+            Influences(i, &b[MATH_SKINNING_INFLUENCES*i], wi);
+            w.Set(i, wi);
+            p.Set(i, Position(i));
+        }
+        SkinDualQuaternion(dq.data(), b.data(), w, p, SoASpan<const Vector3>(), p0, SoASpan<Vector3>());
+        SkinDualQuaternion(flipped.data(), b.data(), w, p, SoASpan<const Vector3>(), p1, SoASpan<Vector3>());
+        err = 0.0f;
+        for (int i=0; i<m; i++) err = max(err, Error(p0.Get(i), p1.Get(i)));
+        IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+
+        Print("Testing skinning methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "           SKINNING UNIT TESTING           " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "       ALL SKINNING TESTS HAVE FINISHED    " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestKinematics
+{
+    Counter counter;
+    static const int joints = 5, iterations = 8;
+    //! Joint j of chain c: a bent line of bones between 0.4 and 0.6 long
+    static Vector3 Joint(int c, int j) {return Vector3(0.5f*j + 0.1f*(c % 3), 0.1f*sinf(float(c + j)), 0.1f*cosf(0.3f*c + j));}
+    //! Target of chain c, at reach times the distance from the root to the end effector
+    static Vector3 Target(int c, float reach)
+    {
+        const Vector3 d = Normalize(Vector3(1.0f, 0.3f*sinf(0.7f*c), 0.5f*cosf(1.1f*c)));
+        return Joint(c, 0) + d*(reach*Magnitude(Joint(c, joints - 1) - Joint(c, 0)));
+    }
+    static float Error(const Vector3& a, const Vector3& b) {return max(max(fabsf(a.x - b.x), fabsf(a.y - b.y)), fabsf(a.z - b.z));}
+    static Vector3 Get(const SoA<Point3>& s, int i) {const Point3 p = s.Get(i); return Vector3(p.x, p.y, p.z);}
+    //! Per-chain CCD and FABRIK, in the order of the batch solvers
+    static void ReferenceCCD(Vector3 *p, const Vector3& target)
+    {
+        for (int it=0; it<iterations; it++)
+            for (int j=joints - 2; j>=0; j--)
+            {
+                const Vector3 a = p[joints - 1] - p[j], b = target - p[j];
+                const Quaternion r = Normalize(Quaternion(CrossProduct(a, b), Magnitude(a)*Magnitude(b) + InnerProduct(a, b)));
+                for (int k=j + 1; k<joints; k++) p[k] = p[j] + Transform(p[k] - p[j], UnitQuaternion::FromNormalized(r));
+            }
+    }
+    static void ReferenceFABRIK(Vector3 *p, const Vector3& target)
+    {
+        float length[joints - 1];
+        for (int j=0; j<joints - 1; j++) length[j] = Magnitude(p[j + 1] - p[j]);
+        const Vector3 root = p[0];
+        for (int it=0; it<iterations; it++)
+        {
+            p[joints - 1] = target;
+            for (int j=joints - 2; j>=0; j--) p[j] = p[j + 1] + Normalize(p[j] - p[j + 1])*length[j];
+            p[0] = root;
+            for (int j=0; j<joints - 1; j++) p[j + 1] = p[j] + Normalize(p[j + 1] - p[j])*length[j];
+        }
+    }
+    void Methods(void)
+    {
+        Print("Testing inverse kinematics methods...");
+
+        // Batch solvers against per-chain references: whole packets, a partial one and chains
+        // split across threads when the machine has several cores
+        for (int m : {37, 2*MATH_IK_PARALLEL_GRAIN + 3})
+        {
+            SoA<Point3> t(m), pc(joints*m), pf(joints*m);
+            SoA<Quaternion> rc((joints - 1)*m), rf((joints - 1)*m);
+            for (int c=0; c<m; c++)
+            {
+                const Vector3 g = Target(c, 0.8f);
+                t.Set(c, Point3(g.x, g.y, g.z));
+                for (int j=0; j<joints; j++)
+                {
+                    const Vector3 q = Joint(c, j);
+                    pc.Set(j*m + c, Point3(q.x, q.y, q.z)); pf.Set(j*m + c, Point3(q.x, q.y, q.z));
+                }
+            }
+            SolveCCD(joints, iterations, 0.0f, pc, t, rc);
+            SolveFABRIK(joints, iterations, 0.0f, pf, t, rf);
+            float ec = 0.0f, ef = 0.0f, er = 0.0f, el = 0.0f;
+            for (int c=0; c<m; c++)
+            {
+                Vector3 a[joints], b[joints];
+                for (int j=0; j<joints; j++) a[j] = b[j] = Joint(c, j);
+                ReferenceCCD(a, Get(t, c));
+                ReferenceFABRIK(b, Get(t, c));
+                for (int j=0; j<joints; j++) {ec = max(ec, Error(Get(pc, j*m + c), a[j])); ef = max(ef, Error(Get(pf, j*m + c), b[j]));}
+                // Bone rotations take the bones from where they were to where they are, lengths kept
+                for (int j=0; j<joints - 1; j++)
+                {
+                    const Vector3 d = Joint(c, j + 1) - Joint(c, j);
+                    const Vector3 dc = Get(pc, (j + 1)*m + c) - Get(pc, j*m + c), df = Get(pf, (j + 1)*m + c) - Get(pf, j*m + c);
+                    er = max(er, Error(Transform(d, UnitQuaternion::FromNormalized(rc.Get(j*m + c))), dc));
+                    er = max(er, Error(Transform(d, UnitQuaternion::FromNormalized(rf.Get(j*m + c))), df));
+                    el = max(el, max(fabsf(Magnitude(dc) - Magnitude(d)), fabsf(Magnitude(df) - Magnitude(d))));
+                }
+            }
+            IS_LESS(ec, 1e-4f); counter.SetCount(ec < 1e-4f);
+            IS_LESS(ef, 1e-4f); counter.SetCount(ef < 1e-4f);
+            IS_LESS(er, 1e-4f); counter.SetCount(er < 1e-4f);
+            IS_LESS(el, 1e-4f); counter.SetCount(el < 1e-4f);
+        }
+
+        // Reachable targets are reached, unreachable ones leave the chain stretched towards them,
+        // and chains already within tolerance do not move
+        const int m = 13;
+        for (int solver=0; solver<2; solver++)
+        {
+            SoA<Point3> t(m), far(m), p(joints*m), s(joints*m), q(joints*m);
+            SoA<Quaternion> r((joints - 1)*m);
+            for (int c=0; c<m; c++)
+            {
+                const Vector3 g = Target(c, 0.6f), h = Target(c, 3.0f);
+                t.Set(c, Point3(g.x, g.y, g.z));
+                far.Set(c, Point3(h.x, h.y, h.z));
+                for (int j=0; j<joints; j++)
+                {
+                    const Vector3 v = Joint(c, j);
+                    p.Set(j*m + c, Point3(v.x, v.y, v.z)); s.Set(j*m + c, Point3(v.x, v.y, v.z)); q.Set(j*m + c, Point3(v.x, v.y, v.z));
+                }
+            }
+            auto solve = [&](const SoA<Point3>& target, SoA<Point3>& chain, float tolerance)
+                {(solver == 0 ? SolveCCD : SolveFABRIK)(joints, 64, tolerance, chain, target, r);};
+            solve(t, p, 1e-4f);
+            solve(far, s, 1e-4f);
+            float reach = 0.0f, stretch = 0.0f;
+            for (int c=0; c<m; c++)
+            {
+                reach = max(reach, Magnitude(Get(p, (joints - 1)*m + c) - Get(t, c)));
+                const Vector3 root = Joint(c, 0), dir = Normalize(Get(far, c) - root);
+                float length = 0.0f;
+                for (int j=0; j<joints - 1; j++) length += Magnitude(Joint(c, j + 1) - Joint(c, j));
+                for (int j=0; j<joints; j++)
+                {
+                    const Vector3 v = Get(s, j*m + c) - root;
+                    stretch = max(stretch, Magnitude(v - dir*InnerProduct(v, dir)));
+                }
+                stretch = max(stretch, fabsf(Magnitude(Get(s, (joints - 1)*m + c) - root) - length));
+            }
+            IS_LESS(reach, 2e-4f); counter.SetCount(reach < 2e-4f);
+            IS_LESS(stretch, 1e-3f); counter.SetCount(stretch < 1e-3f);
+
+            for (int c=0; c<m; c++) {const Vector3 e = Joint(c, joints - 1); t.Set(c, Point3(e.x, e.y, e.z));}
+            solve(t, q, 1e-4f);
+            bool still = true;
+            for (int c=0; c<m; c++)
+            {
+                for (int j=0; j<joints; j++) still = still && Get(q, j*m + c) == Joint(c, j);
+                for (int j=0; j<joints - 1; j++) still = still && r.Get(j*m + c) == Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+            }
+            IS_TRUE(still); counter.SetCount(still);
+        }
+
+        Print("Testing inverse kinematics methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "      INVERSE KINEMATICS UNIT TESTING      " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "  ALL INVERSE KINEMATICS TESTS HAVE FINISHED " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestCurves
+{
+    Counter counter;
+    static const int count = 13;
+    vector<Point3> points;
+    //! A spiral of 13 points, widening as it climbs
+    TestCurves() {for (int i=0; i<count; i++) points.push_back(Point3(cosf(0.5f*i)*(1.0f + 0.1f*i), sinf(0.5f*i), 0.2f*i));}
+    static float Error(const Vector3& a, const Vector3& b) {return max(max(fabsf(a.x - b.x), fabsf(a.y - b.y)), fabsf(a.z - b.z));}
+    //! Every kind of curve over the spiral
+    vector<CubicCurve> Curves(void) const
+        {return {CubicCurve::Bezier(points.data(), count), CubicCurve::CatmullRom(points.data(), count), CubicCurve::BSpline(points.data(), count)};}
+    void Initialize(void)
+    {
+        Print("Testing curve initialization...");
+
+        IS_EQUAL(CubicCurve::Bezier(points.data(), count).Segments(), 4); counter.SetCount(CubicCurve::Bezier(points.data(), count).Segments() == 4);
+        IS_EQUAL(CubicCurve::CatmullRom(points.data(), count).Segments(), 12); counter.SetCount(CubicCurve::CatmullRom(points.data(), count).Segments() == 12);
+        IS_EQUAL(CubicCurve::BSpline(points.data(), count).Segments(), 10); counter.SetCount(CubicCurve::BSpline(points.data(), count).Segments() == 10);
+        int thrown = 0;
+        try {CubicCurve::Bezier(points.data(), 5);} catch (const CurveControlPointsE&) {thrown++;}
+        try {CubicCurve::CatmullRom(points.data(), 1);} catch (const CurveControlPointsE&) {thrown++;}
+        try {CubicCurve::BSpline(points.data(), 3);} catch (const CurveControlPointsE&) {thrown++;}
+        IS_EQUAL(thrown, 3); counter.SetCount(thrown == 3);
+
+        Print("Testing curve initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing curve methods...");
+
+        // Bezier and Catmull-Rom curves pass through their points, Bezier tangent to the polygon
+        const vector<CubicCurve> curves = Curves();
+        float err = 0.0f;
+        for (int s=0; s<=4; s++) err = max(err, Error(curves[0].Evaluate(float(s)), points[3*s]));
+        for (int i=0; i<count; i++) err = max(err, Error(curves[1].Evaluate(float(i)), points[i]));
+        err = max(err, Error(curves[0].Derivative(0.0f), 3.0f*(points[1] - points[0])));
+        IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+        // Evenly spaced points on a line give a line at unit speed: from the second point for the
+        // B-spline, from the first for Catmull-Rom with its mirrored ends
+        vector<Point3> line;
+        for (int i=0; i<6; i++) line.push_back(Point3(float(i), 0.0f, 0.0f));
+        const CubicCurve b = CubicCurve::BSpline(line.data(), 6), c = CubicCurve::CatmullRom(line.data(), 6);
+        err = 0.0f;
+        for (int i=0; i<=20; i++)
+        {
+            const float u = 0.25f*i;
+            err = max(err, Error(b.Evaluate(u), Point3(min(u, 3.0f) + 1.0f, 0.0f, 0.0f)));
+            err = max(err, Error(c.Evaluate(u), Point3(min(u, 5.0f), 0.0f, 0.0f)));
+            err = max(err, max(Error(b.Derivative(u), Vector3(1.0f, 0.0f, 0.0f)), Error(c.Derivative(u), Vector3(1.0f, 0.0f, 0.0f))));
+        }
+        IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+        IS_TRUE(fabsf(c.Length() - 5.0f) < 1e-5f && fabsf(c.ParameterAtLength(1.75f) - 1.75f) < 1e-5f);
+        counter.SetCount(fabsf(c.Length() - 5.0f) < 1e-5f && fabsf(c.ParameterAtLength(1.75f) - 1.75f) < 1e-5f);
+
+        for (const CubicCurve& k : curves)
+        {
+            const int S = k.Segments();
+            // Arc lengths against a fine polyline, and ParameterAtLength() inverting LengthAt()
+            double polyline = 0.0;
+            for (int i=1; i<=20000; i++) polyline += Magnitude(k.Evaluate(float(S)*i/20000) - k.Evaluate(float(S)*(i - 1)/20000));
+            IS_LESS(fabsf(k.Length() - float(polyline)), 1e-4f*k.Length()); counter.SetCount(fabsf(k.Length() - float(polyline)) < 1e-4f*k.Length());
+            float inverse = 0.0f;
+            for (int i=0; i<=200; i++) {const float s = k.Length()*i/200; inverse = max(inverse, fabsf(k.LengthAt(k.ParameterAtLength(s)) - s));}
+            IS_LESS(inverse, 1e-5f*k.Length()); counter.SetCount(inverse < 1e-5f*k.Length());
+            IS_TRUE(k.ParameterAtLength(-1.0f) == 0.0f && k.ParameterAtLength(2.0f*k.Length()) == float(S));
+            counter.SetCount(k.ParameterAtLength(-1.0f) == 0.0f && k.ParameterAtLength(2.0f*k.Length()) == float(S));
+
+            // Batch evaluation, parameters out of range and a partial packet included
+            const int m = 101;
+            vector<float> u(m), s(m);
+            for (int i=0; i<m; i++) {u[i] = -1.0f + 0.15f*i; s[i] = k.Length()*(0.011f*i - 0.05f);}
+            SoA<Point3> pu(m), ps(m);
+            k.Evaluate(u.data(), m, pu);
+            k.EvaluateAtLength(s.data(), m, ps);
+            err = 0.0f;
+            for (int i=0; i<m; i++) err = max(err, max(Error(pu.Get(i), k.Evaluate(u[i])), Error(ps.Get(i), k.EvaluateAtLength(s[i]))));
+            IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+            // Forward differencing, with steps of one sample, of a partial packet and of restarted tables
+            err = 0.0f;
+            for (int steps : {1, 13, 1024})
+            {
+                SoA<Point3> p(S*steps + 1);
+                k.SampleUniform(steps, p);
+                for (int i=0; i<=S*steps; i++) err = max(err, Error(p.Get(i), k.Evaluate(float(i)/steps)));
+            }
+            IS_LESS(err, 1e-5f); counter.SetCount(err < 1e-5f);
+        }
+
+        Print("Testing curve methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "            CURVES UNIT TESTING            " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "        ALL CURVES TESTS HAVE FINISHED     " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
+struct TestMatrixX
+{
+    Counter counter;
+    //! Deterministic sample entries in [-1, 1]
+    static MatrixX Sample(int r, int c, float shift = 0.0f)
+    {
+        return MatrixX::Generate(r, c, [&](int i, int j) {return sinf(1.3f*i + 2.9f*j + 0.7f*i*j) + (i == j ? shift : 0.0f);});
+    }
+    //! Largest absolute difference between two matrices of the same size
+    static float MaxDiff(const MatrixX& A, const MatrixX& B)
+    {
+        float d = 0.0f;
+        for (int j=0; j<A.Cols(); j++)
+            for (int i=0; i<A.Rows(); i++) d = max(d, fabsf(A(i,j) - B(i,j)));
+        return d;
+    }
+    void Initialize(void)
+    {
+        Print("Testing MatrixX initialization...");
+
+        MatrixX E;
+        IS_EQUAL(E.Rows(), 0); counter.SetCount(E.Rows() == 0);
+        IS_EQUAL(E.Cols(), 0); counter.SetCount(E.Cols() == 0);
+        MatrixX Z(3, 5);
+        IS_EQUAL(Z.Rows(), 3); counter.SetCount(Z.Rows() == 3);
+        IS_EQUAL(Z.Cols(), 5); counter.SetCount(Z.Cols() == 5);
+        IS_EQUAL(Z(2,4), 0.0f); counter.SetCount(Z(2,4) == 0.0f);
+        IS_TRUE(Z == MatrixX::Zero(3, 5)); counter.SetCount(Z == MatrixX::Zero(3, 5));
+        const float values[6] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+        MatrixX M(2, 3, values);
+        IS_EQUAL(M(0,2), 3.0f); counter.SetCount(M(0,2) == 3.0f);
+        IS_EQUAL(M(1,0), 4.0f); counter.SetCount(M(1,0) == 4.0f);
+        MatrixX I = MatrixX::Identity(4);
+        IS_EQUAL(I(3,3), 1.0f); counter.SetCount(I(3,3) == 1.0f);
+        IS_EQUAL(I(1,2), 0.0f); counter.SetCount(I(1,2) == 0.0f);
+        Matrix4 F(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f, 12.0f, 13.0f, 14.0f, 15.0f, 16.0f);
+        MatrixX X(F);
+        IS_EQUAL(X(1,3), 8.0f); counter.SetCount(X(1,3) == 8.0f);
+        IS_EQUAL(X(3,0), 13.0f); counter.SetCount(X(3,0) == 13.0f);
+        MatrixX C = M;
+        IS_TRUE(C == M); counter.SetCount(C == M);
+        MatrixX D = move(C);
+        IS_TRUE(D == M); counter.SetCount(D == M);
+        IS_EQUAL(C.Rows(), 0); counter.SetCount(C.Rows() == 0);
+
+        Print("Testing MatrixX initialization complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void MemoryPlacement(void)
+    {
+        Print("Testing MatrixX memory placement...");
+
+        MatrixX A = Sample(13, 3);
+        IS_EQUAL(A.Stride(), 16); counter.SetCount(A.Stride() == 16);
+        IS_EQUAL(&A(0,1), A.Col(0) + 16); counter.SetCount(&A(0,1) == A.Col(0) + 16);
+        IS_EQUAL(&A(5,2), A.Col(2) + 5); counter.SetCount(&A(5,2) == A.Col(2) + 5);
+        IS_EQUAL(uintptr_t(A.Col(0)) % MATH_BATCH_ALIGNMENT, uintptr_t(0)); counter.SetCount(uintptr_t(A.Col(0)) % MATH_BATCH_ALIGNMENT == 0);
+        // Padding rows stay zero through the operators and factorizations
+        MatrixX B = A*Transpose(Sample(3, 3)) - A;
+        QRDecomposition qr(A);
+        bool zero = true;
+        for (int j=0; j<3; j++)
+            for (int i=13; i<16; i++) zero = zero && B.Col(j)[i] == 0.0f && qr.QR.Col(j)[i] == 0.0f;
+        IS_TRUE(zero); counter.SetCount(zero);
+
+        Print("Testing MatrixX memory placement complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void ClassOperators(void)
+    {
+        Print("Testing MatrixX class operators...");
+
+        const float a[4] = {1.0f, 2.0f, 3.0f, 4.0f}, b[4] = {5.0f, 6.0f, 7.0f, 8.0f};
+        MatrixX A(2, 2, a), B(2, 2, b);
+        const float sum[4] = {6.0f, 8.0f, 10.0f, 12.0f}, diff[4] = {-4.0f, -4.0f, -4.0f, -4.0f};
+        const float prod[4] = {19.0f, 22.0f, 43.0f, 50.0f}, twice[4] = {2.0f, 4.0f, 6.0f, 8.0f};
+        IS_TRUE(A + B == MatrixX(2, 2, sum)); counter.SetCount(A + B == MatrixX(2, 2, sum));
+        IS_TRUE(A - B == MatrixX(2, 2, diff)); counter.SetCount(A - B == MatrixX(2, 2, diff));
+        IS_TRUE(A*B == MatrixX(2, 2, prod)); counter.SetCount(A*B == MatrixX(2, 2, prod));
+        IS_TRUE(2.0f*A == MatrixX(2, 2, twice)); counter.SetCount(2.0f*A == MatrixX(2, 2, twice));
+        IS_TRUE(-A == A*-1.0f); counter.SetCount(-A == A*-1.0f);
+        IS_TRUE(A != B); counter.SetCount(A != B);
+        IS_TRUE(A != MatrixX(2, 3)); counter.SetCount(A != MatrixX(2, 3));
+        IS_EQUAL((A*MatrixX(3, 2)).Rows(), 0); counter.SetCount((A*MatrixX(3, 2)).Rows() == 0);
+        // Mismatched sums: empty results, and the compound operators leave the matrix unchanged
+        IS_EQUAL((A + MatrixX(3, 2)).Rows(), 0); counter.SetCount((A + MatrixX(3, 2)).Rows() == 0);
+        IS_EQUAL((A - MatrixX(2, 3)).Rows(), 0); counter.SetCount((A - MatrixX(2, 3)).Rows() == 0);
+        MatrixX C = A;
+        C += MatrixX(3, 3);
+        C -= MatrixX(2, 1);
+        IS_TRUE(C == A); counter.SetCount(C == A);
+        vector<float> y = A*vector<float>{1.0f, -1.0f};
+        IS_TRUE(y.size() == 2 && y[0] == -1.0f && y[1] == -1.0f); counter.SetCount(y.size() == 2 && y[0] == -1.0f && y[1] == -1.0f);
+
+        // Blocked products over every tail case against the naive triple loop
+        bool ok = true;
+        const int sizes[4][3] = {{1, 1, 1}, {7, 5, 3}, {45, 37, 29}, {133, 9, 270}};
+        for (auto& s : sizes)
+        {
+            MatrixX P = Sample(s[0], s[2]), Q = Sample(s[2], s[1], 0.5f);
+            MatrixX R = MatrixX::Generate(s[0], s[1], [&](int i, int j)
+            {
+                float t = 0.0f;
+                for (int p=0; p<s[2]; p++) t += P(i,p)*Q(p,j);
+                return t;
+            });
+            ok = ok && MaxDiff(P*Q, R) < 1e-4f && MaxDiff(TransposeTimes(Transpose(P), Q), R) < 1e-4f;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        Matrix4 F(1.0f, 2.0f, 3.0f, 4.0f, 2.0f, 0.5f, -1.0f, 3.0f, 0.0f, 1.0f, 2.0f, -2.0f, 1.0f, 1.0f, 0.0f, 1.0f);
+        IS_TRUE(MatrixX(F)*MatrixX(F) == MatrixX(F*F)); counter.SetCount(MatrixX(F)*MatrixX(F) == MatrixX(F*F));
+
+        Print("Testing MatrixX class operators complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void Methods(void)
+    {
+        Print("Testing MatrixX methods...");
+
+        // LU, over one and several blocks
+        bool ok = true;
+        for (int n : {1, 5, 37, 70})
+        {
+            MatrixX A = Sample(n, n, 2.0f);
+            LUDecomposition lu(A);
+            MatrixX PA = MatrixX::Generate(n, n, [&](int i, int j) {return A(lu.pivot[i],j);});
+            ok = ok && !lu.singular && MaxDiff(lu.L()*lu.U(), PA) < 1e-4f;
+            vector<float> x(n);
+            for (int i=0; i<n; i++) x[i] = 1.0f - 0.125f*(i % 9);
+            vector<float> s = lu.Solve(A*x);
+            for (int i=0; i<n; i++) ok = ok && fabsf(s[i] - x[i]) < 1e-3f;
+            ok = ok && MaxDiff(A*lu.Inverse(), MatrixX::Identity(n)) < 1e-3f;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        // Zero leading pivot
+        const float swapped[9] = {0.0f, 1.0f, 2.0f, 1.0f, 0.0f, 3.0f, 4.0f, -3.0f, 8.0f};
+        LUDecomposition sw(MatrixX(3, 3, swapped));
+        IS_FALSE(sw.singular); counter.SetCount(!sw.singular);
+        IS_TRUE(CloseFloat(sw.Det(), -2.0f)); counter.SetCount(CloseFloat(sw.Det(), -2.0f));
+        vector<float> xs = sw.Solve(vector<float>{3.0f, 4.0f, 9.0f});
+        IS_TRUE(CloseFloat(xs[0], 1.0f) && CloseFloat(xs[1], 1.0f) && CloseFloat(xs[2], 1.0f)); counter.SetCount(CloseFloat(xs[0], 1.0f) && CloseFloat(xs[1], 1.0f) && CloseFloat(xs[2], 1.0f));
+        // Singular and non square matrices are reported, not thrown
+        const float rank2[9] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f};
+        MatrixX S(3, 3, rank2), inv;
+        float det = 1.0f;
+        IS_FALSE(LUDecomposition().Factor(S)); counter.SetCount(!LUDecomposition().Factor(S));
+        IS_FALSE(TryInverse(S, inv, det)); counter.SetCount(!TryInverse(S, inv, det));
+        IS_TRUE(inv == MatrixX(3, 3) && det == 0.0f); counter.SetCount(inv == MatrixX(3, 3) && det == 0.0f);
+        IS_EQUAL(Det(S), 0.0f); counter.SetCount(Det(S) == 0.0f);
+        IS_FALSE(LUDecomposition().Factor(MatrixX(2, 3))); counter.SetCount(!LUDecomposition().Factor(MatrixX(2, 3)));
+        MatrixX X;
+        IS_FALSE(TrySolve(S, MatrixX(3, 1), X)); counter.SetCount(!TrySolve(S, MatrixX(3, 1), X));
+        // Agrees with the fixed size Matrix4 functions
+        Matrix4 F(2.0f, 1.0f, 0.0f, 3.0f, 1.0f, 4.0f, 1.0f, 0.0f, 0.0f, 2.0f, 5.0f, 1.0f, 1.0f, 0.0f, 1.0f, 3.0f);
+        IS_TRUE(TryInverse(MatrixX(F), inv, det)); counter.SetCount(TryInverse(MatrixX(F), inv, det));
+        IS_TRUE(inv == MatrixX(Inverse(F))); counter.SetCount(inv == MatrixX(Inverse(F)));
+        IS_TRUE(fabsf(det - Det(F)) < 1e-4f); counter.SetCount(fabsf(det - Det(F)) < 1e-4f);
+        IS_TRUE(TrySolve(MatrixX(F), MatrixX::Identity(4), X) && X == inv); counter.SetCount(TrySolve(MatrixX(F), MatrixX::Identity(4), X) && X == inv);
+
+        // Cholesky of A^T*A/n + I
+        ok = true;
+        for (int n : {3, 37, 70})
+        {
+            MatrixX A = Sample(n, n);
+            MatrixX S = TransposeTimes(A, A)*(1.0f/n) + MatrixX::Identity(n);
+            CholeskyDecomposition ch(S);
+            ok = ok && ch.positiveDefinite && MaxDiff(ch.L*Transpose(ch.L), S) < 1e-5f*n;
+            ok = ok && MaxDiff(S*ch.Solve(MatrixX::Identity(n)), MatrixX::Identity(n)) < 1e-3f;
+            ok = ok && fabsf(ch.Det() - LUDecomposition(S).Det()) <= 1e-3f*fabsf(ch.Det());
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        const float indefinite[4] = {1.0f, 2.0f, 2.0f, 1.0f};
+        CholeskyDecomposition nd(MatrixX(2, 2, indefinite));
+        IS_FALSE(nd.positiveDefinite); counter.SetCount(!nd.positiveDefinite);
+        IS_EQUAL(nd.Det(), 0.0f); counter.SetCount(nd.Det() == 0.0f);
+
+        // QR of tall matrices: orthonormal Q, Q*R = A, least squares through the normal equations
+        ok = true;
+        for (int m : {4, 50, 90})
+        {
+            const int n = m*3/4 + 1;
+            MatrixX A = Sample(m, n, 1.5f);
+            QRDecomposition qr(A);
+            MatrixX Q = qr.Q();
+            ok = ok && qr.fullRank && MaxDiff(TransposeTimes(Q, Q), MatrixX::Identity(n)) < 1e-5f*m;
+            ok = ok && MaxDiff(Q*qr.R(), A) < 1e-5f*m;
+            vector<float> b(m);
+            for (int i=0; i<m; i++) b[i] = 0.5f - 0.25f*(i % 5);
+            vector<float> x = qr.Solve(b);
+            vector<float> r = A*x;
+            MatrixX res(m, 1);
+            for (int i=0; i<m; i++) res(i,0) = r[i] - b[i];
+            ok = ok && MaxDiff(TransposeTimes(A, res), MatrixX(n, 1)) < 1e-4f*m;
+        }
+        IS_TRUE(ok); counter.SetCount(ok);
+        MatrixX D = Sample(6, 3);
+        for (int i=0; i<6; i++) D(i,2) = 2.0f*D(i,0);
+        IS_FALSE(QRDecomposition(D).fullRank); counter.SetCount(!QRDecomposition(D).fullRank);
+        IS_FALSE(QRDecomposition(MatrixX(2, 3)).fullRank); counter.SetCount(!QRDecomposition(MatrixX(2, 3)).fullRank);
+
+        Print("Testing MatrixX methods complete!");
+        Print("-Total Tests: " + to_string(counter.GetTotal()));
+        Print("-Tests Passed: " + to_string(counter.GetCountPass()));
+        Print("-Tests Failed: " + to_string(counter.GetCountFail()) + "\n");
+        counter.Reset();
+    }
+    void AllTests(void)
+    {
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "           MATRIXX UNIT TESTING            " << endl;
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+
+        Initialize();
+        MemoryPlacement();
+        ClassOperators();
+        Methods();
+
+        cout << endl << "* * * * * * * * * * * * * * * * * * * * * *" << endl;
+        cout << "      ALL MATRIXX TESTS HAVE FINISHED      " << endl;
+        cout << " - Total Tests: " << to_string(counter.GetAccumulatorTotal()) << endl;
+        cout << " - Tests Passed: " << to_string(counter.GetAccumulatorPass()) << endl;
+        cout << " - Tests Failed: " << to_string(counter.GetAccumulatorFail()) << endl << endl;
+        counter.ResetAccumulator();
+        cout << "* * * * * * * * * * * * * * * * * * * * * *" << endl << endl;
+    }
+};
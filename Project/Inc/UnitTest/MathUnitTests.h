@@ -116,12 +116,13 @@ public:
 struct TestMatrix
 {
 private:
-    TestMatrix2 M2; TestMatrix3 M3; TestMatrix4 M4;
+    TestMatrix2 M2; TestMatrix3 M3; TestMatrix4 M4; TestMatrixX MX;
 public:
     void InitializeMatrix2(void) {M2.Initialize();}
     void InitializeMatrix3(void) {M3.Initialize();}
     void InitializeMatrix4(void) {M4.Initialize();}
-    void InitializeAll(void) {InitializeMatrix2(); InitializeMatrix3(); InitializeMatrix4();}
+    void InitializeMatrixX(void) {MX.Initialize();}
+    void InitializeAll(void) {InitializeMatrix2(); InitializeMatrix3(); InitializeMatrix4(); InitializeMatrixX();}
 
     void ValueChangeMatrix2(void) {M2.ValueChange();}
     void ValueChangeMatrix3(void) {M3.ValueChange();}
@@ -131,17 +132,20 @@ public:
     void MemoryPlacementMatrix2(void) {M2.MemoryPlacement();}
     void MemoryPlacementMatrix3(void) {M3.MemoryPlacement();}
     void MemoryPlacementMatrix4(void) {M4.MemoryPlacement();}
-    void MemoryPlacementAll(void) {MemoryPlacementMatrix2(); MemoryPlacementMatrix3(); MemoryPlacementMatrix4();}
+    void MemoryPlacementMatrixX(void) {MX.MemoryPlacement();}
+    void MemoryPlacementAll(void) {MemoryPlacementMatrix2(); MemoryPlacementMatrix3(); MemoryPlacementMatrix4(); MemoryPlacementMatrixX();}
 
     void ClassOperatorsMatrix2(void) {M2.ClassOperators();}
     void ClassOperatorsMatrix3(void) {M3.ClassOperators();}
     void ClassOperatorsMatrix4(void) {M4.ClassOperators();}
-    void ClassOperatorsAll(void) {ClassOperatorsMatrix2(); ClassOperatorsMatrix3(); ClassOperatorsMatrix4();}
+    void ClassOperatorsMatrixX(void) {MX.ClassOperators();}
+    void ClassOperatorsAll(void) {ClassOperatorsMatrix2(); ClassOperatorsMatrix3(); ClassOperatorsMatrix4(); ClassOperatorsMatrixX();}
 
     void AllTestsMatrix2(void) {M2.AllTests();}
     void AllTestsMatrix3(void) {M3.AllTests();}
     void AllTestsMatrix4(void) {M4.AllTests();}
-    void AllMatrixTests(void) {AllTestsMatrix2(); AllTestsMatrix3(); AllTestsMatrix4();}
+    void AllTestsMatrixX(void) {MX.AllTests();}
+    void AllMatrixTests(void) {AllTestsMatrix2(); AllTestsMatrix3(); AllTestsMatrix4(); AllTestsMatrixX();}
 };
 struct TestTransforms
 {
@@ -172,4 +176,67 @@ public:
     void AllTestsTransform4(void) {T4.AllTests();}
     void AllTestsQuaternion(void) {Q.AllTests();}
     void AllTransformTests(void) {AllTestsTransform3(); AllTestsTransform4(); AllTestsQuaternion();}
+};
+struct TestCoreTypes
+{
+private:
+    TestCore c;
+    TestExpressions e;
+public:
+    void Initialize(void) {c.Initialize();}
+    void MemoryPlacement(void) {c.MemoryPlacement();}
+    void Methods(void) {c.Methods();}
+    void MethodsExpressions(void) {e.Methods();}
+    void AllCoreTests(void) {c.AllTests(); e.AllTests();}
+};
+struct TestBatch
+{
+private:
+    TestSoA S;
+    TestCompression C;
+    TestPackets P;
+    TestRebase R;
+    TestBatchTransforms T;
+    TestTransformHierarchy H;
+    TestAnimationClip A;
+    TestSkinning K;
+    TestKinematics I;
+    TestCurves V;
+public:
+    void InitializeSoA(void) {S.Initialize();}
+    void ValueChangeSoA(void) {S.ValueChange();}
+    void MemoryPlacementSoA(void) {S.MemoryPlacement();}
+    void MethodsSoA(void) {S.Methods();}
+    void AllTestsSoA(void) {S.AllTests();}
+    void InitializeCompression(void) {C.Initialize();}
+    void MemoryPlacementCompression(void) {C.MemoryPlacement();}
+    void MethodsCompression(void) {C.Methods();}
+    void AllTestsCompression(void) {C.AllTests();}
+    void InitializePackets(void) {P.Initialize();}
+    void MemoryPlacementPackets(void) {P.MemoryPlacement();}
+    void MethodsPackets(void) {P.Methods();}
+    void AllTestsPackets(void) {P.AllTests();}
+    void InitializeRebase(void) {R.Initialize();}
+    void MemoryPlacementRebase(void) {R.MemoryPlacement();}
+    void MethodsRebase(void) {R.Methods();}
+    void AllTestsRebase(void) {R.AllTests();}
+    void InitializeTransforms(void) {T.Initialize();}
+    void MemoryPlacementTransforms(void) {T.MemoryPlacement();}
+    void MethodsTransforms(void) {T.Methods();}
+    void AllTestsTransforms(void) {T.AllTests();}
+    void InitializeHierarchy(void) {H.Initialize();}
+    void MethodsHierarchy(void) {H.Methods();}
+    void AllTestsHierarchy(void) {H.AllTests();}
+    void InitializeAnimation(void) {A.Initialize();}
+    void MethodsAnimation(void) {A.Methods();}
+    void AllTestsAnimation(void) {A.AllTests();}
+    void InitializeSkinning(void) {K.Initialize();}
+    void MethodsSkinning(void) {K.Methods();}
+    void AllTestsSkinning(void) {K.AllTests();}
+    void MethodsKinematics(void) {I.Methods();}
+    void AllTestsKinematics(void) {I.AllTests();}
+    void InitializeCurves(void) {V.Initialize();}
+    void MethodsCurves(void) {V.Methods();}
+    void AllTestsCurves(void) {V.AllTests();}
+    void AllBatchTests(void) {AllTestsSoA(); AllTestsCompression(); AllTestsPackets(); AllTestsRebase(); AllTestsTransforms(); AllTestsHierarchy(); AllTestsAnimation(); AllTestsSkinning(); AllTestsKinematics(); AllTestsCurves();}
 };
\ No newline at end of file
@@ -0,0 +1 @@
+#include "Benchmark\MathBenchmarks.h"
\ No newline at end of file
@@ -0,0 +1,31 @@
+#include <iostream>
+#include "Benchmark\MathBenchmarks.h"
+
+using namespace std;
+
+int main()
+{
+    BenchmarkCompression benchC;
+    BenchmarkExpressions benchE;
+    BenchmarkMatrices benchM;
+    BenchmarkTransforms benchT;
+    BenchmarkDense benchD;
+    BenchmarkHierarchy benchH;
+    BenchmarkAnimation benchA;
+    BenchmarkSkinning benchK;
+    BenchmarkKinematics benchI;
+    BenchmarkCurves benchV;
+
+    benchC.AllBenchmarks();
+    benchE.AllBenchmarks();
+    benchM.AllBenchmarks();
+    benchT.AllBenchmarks();
+    benchD.AllBenchmarks();
+    benchH.AllBenchmarks();
+    benchA.AllBenchmarks();
+    benchK.AllBenchmarks();
+    benchI.AllBenchmarks();
+    benchV.AllBenchmarks();
+
+    return 0;
+}
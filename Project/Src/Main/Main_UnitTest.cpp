@@ -9,17 +9,21 @@ using namespace std;
 
 int main()
 {
+    TestCoreTypes testC;
     TestVector testV;
     TestPoint testP;
     TestGeometry testG;
     TestMatrix testM;
     TestTransforms testT;
+    TestBatch testB;
 
+    testC.AllCoreTests();
     testV.AllVectorTests();
     testP.AllPointTests();
     testG.AllGeometryTests();
     testM.AllMatrixTests();
     testT.AllTransformTests();
+    testB.AllBatchTests();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "Math\Animation.h"
+#include <cstring>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                         CLASS METHODS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * ANIMATION CLIP * * * * * //
+
+// Bytes of the ranges and of one frame of keys of a group
+static const size_t RangeBytes = 2*AnimationClip::Components*AnimationClip::GroupBones*sizeof(float);
+static const size_t KeyBytes = AnimationClip::Components*AnimationClip::GroupBones*sizeof(uint16_t);
+
+// Value of every component of a padding bone: the identity rotation, no translation, unit scale
+static const float PaddingValue[AnimationClip::Components] = {0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f};
+
+static AnimationClipHeader EmptyHeader(void)
+{
+    AnimationClipHeader h;
+    memset(&h, 0, sizeof(h));
+    h.magic = MATH_ANIMATION_MAGIC;
+    h.version = MATH_ANIMATION_VERSION;
+    h.frameRate = 1.0f;
+    h.rangeOffset = h.keyOffset = uint32_t(sizeof(AnimationClipHeader));
+    return h;
+}
+
+AnimationClip::AnimationClip()
+{
+    const AnimationClipHeader h = EmptyHeader();
+    storage.resize(sizeof(h));
+    memcpy(storage.data(), &h, sizeof(h));
+    view = nullptr;
+}
+
+AnimationClip::AnimationClip(int boneCount, int frameCount, float frameRate, const Quaternion *rotation, const Point3 *translation, const Vector3 *scale)
+{
+    AnimationClipHeader h = EmptyHeader();
+    h.bones = uint32_t(boneCount);
+    h.frames = uint32_t(frameCount);
+    h.frameRate = frameRate;
+    h.groups = uint32_t((boneCount + GroupBones - 1)/GroupBones);
+    h.keyOffset = uint32_t(h.rangeOffset + h.groups*RangeBytes);
+    storage.assign(h.keyOffset + size_t(frameCount)*h.groups*KeyBytes, 0);
+    memcpy(storage.data(), &h, sizeof(h));
+    view = nullptr;
+
+    vector<Quaternion> q(frameCount);
+    vector<float> track(frameCount);
+    for (int b=0; b<int(h.groups)*GroupBones; b++)
+    {
+        const int g = b/GroupBones, lane = b % GroupBones;
+        float *range = reinterpret_cast<float *>(storage.data() + h.rangeOffset + g*RangeBytes);
+        if (b < boneCount)
+        {
+            // Consecutive rotations in the same hemisphere, so that interpolating keys takes the short arc
+            q[0] = rotation[b];
+            for (int f=1; f<frameCount; f++)
+            {
+                const Quaternion& r = rotation[f*boneCount + b];
+                q[f] = (r.x*q[f - 1].x + r.y*q[f - 1].y + r.z*q[f - 1].z + r.w*q[f - 1].w < 0.0f) ? Quaternion(-r.x, -r.y, -r.z, -r.w) : r;
+            }
+        }
+        for (int k=0; k<Components; k++)
+        {
+            float *minimum = range + k*GroupBones + lane, *step = minimum + Components*GroupBones;
+            if (b >= boneCount) {*minimum = PaddingValue[k]; *step = 0.0f; continue;}
+            for (int f=0; f<frameCount; f++)
+            {
+                const int i = f*boneCount + b;
+                track[f] = (k < 4) ? (&q[f].x)[k] : (k < 7) ? translation[i][k - 4] : scale[i][k - 7];
+            }
+            float lo = track[0], hi = track[0];
+            for (int f=1; f<frameCount; f++) {lo = min(lo, track[f]); hi = max(hi, track[f]);}
+            *minimum = lo;
+            *step = (hi - lo)/65535.0f;
+            const float inv = (hi > lo) ? 65535.0f/(hi - lo) : 0.0f;
+            for (int f=0; f<frameCount; f++)
+            {
+                uint16_t *keys = reinterpret_cast<uint16_t *>(storage.data() + h.keyOffset + (size_t(f)*h.groups + g)*KeyBytes);
+                keys[k*GroupBones + lane] = uint16_t(fminf(fmaxf(nearbyintf((track[f] - lo)*inv), 0.0f), 65535.0f));
+            }
+        }
+    }
+}
+
+bool AnimationClip::View(const void *memory, size_t bytes)
+{
+    *this = AnimationClip();
+    if (bytes < sizeof(AnimationClipHeader) || reinterpret_cast<uintptr_t>(memory) % alignof(float) != 0) return false;
+    AnimationClipHeader h;
+    memcpy(&h, memory, sizeof(h));
+    if (h.magic != MATH_ANIMATION_MAGIC || h.version != MATH_ANIMATION_VERSION) return false;
+    if (h.groups != (uint64_t(h.bones) + GroupBones - 1)/GroupBones || h.rangeOffset != sizeof(AnimationClipHeader)) return false;
+    if (h.keyOffset != h.rangeOffset + uint64_t(h.groups)*RangeBytes) return false;
+    if (h.groups > 0 && h.frames < 1) return false;
+    if (bytes < h.keyOffset + uint64_t(h.frames)*h.groups*KeyBytes) return false;
+    storage.clear();
+    view = static_cast<const uint8_t *>(memory);
+    return true;
+}
+
+size_t AnimationClip::Bytes(void) const
+{
+    const AnimationClipHeader& h = Header();
+    return h.keyOffset + size_t(h.frames)*h.groups*KeyBytes;
+}
+
+const float *AnimationClip::Ranges(int group) const
+{
+    return reinterpret_cast<const float *>(Data() + Header().rangeOffset + group*RangeBytes);
+}
+
+const uint16_t *AnimationClip::Keys(int frame, int group) const
+{
+    const AnimationClipHeader& h = Header();
+    return reinterpret_cast<const uint16_t *>(Data() + h.keyOffset + (size_t(frame)*h.groups + group)*KeyBytes);
+}
+
+void AnimationClip::Frame(float time, int& f0, int& f1, float& t) const
+{
+    const int frames = Frames();
+    if (frames <= 1) {f0 = f1 = 0; t = 0.0f; return;}
+    const float p = fminf(fmaxf(time*FrameRate(), 0.0f), float(frames - 1));
+    f0 = min(int(p), frames - 2);
+    f1 = f0 + 1;
+    t = p - float(f0);
+}
+
+// Both samplers interpolate the keys before scaling them to the track range, so that they round alike
+void AnimationClip::SampleBone(int bone, float time, Quaternion& rotation, Point3& translation, Vector3& scale) const
+{
+    int f0, f1;
+    float t;
+    Frame(time, f0, f1, t);
+    const int g = bone/GroupBones, lane = bone % GroupBones;
+    const float *range = Ranges(g);
+    const uint16_t *k0 = Keys(f0, g), *k1 = Keys(f1, g);
+    float c[Components];
+    for (int k=0; k<Components; k++)
+    {
+        const int j = k*GroupBones + lane;
+        const float a = float(k0[j]), n = a + (float(k1[j]) - a)*t;
+        c[k] = range[j] + n*range[Components*GroupBones + j];
+    }
+    const float inv = 1.0f/sqrtf(c[0]*c[0] + c[1]*c[1] + c[2]*c[2] + c[3]*c[3]);
+    rotation = Quaternion(c[0]*inv, c[1]*inv, c[2]*inv, c[3]*inv);
+    translation = Point3(c[4], c[5], c[6]);
+    scale = Vector3(c[7], c[8], c[9]);
+}
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// Converts 8 uint16 keys to floats
+static inline Floatx8 KeysToFloatx8(const uint16_t *k)
+{
+#if MATH_SIMD_AVX2
+    return SimdPacket(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(k)))));
+#elif MATH_SIMD_SSE
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(k)), zero = _mm_setzero_si128();
+    const __m128 lo = _mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), hi = _mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero));
+#if MATH_SIMD_AVX
+    return SimdPacket(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+#else
+    return SimdPacket(lo, hi);
+#endif
+#else
+    float f[MATH_BATCH_WIDTH];
+    for (int j=0; j<MATH_BATCH_WIDTH; j++) f[j] = float(k[j]);
+    return Floatx8::Load(f);
+#endif
+}
+
+void AnimationClip::SamplePose(float time, const SoASpan<Quaternion>& rotation, const SoASpan<Point3>& translation, const SoASpan<Vector3>& scale) const
+{
+    static_assert(GroupBones == MATH_BATCH_WIDTH, "a group of bones is one packet");
+    int f0, f1;
+    float t;
+    Frame(time, f0, f1, t);
+    const int bones = Bones();
+    const Floatx8 w = Floatx8::Broadcast(t);
+    for (int g=0; g<int(Header().groups); g++)
+    {
+        const float *range = Ranges(g);
+        const uint16_t *k0 = Keys(f0, g), *k1 = Keys(f1, g);
+        Floatx8 c[Components];
+        for (int k=0; k<Components; k++)
+        {
+            const Floatx8 a = KeysToFloatx8(k0 + k*GroupBones), n = a + (KeysToFloatx8(k1 + k*GroupBones) - a)*w;
+            c[k] = Floatx8::Load(range + k*GroupBones) + n*Floatx8::Load(range + (Components + k)*GroupBones);
+        }
+        const Floatx8 inv = Floatx8::Broadcast(1.0f)/Sqrt(c[0]*c[0] + c[1]*c[1] + c[2]*c[2] + c[3]*c[3]);
+        for (int k=0; k<4; k++) c[k] = c[k]*inv;
+
+        const int first = g*GroupBones;
+        if (first + GroupBones <= bones)
+        {
+            for (int k=0; k<4; k++) c[k].Store(rotation[k] + first);
+            for (int k=0; k<3; k++) {c[4 + k].Store(translation[k] + first); c[7 + k].Store(scale[k] + first);}
+            continue;
+        }
+        // Last, padded group
+        float out[Components][MATH_BATCH_WIDTH];
+        for (int k=0; k<Components; k++) c[k].Store(out[k]);
+        for (int j=0; first + j<bones; j++)
+        {
+            for (int k=0; k<4; k++) rotation[k][first + j] = out[k][j];
+            for (int k=0; k<3; k++) {translation[k][first + j] = out[4 + k][j]; scale[k][first + j] = out[7 + k][j];}
+        }
+    }
+}
@@ -0,0 +1,241 @@
+#include "Math\Compression.h"
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * HALF PRECISION * * * * * //
+
+// Converts 8 floats to 8 halves
+static inline void FloatToHalf8(const float *in, uint16_t *out)
+{
+#if MATH_SIMD_F16C
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm256_cvtps_ph(_mm256_loadu_ps(in), _MM_FROUND_TO_NEAREST_INT));
+#else
+    for (int j=0; j<MATH_BATCH_WIDTH; j++) out[j] = FloatToHalf(in[j]);
+#endif
+}
+
+// Converts 8 halves to 8 floats
+static inline void HalfToFloat8(const uint16_t *in, float *out)
+{
+#if MATH_SIMD_F16C
+    _mm256_storeu_ps(out, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(in))));
+#else
+    for (int j=0; j<MATH_BATCH_WIDTH; j++) out[j] = HalfToFloat(in[j]);
+#endif
+}
+
+void PackHalf3(const SoASpan<const Vector3>& a, Half3 *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        uint16_t h[3][MATH_BATCH_WIDTH];
+        for (int k=0; k<3; k++) FloatToHalf8(a[k] + i, h[k]);
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) out[i + j] = Half3(h[0][j], h[1][j], h[2][j]);
+    }
+    for (; i < a.count; i++) out[i] = PackHalf3(a.Get(i));
+}
+
+void UnpackHalf3(const Half3 *in, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        uint16_t h[3][MATH_BATCH_WIDTH];
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) {h[0][j] = in[i + j].x; h[1][j] = in[i + j].y; h[2][j] = in[i + j].z;}
+        for (int k=0; k<3; k++) HalfToFloat8(h[k], out[k] + i);
+    }
+    for (; i < out.count; i++) out.Set(i, UnpackHalf3(in[i]));
+}
+
+void PackHalf4(const SoASpan<const Vector4>& a, Half4 *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        uint16_t h[4][MATH_BATCH_WIDTH];
+        for (int k=0; k<4; k++) FloatToHalf8(a[k] + i, h[k]);
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) out[i + j] = Half4(h[0][j], h[1][j], h[2][j], h[3][j]);
+    }
+    for (; i < a.count; i++) out[i] = PackHalf4(a.Get(i));
+}
+
+void UnpackHalf4(const Half4 *in, const SoASpan<Vector4>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        uint16_t h[4][MATH_BATCH_WIDTH];
+        for (int j=0; j<MATH_BATCH_WIDTH; j++)
+            {h[0][j] = in[i + j].x; h[1][j] = in[i + j].y; h[2][j] = in[i + j].z; h[3][j] = in[i + j].w;}
+        for (int k=0; k<4; k++) HalfToFloat8(h[k], out[k] + i);
+    }
+    for (; i < out.count; i++) out.Set(i, UnpackHalf4(in[i]));
+}
+
+// * * * * * SIGNED NORMALIZED * * * * * //
+
+// Clamps 8 floats to [-1, 1] and scales them to the nearest snorm16 value
+static inline Floatx8 FloatToSNorm16x8(const Floatx8& f)
+{
+    return Round(Min(Max(f, Floatx8::Broadcast(-1.0f)), Floatx8::Broadcast(1.0f)) * 32767.0f);
+}
+
+// Scales 8 snorm16 values back to [-1, 1]
+static inline Floatx8 SNorm16ToFloatx8(const Floatx8& s)
+{
+    return Max(s * (1.0f / 32767.0f), Floatx8::Broadcast(-1.0f));
+}
+
+void PackSNorm16x3(const SoASpan<const Vector3>& a, SNorm16x3 *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        float s[3][MATH_BATCH_WIDTH];
+        for (int k=0; k<3; k++) FloatToSNorm16x8(Floatx8::Load(a[k] + i)).Store(s[k]);
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) out[i + j] = SNorm16x3(int16_t(s[0][j]), int16_t(s[1][j]), int16_t(s[2][j]));
+    }
+    for (; i < a.count; i++) out[i] = PackSNorm16x3(a.Get(i));
+}
+
+void UnpackSNorm16x3(const SNorm16x3 *in, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        float s[3][MATH_BATCH_WIDTH];
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) {s[0][j] = in[i + j].x; s[1][j] = in[i + j].y; s[2][j] = in[i + j].z;}
+        for (int k=0; k<3; k++) SNorm16ToFloatx8(Floatx8::Load(s[k])).Store(out[k] + i);
+    }
+    for (; i < out.count; i++) out.Set(i, UnpackSNorm16x3(in[i]));
+}
+
+// * * * * * OCTAHEDRAL * * * * * //
+
+void PackOctahedral32(const SoASpan<const Vector3>& a, Octahedral32 *out)
+{
+    Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 x = Floatx8::Load(a[0] + i), y = Floatx8::Load(a[1] + i), z = Floatx8::Load(a[2] + i);
+        Floatx8 inv = one / (Abs(x) + Abs(y) + Abs(z));
+        Floatx8 u = x * inv, w = y * inv;
+        // Fold the lower half of the octahedron over the diagonals
+        Floatx8 fu = (one - Abs(w)) * Select(CmpLess(u, zero), -one, one);
+        Floatx8 fw = (one - Abs(u)) * Select(CmpLess(w, zero), -one, one);
+        Floatx8 lower = CmpLess(z, zero);
+        float s[2][MATH_BATCH_WIDTH];
+        FloatToSNorm16x8(Select(lower, fu, u)).Store(s[0]);
+        FloatToSNorm16x8(Select(lower, fw, w)).Store(s[1]);
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) out[i + j] = Octahedral32(int16_t(s[0][j]), int16_t(s[1][j]));
+    }
+    for (; i < a.count; i++) out[i] = PackOctahedral32(a.Get(i));
+}
+
+void UnpackOctahedral32(const Octahedral32 *in, const SoASpan<Vector3>& out)
+{
+    Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        float s[2][MATH_BATCH_WIDTH];
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) {s[0][j] = in[i + j].u; s[1][j] = in[i + j].v;}
+        Floatx8 x = SNorm16ToFloatx8(Floatx8::Load(s[0])), y = SNorm16ToFloatx8(Floatx8::Load(s[1]));
+        Floatx8 z = one - Abs(x) - Abs(y);
+        // Unfold the lower half: t is zero on the upper half
+        Floatx8 t = Select(CmpLess(z, zero), -z, zero);
+        x = x + Select(CmpLess(x, zero), t, -t);
+        y = y + Select(CmpLess(y, zero), t, -t);
+        Floatx8 sc = one / Sqrt(x*x + y*y + z*z);
+        (x*sc).Store(out[0] + i);
+        (y*sc).Store(out[1] + i);
+        (z*sc).Store(out[2] + i);
+    }
+    for (; i < out.count; i++) out.Set(i, UnpackOctahedral32(in[i]));
+}
+
+// * * * * * SMALLEST THREE * * * * * //
+
+void PackSmallestThree(const SoASpan<const Quaternion>& q, int bits, uint8_t *out)
+{
+    memset(out, 0, SmallestThreeStreamBytes(q.count, bits));
+    const Floatx8 one = Floatx8::Broadcast(1.0f), zero = Floatx8::Zero();
+    int width[3], shift[3];
+    for (int j=0, s=2; j<3; s += width[j], j++) {width[j] = SmallestThreeWidth(bits, j); shift[j] = s;}
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= q.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 c[4];
+        for (int k=0; k<4; k++) c[k] = Floatx8::Load(q[k] + i);
+        // Largest magnitude, the first one on ties as in PackSmallestThree(q, bits)
+        Floatx8 best = Abs(c[0]), largest = c[0], index = zero;
+        for (int k=1; k<4; k++)
+        {
+            const Floatx8 m = CmpGreater(Abs(c[k]), best);
+            best = Select(m, Abs(c[k]), best);
+            largest = Select(m, c[k], largest);
+            index = Select(m, Floatx8::Broadcast(float(k)), index);
+        }
+        const Floatx8 sign = Select(CmpLess(largest, zero), -one, one);
+        float n[3][MATH_BATCH_WIDTH], idx[MATH_BATCH_WIDTH];
+        index.Store(idx);
+        for (int j=0; j<3; j++)
+        {
+            // Slot j holds component j below the dropped one and component j + 1 from it on
+            const Floatx8 v = Select(CmpLessEqual(index, Floatx8::Broadcast(float(j))), c[j + 1], c[j]);
+            const Floatx8 s = Min(Max(sign*v*1.41421356f, -one), one);
+            Round((s + one)*0.5f*float((1 << width[j]) - 2)).Store(n[j]);
+        }
+        for (int l=0; l<MATH_BATCH_WIDTH; l++)
+        {
+            const uint64_t code = uint64_t(idx[l]) | (uint64_t(n[0][l]) << shift[0]) |
+                                  (uint64_t(n[1][l]) << shift[1]) | (uint64_t(n[2][l]) << shift[2]);
+            const size_t offset = size_t(i + l)*size_t(bits);
+            uint64_t word;
+            memcpy(&word, out + offset/8, sizeof(word));
+            word |= code << (offset % 8);
+            memcpy(out + offset/8, &word, sizeof(word));
+        }
+    }
+    for (; i < q.count; i++) WriteSmallestThree(out, i, bits, PackSmallestThree(q.Get(i), bits));
+}
+
+void UnpackSmallestThree(const uint8_t *in, int bits, const SoASpan<Quaternion>& out)
+{
+    const Floatx8 one = Floatx8::Broadcast(1.0f), zero = Floatx8::Zero();
+    int width[3], shift[3];
+    uint64_t mask[3];
+    for (int j=0, s=2; j<3; s += width[j], j++)
+        {width[j] = SmallestThreeWidth(bits, j); shift[j] = s; mask[j] = (uint64_t(1) << width[j]) - 1u;}
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        float n[3][MATH_BATCH_WIDTH], idx[MATH_BATCH_WIDTH];
+        for (int l=0; l<MATH_BATCH_WIDTH; l++)
+        {
+            const uint64_t code = ReadSmallestThree(in, i + l, bits);
+            idx[l] = float(int(code & 3u));
+            for (int j=0; j<3; j++) n[j][l] = float(int((code >> shift[j]) & mask[j]));
+        }
+        Floatx8 s[3], sum = zero;
+        for (int j=0; j<3; j++)
+        {
+            const float m = float((1 << width[j]) - 2);
+            s[j] = (Floatx8::Load(n[j])*2.0f - Floatx8::Broadcast(m))*(0.707106781f/m);
+            sum = sum + s[j]*s[j];
+        }
+        const Floatx8 index = Floatx8::Load(idx), largest = Sqrt(Max(one - sum, zero));
+        // Component k is slot k below the dropped one, the rebuilt one at it and slot k - 1 above it
+        for (int k=0; k<4; k++)
+        {
+            const Floatx8 kf = Floatx8::Broadcast(float(k));
+            const Floatx8 below = (k < 3) ? s[k] : zero, above = (k > 0) ? s[k - 1] : zero;
+            Select(CmpEqual(index, kf), largest, Select(CmpLess(kf, index), below, above)).Store(out[k] + i);
+        }
+    }
+    for (; i < out.count; i++) out.Set(i, UnpackSmallestThree(ReadSmallestThree(in, i, bits), bits));
+}
@@ -0,0 +1,34 @@
+#include "Math\Core.h"
+
+//---------------------------------------------------------------------------------------------
+//                                      INSTANTIATIONS
+//---------------------------------------------------------------------------------------------
+
+// Every member of the supported instantiations is compiled here once, so that a change to the
+// templates that breaks one of the scalar types is caught even if no caller uses it yet.
+
+// * * * * * VECTORS * * * * * //
+
+template struct VecN<float, 2>;
+template struct VecN<float, 3>;
+template struct VecN<float, 4>;
+template struct VecN<double, 2>;
+template struct VecN<double, 3>;
+template struct VecN<double, 4>;
+template struct VecN<int32_t, 2>;
+template struct VecN<int32_t, 3>;
+template struct VecN<int32_t, 4>;
+
+// * * * * * MATRICES * * * * * //
+
+template struct Mat<float, 2, 2>;
+template struct Mat<float, 3, 3>;
+template struct Mat<float, 4, 4>;
+template struct Mat<float, 3, 4>;
+template struct Mat<double, 2, 2>;
+template struct Mat<double, 3, 3>;
+template struct Mat<double, 4, 4>;
+template struct Mat<double, 3, 4>;
+template struct Mat<int32_t, 2, 2>;
+template struct Mat<int32_t, 3, 3>;
+template struct Mat<int32_t, 4, 4>;
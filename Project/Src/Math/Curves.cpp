@@ -0,0 +1,324 @@
+#include "Math\Curves.h"
+#include "Math\Packets.h"
+#include <algorithm>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                         CLASS METHODS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * CUBIC CURVE * * * * * //
+
+// 5 point Gauss-Legendre quadrature on [-1, 1], exact for polynomials up to degree 9
+static const float GaussNode[5] = {0.0f, -0.538469310f, 0.538469310f, -0.906179846f, 0.906179846f};
+static const float GaussWeight[5] = {0.568888889f, 0.478628670f, 0.478628670f, 0.236926885f, 0.236926885f};
+
+CubicCurve::CubicCurve(vector<Vector3>&& segmentCoefficients) : coefficients(move(segmentCoefficients))
+{
+    const int samples = Segments()*MATH_CURVE_ARC_SAMPLES;
+    arcLength.resize(samples + 1);
+    arcLength[0] = 0.0f;
+    for (int i=0; i<samples; i++)
+    {
+        const int s = i/MATH_CURVE_ARC_SAMPLES, r = i % MATH_CURVE_ARC_SAMPLES;
+        arcLength[i + 1] = arcLength[i] + SegmentLength(s, float(r)/MATH_CURVE_ARC_SAMPLES, float(r + 1)/MATH_CURVE_ARC_SAMPLES);
+    }
+}
+
+CubicCurve CubicCurve::Bezier(const Point3 *control, int count)
+{
+    if (count < 4 || (count - 1) % 3 != 0) throw CurveControlPointsE();
+    vector<Vector3> c;
+    for (int i=0; i + 3<count; i += 3)
+    {
+        const Vector3 &p0 = control[i], &p1 = control[i + 1], &p2 = control[i + 2], &p3 = control[i + 3];
+        c.push_back(p3 - p0 + 3.0f*(p1 - p2));
+        c.push_back(3.0f*(p0 + p2) - 6.0f*p1);
+        c.push_back(3.0f*(p1 - p0));
+        c.push_back(p0);
+    }
+    return CubicCurve(move(c));
+}
+
+CubicCurve CubicCurve::CatmullRom(const Point3 *points, int count)
+{
+    if (count < 2) throw CurveControlPointsE();
+    vector<Vector3> c;
+    for (int i=0; i + 1<count; i++)
+    {
+        const Vector3 &p1 = points[i], &p2 = points[i + 1];
+        // Mirrored end points: p0 - p1 = p1 - p2 before the first point, and likewise after the last
+        const Vector3 p0 = (i > 0) ? Vector3(points[i - 1]) : 2.0f*p1 - p2;
+        const Vector3 p3 = (i + 2 < count) ? Vector3(points[i + 2]) : 2.0f*p2 - p1;
+        c.push_back(0.5f*(p3 - p0) + 1.5f*(p1 - p2));
+        c.push_back(p0 - 2.5f*p1 + 2.0f*p2 - 0.5f*p3);
+        c.push_back(0.5f*(p2 - p0));
+        c.push_back(p1);
+    }
+    return CubicCurve(move(c));
+}
+
+CubicCurve CubicCurve::BSpline(const Point3 *control, int count)
+{
+    if (count < 4) throw CurveControlPointsE();
+    vector<Vector3> c;
+    for (int i=0; i + 3<count; i++)
+    {
+        const Vector3 &p0 = control[i], &p1 = control[i + 1], &p2 = control[i + 2], &p3 = control[i + 3];
+        c.push_back((p3 - p0 + 3.0f*(p1 - p2))/6.0f);
+        c.push_back(0.5f*(p0 + p2) - p1);
+        c.push_back(0.5f*(p2 - p0));
+        c.push_back((p0 + 4.0f*p1 + p2)/6.0f);
+    }
+    return CubicCurve(move(c));
+}
+
+int CubicCurve::Locate(float u, float& t) const
+{
+    const float v = fminf(fmaxf(u, 0.0f), float(Segments()));
+    const int s = min(int(v), Segments() - 1);
+    t = v - float(s);
+    return s;
+}
+
+float CubicCurve::SegmentLength(int s, float t0, float t1) const
+{
+    const Vector3 *k = &coefficients[4*s];
+    const float half = 0.5f*(t1 - t0), mid = 0.5f*(t0 + t1);
+    float sum = 0.0f;
+    for (int i=0; i<5; i++)
+    {
+        const float t = mid + half*GaussNode[i];
+        sum += GaussWeight[i]*Magnitude((3.0f*k[0]*t + 2.0f*k[1])*t + k[2]);
+    }
+    return sum*half;
+}
+
+Point3 CubicCurve::Evaluate(float u) const
+{
+    float t;
+    const Vector3 *k = &coefficients[4*Locate(u, t)];
+    const Vector3 p = ((k[0]*t + k[1])*t + k[2])*t + k[3];
+    return Point3(p.x, p.y, p.z);
+}
+
+Vector3 CubicCurve::Derivative(float u) const
+{
+    float t;
+    const Vector3 *k = &coefficients[4*Locate(u, t)];
+    return (3.0f*k[0]*t + 2.0f*k[1])*t + k[2];
+}
+
+float CubicCurve::LengthAt(float u) const
+{
+    float t;
+    const int s = Locate(u, t);
+    const int r = min(int(t*MATH_CURVE_ARC_SAMPLES), MATH_CURVE_ARC_SAMPLES - 1);
+    return arcLength[s*MATH_CURVE_ARC_SAMPLES + r] + SegmentLength(s, float(r)/MATH_CURVE_ARC_SAMPLES, t);
+}
+
+float CubicCurve::ParameterAtLength(float s) const
+{
+    const float d = fminf(fmaxf(s, 0.0f), Length());
+    const int last = int(arcLength.size()) - 2;
+    const int i = min(max(int(upper_bound(arcLength.begin(), arcLength.end(), d) - arcLength.begin()) - 1, 0), last);
+    const int segment = i/MATH_CURVE_ARC_SAMPLES, r = i % MATH_CURVE_ARC_SAMPLES;
+    const float span = arcLength[i + 1] - arcLength[i];
+    const float t0 = float(r)/MATH_CURVE_ARC_SAMPLES, t1 = float(r + 1)/MATH_CURVE_ARC_SAMPLES;
+    // Linear guess between the table entries, then one Newton step on the length, kept between them
+    float t = t0 + ((span > 0.0f) ? (d - arcLength[i])/span : 0.0f)*(t1 - t0);
+    const float speed = Magnitude(Derivative(float(segment) + t));
+    if (speed > 0.0f) t = fminf(fmaxf(t - (arcLength[i] + SegmentLength(segment, t0, t) - d)/speed, t0), t1);
+    return float(segment) + t;
+}
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// Loads the n parameters starting at u, lanes past n repeating u[0]
+static inline Floatx8 LoadParameters(const float *u, int n)
+{
+    if (n == MATH_BATCH_WIDTH) return Floatx8::Load(u);
+    float f[MATH_BATCH_WIDTH];
+    for (int j=0; j<MATH_BATCH_WIDTH; j++) f[j] = u[(j < n) ? j : 0];
+    return Floatx8::Load(f);
+}
+
+// Locate() on 8 lanes: the segment of every lane into s, and the parameters within them
+static inline Floatx8 LocatePacket(const Floatx8& u, int segments, int (&s)[MATH_BATCH_WIDTH])
+{
+    const Floatx8 v = Min(Max(u, Floatx8::Zero()), Floatx8::Broadcast(float(segments)));
+    float f[MATH_BATCH_WIDTH];
+    v.Store(f);
+    for (int j=0; j<MATH_BATCH_WIDTH; j++)
+    {
+        s[j] = min(int(f[j]), segments - 1);
+        f[j] = float(s[j]);
+    }
+    return v - Floatx8::Load(f);
+}
+
+// Loads the coefficients of the segments of 8 lanes, coefficient e of every lane into k[e] in the
+// order a.x, a.y, a.z, b.x, ... d.z. Lanes sharing one segment, as sorted parameters mostly do,
+// broadcast it; otherwise AVX2 gathers every coefficient, and SSE transposes the 12 floats of 4
+// segments at a time
+static inline void GatherSegments(const float *base, const int (&s)[MATH_BATCH_WIDTH], Floatx8 (&k)[12])
+{
+    bool shared = true;
+    for (int j=1; j<MATH_BATCH_WIDTH; j++) shared = shared && s[j] == s[0];
+    if (shared)
+    {
+        for (int e=0; e<12; e++) k[e] = Floatx8::Broadcast(base[12*s[0] + e]);
+        return;
+    }
+#if MATH_SIMD_AVX2
+    const __m256i index = _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s)), _mm256_set1_epi32(12));
+    for (int e=0; e<12; e++) k[e] = SimdPacket(_mm256_i32gather_ps(base + e, index, 4));
+#else
+    float c[12][MATH_BATCH_WIDTH];
+    for (int h=0; h<MATH_BATCH_WIDTH; h += 4)
+        for (int q=0; q<3; q++)
+        {
+#if MATH_SIMD_SSE
+            __m128 r0 = _mm_loadu_ps(base + 12*s[h] + 4*q), r1 = _mm_loadu_ps(base + 12*s[h + 1] + 4*q);
+            __m128 r2 = _mm_loadu_ps(base + 12*s[h + 2] + 4*q), r3 = _mm_loadu_ps(base + 12*s[h + 3] + 4*q);
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(c[4*q] + h, r0);
+            _mm_storeu_ps(c[4*q + 1] + h, r1);
+            _mm_storeu_ps(c[4*q + 2] + h, r2);
+            _mm_storeu_ps(c[4*q + 3] + h, r3);
+#else
+            for (int j=0; j<4; j++)
+                for (int r=0; r<4; r++) c[4*q + r][h + j] = base[12*s[h + j] + 4*q + r];
+#endif
+        }
+    for (int e=0; e<12; e++) k[e] = Floatx8::Load(c[e]);
+#endif
+}
+
+// The cubic of every lane at its parameter t
+static inline Vector3x8 EvaluateCubic(const Floatx8 (&k)[12], const Floatx8& t)
+{
+    Floatx8 p[3];
+    for (int x=0; x<3; x++) p[x] = MulAdd(MulAdd(MulAdd(k[x], t, k[3 + x]), t, k[6 + x]), t, k[9 + x]);
+    return Vector3x8(p[0], p[1], p[2]);
+}
+
+// Magnitude of the derivative of the cubic of every lane at its parameter t
+static inline Floatx8 SpeedCubic(const Floatx8 (&k)[12], const Floatx8& t)
+{
+    const Floatx8 three = Floatx8::Broadcast(3.0f), two = Floatx8::Broadcast(2.0f);
+    Floatx8 m = Floatx8::Zero();
+    for (int x=0; x<3; x++)
+    {
+        const Floatx8 d = MulAdd(MulAdd(three*k[x], t, two*k[3 + x]), t, k[6 + x]);
+        m = MulAdd(d, d, m);
+    }
+    return Sqrt(m);
+}
+
+// Stores the first n lanes of a packet into the elements starting at element i
+static inline void StorePoints(const SoASpan<Point3>& out, int i, int n, const Vector3x8& p)
+{
+    const Floatx8 *v[3] = {&p.x, &p.y, &p.z};
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<3; k++) v[k]->Store(out[k] + i);
+        return;
+    }
+    float f[MATH_BATCH_WIDTH];
+    for (int k=0; k<3; k++)
+    {
+        v[k]->Store(f);
+        for (int j=0; j<n; j++) out[k][i + j] = f[j];
+    }
+}
+
+void CubicCurve::Evaluate(const float *u, int count, const SoASpan<Point3>& out) const
+{
+    static_assert(sizeof(Vector3) == 3*sizeof(float), "segments are 12 contiguous floats");
+    const float *base = &coefficients[0].x;
+    for (int i=0; i<count; i += MATH_BATCH_WIDTH)
+    {
+        const int n = min(MATH_BATCH_WIDTH, count - i);
+        int s[MATH_BATCH_WIDTH];
+        Floatx8 k[12];
+        const Floatx8 t = LocatePacket(LoadParameters(u + i, n), Segments(), s);
+        GatherSegments(base, s, k);
+        StorePoints(out, i, n, EvaluateCubic(k, t));
+    }
+}
+
+void CubicCurve::EvaluateAtLength(const float *s, int count, const SoASpan<Point3>& out) const
+{
+    const float *base = &coefficients[0].x;
+    const int last = int(arcLength.size()) - 2;
+    const Floatx8 zero = Floatx8::Zero(), half = Floatx8::Broadcast(0.5f);
+    for (int i=0; i<count; i += MATH_BATCH_WIDTH)
+    {
+        const int n = min(MATH_BATCH_WIDTH, count - i);
+        // The table search of ParameterAtLength() per lane, the rest of it on 8 lanes
+        int segment[MATH_BATCH_WIDTH];
+        float d[MATH_BATCH_WIDTH], l0[MATH_BATCH_WIDTH], l1[MATH_BATCH_WIDTH], t0[MATH_BATCH_WIDTH], t1[MATH_BATCH_WIDTH];
+        for (int j=0; j<MATH_BATCH_WIDTH; j++)
+        {
+            d[j] = fminf(fmaxf(s[i + ((j < n) ? j : 0)], 0.0f), Length());
+            const int e = min(max(int(upper_bound(arcLength.begin(), arcLength.end(), d[j]) - arcLength.begin()) - 1, 0), last);
+            segment[j] = e/MATH_CURVE_ARC_SAMPLES;
+            const int r = e % MATH_CURVE_ARC_SAMPLES;
+            l0[j] = arcLength[e];
+            l1[j] = arcLength[e + 1];
+            t0[j] = float(r)/MATH_CURVE_ARC_SAMPLES;
+            t1[j] = float(r + 1)/MATH_CURVE_ARC_SAMPLES;
+        }
+        Floatx8 k[12];
+        GatherSegments(base, segment, k);
+        const Floatx8 D = Floatx8::Load(d), L0 = Floatx8::Load(l0), span = Floatx8::Load(l1) - L0;
+        const Floatx8 T0 = Floatx8::Load(t0), T1 = Floatx8::Load(t1);
+        Floatx8 t = T0 + Select(CmpGreater(span, zero), (D - L0)/span, zero)*(T1 - T0);
+        // One Newton step on the length, SegmentLength() from t0 to t by the same quadrature
+        const Floatx8 speed = SpeedCubic(k, t);
+        const Floatx8 h = half*(t - T0), mid = half*(T0 + t);
+        Floatx8 length = zero;
+        for (int q=0; q<5; q++) length = MulAdd(Floatx8::Broadcast(GaussWeight[q]), SpeedCubic(k, MulAdd(h, Floatx8::Broadcast(GaussNode[q]), mid)), length);
+        const Floatx8 step = Min(Max(t - (L0 + length*h - D)/speed, T0), T1);
+        t = Select(CmpGreater(speed, zero), step, t);
+        StorePoints(out, i, n, EvaluateCubic(k, t));
+    }
+}
+
+// Packets advanced by adds before the difference tables are restarted from the polynomial,
+// which keeps the rounding of long runs of adds from piling up
+static const int RestartPackets = 32;
+
+void CubicCurve::SampleUniform(int steps, const SoASpan<Point3>& out) const
+{
+    const float h = 1.0f/float(steps);
+    const Floatx8 hh = Floatx8::Broadcast(MATH_BATCH_WIDTH*h), h2 = hh*hh, h3 = h2*hh;
+    float lane[MATH_BATCH_WIDTH];
+    for (int j=0; j<MATH_BATCH_WIDTH; j++) lane[j] = float(j)*h;
+    const Floatx8 offset = Floatx8::Load(lane);
+    for (int s=0; s<Segments(); s++)
+    {
+        const Vector3x8 a(coefficients[4*s]), b(coefficients[4*s + 1]), c(coefficients[4*s + 2]), d(coefficients[4*s + 3]);
+        const Vector3x8 d3 = a*(6.0f*h3);
+        for (int first=0; first<steps; first += RestartPackets*MATH_BATCH_WIDTH)
+        {
+            // Lane j tabulates the parameters t + m*8h: the point and its first three differences
+            const Floatx8 t = Floatx8::Broadcast(float(first)*h) + offset, t2 = t*t;
+            Vector3x8 f = ((a*t + b)*t + c)*t + d;
+            Vector3x8 d1 = a*(3.0f*t2*hh + 3.0f*t*h2 + h3) + b*(2.0f*t*hh + h2) + c*hh;
+            Vector3x8 d2 = a*(6.0f*t*h2 + 6.0f*h3) + b*(2.0f*h2);
+            const int last = min(steps, first + RestartPackets*MATH_BATCH_WIDTH);
+            for (int k=first; k<last; k += MATH_BATCH_WIDTH)
+            {
+                StorePoints(out, s*steps + k, min(MATH_BATCH_WIDTH, last - k), f);
+                f += d1; d1 += d2; d2 += d3;
+            }
+        }
+    }
+    const Point3 end = Evaluate(float(Segments()));
+    for (int k=0; k<3; k++) out[k][Segments()*steps] = end[k];
+}
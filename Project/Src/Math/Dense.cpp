@@ -0,0 +1,643 @@
+#include "Math\Dense.h"
+#include <cfloat>
+#include <numeric>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                          KERNELS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * VECTOR KERNELS * * * * * //
+
+// Largest absolute value of n floats
+static float MaxAbs(const float *x, int n)
+{
+    Floatx8 m = Floatx8::Zero();
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= n; i += MATH_BATCH_WIDTH) m = Max(m, Abs(Floatx8::Load(x + i)));
+    float r = 0.0f;
+    for (int l=0; l<MATH_BATCH_WIDTH; l++) r = max(r, m.Lane(l));
+    for (; i<n; i++) r = max(r, fabsf(x[i]));
+    return r;
+}
+
+// Index of the first element of largest absolute value among n floats
+static int IndexOfMaxAbs(const float *x, int n)
+{
+    int best = 0;
+    float m = -1.0f;
+    for (int i=0; i<n; i++)
+        if (fabsf(x[i]) > m) {m = fabsf(x[i]); best = i;}
+    return best;
+}
+
+// y += a*x over n floats
+static void Axpy(int n, float a, const float *x, float *y)
+{
+    Floatx8 av = Floatx8::Broadcast(a);
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= n; i += MATH_BATCH_WIDTH) MulAdd(av, Floatx8::Load(x + i), Floatx8::Load(y + i)).Store(y + i);
+    for (; i<n; i++) y[i] += a*x[i];
+}
+
+// x *= s over n floats
+static void Scale(int n, float s, float *x)
+{
+    Floatx8 sv = Floatx8::Broadcast(s);
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= n; i += MATH_BATCH_WIDTH) (sv*Floatx8::Load(x + i)).Store(x + i);
+    for (; i<n; i++) x[i] *= s;
+}
+
+// Dot product of n floats
+static float Dot(int n, const float *x, const float *y)
+{
+    Floatx8 s = Floatx8::Zero();
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= n; i += MATH_BATCH_WIDTH) s = MulAdd(Floatx8::Load(x + i), Floatx8::Load(y + i), s);
+    float r = 0.0f;
+    for (int l=0; l<MATH_BATCH_WIDTH; l++) r += s.Lane(l);
+    for (; i<n; i++) r += x[i]*y[i];
+    return r;
+}
+
+// Largest absolute value of the elements of a matrix, padding rows included since they are zero
+static float MaxAbs(const MatrixX& A)
+{
+    float r = 0.0f;
+    for (int j=0; j<A.Cols(); j++) r = max(r, MaxAbs(A.Col(j), A.Stride()));
+    return r;
+}
+
+// Number of columns of a product worth a worker thread, for products of m x k by k x n
+static int ColumnGrain(long long m, long long k)
+{
+    return int(max(1LL, (long long)(MATH_DENSE_PARALLEL_FLOPS) / max(1LL, 2*m*k)));
+}
+
+// * * * * * MATRIX PRODUCT * * * * * //
+
+// Depth and height of the block of A kept in cache while it is multiplied by every column of B
+static const int GemmDepth = 256;
+static const int GemmHeight = 128;
+
+// Multiplies MP packed strips of 8 rows of A (aStrip floats apart, kc columns each) by NC columns
+// of B and adds alpha times the result to C
+template<int MP, int NC>
+static inline void GemmKernel(int kc, const float *a, int aStrip, const float *B, int bRow, int bCol, float *C, int ldc, float alpha)
+{
+    Floatx8 c[MP][NC];
+    for (int s=0; s<MP; s++)
+        for (int q=0; q<NC; q++) c[s][q] = Floatx8::Zero();
+    for (int p=0; p<kc; p++)
+    {
+        Floatx8 av[MP];
+        for (int s=0; s<MP; s++) av[s] = Floatx8::Load(a + s*aStrip + p*MATH_BATCH_WIDTH);
+        const float *b = B + p*bRow;
+        for (int q=0; q<NC; q++)
+        {
+            Floatx8 bq = Floatx8::Broadcast(b[q*bCol]);
+            for (int s=0; s<MP; s++) c[s][q] = MulAdd(av[s], bq, c[s][q]);
+        }
+    }
+    Floatx8 al = Floatx8::Broadcast(alpha);
+    for (int s=0; s<MP; s++)
+        for (int q=0; q<NC; q++)
+        {
+            float *cp = C + s*MATH_BATCH_WIDTH + q*ldc;
+            MulAdd(al, c[s][q], Floatx8::Load(cp)).Store(cp);
+        }
+}
+
+template<int MP>
+static inline void GemmKernel(int nc, int kc, const float *a, int aStrip, const float *B, int bRow, int bCol, float *C, int ldc, float alpha)
+{
+    switch (nc)
+    {
+        case 4: GemmKernel<MP, 4>(kc, a, aStrip, B, bRow, bCol, C, ldc, alpha); break;
+        case 3: GemmKernel<MP, 3>(kc, a, aStrip, B, bRow, bCol, C, ldc, alpha); break;
+        case 2: GemmKernel<MP, 2>(kc, a, aStrip, B, bRow, bCol, C, ldc, alpha); break;
+        default: GemmKernel<MP, 1>(kc, a, aStrip, B, bRow, bCol, C, ldc, alpha); break;
+    }
+}
+
+// Copies rows i0..i0+mc (a multiple of 8) and columns p0..p0+kc of A into strips of 8 rows, each
+// strip column by column, so that the kernel reads the block contiguously
+static void GemmPack(const float *A, int aRow, int aCol, int i0, int mc, int p0, int kc, float *buffer)
+{
+    for (int s=0; s<mc/MATH_BATCH_WIDTH; s++)
+    {
+        float *dst = buffer + s*kc*MATH_BATCH_WIDTH;
+        int i = i0 + s*MATH_BATCH_WIDTH;
+        if (aRow == 1)
+            for (int p=0; p<kc; p++) memcpy(dst + p*MATH_BATCH_WIDTH, A + i + (p0 + p)*aCol, MATH_BATCH_WIDTH*sizeof(float));
+        else
+            for (int r=0; r<MATH_BATCH_WIDTH; r++)
+                for (int p=0; p<kc; p++) dst[p*MATH_BATCH_WIDTH + r] = A[(i + r)*aRow + (p0 + p)*aCol];
+    }
+}
+
+/*
+ * C += alpha*A*B for C of m x n and inner size k. Element (i,p) of A is A[i*aRow + p*aCol] and
+ * element (p,j) of B is B[p*bRow + j*bCol], so either operand may be read transposed; C is
+ * column-major with column stride ldc. With lower set only the elements of C on or below the
+ * diagonal (i >= j) are needed, the others may or may not be updated. The columns of C are split
+ * across worker threads; every thread walks A in GemmHeight x GemmDepth blocks, packed once and
+ * then multiplied by its columns of B with the 16 x 4 (or 8 x 4) register kernel.
+ */
+static void Gemm(int m, int n, int k, float alpha, const float *A, int aRow, int aCol,
+                 const float *B, int bRow, int bCol, float *C, int ldc, bool lower)
+{
+    if (m <= 0 || n <= 0 || k <= 0) return;
+    const int packed = m / MATH_BATCH_WIDTH * MATH_BATCH_WIDTH;
+    ParallelFor(n, ColumnGrain(m, k), [&](int j0, int j1)
+    {
+        vector<float> buffer(size_t(GemmHeight)*GemmDepth);
+        for (int p0=0; p0<k; p0+=GemmDepth)
+        {
+            const int kc = min(GemmDepth, k - p0);
+            const int aStrip = kc*MATH_BATCH_WIDTH;
+            for (int i0=0; i0<packed; i0+=GemmHeight)
+            {
+                const int mc = min(GemmHeight, packed - i0);
+                const int strips = mc / MATH_BATCH_WIDTH;
+                if (lower && i0 + mc <= j0) continue;
+                GemmPack(A, aRow, aCol, i0, mc, p0, kc, buffer.data());
+                for (int j=j0; j<j1; j+=4)
+                {
+                    const int nc = min(4, j1 - j);
+                    int s = lower ? max(0, (j - i0) / MATH_BATCH_WIDTH) : 0;
+                    const float *b = B + p0*bRow + j*bCol;
+                    float *c = C + i0 + j*ldc;
+                    for (; s + 2 <= strips; s += 2)
+                        GemmKernel<2>(nc, kc, buffer.data() + s*aStrip, aStrip, b, bRow, bCol, c + s*MATH_BATCH_WIDTH, ldc, alpha);
+                    if (s < strips)
+                        GemmKernel<1>(nc, kc, buffer.data() + s*aStrip, aStrip, b, bRow, bCol, c + s*MATH_BATCH_WIDTH, ldc, alpha);
+                }
+            }
+        }
+        // Rows below the last whole strip
+        for (int j=j0; j<j1; j++)
+            for (int i=packed; i<m; i++)
+            {
+                if (lower && i < j) continue;
+                float sum = 0.0f;
+                for (int p=0; p<k; p++) sum += A[i*aRow + p*aCol]*B[p*bRow + j*bCol];
+                C[i + j*ldc] += alpha*sum;
+            }
+    });
+}
+
+// * * * * * TRIANGULAR SOLVES * * * * * //
+
+/*
+ * Solves T*X = B in place for the n x n lower triangular T, element (i,j) at T[i*tRow + j*tCol],
+ * and the nrhs columns of X (column stride ldx). The diagonal is taken as 1 when unit is set.
+ * Diagonal blocks of MATH_DENSE_BLOCK rows are solved by substitution, the rows below them are
+ * updated with Gemm().
+ */
+static void SolveLower(int n, const float *T, int tRow, int tCol, bool unit, float *X, int ldx, int nrhs)
+{
+    for (int k0=0; k0<n; k0+=MATH_DENSE_BLOCK)
+    {
+        const int k1 = min(n, k0 + MATH_DENSE_BLOCK);
+        ParallelFor(nrhs, ColumnGrain(k1 - k0, k1 - k0), [&](int c0, int c1)
+        {
+            for (int c=c0; c<c1; c++)
+            {
+                float *x = X + c*ldx;
+                for (int p=k0; p<k1; p++)
+                {
+                    if (!unit) x[p] /= T[p*tRow + p*tCol];
+                    for (int i=p+1; i<k1; i++) x[i] -= T[i*tRow + p*tCol]*x[p];
+                }
+            }
+        });
+        if (k1 < n) Gemm(n - k1, nrhs, k1 - k0, -1.0f, T + k1*tRow + k0*tCol, tRow, tCol, X + k0, 1, ldx, X + k1, ldx, false);
+    }
+}
+
+// Solves T*X = B in place for the n x n upper triangular T, see SolveLower()
+static void SolveUpper(int n, const float *T, int tRow, int tCol, bool unit, float *X, int ldx, int nrhs)
+{
+    for (int k1=n; k1>0; k1-=MATH_DENSE_BLOCK)
+    {
+        const int k0 = max(0, k1 - MATH_DENSE_BLOCK);
+        ParallelFor(nrhs, ColumnGrain(k1 - k0, k1 - k0), [&](int c0, int c1)
+        {
+            for (int c=c0; c<c1; c++)
+            {
+                float *x = X + c*ldx;
+                for (int p=k1-1; p>=k0; p--)
+                {
+                    if (!unit) x[p] /= T[p*tRow + p*tCol];
+                    for (int i=k0; i<p; i++) x[i] -= T[i*tRow + p*tCol]*x[p];
+                }
+            }
+        });
+        if (k0 > 0) Gemm(k0, nrhs, k1 - k0, -1.0f, T + k0*tCol, tRow, tCol, X + k0, 1, ldx, X, ldx, false);
+    }
+}
+
+// * * * * * HOUSEHOLDER REFLECTIONS * * * * * //
+
+/*
+ * Applies the product of the reflections k0..k0+nb of a QR factorization, H = I - V*T*V^T in
+ * compact WY form, or its transpose, to rows k0..m of the n columns of C (column stride ldc).
+ * The reflections are applied with two Gemm() calls instead of one rank-1 update each.
+ */
+static void ApplyReflections(const MatrixX& QR, const vector<float>& tau, int k0, int nb, bool transpose, float *C, int ldc, int n)
+{
+    const int len = QR.Rows() - k0;
+    if (len <= 0 || nb <= 0 || n <= 0) return;
+    MatrixX V(len, nb);
+    for (int j=0; j<nb; j++)
+    {
+        V(j,j) = 1.0f;
+        memcpy(V.Col(j) + j + 1, QR.Col(k0 + j) + k0 + j + 1, (len - j - 1)*sizeof(float));
+    }
+    // Upper triangular T, built column by column: T(0:i,i) = -tau_i*T(0:i,0:i)*V(:,0:i)^T*v_i
+    MatrixX T(nb, nb);
+    vector<float> z(nb);
+    for (int i=0; i<nb; i++)
+    {
+        const float t = tau[k0 + i];
+        for (int r=0; r<i; r++) z[r] = Dot(len - i, V.Col(r) + i, V.Col(i) + i);
+        for (int r=0; r<i; r++)
+        {
+            float s = 0.0f;
+            for (int q=r; q<i; q++) s += T(r,q)*z[q];
+            T(r,i) = -t*s;
+        }
+        T(i,i) = t;
+    }
+    // W = V^T*C, then T*W or T^T*W, then C -= V*W
+    MatrixX W(nb, n);
+    Gemm(nb, n, len, 1.0f, V.Col(0), V.Stride(), 1, C, 1, ldc, W.Col(0), W.Stride(), false);
+    for (int c=0; c<n; c++)
+    {
+        float *w = W.Col(c);
+        if (transpose)
+            for (int i=nb-1; i>=0; i--)
+            {
+                float s = 0.0f;
+                for (int r=0; r<=i; r++) s += T(r,i)*w[r];
+                w[i] = s;
+            }
+        else
+            for (int i=0; i<nb; i++)
+            {
+                float s = 0.0f;
+                for (int r=i; r<nb; r++) s += T(i,r)*w[r];
+                w[i] = s;
+            }
+    }
+    Gemm(len, n, nb, -1.0f, V.Col(0), 1, V.Stride(), W.Col(0), 1, W.Stride(), C, ldc, false);
+}
+
+//---------------------------------------------------------------------------------------------
+//                                         CLASS METHODS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * MATRIXX * * * * * //
+
+MatrixX& MatrixX::operator +=(const MatrixX& M)
+{
+    if (rows != M.rows || cols != M.cols) return (*this);
+    for (int j=0; j<cols; j++) Axpy(rows, 1.0f, M.Col(j), Col(j));
+    return (*this);
+}
+
+MatrixX& MatrixX::operator -=(const MatrixX& M)
+{
+    if (rows != M.rows || cols != M.cols) return (*this);
+    for (int j=0; j<cols; j++) Axpy(rows, -1.0f, M.Col(j), Col(j));
+    return (*this);
+}
+
+MatrixX& MatrixX::operator *=(float sc)
+{
+    for (int j=0; j<cols; j++) Scale(rows, sc, Col(j));
+    return (*this);
+}
+
+const bool MatrixX::operator ==(const MatrixX& M) const
+{
+    if (rows != M.rows || cols != M.cols) return false;
+    for (int j=0; j<cols; j++)
+        for (int i=0; i<rows; i++)
+            if (!CloseFloat((*this)(i,j), M(i,j))) return false;
+    return true;
+}
+
+// * * * * * LU DECOMPOSITION * * * * * //
+
+bool LUDecomposition::Factor(const MatrixX& A)
+{
+    LU = A;
+    const int n = A.Rows();
+    pivot.resize(n);
+    iota(pivot.begin(), pivot.end(), 0);
+    sign = 1;
+    if (!A.IsSquare()) {singular = true; return false;}
+
+    // Pivots this small next to the largest element are rounding noise of a zero pivot
+    const float tolerance = n*FLT_EPSILON*MaxAbs(A);
+    const int stride = LU.Stride();
+    singular = false;
+    for (int k0=0; k0<n; k0+=MATH_DENSE_BLOCK)
+    {
+        const int k1 = min(n, k0 + MATH_DENSE_BLOCK);
+        // Panel: unblocked elimination of columns k0..k1, whole rows swapped
+        for (int j=k0; j<k1; j++)
+        {
+            float *cj = LU.Col(j);
+            const int p = j + IndexOfMaxAbs(cj + j, n - j);
+            if (p != j)
+            {
+                for (int c=0; c<n; c++) swap(LU(p,c), LU(j,c));
+                swap(pivot[p], pivot[j]);
+                sign = -sign;
+            }
+            const float d = cj[j];
+            if (!(fabsf(d) > tolerance)) singular = true;
+            if (d != 0.0f) Scale(n - j - 1, 1.0f/d, cj + j + 1);
+            for (int c=j+1; c<k1; c++) Axpy(n - j - 1, -LU(j,c), cj + j + 1, LU.Col(c) + j + 1);
+        }
+        if (k1 == n) break;
+        // U12 = L11^-1 * A12, then the trailing update A22 -= L21*U12
+        SolveLower(k1 - k0, &LU(k0,k0), 1, stride, true, &LU(k0,k1), stride, n - k1);
+        Gemm(n - k1, n - k1, k1 - k0, -1.0f, &LU(k1,k0), 1, stride, &LU(k0,k1), 1, stride, &LU(k1,k1), stride, false);
+    }
+    return !singular;
+}
+
+MatrixX LUDecomposition::Solve(const MatrixX& B) const
+{
+    const int n = LU.Rows();
+    if (B.Rows() != n) return MatrixX();
+    MatrixX X(n, B.Cols());
+    for (int c=0; c<B.Cols(); c++)
+        for (int i=0; i<n; i++) X(i,c) = B(pivot[i],c);
+    SolveLower(n, LU.Col(0), 1, LU.Stride(), true, X.Col(0), X.Stride(), X.Cols());
+    SolveUpper(n, LU.Col(0), 1, LU.Stride(), false, X.Col(0), X.Stride(), X.Cols());
+    return X;
+}
+
+vector<float> LUDecomposition::Solve(const vector<float>& b) const
+{
+    if (int(b.size()) != LU.Rows()) return vector<float>();
+    MatrixX x = Solve(MatrixX(int(b.size()), 1, b.data()));
+    return vector<float>(x.Col(0), x.Col(0) + x.Rows());
+}
+
+MatrixX LUDecomposition::Inverse(void) const {return Solve(MatrixX::Identity(LU.Rows()));}
+
+float LUDecomposition::Det(void) const
+{
+    if (singular) return 0.0f;
+    float det = float(sign);
+    for (int i=0; i<LU.Rows(); i++) det *= LU(i,i);
+    return det;
+}
+
+MatrixX LUDecomposition::L(void) const
+{
+    return MatrixX::Generate(LU.Rows(), LU.Cols(), [&](int i, int j) {return (i > j) ? LU(i,j) : float(i == j);});
+}
+
+MatrixX LUDecomposition::U(void) const
+{
+    return MatrixX::Generate(LU.Rows(), LU.Cols(), [&](int i, int j) {return (i <= j) ? LU(i,j) : 0.0f;});
+}
+
+// * * * * * CHOLESKY DECOMPOSITION * * * * * //
+
+bool CholeskyDecomposition::Factor(const MatrixX& A)
+{
+    L = A;
+    positiveDefinite = A.IsSquare();
+    const int n = A.Rows();
+    const int stride = L.Stride();
+    for (int k0=0; k0<n && positiveDefinite; k0+=MATH_DENSE_BLOCK)
+    {
+        const int k1 = min(n, k0 + MATH_DENSE_BLOCK);
+        // Panel: L11 and L21 together, right-looking within the panel
+        for (int j=k0; j<k1; j++)
+        {
+            float *cj = L.Col(j);
+            if (!(cj[j] > 0.0f)) {positiveDefinite = false; break;}
+            cj[j] = sqrtf(cj[j]);
+            Scale(n - j - 1, 1.0f/cj[j], cj + j + 1);
+            for (int c=j+1; c<k1; c++) Axpy(n - c, -cj[c], cj + c, L.Col(c) + c);
+        }
+        // Trailing update of the lower triangle, A22 -= L21*L21^T
+        if (positiveDefinite && k1 < n)
+            Gemm(n - k1, n - k1, k1 - k0, -1.0f, &L(k1,k0), 1, stride, &L(k1,k0), stride, 1, &L(k1,k1), stride, true);
+    }
+    for (int j=1; j<L.Cols(); j++) memset(L.Col(j), 0, min(j, n)*sizeof(float));
+    return positiveDefinite;
+}
+
+MatrixX CholeskyDecomposition::Solve(const MatrixX& B) const
+{
+    const int n = L.Rows();
+    if (B.Rows() != n) return MatrixX();
+    MatrixX X = B;
+    SolveLower(n, L.Col(0), 1, L.Stride(), false, X.Col(0), X.Stride(), X.Cols());
+    SolveUpper(n, L.Col(0), L.Stride(), 1, false, X.Col(0), X.Stride(), X.Cols());
+    return X;
+}
+
+vector<float> CholeskyDecomposition::Solve(const vector<float>& b) const
+{
+    if (int(b.size()) != L.Rows()) return vector<float>();
+    MatrixX x = Solve(MatrixX(int(b.size()), 1, b.data()));
+    return vector<float>(x.Col(0), x.Col(0) + x.Rows());
+}
+
+float CholeskyDecomposition::Det(void) const
+{
+    if (!positiveDefinite) return 0.0f;
+    float det = 1.0f;
+    for (int i=0; i<L.Rows(); i++) det *= L(i,i)*L(i,i);
+    return det;
+}
+
+// * * * * * QR DECOMPOSITION * * * * * //
+
+bool QRDecomposition::Factor(const MatrixX& A)
+{
+    QR = A;
+    const int m = A.Rows();
+    const int n = A.Cols();
+    tau.assign(n, 0.0f);
+    fullRank = (m >= n);
+    if (!fullRank) return false;
+
+    const float tolerance = max(m, n)*FLT_EPSILON*MaxAbs(A);
+    for (int k0=0; k0<n; k0+=MATH_DENSE_BLOCK)
+    {
+        const int k1 = min(n, k0 + MATH_DENSE_BLOCK);
+        // Panel: one reflection per column, applied to the rest of the panel only
+        for (int j=k0; j<k1; j++)
+        {
+            float *v = QR.Col(j) + j;
+            const int len = m - j;
+            const float alpha = v[0];
+            const float sigma = Dot(len - 1, v + 1, v + 1);
+            float beta = alpha;
+            if (sigma > 0.0f)
+            {
+                const float norm = sqrtf(alpha*alpha + sigma);
+                beta = (alpha <= 0.0f) ? norm : -norm;
+                tau[j] = (beta - alpha)/beta;
+                Scale(len - 1, 1.0f/(alpha - beta), v + 1);
+                v[0] = beta;
+            }
+            if (!(fabsf(beta) > tolerance)) fullRank = false;
+            for (int c=j+1; c<k1; c++)
+            {
+                float *x = QR.Col(c) + j;
+                const float w = tau[j]*(x[0] + Dot(len - 1, v + 1, x + 1));
+                x[0] -= w;
+                Axpy(len - 1, -w, v + 1, x + 1);
+            }
+        }
+        if (k1 < n) ApplyReflections(QR, tau, k0, k1 - k0, true, QR.Col(k1) + k0, QR.Stride(), n - k1);
+    }
+    return fullRank;
+}
+
+MatrixX QRDecomposition::Solve(const MatrixX& B) const
+{
+    const int m = QR.Rows();
+    const int n = QR.Cols();
+    if (B.Rows() != m || m < n) return MatrixX();
+    // Q^T*B, then back substitution with R on its first n rows
+    MatrixX Y = B;
+    for (int k0=0; k0<n; k0+=MATH_DENSE_BLOCK)
+        ApplyReflections(QR, tau, k0, min(MATH_DENSE_BLOCK, n - k0), true, Y.Col(0) + k0, Y.Stride(), Y.Cols());
+    MatrixX X(n, B.Cols());
+    for (int c=0; c<B.Cols(); c++) memcpy(X.Col(c), Y.Col(c), n*sizeof(float));
+    SolveUpper(n, QR.Col(0), 1, QR.Stride(), false, X.Col(0), X.Stride(), X.Cols());
+    return X;
+}
+
+vector<float> QRDecomposition::Solve(const vector<float>& b) const
+{
+    if (int(b.size()) != QR.Rows()) return vector<float>();
+    MatrixX x = Solve(MatrixX(int(b.size()), 1, b.data()));
+    return vector<float>(x.Col(0), x.Col(0) + x.Rows());
+}
+
+MatrixX QRDecomposition::Q(void) const
+{
+    const int m = QR.Rows();
+    const int n = QR.Cols();
+    MatrixX Qm = MatrixX::Generate(m, n, [](int i, int j) {return float(i == j);});
+    for (int k0=(n - 1)/MATH_DENSE_BLOCK*MATH_DENSE_BLOCK; k0>=0 && n>0; k0-=MATH_DENSE_BLOCK)
+        ApplyReflections(QR, tau, k0, min(MATH_DENSE_BLOCK, n - k0), false, Qm.Col(0) + k0, Qm.Stride(), n);
+    return Qm;
+}
+
+MatrixX QRDecomposition::R(void) const
+{
+    const int n = QR.Cols();
+    return MatrixX::Generate(n, n, [&](int i, int j) {return (i <= j) ? QR(i,j) : 0.0f;});
+}
+
+//---------------------------------------------------------------------------------------------
+//                                         OPERATORS
+//---------------------------------------------------------------------------------------------
+
+MatrixX operator +(const MatrixX& A, const MatrixX& B)
+{
+    if (A.Rows() != B.Rows() || A.Cols() != B.Cols()) return MatrixX();
+    MatrixX C = A;
+    C += B;
+    return C;
+}
+
+MatrixX operator -(const MatrixX& A, const MatrixX& B)
+{
+    if (A.Rows() != B.Rows() || A.Cols() != B.Cols()) return MatrixX();
+    MatrixX C = A;
+    C -= B;
+    return C;
+}
+
+MatrixX operator -(const MatrixX& A) {MatrixX C = A; C *= -1.0f; return C;}
+
+MatrixX operator *(const MatrixX& A, float sc) {MatrixX C = A; C *= sc; return C;}
+
+MatrixX operator *(float sc, const MatrixX& A) {MatrixX C = A; C *= sc; return C;}
+
+MatrixX operator *(const MatrixX& A, const MatrixX& B)
+{
+    if (A.Cols() != B.Rows()) return MatrixX();
+    MatrixX C(A.Rows(), B.Cols());
+    Gemm(A.Rows(), B.Cols(), A.Cols(), 1.0f, A.Col(0), 1, A.Stride(), B.Col(0), 1, B.Stride(), C.Col(0), C.Stride(), false);
+    return C;
+}
+
+vector<float> operator *(const MatrixX& A, const vector<float>& x)
+{
+    if (int(x.size()) != A.Cols()) return vector<float>();
+    vector<float> y(A.Rows(), 0.0f);
+    for (int j=0; j<A.Cols(); j++) Axpy(A.Rows(), x[j], A.Col(j), y.data());
+    return y;
+}
+
+//---------------------------------------------------------------------------------------------
+//                                         FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+MatrixX Transpose(const MatrixX& A)
+{
+    MatrixX T(A.Cols(), A.Rows());
+    // Tiles small enough for both the source columns and the destination columns to stay cached
+    const int tile = 32;
+    for (int j0=0; j0<A.Cols(); j0+=tile)
+        for (int i0=0; i0<A.Rows(); i0+=tile)
+            for (int j=j0; j<min(j0 + tile, A.Cols()); j++)
+                for (int i=i0; i<min(i0 + tile, A.Rows()); i++) T(j,i) = A(i,j);
+    return T;
+}
+
+MatrixX TransposeTimes(const MatrixX& A, const MatrixX& B)
+{
+    if (A.Rows() != B.Rows()) return MatrixX();
+    MatrixX C(A.Cols(), B.Cols());
+    Gemm(A.Cols(), B.Cols(), A.Rows(), 1.0f, A.Col(0), A.Stride(), 1, B.Col(0), 1, B.Stride(), C.Col(0), C.Stride(), false);
+    return C;
+}
+
+float Det(const MatrixX& A) {return LUDecomposition(A).Det();}
+
+bool TryInverse(const MatrixX& A, MatrixX& inv, float& det)
+{
+    LUDecomposition lu(A);
+    if (lu.singular)
+    {
+        inv = MatrixX(A.Rows(), A.Cols());
+        det = 0.0f;
+        return false;
+    }
+    inv = lu.Inverse();
+    det = lu.Det();
+    return true;
+}
+
+bool TrySolve(const MatrixX& A, const MatrixX& B, MatrixX& X)
+{
+    LUDecomposition lu(A);
+    if (lu.singular || B.Rows() != A.Rows())
+    {
+        X = MatrixX(A.Cols(), B.Cols());
+        return false;
+    }
+    X = lu.Solve(B);
+    return true;
+}
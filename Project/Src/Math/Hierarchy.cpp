@@ -0,0 +1,112 @@
+#include "Math\Hierarchy.h"
+#include <cstring>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                         CLASS METHODS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * TRANSFORM HIERARCHY * * * * * //
+
+void TransformHierarchy::Reserve(int count)
+{
+    local.reserve(count); world.reserve(count); parent.reserve(count); depth.reserve(count);
+    dirty.reserve(count); node.reserve(count); slot.reserve(count);
+}
+
+int TransformHierarchy::AddNode(const Transform4& localTransform, int parentNode)
+{
+    if (parentNode != NoParent && (parentNode < 0 || parentNode >= Size())) return NoParent;
+    const int n = Size();
+    const int p = (parentNode == NoParent) ? NoParent : slot[parentNode];
+    const int d = (p == NoParent) ? 0 : depth[p] + 1;
+    // Appending keeps the order while depths do not decrease; the parent always precedes the child
+    if (sorted && n > 0 && d < depth.back()) sorted = false;
+    if (sorted)
+    {
+        if (d == levelCount) levels.push_back(n + 1);
+        else levels.back() = n + 1;
+    }
+    levelCount = max(levelCount, d + 1);
+    local.push_back(localTransform);
+    world.push_back(localTransform);
+    parent.push_back(p);
+    depth.push_back(d);
+    dirty.push_back(1);
+    node.push_back(n);
+    slot.push_back(n);
+    firstDirty = min(firstDirty, d);
+    return n;
+}
+
+// Counting sort of the slots by depth. It is stable, so parents keep preceding their children and
+// siblings keep their order
+void TransformHierarchy::Sort(void)
+{
+    const int n = Size();
+    int maxDepth = 0;
+    for (int s=0; s<n; s++) maxDepth = max(maxDepth, depth[s]);
+    levels.assign(maxDepth + 2, 0);
+    for (int s=0; s<n; s++) levels[depth[s] + 1]++;
+    for (int d=0; d<=maxDepth; d++) levels[d + 1] += levels[d];
+
+    vector<int> next(levels.begin(), levels.end() - 1), moved(n);
+    for (int s=0; s<n; s++) moved[s] = next[depth[s]]++;
+    vector<Transform4> l(n), w(n);
+    vector<int> p(n), dp(n), nd(n);
+    vector<uint8_t> dt(n);
+    for (int s=0; s<n; s++)
+    {
+        const int t = moved[s];
+        l[t] = local[s]; w[t] = world[s];
+        p[t] = (parent[s] == NoParent) ? NoParent : moved[parent[s]];
+        dp[t] = depth[s]; dt[t] = dirty[s]; nd[t] = node[s];
+        slot[node[s]] = t;
+    }
+    local.swap(l); world.swap(w); parent.swap(p); depth.swap(dp); dirty.swap(dt); node.swap(nd);
+    sorted = true;
+}
+
+bool TransformHierarchy::IsDirty(int n) const
+{
+    for (int s = slot[n]; s != NoParent; s = parent[s])
+        if (dirty[s]) return true;
+    return false;
+}
+
+void TransformHierarchy::Update(void)
+{
+    if (!sorted) Sort();
+    if (firstDirty == INT_MAX) return;
+    for (int d = firstDirty; d < Levels(); d++)
+    {
+        const int first = levels[d];
+        ParallelFor(levels[d + 1] - first, MATH_HIERARCHY_PARALLEL_GRAIN, [&](int begin, int end)
+        {
+            for (int s = first + begin; s < first + end; s++)
+            {
+                const int p = parent[s];
+                if (p == NoParent)
+                {
+                    if (dirty[s]) world[s] = local[s];
+                    continue;
+                }
+                // Dirtiness flows down one level at a time; the flags are cleared once every level is done
+                dirty[s] |= dirty[p];
+                if (dirty[s]) world[s] = world[p]*local[s];
+            }
+        });
+    }
+    const int first = levels[firstDirty];
+    memset(dirty.data() + first, 0, size_t(Size() - first));
+    firstDirty = INT_MAX;
+}
+
+void TransformHierarchy::UpdateAll(void)
+{
+    if (Size() == 0) return;
+    fill(dirty.begin(), dirty.end(), uint8_t(1));
+    firstDirty = 0;
+    Update();
+}
@@ -0,0 +1,141 @@
+#include "Math\Kinematics.h"
+#include "Math\Packets.h"
+#include <vector>
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * KERNEL * * * * * //
+
+// Smallest squared norm of the unnormalized ShortestArc() quaternion, relative to |a|^2 |b|^2, that
+// is normalized; below it, within about 1e-5 radians of a half turn, a and b count as opposite
+static const float MinArc = 1e-10f;
+// Distance under which Reach() leaves a joint on the one it follows
+static const float MinLength = 1e-20f;
+
+// Loads elements i to i + n - 1 of a span, lanes past n repeating element i so that they hold a
+// real chain
+template<typename T>
+static inline Vector3x8 LoadLanes(const SoASpan<T>& s, int i, int n)
+{
+    if (n == MATH_BATCH_WIDTH) return Vector3x8(Floatx8::Load(s[0] + i), Floatx8::Load(s[1] + i), Floatx8::Load(s[2] + i));
+    float f[3][MATH_BATCH_WIDTH];
+    for (int k=0; k<3; k++)
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) f[k][j] = s[k][i + ((j < n) ? j : 0)];
+    return Vector3x8(Floatx8::Load(f[0]), Floatx8::Load(f[1]), Floatx8::Load(f[2]));
+}
+
+// Stores the first n lanes of N packets into elements i to i + n - 1 of a span
+template<int N, typename T>
+static inline void StoreLanes(const SoASpan<T>& s, int i, int n, const Floatx8 *const (&v)[N])
+{
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<N; k++) v[k]->Store(s[k] + i);
+        return;
+    }
+    float f[MATH_BATCH_WIDTH];
+    for (int k=0; k<N; k++)
+    {
+        v[k]->Store(f);
+        for (int j=0; j<n; j++) s[k][i + j] = f[j];
+    }
+}
+
+// Rotation taking the direction of a to that of b by the shortest arc, (a x b, |a||b| + a.b)
+// normalized, for every lane. Lanes where a or b is zero, or where they point opposite ways,
+// keep the identity
+static inline Quaternionx8 ShortestArc(const Vector3x8& a, const Vector3x8& b)
+{
+    const Floatx8 one = Floatx8::Broadcast(1.0f), zero = Floatx8::Zero();
+    const Floatx8 ab = (a*a)*(b*b);
+    const Vector3x8 c = CrossProduct(a, b);
+    const Floatx8 w = Sqrt(ab) + a*b;
+    const Floatx8 n2 = c*c + w*w;
+    const Floatx8 ok = CmpGreater(n2, Floatx8::Broadcast(MinArc)*ab);
+    const Floatx8 inv = one/Sqrt(Select(ok, n2, one));
+    return Quaternionx8(Select(ok, c.x*inv, zero), Select(ok, c.y*inv, zero), Select(ok, c.z*inv, zero), Select(ok, w*inv, one));
+}
+
+// The point at distance length from anchor towards p
+static inline Vector3x8 Reach(const Vector3x8& anchor, const Vector3x8& p, const Floatx8& length)
+{
+    const Vector3x8 d = p - anchor;
+    return anchor + d*(length/Max(Magnitude(d), Floatx8::Broadcast(MinLength)));
+}
+
+// Runs an iteration of a solver on groups of 8 chains until their end effectors are all within
+// tolerance or the iterations are spent, then writes back the joints and the bone rotations.
+// solve(p, length, root, target) moves the joints p of one group
+template<typename Solve>
+static void SolveChains(int jointCount, int iterations, float tolerance, const SoASpan<Point3>& joints,
+                        const SoASpan<const Point3>& targets, const SoASpan<Quaternion>& rotations, Solve solve)
+{
+    if (jointCount < 2) return;
+    const int chains = targets.count, end = jointCount - 1;
+    const Floatx8 tolerance2 = Floatx8::Broadcast(tolerance*tolerance);
+    ParallelFor(chains, MATH_IK_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        vector<Vector3x8> p(jointCount);
+        vector<Floatx8> length(end);
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            for (int j=0; j<jointCount; j++) p[j] = LoadLanes(joints, j*chains + i, n);
+            for (int j=0; j<end; j++) length[j] = Magnitude(p[j + 1] - p[j]);
+            const Vector3x8 root = p[0], target = LoadLanes(targets, i, n);
+            for (int it=0; it<iterations; it++)
+            {
+                const Vector3x8 miss = p[end] - target;
+                if (MoveMask(CmpLessEqual(miss*miss, tolerance2)) == 0xFF) break;
+                solve(p.data(), length.data(), root, target);
+            }
+
+            Vector3x8 before = root;
+            for (int j=0; j<end; j++)
+            {
+                const Vector3x8 next = LoadLanes(joints, (j + 1)*chains + i, n);
+                const Quaternionx8 r = ShortestArc(next - before, p[j + 1] - p[j]);
+                StoreLanes<4>(rotations, j*chains + i, n, {&r.x, &r.y, &r.z, &r.w});
+                before = next;
+            }
+            for (int j=0; j<jointCount; j++) StoreLanes<3>(joints, j*chains + i, n, {&p[j].x, &p[j].y, &p[j].z});
+        }
+    });
+}
+
+// * * * * * CCD * * * * * //
+
+void SolveCCD(int jointCount, int iterations, float tolerance, const SoASpan<Point3>& joints,
+              const SoASpan<const Point3>& targets, const SoASpan<Quaternion>& rotations)
+{
+    const int end = jointCount - 1;
+    SolveChains(jointCount, iterations, tolerance, joints, targets, rotations,
+                [end](Vector3x8 *p, const Floatx8 *, const Vector3x8&, const Vector3x8& target)
+    {
+        for (int j=end - 1; j>=0; j--)
+        {
+            const Quaternionx8 r = ShortestArc(p[end] - p[j], target - p[j]);
+            for (int k=j + 1; k<=end; k++) p[k] = p[j] + Rotate(p[k] - p[j], r);
+        }
+    });
+}
+
+// * * * * * FABRIK * * * * * //
+
+void SolveFABRIK(int jointCount, int iterations, float tolerance, const SoASpan<Point3>& joints,
+                 const SoASpan<const Point3>& targets, const SoASpan<Quaternion>& rotations)
+{
+    const int end = jointCount - 1;
+    SolveChains(jointCount, iterations, tolerance, joints, targets, rotations,
+                [end](Vector3x8 *p, const Floatx8 *length, const Vector3x8& root, const Vector3x8& target)
+    {
+        p[end] = target;
+        for (int j=end - 1; j>=0; j--) p[j] = Reach(p[j + 1], p[j], length[j]);
+        p[0] = root;
+        for (int j=0; j<end; j++) p[j + 1] = Reach(p[j], p[j + 1], length[j]);
+    });
+}
@@ -1,4 +1,6 @@
 #include "Math\Matrices.h"
+#include "Math\Expressions.h"
+#include "Rotations.h"
 #include <iostream>
 #include <cfloat>
 
@@ -8,23 +10,6 @@
 
 using namespace std;
 
-// * * * * * MATRIX4 * * * * * //
-string Matrix4::ToString(void)
-{
-    string s;
-    for (int i=0; i<4; i++)
-    {
-        s += "\t[";
-        for (int j=0; j<4; j++)
-        {
-            if (j!=3) s += to_string(m[j][i]) + ", ";
-            else s += to_string(m[j][i]);
-        }
-        s+= "]\n";
-    }
-    return s;
-}
-
 // * * * * * QUATERNIONS * * * * * //
 
 Matrix3 Quaternion::GetRotation(void)
@@ -87,6 +72,22 @@ void Quaternion::SetRotation(const Matrix3& M)
     };
 }
 
+void UnitQuaternion::SetRotation(const Matrix3& M)
+{
+    const float m00 = M(0,0), m11 = M(1,1), m22 = M(2,2);
+    const float trace = m00 + m11 + m22;
+    const bool caseW = trace > 0.0f;
+    const bool caseX = !caseW && m00 > m11 && m00 > m22;
+    const bool caseY = !caseW && !caseX && m11 > m22;
+    // t = 4*c^2 for the picked component c, at least 1 for a rotation
+    const float t = caseW ? 1.0f + trace : caseX ? 1.0f + m00 - m11 - m22 : caseY ? 1.0f - m00 + m11 - m22 : 1.0f - m00 - m11 + m22;
+    const float s = 0.5f*InvSqrtFast(t);
+    x = s*(caseW ? M(2,1) - M(1,2) : caseX ? t : caseY ? M(1,0) + M(0,1) : M(0,2) + M(2,0));
+    y = s*(caseW ? M(0,2) - M(2,0) : caseX ? M(1,0) + M(0,1) : caseY ? t : M(2,1) + M(1,2));
+    z = s*(caseW ? M(1,0) - M(0,1) : caseX ? M(0,2) + M(2,0) : caseY ? M(2,1) + M(1,2) : t);
+    w = s*(caseW ? t : caseX ? M(2,1) - M(1,2) : caseY ? M(0,2) - M(2,0) : M(1,0) - M(0,1));
+}
+
 // * * * * * REF * * * * * //
 
 Matrix2 REF(const Matrix2& M, float *c)
@@ -267,46 +268,38 @@ float Det(const Matrix4& M)
 
 // * * * * * INVERSE * * * * * //
 
-Matrix2 Inverse(const Matrix2& M)
+// A matrix is treated as singular when its determinant, or the reciprocal scaling the adjugate,
+// is not finite. Zero determinants fall in the second case
+static inline bool Invertible(float det, float sc) {return (isfinite(det) && isfinite(sc));}
+
+bool TryInverse(const Matrix2& M, Matrix2& inv, float& det) noexcept
 {
-    try
-    {
-        if (Det(M) == 0.0f) throw NonInvertibleE();
-        return (1.0/Det(M)) * Matrix2(M(1,1), -1.0*M(0,1), -1.0*M(1,0), M(0,0));
-    }
-    catch(NonInvertibleE& e)
-    {
-        cout << "Exception occurred!\n" << e.what();
-    }
-    return M.Zero();
+    det = Det(M);
+    float sc = 1.0f/det;
+    if (!Invertible(det, sc)) {inv = M.Zero(); return false;}
+    inv = sc * Matrix2(M(1,1), 0.0f - M(0,1), 0.0f - M(1,0), M(0,0));
+    return true;
 }
 
-Matrix3 Inverse(const Matrix3& M)
+bool TryInverse(const Matrix3& M, Matrix3& inv, float& det) noexcept
 {
     const Vector3& m0 = M[0];
     const Vector3& m1 = M[1];
     const Vector3& m2 = M[2];
-    float scalarTP = ScalarTripleProduct(m0,m1,m2);
-
-    try{
-
-        if (scalarTP == 0.0f) throw NonInvertibleE();
-        float sc = (1.0f/scalarTP);
-        Vector3 v0 = CrossProduct(m1,m2);
-        Vector3 v1 = CrossProduct(m2,m0);
-        Vector3 v2 = CrossProduct(m0,m1);
-        return (Matrix3(v0.x*sc, v0.y*sc, v0.z*sc,
-                        v1.x*sc, v1.y*sc, v1.z*sc,
-                        v2.x*sc, v2.y*sc, v2.z*sc));
-    }
-    catch (NonInvertibleE& e)
-    {
-        cout << "Exception occurred!\n" << e.what();
-    }
-    return M.Zero();
+    det = ScalarTripleProduct(m0,m1,m2);
+    float sc = (1.0f/det);
+    if (!Invertible(det, sc)) {inv = M.Zero(); return false;}
+
+    Vector3 v0 = CrossProduct(m1,m2);
+    Vector3 v1 = CrossProduct(m2,m0);
+    Vector3 v2 = CrossProduct(m0,m1);
+    inv = Matrix3(v0.x*sc, v0.y*sc, v0.z*sc,
+                  v1.x*sc, v1.y*sc, v1.z*sc,
+                  v2.x*sc, v2.y*sc, v2.z*sc);
+    return true;
 }
 
-Matrix4 Inverse(const Matrix4& M)
+bool TryInverse(const Matrix4& M, Matrix4& inv, float& det) noexcept
 {
     const Vector3& a = reinterpret_cast<const Vector3&>(M[0]);
     const Vector3& b = reinterpret_cast<const Vector3&>(M[1]);
@@ -319,44 +312,39 @@ Matrix4 Inverse(const Matrix4& M)
     Vector3 u = a*vec.y - b*vec.x;
     Vector3 v = c*vec.w - d*vec.z;
 
-    float det = (s*v)+(t*u);
+    det = (s*v)+(t*u);
+    float sc = (1.0f / det);
+    if (!Invertible(det, sc)) {inv = M.Zero(); return false;}
 
-    try
-    {
-        if (det == 0) throw NonInvertibleE();
-        float sc = (1.0f / det);
-        s *= sc;
-        t *= sc;
-        u *= sc;
-        v *= sc;
-
-        Vector3 r0 = CrossProduct(b, v) + t*vec.y;
-        Vector3 r1 = CrossProduct(v, a) - t*vec.x;
-        Vector3 r2 = CrossProduct(d, u) + s*vec.w;
-        Vector3 r3 = CrossProduct(u, c) - s*vec.z;
-
-        return (Matrix4(r0.x, r0.y, r0.z, -(b*t),
-                        r1.x, r1.y, r1.z, (a*t),
-                        r2.x, r2.y, r2.z, -(d*s),
-                        r3.x, r3.y, r3.z, (c*s)));
-    }
-    catch(NonInvertibleE& e)
-    {
-        cout << "Exception occurred!\n" << e.what();
-    }
-    return M.Zero();
+    s *= sc;
+    t *= sc;
+    u *= sc;
+    v *= sc;
+
+    Vector3 r0 = CrossProduct(b, v) + t*vec.y;
+    Vector3 r1 = CrossProduct(v, a) - t*vec.x;
+    Vector3 r2 = CrossProduct(d, u) + s*vec.w;
+    Vector3 r3 = CrossProduct(u, c) - s*vec.z;
+
+    inv = Matrix4(r0.x, r0.y, r0.z, -(b*t),
+                  r1.x, r1.y, r1.z, (a*t),
+                  r2.x, r2.y, r2.z, -(d*s),
+                  r3.x, r3.y, r3.z, (c*s));
+    return true;
 }
 
-Transform3 Inverse(const Transform3& T)
+bool TryInverse(const Transform3& T, Transform3& inv, float& det) noexcept
 {
     const Matrix3& M = Matrix3( T(0,0), T(0,1), T(0,2),
                                 T(1,0), T(1,1), T(1,2),
                                 0.0f,   0.0f,   1.0f);
-    Matrix3 Inv = Inverse(M);
-    return (Transform3(Inv(0,0), Inv(0,1), Inv(0,2), Inv(1,0), Inv(1,1), Inv(1,2)));
+    Matrix3 Inv;
+    bool valid = TryInverse(M, Inv, det);
+    inv = Transform3(Inv(0,0), Inv(0,1), Inv(0,2), Inv(1,0), Inv(1,1), Inv(1,2));
+    return valid;
 }
 
-Transform4 Inverse(const Transform4& T)
+bool TryInverse(const Transform4& T, Transform4& inv, float& det) noexcept
 {
     const Vector3& w = T[0];
     const Vector3& x = T[1];
@@ -366,85 +354,63 @@ Transform4 Inverse(const Transform4& T)
     Vector3 s = CrossProduct(w, x);
     Vector3 t = CrossProduct(y, z);
 
-    float det = s*y;
+    det = s*y;
+    float sc = 1.0f/det;
+    if (!Invertible(det, sc)) {inv = T.Zero(); return false;}
+
+    s *= sc;
+    t *= sc;
 
-    try {
-        if (det == 0.0f) throw NonInvertibleE();
-        float sc = 1.0f/(s*y);
-        s *= sc;
-        t *= sc;
+    Vector3 vec = y*sc;
+    Vector3 r0 = CrossProduct(x, vec);
+    Vector3 r1 = CrossProduct(vec, w);
 
-        Vector3 vec = y*sc;
-        Vector3 r0 = CrossProduct(x, vec);
-        Vector3 r1 = CrossProduct(vec, w);
+    inv = Transform4(
+        r0.x, r0.y, r0.z, -(x*t),
+        r1.x, r1.y, r1.z, (w*t),
+        s.x, s.y, s.z, -(z*s));
+    return true;
+}
 
-        return (Transform4(
-            r0.x, r0.y, r0.z, -(x*t),
-            r1.x, r1.y, r1.z, (w*t),
-            s.x, s.y, s.z, -(z*s)));
+// The throwing functions keep their historic behaviour on top of TryInverse: singular matrices
+// raise NonInvertibleE, which is reported on the console, and yield the zero matrix
+template<typename M>
+static M InverseOrReport(const M& A)
+{
+    M inv;
+    float det;
+    try
+    {
+        if (!TryInverse(A, inv, det)) throw NonInvertibleE();
     }
     catch (NonInvertibleE& e)
     {
         cout << "Exception occurred!\n" << e.what();
     }
-    return T.Zero();
+    return inv;
 }
 
+Matrix2 Inverse(const Matrix2& M) {return InverseOrReport(M);}
+Matrix3 Inverse(const Matrix3& M) {return InverseOrReport(M);}
+Matrix4 Inverse(const Matrix4& M) {return InverseOrReport(M);}
+Transform3 Inverse(const Transform3& T) {return InverseOrReport(T);}
+Transform4 Inverse(const Transform4& T) {return InverseOrReport(T);}
+
 // * * * * * ADJUGATE * * * * * //
+
+// The rows of the adjugate are the cross products of the columns, as in the inverse before the
+// division by the determinant, so singular matrices need no special case
 Matrix3 Adjugate(const Matrix3& M)
 {
-    // Calculate using inverse if Det(M) > FLT_MIN, faster
-    if (fabs(Det(M)) > FLT_MIN) return (Det(M)*Inverse(M));
-    // Calculate using minor matrix, much slower
-    else
-    {
-        float m00 = Det(Matrix2(M(1,1), M(1,2), M(2,1), M(2,2)));
-        float m01 = Det(Matrix2(M(1,0), M(1,2), M(2,0), M(2,2)));
-        float m02 = Det(Matrix2(M(1,0), M(1,1), M(2,0), M(2,1)));
-        float m10 = Det(Matrix2(M(0,1), M(0,2), M(2,1), M(2,2)));
-        float m11 = Det(Matrix2(M(0,0), M(0,2), M(2,0), M(2,2)));
-        float m12 = Det(Matrix2(M(0,0), M(0,1), M(2,0), M(2,1)));
-        float m20 = Det(Matrix2(M(0,1), M(0,2), M(1,1), M(1,2)));
-        float m21 = Det(Matrix2(M(0,0), M(0,2), M(1,0), M(1,2)));
-        float m22 = Det(Matrix2(M(0,0), M(0,1), M(1,0), M(1,1)));
-
-        return Transpose(Matrix3( m00, 0.0f-m01, m02,
-                                0.0f-m10, m11, 0.0f-m12,
-                                m20, 0.0f-m21, m22));
-    }
+    Vector3 v0 = CrossProduct(M[1], M[2]);
+    Vector3 v1 = CrossProduct(M[2], M[0]);
+    Vector3 v2 = CrossProduct(M[0], M[1]);
+    return (Matrix3(v0.x, v0.y, v0.z,
+                    v1.x, v1.y, v1.z,
+                    v2.x, v2.y, v2.z));
 }
 
-Matrix4 Adjugate(const Matrix4& M)
-{
-    // Calculate using inverse if Det(M) > FLT_MIN, faster
-    if (fabs(Det(M)) > FLT_MIN) return (Det(M)*Inverse(M));
-    // Calculate using minor matrix, much slower
-    else
-    {
-        float m00 = Det(Matrix3(M(1,1), M(1,2), M(1,3), M(2,1), M(2,2), M(2,3), M(3,1), M(3,2), M(3,3)));
-        float m01 = Det(Matrix3(M(1,0), M(1,2), M(1,3), M(2,0), M(2,2), M(2,3), M(3,0), M(3,2), M(3,3)));
-        float m02 = Det(Matrix3(M(1,0), M(1,1), M(1,3), M(2,0), M(2,1), M(2,3), M(3,0), M(3,1), M(3,3)));
-        float m03 = Det(Matrix3(M(1,0), M(1,1), M(1,2), M(2,0), M(2,1), M(2,2), M(3,0), M(3,1), M(3,2)));
-        float m10 = Det(Matrix3(M(0,1), M(0,2), M(0,3), M(2,1), M(2,2), M(2,3), M(3,1), M(3,2), M(3,3)));
-        float m11 = Det(Matrix3(M(0,0), M(0,2), M(0,3), M(2,0), M(2,2), M(2,3), M(3,0), M(3,2), M(3,3)));
-        float m12 = Det(Matrix3(M(0,0), M(0,1), M(0,3), M(2,0), M(2,1), M(2,3), M(3,0), M(3,1), M(3,3)));
-        float m13 = Det(Matrix3(M(0,0), M(0,1), M(0,2), M(2,0), M(2,1), M(2,2), M(3,0), M(3,1), M(3,2)));
-        float m20 = Det(Matrix3(M(0,1), M(0,2), M(0,3), M(1,1), M(1,2), M(1,3), M(3,1), M(3,2), M(3,3)));
-        float m21 = Det(Matrix3(M(0,0), M(0,2), M(0,3), M(1,0), M(1,2), M(1,3), M(3,0), M(3,2), M(3,3)));
-        float m22 = Det(Matrix3(M(0,0), M(0,1), M(0,3), M(1,0), M(1,1), M(1,3), M(3,0), M(3,1), M(3,3)));
-        float m23 = Det(Matrix3(M(0,0), M(0,1), M(0,2), M(1,0), M(1,1), M(1,2), M(3,0), M(3,1), M(3,2)));
-        float m30 = Det(Matrix3(M(0,1), M(0,2), M(0,3), M(1,1), M(1,2), M(1,3), M(2,1), M(2,2), M(2,3)));
-        float m31 = Det(Matrix3(M(0,0), M(0,2), M(0,3), M(1,0), M(1,2), M(1,3), M(2,0), M(2,2), M(2,3)));
-        float m32 = Det(Matrix3(M(0,0), M(0,1), M(0,3), M(1,0), M(1,1), M(1,3), M(2,0), M(2,1), M(2,3)));
-        float m33 = Det(Matrix3(M(0,0), M(0,1), M(0,2), M(1,0), M(1,1), M(1,2), M(2,0), M(2,1), M(2,2)));
-
-
-        return Transpose(Matrix4( m00, 0.0f-m01, m02, 0.0f-m03,
-                                 0.0f-m10, m11, 0.0f-m12, m13,
-                                 m20, 0.0f-m21, m22, 0.0f-m23,
-                                 0.0f-m30, m31, 0.0f-m32, m33));
-    }
-}
+Matrix4 Adjugate(const Matrix4& M) {return (Transpose(Cofactor(M)));}
 
 // * * * * * SCALE MATRICES * * * * * //
 
@@ -542,40 +508,22 @@ Matrix4 Skew(float angle, const Vector4& u1, const Vector4& u2)
 
 Matrix2 Rotate(float angle)
 {
-	float cs = cos(angle);
-	float sn = sin(angle);
-
-	return Matrix2(cs, -sn, sn, cs);
+	return Matrix2::Rotation(cos(angle), sin(angle));
 }
 
 Matrix3 RotateAboutX(float angle)
 {
-    float cs = cos(angle);
-    float sn = sin(angle);
-
-    return (Matrix3(1.0f, 0.0f, 0.0f,
-                    0.0f, cs, -sn,
-                    0.0f, sn, cs));
+    return (Matrix3::RotationX(cos(angle), sin(angle)));
 }
 
 Matrix3 RotateAboutY(float angle)
 {
-    float cs = cos(angle);
-    float sn = sin(angle);
-
-    return (Matrix3(cs, 0.0f, sn,
-                    0.0f, 1.0f, 0.0f,
-                    -sn, 0.0f, cs));
+    return (Matrix3::RotationY(cos(angle), sin(angle)));
 }
 
 Matrix3 RotateAboutZ(float angle)
 {
-    float cs = cos(angle);
-    float sn = sin (angle);
-
-    return (Matrix3(cs, -sn, 0.0f,
-                    sn, cs, 0.0f,
-                    0.0f, 0.0f, 1.0f));
+    return (Matrix3::RotationZ(cos(angle), sin(angle)));
 }
 
 Matrix3 RotateAboutAxis(float angle, const Vector3& ax)
@@ -731,5 +679,327 @@ Vector3 Transform(const Vector3& v, const Quaternion& q)
 {
     const Vector3& u = q.GetVector();
     float uDotU= u.x*u.x + u.y*u.y + u.z*u.z;
-    return (v*(q.w*q.w - uDotU) + u*u*v*2.0f + CrossProduct(u,v)*q.w*2.0f);
-}
\ No newline at end of file
+    // The sandwich product q*v*q^-1 scaled by |q|^2, evaluated in one pass per component, bit for
+    // bit the eager formula
+    return Eval(Lazy(v)*(q.w*q.w - uDotU) + Lazy(u)*(u*v)*2.0f + CrossProduct(Lazy(u), Lazy(v))*q.w*2.0f);
+}
+// * * * * * TRS * * * * * //
+
+bool DecomposeTRS(const Transform4& T, Point3& translation, Quaternion& rotation, Vector3& scale) noexcept
+{
+    translation = T.GetTranslation();
+    Vector3 a[3] = {T[0], T[1], T[2]};
+    const float det = a[0]*CrossProduct(a[1], a[2]);
+    const float norm2 = a[0]*a[0] + a[1]*a[1] + a[2]*a[2];
+    if (!(fabsf(det) > MATH_TRS_MIN_DETERMINANT*norm2*sqrtf(norm2)))
+    {
+        rotation = Quaternion(0.0f, 0.0f, 0.0f, 1.0f);
+        scale = Vector3(Magnitude(a[0]), Magnitude(a[1]), Magnitude(a[2]));
+        return false;
+    }
+    // A mirrored transform keeps its reflection in the x axis, the rest is a proper rotation
+    const float flip = (det < 0.0f) ? -1.0f : 1.0f;
+    a[0] = a[0]*flip;
+    // Polar decomposition by scaled Newton iteration, X <- (g*X + X^-T/g)/2, which converges to
+    // the rotation nearest to A. The columns of X^-T are the cross products of those of X over det
+    Vector3 x[3] = {a[0], a[1], a[2]};
+    for (int it=0; it<MATH_TRS_MAX_ITERATIONS; it++)
+    {
+        Vector3 c[3] = {CrossProduct(x[1], x[2]), CrossProduct(x[2], x[0]), CrossProduct(x[0], x[1])};
+        const float d = x[0]*c[0];
+        const float xn = x[0]*x[0] + x[1]*x[1] + x[2]*x[2];
+        const float cn = c[0]*c[0] + c[1]*c[1] + c[2]*c[2];
+        const float g = sqrtf(sqrtf(cn/(xn*d*d)));
+        const float h = 0.5f/(g*d);
+        float change = 0.0f;
+        for (int k=0; k<3; k++)
+        {
+            Vector3 n = x[k]*(0.5f*g) + c[k]*h;
+            change = max(change, max(fabsf(n.x - x[k].x), max(fabsf(n.y - x[k].y), fabsf(n.z - x[k].z))));
+            x[k] = n;
+        }
+        if (change < MATH_TRS_TOLERANCE) break;
+    }
+    // S = R^T*A, whose diagonal is the scale
+    scale = Vector3(flip*(x[0]*a[0]), x[1]*a[1], x[2]*a[2]);
+    rotation.SetRotation(Matrix3(x[0], x[1], x[2]));
+    return true;
+}
+
+Transform4 ComposeTRS(const Point3& translation, const Quaternion& rotation, const Vector3& scale) noexcept
+{
+    const Quaternion& q = rotation;
+    // 2/|q|^2 instead of 2 rotates by non unit quaternions without normalizing them first
+    const float s = 2.0f/(q.x*q.x + q.y*q.y + q.z*q.z + q.w*q.w);
+    const float xx = s*q.x*q.x, yy = s*q.y*q.y, zz = s*q.z*q.z;
+    const float xy = s*q.x*q.y, xz = s*q.x*q.z, yz = s*q.y*q.z;
+    const float wx = s*q.w*q.x, wy = s*q.w*q.y, wz = s*q.w*q.z;
+    return Transform4(
+        (1.0f - yy - zz)*scale.x, (xy - wz)*scale.y, (xz + wy)*scale.z, translation.x,
+        (xy + wz)*scale.x, (1.0f - xx - zz)*scale.y, (yz - wx)*scale.z, translation.y,
+        (xz - wy)*scale.x, (yz + wx)*scale.y, (1.0f - xx - yy)*scale.z, translation.z);
+}
+
+DualQuaternion::DualQuaternion(const Transform4& T)
+{
+    Point3 t;
+    Quaternion q;
+    Vector3 s;
+    DecomposeTRS(T, t, q, s);
+    *this = DualQuaternion(UnitQuaternion::FromNormalized(q), t);
+}
+
+// * * * * * EIGEN DECOMPOSITION * * * * * //
+
+// Zeroes a[p][q] of the symmetric matrix a with the Jacobi rotation J of the (p,q) plane, a <- J^T*a*J,
+// and accumulates the rotation, v <- v*J. The tangent of the angle is the smaller root, so |angle| <= pi/4
+static void JacobiRotate(float (&a)[3][3], float (&v)[3][3], int p, int q)
+{
+    const float apq = a[p][q];
+    if (apq == 0.0f) return;
+    const int r = 3 - p - q;
+    const float tau = (a[q][q] - a[p][p])/(2.0f*apq);
+    const float t = copysignf(1.0f, tau)/(fabsf(tau) + sqrtf(1.0f + tau*tau));
+    const float c = 1.0f/sqrtf(1.0f + t*t);
+    const float s = t*c;
+    a[p][p] -= t*apq;
+    a[q][q] += t*apq;
+    a[p][q] = a[q][p] = 0.0f;
+    const float arp = a[r][p], arq = a[r][q];
+    a[r][p] = a[p][r] = c*arp - s*arq;
+    a[r][q] = a[q][r] = s*arp + c*arq;
+    for (int i=0; i<3; i++)
+    {
+        const float vp = v[i][p], vq = v[i][q];
+        v[i][p] = c*vp - s*vq;
+        v[i][q] = s*vp + c*vq;
+    }
+}
+
+void DiagonalizeSymmetric(const Matrix3& M, Matrix3& rotation, Vector3& values) noexcept
+{
+    float a[3][3], v[3][3];
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++)
+        {
+            a[i][j] = 0.5f*(M(i,j) + M(j,i));
+            v[i][j] = float(i == j);
+        }
+    for (int sweep=0; sweep<MATH_JACOBI_SWEEPS; sweep++)
+    {
+        JacobiRotate(a, v, 0, 1);
+        JacobiRotate(a, v, 0, 2);
+        JacobiRotate(a, v, 1, 2);
+    }
+    // Sorting network, every swap negates one column so that v stays a rotation
+    float d[3] = {a[0][0], a[1][1], a[2][2]};
+    const int pairs[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+    for (const auto& pr : pairs)
+    {
+        const int i = pr[0], j = pr[1];
+        if (d[i] >= d[j]) continue;
+        swap(d[i], d[j]);
+        for (int k=0; k<3; k++)
+        {
+            const float vi = v[k][i];
+            v[k][i] = v[k][j];
+            v[k][j] = -vi;
+        }
+    }
+    rotation = Matrix3(v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
+    values = Vector3(d[0], d[1], d[2]);
+}
+
+void DiagonalizeSymmetric(const Matrix3& M, Quaternion& rotation, Vector3& values) noexcept
+{
+    Matrix3 R;
+    DiagonalizeSymmetric(M, R, values);
+    rotation.SetRotation(R);
+}
+
+// * * * * * SINGULAR VALUE DECOMPOSITION * * * * * //
+
+// Right-multiplies the quaternion q = (x, y, z, w) by the rotation of the (i,j) plane that turns
+// e_i towards e_j by twice the half angle of cosine ch and sine sh
+static inline void RotateQuaternion(float (&q)[4], int i, int j, float ch, float sh)
+{
+    const int k = 3 - i - j;
+    const float sk = (j == (i + 1) % 3) ? sh : -sh;
+    const float qi = q[i], qj = q[j], qk = q[k], qw = q[3];
+    q[i] = ch*qi + sh*qj;
+    q[j] = ch*qj - sh*qi;
+    q[k] = ch*qk + sk*qw;
+    q[3] = ch*qw - sk*qk;
+}
+
+// One-sided Jacobi rotation Q of the (i,j) plane that orthogonalizes columns i and j of b, b <- b*Q,
+// accumulated into q. This is the Jacobi rotation of b^T*b, tan(2*angle) = 2*bij/(bii - bjj) with
+// |angle| <= pi/4, but the double, single and half angles come from normalizing 2D vectors with
+// reciprocal square roots instead of the arctangent, square roots and divide
+static void JacobiOrthogonalize(float (&b)[3][3], float (&q)[4], int i, int j)
+{
+    float bii = 0.0f, bjj = 0.0f, bij = 0.0f;
+    for (int k=0; k<3; k++)
+    {
+        bii += b[k][i]*b[k][i];
+        bjj += b[k][j]*b[k][j];
+        bij += b[k][i]*b[k][j];
+    }
+    const float d = bii - bjj, e = (d < 0.0f) ? -2.0f*bij : 2.0f*bij;
+    const float r2 = d*d + e*e;
+    // Orthogonal (or zero) columns are left alone
+    const float w2 = (r2 >= FLT_MIN) ? InvSqrtFast(r2) : 0.0f;
+    const float c2 = 1.0f + fabsf(d)*w2, s2 = e*w2;
+    const float w1 = InvSqrtFast(c2*c2 + s2*s2);
+    const float c1 = 1.0f + c2*w1, s1 = s2*w1;
+    const float w = InvSqrtFast(c1*c1 + s1*s1);
+    const float ch = c1*w, sh = s1*w;
+    const float c = ch*ch - sh*sh, s = 2.0f*ch*sh;
+    for (int k=0; k<3; k++)
+    {
+        const float bi = b[k][i], bj = b[k][j];
+        b[k][i] = c*bi + s*bj;
+        b[k][j] = c*bj - s*bi;
+    }
+    RotateQuaternion(q, i, j, ch, sh);
+}
+
+// Givens rotation Q of the (i,j) plane that zeroes b[j][col] against the pivot b[i][col], which
+// ends up non-negative, b <- Q^T*b, accumulated into q
+static void QRGivens(float (&b)[3][3], float (&q)[4], int i, int j, int col)
+{
+    const float a1 = b[i][col], a2 = b[j][col];
+    const float r2 = a1*a1 + a2*a2;
+    const bool pivot = r2 > SVDEpsilon*SVDEpsilon;
+    float ch = fabsf(a1) + (pivot ? r2*InvSqrtFast(r2) : SVDEpsilon);
+    float sh = pivot ? a2 : 0.0f;
+    if (a1 < 0.0f) swap(ch, sh);
+    const float w = InvSqrtFast(ch*ch + sh*sh);
+    ch *= w;
+    sh *= w;
+    const float c = ch*ch - sh*sh, s = 2.0f*ch*sh;
+    for (int k=0; k<3; k++)
+    {
+        const float bi = b[i][k], bj = b[j][k];
+        b[i][k] = c*bi + s*bj;
+        b[j][k] = c*bj - s*bi;
+    }
+    RotateQuaternion(q, i, j, ch, sh);
+}
+
+// Normalizes q with a reciprocal square root and writes its rotation matrix to r
+static void QuaternionToRotation(float (&q)[4], float (&r)[3][3])
+{
+    const float n = InvSqrtFast(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    for (int i=0; i<4; i++) q[i] *= n;
+    const float x = q[0], y = q[1], z = q[2], w = q[3];
+    r[0][0] = 1.0f - 2.0f*(y*y + z*z); r[0][1] = 2.0f*(x*y - w*z); r[0][2] = 2.0f*(x*z + w*y);
+    r[1][0] = 2.0f*(x*y + w*z); r[1][1] = 1.0f - 2.0f*(x*x + z*z); r[1][2] = 2.0f*(y*z - w*x);
+    r[2][0] = 2.0f*(x*z - w*y); r[2][1] = 2.0f*(y*z + w*x); r[2][2] = 1.0f - 2.0f*(x*x + y*y);
+}
+
+// Computes the SVD into quaternions and rotation matrices: u and v hold (x, y, z, w), U and V the
+// matrices, sigma the singular values
+static void SVD(const Matrix3& M, float (&u)[4], float (&U)[3][3], float (&sigma)[3], float (&v)[4], float (&V)[3][3])
+{
+    // Scaled so that the largest element is 1 and the squared column lengths neither overflow nor
+    // underflow
+    float m = 0.0f;
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++) m = max(m, fabsf(M(i,j)));
+    const float scale = (m > 0.0f) ? 1.0f/max(m, FLT_MIN) : 1.0f;
+    float B[3][3], rho[3];
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++) B[i][j] = scale*M(i,j);
+
+    // B <- M*V with orthogonal columns, V diagonalizing M^T*M
+    v[0] = v[1] = v[2] = 0.0f; v[3] = 1.0f;
+    for (int sweep=0; sweep<MATH_SVD_SWEEPS; sweep++)
+    {
+        JacobiOrthogonalize(B, v, 0, 1);
+        JacobiOrthogonalize(B, v, 1, 2);
+        JacobiOrthogonalize(B, v, 2, 0);
+    }
+
+    // Columns sorted by decreasing length. Every swap negates one column, a quarter turn of V
+    for (int j=0; j<3; j++) rho[j] = B[0][j]*B[0][j] + B[1][j]*B[1][j] + B[2][j]*B[2][j];
+    const int pairs[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+    for (const auto& pr : pairs)
+    {
+        const int i = pr[0], j = pr[1];
+        if (rho[i] >= rho[j]) continue;
+        swap(rho[i], rho[j]);
+        for (int k=0; k<3; k++)
+        {
+            const float bi = B[k][i];
+            B[k][i] = B[k][j];
+            B[k][j] = -bi;
+        }
+        RotateQuaternion(v, i, j, SVDSqrtHalf, SVDSqrtHalf);
+    }
+    QuaternionToRotation(v, V);
+
+    // U is the orthogonal factor of the QR decomposition of B, and its triangle is diagonal
+    u[0] = u[1] = u[2] = 0.0f; u[3] = 1.0f;
+    QRGivens(B, u, 0, 1, 0);
+    QRGivens(B, u, 0, 2, 0);
+    QRGivens(B, u, 1, 2, 1);
+    QuaternionToRotation(u, U);
+    for (int i=0; i<3; i++) sigma[i] = m*B[i][i];
+}
+
+void SVD(const Matrix3& M, Matrix3& U, Vector3& sigma, Matrix3& V) noexcept
+{
+    float u[4], v[4], Ur[3][3], Vr[3][3], s[3];
+    SVD(M, u, Ur, s, v, Vr);
+    U = Matrix3(Ur[0][0], Ur[0][1], Ur[0][2], Ur[1][0], Ur[1][1], Ur[1][2], Ur[2][0], Ur[2][1], Ur[2][2]);
+    V = Matrix3(Vr[0][0], Vr[0][1], Vr[0][2], Vr[1][0], Vr[1][1], Vr[1][2], Vr[2][0], Vr[2][1], Vr[2][2]);
+    sigma = Vector3(s[0], s[1], s[2]);
+}
+
+void SVD(const Matrix3& M, Quaternion& U, Vector3& sigma, Quaternion& V) noexcept
+{
+    float u[4], v[4], Ur[3][3], Vr[3][3], s[3];
+    SVD(M, u, Ur, s, v, Vr);
+    U = Quaternion(u[0], u[1], u[2], u[3]);
+    V = Quaternion(v[0], v[1], v[2], v[3]);
+    sigma = Vector3(s[0], s[1], s[2]);
+}
+
+// * * * * * INTERPOLATION * * * * * //
+
+// sin(t*theta)/sin(theta) for cos(theta) = d + 1: t times the series 1 + c1*d*(1 + c2*d*(...)),
+// ci = ui*t^2 - vi = (t^2 - i^2)/(i*(2i + 1)), evaluated by Horner's rule
+static inline float SlerpWeight(float d, float t)
+{
+    const float t2 = t*t;
+    float s = 1.0f;
+    for (int i=SlerpFastTerms; i>=1; i--) s = 1.0f + (SlerpFastSeries.u[i]*t2 - SlerpFastSeries.v[i])*d*s;
+    return t*s;
+}
+
+Quaternion Nlerp(const Quaternion& a, const Quaternion& b, float t) noexcept
+{
+    const float d = a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;
+    const float tb = (d < 0.0f) ? -t : t;
+    return Normalize((1.0f - t)*a + tb*b);
+}
+
+Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t) noexcept
+{
+    float d = a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;
+    const float sign = (d < 0.0f) ? -1.0f : 1.0f;
+    d = fabsf(d);
+    if (d > MATH_SLERP_THRESHOLD) return Nlerp(a, b, t);
+    const float theta = acosf(d);
+    const float inv = 1.0f/sinf(theta);
+    return (sinf((1.0f - t)*theta)*inv)*a + (sign*sinf(t*theta)*inv)*b;
+}
+
+Quaternion SlerpFast(const Quaternion& a, const Quaternion& b, float t) noexcept
+{
+    const float d = a.x*b.x + a.y*b.y + a.z*b.z + a.w*b.w;
+    const float sign = (d < 0.0f) ? -1.0f : 1.0f;
+    const float x = fabsf(d) - 1.0f;
+    return SlerpWeight(x, 1.0f - t)*a + (sign*SlerpWeight(x, t))*b;
+}
@@ -0,0 +1,90 @@
+#include "Math\Rebase.h"
+
+static_assert(sizeof(Point3d) == 3*sizeof(double) && sizeof(Point3) == 3*sizeof(float), "Points must be tightly packed");
+static_assert(sizeof(Transform4d) == 16*sizeof(double) && sizeof(Transform4) == 16*sizeof(float), "Transforms must be tightly packed");
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * POSITIONS * * * * * //
+
+// Both arrays are read as flat coordinate streams x0 y0 z0 x1 ..., so 4 points are 12 doubles
+// against an origin pattern that repeats every 3 values
+void Rebase(const Point3d *in, int count, const Point3d& origin, Point3 *out)
+{
+    const double *src = &in[0].x;
+    float *dst = &out[0].x;
+    int i = 0;
+#if MATH_SIMD_AVX
+    __m256d o0 = _mm256_setr_pd(origin.x, origin.y, origin.z, origin.x);
+    __m256d o1 = _mm256_setr_pd(origin.y, origin.z, origin.x, origin.y);
+    __m256d o2 = _mm256_setr_pd(origin.z, origin.x, origin.y, origin.z);
+    for (; i + 4 <= count; i += 4, src += 12, dst += 12)
+    {
+        _mm_storeu_ps(dst, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src), o0)));
+        _mm_storeu_ps(dst + 4, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src + 4), o1)));
+        _mm_storeu_ps(dst + 8, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src + 8), o2)));
+    }
+#elif MATH_SIMD_SSE
+    __m128d o0 = _mm_setr_pd(origin.x, origin.y), o1 = _mm_setr_pd(origin.z, origin.x), o2 = _mm_setr_pd(origin.y, origin.z);
+    for (; i + 4 <= count; i += 4, src += 12, dst += 12)
+    {
+        __m128 a = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src), o0));
+        __m128 b = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 2), o1));
+        __m128 c = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 4), o2));
+        __m128 d = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 6), o0));
+        __m128 e = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 8), o1));
+        __m128 f = _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 10), o2));
+        _mm_storeu_ps(dst, _mm_movelh_ps(a, b));
+        _mm_storeu_ps(dst + 4, _mm_movelh_ps(c, d));
+        _mm_storeu_ps(dst + 8, _mm_movelh_ps(e, f));
+    }
+#endif
+    for (; i < count; i++) out[i] = Rebase(in[i], origin);
+}
+
+void Rebase(const Point3d *in, const Point3d& origin, const SoASpan<Point3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= out.count; i += MATH_BATCH_WIDTH)
+    {
+        Point3 p[MATH_BATCH_WIDTH];
+        Rebase(in + i, MATH_BATCH_WIDTH, origin, p);
+        for (int k=0; k<3; k++)
+            for (int j=0; j<MATH_BATCH_WIDTH; j++) out[k][i + j] = p[j][k];
+    }
+    for (; i < out.count; i++) out.Set(i, Rebase(in[i], origin));
+}
+
+// * * * * * TRANSFORMS * * * * * //
+
+// Transforms are read column by column; only the translation column is offset by the origin
+void Rebase(const Transform4d *in, int count, const Point3d& origin, Transform4 *out)
+{
+#if MATH_SIMD_AVX
+    __m256d t = _mm256_setr_pd(origin.x, origin.y, origin.z, 0.0);
+    for (int i=0; i<count; i++)
+    {
+        const double *src = &in[i](0,0);
+        float *dst = &out[i](0,0);
+        _mm_storeu_ps(dst, _mm256_cvtpd_ps(_mm256_loadu_pd(src)));
+        _mm_storeu_ps(dst + 4, _mm256_cvtpd_ps(_mm256_loadu_pd(src + 4)));
+        _mm_storeu_ps(dst + 8, _mm256_cvtpd_ps(_mm256_loadu_pd(src + 8)));
+        _mm_storeu_ps(dst + 12, _mm256_cvtpd_ps(_mm256_sub_pd(_mm256_loadu_pd(src + 12), t)));
+    }
+#elif MATH_SIMD_SSE
+    __m128d t0 = _mm_setr_pd(origin.x, origin.y), t1 = _mm_setr_pd(origin.z, 0.0);
+    for (int i=0; i<count; i++)
+    {
+        const double *src = &in[i](0,0);
+        float *dst = &out[i](0,0);
+        for (int j=0; j<3; j++)
+            _mm_storeu_ps(dst + 4*j, _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(src + 4*j)), _mm_cvtpd_ps(_mm_loadu_pd(src + 4*j + 2))));
+        _mm_storeu_ps(dst + 12, _mm_movelh_ps(_mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 12), t0)),
+                                              _mm_cvtpd_ps(_mm_sub_pd(_mm_loadu_pd(src + 14), t1))));
+    }
+#else
+    for (int i=0; i<count; i++) out[i] = Rebase(in[i], origin);
+#endif
+}
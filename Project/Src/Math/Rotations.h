@@ -0,0 +1,38 @@
+#pragma once
+
+/*!
+ * Constants shared by the scalar rotation kernels of Matrices.cpp and their 8 lane forms in
+ * Transforms.cpp, so that both compute the same decompositions and interpolations. Internal to
+ * the library sources; not part of the public headers.
+ */
+
+// * * * * * SINGULAR VALUE DECOMPOSITION * * * * * //
+
+// Half angle cosine and sine of a quarter turn
+static const float SVDSqrtHalf = 0.7071067812f;
+// Below this length (relative to the largest element) a Givens pivot column counts as zero
+static const float SVDEpsilon = 1.0e-6f;
+
+// * * * * * INTERPOLATION * * * * * //
+
+// Coefficients ui = 1/(i*(2i + 1)) and vi = i/(2i + 1) of the series of sin(t*theta)/sin(theta),
+// the last pair scaled by the factor minimizing the largest error of the truncated series
+template<int Terms>
+struct SlerpSeries
+{
+    float u[Terms + 1], v[Terms + 1];
+    constexpr SlerpSeries(float correction) : u(), v()
+    {
+        for (int i=1; i<=Terms; i++)
+        {
+            const float k = (i == Terms) ? correction : 1.0f;
+            u[i] = k/float(i*(2*i + 1));
+            v[i] = k*float(i)/float(2*i + 1);
+        }
+    }
+};
+// The series of SlerpFast(), and the longer one of the batch Slerp(), whose truncation error
+// (3e-8) is below float rounding
+static const int SlerpFastTerms = 8;
+static constexpr SlerpSeries<SlerpFastTerms> SlerpFastSeries(1.85298109f);
+static constexpr SlerpSeries<16> SlerpExactSeries(1.91668f);
@@ -0,0 +1,167 @@
+#include "Math\Skinning.h"
+#include "Math\Packets.h"
+
+using namespace std;
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * KERNEL * * * * * //
+
+// Loads N components of the n elements starting at element i, filling a partial packet with fill
+template<int N, typename T>
+static inline void Gather(const SoASpan<const T>& s, int i, int n, Floatx8 *v, const float *fill)
+{
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<N; k++) v[k] = Floatx8::Load(s[k] + i);
+        return;
+    }
+    float f[N][MATH_BATCH_WIDTH];
+    for (int k=0; k<N; k++)
+        for (int j=0; j<MATH_BATCH_WIDTH; j++) f[k][j] = (j < n) ? s[k][i + j] : fill[k];
+    for (int k=0; k<N; k++) v[k] = Floatx8::Load(f[k]);
+}
+
+// Stores N components of the first n lanes into the elements starting at element i
+template<int N, typename T>
+static inline void Scatter(const SoASpan<T>& s, int i, int n, const Floatx8 *v)
+{
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<N; k++) v[k].Store(s[k] + i);
+        return;
+    }
+    float f[N][MATH_BATCH_WIDTH];
+    for (int k=0; k<N; k++) v[k].Store(f[k]);
+    for (int k=0; k<N; k++)
+        for (int j=0; j<n; j++) s[k][i + j] = f[k][j];
+}
+
+// Blends the palette entries, Q packets of 4 floats each, of vertex i: sum of w[k]*entry over the
+// influences. With Flip, entries whose first packet (a rotation) has a negative dot product with
+// that of the first influence are subtracted instead
+template<int Q, bool Flip>
+static inline void BlendVertex(const float *base, const uint16_t *bones, const float *w, Floatx4 *c)
+{
+    const float *e0 = base + 4*Q*bones[0];
+    const Floatx4 w0 = Floatx4::Broadcast(w[0]);
+    for (int q=0; q<Q; q++) c[q] = w0*Floatx4::Load(e0 + 4*q);
+    for (int k=1; k<MATH_SKINNING_INFLUENCES; k++)
+    {
+        const float *e = base + 4*Q*bones[k];
+        float wk = w[k];
+        if (Flip && e[0]*e0[0] + e[1]*e0[1] + e[2]*e0[2] + e[3]*e0[3] < 0.0f) wk = -wk;
+        const Floatx4 s = Floatx4::Broadcast(wk);
+        for (int q=0; q<Q; q++) c[q] = MulAdd(s, Floatx4::Load(e + 4*q), c[q]);
+    }
+}
+
+// Blends the palette entries of the n vertices starting at vertex i and transposes them to
+// t[4*q + r][lane], element r of packet q. Lanes past n take palette entry 0 whole
+template<int Q, bool Flip>
+static inline void BlendPacket(const float *base, const uint16_t *bones, const SoASpan<const Vector4>& weights, int i, int n,
+                               float t[4*Q][MATH_BATCH_WIDTH])
+{
+    static const uint16_t padBones[MATH_SKINNING_INFLUENCES] = {};
+    static const float padWeights[MATH_SKINNING_INFLUENCES] = {1.0f, 0.0f, 0.0f, 0.0f};
+    Floatx4 c[MATH_BATCH_WIDTH][Q];
+    for (int j=0; j<MATH_BATCH_WIDTH; j++)
+    {
+        if (j >= n) {BlendVertex<Q, false>(base, padBones, padWeights, c[j]); continue;}
+        const float w[MATH_SKINNING_INFLUENCES] = {weights[0][i + j], weights[1][i + j], weights[2][i + j], weights[3][i + j]};
+        BlendVertex<Q, Flip>(base, bones + MATH_SKINNING_INFLUENCES*(i + j), w, c[j]);
+    }
+    for (int h=0; h<MATH_BATCH_WIDTH; h += 4)
+        for (int q=0; q<Q; q++)
+        {
+#if MATH_SIMD_SSE
+            __m128 r0 = c[h][q].v, r1 = c[h + 1][q].v, r2 = c[h + 2][q].v, r3 = c[h + 3][q].v;
+            _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+            _mm_storeu_ps(t[4*q] + h, r0);
+            _mm_storeu_ps(t[4*q + 1] + h, r1);
+            _mm_storeu_ps(t[4*q + 2] + h, r2);
+            _mm_storeu_ps(t[4*q + 3] + h, r3);
+#else
+            for (int j=0; j<4; j++)
+                for (int r=0; r<4; r++) t[4*q + r][h + j] = c[h + j][q].f[r];
+#endif
+        }
+}
+
+static const float PaddingNormal[3] = {0.0f, 0.0f, 1.0f};
+static const float PaddingPosition[3] = {0.0f, 0.0f, 0.0f};
+
+// * * * * * LINEAR BLEND * * * * * //
+
+void SkinLinear(const Transform4 *palette, const uint16_t *bones, const SoASpan<const Vector4>& weights,
+                const SoASpan<const Point3>& positions, const SoASpan<const Vector3>& normals,
+                const SoASpan<Point3>& outPositions, const SoASpan<Vector3>& outNormals)
+{
+    static_assert(sizeof(Transform4) == 16*sizeof(float), "palette entries are 16 floats");
+    const float *base = reinterpret_cast<const float *>(palette);
+    const bool skinNormals = normals.count > 0;
+    ParallelFor(positions.count, MATH_SKINNING_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            // Blended matrix, blend[4*c + r] = M(r,c) as stored in the column-major palette
+            float blend[16][MATH_BATCH_WIDTH];
+            BlendPacket<4, false>(base, bones, weights, i, n, blend);
+            Floatx8 m[16];
+            for (int e=0; e<16; e++) if (e % 4 != 3) m[e] = Floatx8::Load(blend[e]);
+
+            Floatx8 p[3], res[3];
+            Gather<3>(positions, i, n, p, PaddingPosition);
+            for (int r=0; r<3; r++) res[r] = MulAdd(m[r], p[0], MulAdd(m[4 + r], p[1], MulAdd(m[8 + r], p[2], m[12 + r])));
+            Scatter<3>(outPositions, i, n, res);
+            if (!skinNormals) continue;
+            Gather<3>(normals, i, n, p, PaddingNormal);
+            for (int r=0; r<3; r++) res[r] = MulAdd(m[r], p[0], MulAdd(m[4 + r], p[1], m[8 + r]*p[2]));
+            const Floatx8 inv = Floatx8::Broadcast(1.0f)/Sqrt(res[0]*res[0] + res[1]*res[1] + res[2]*res[2]);
+            for (int r=0; r<3; r++) res[r] = res[r]*inv;
+            Scatter<3>(outNormals, i, n, res);
+        }
+    });
+}
+
+// * * * * * DUAL QUATERNION * * * * * //
+
+void SkinDualQuaternion(const DualQuaternion *palette, const uint16_t *bones, const SoASpan<const Vector4>& weights,
+                        const SoASpan<const Point3>& positions, const SoASpan<const Vector3>& normals,
+                        const SoASpan<Point3>& outPositions, const SoASpan<Vector3>& outNormals)
+{
+    static_assert(sizeof(DualQuaternion) == 8*sizeof(float), "palette entries are 8 floats");
+    const float *base = reinterpret_cast<const float *>(palette);
+    const bool skinNormals = normals.count > 0;
+    ParallelFor(positions.count, MATH_SKINNING_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            float blend[8][MATH_BATCH_WIDTH];
+            BlendPacket<2, true>(base, bones, weights, i, n, blend);
+            Floatx8 b[8];
+            for (int e=0; e<8; e++) b[e] = Floatx8::Load(blend[e]);
+            const Floatx8 inv = Floatx8::Broadcast(1.0f)/Sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2] + b[3]*b[3]);
+            const Quaternionx8 real(b[0]*inv, b[1]*inv, b[2]*inv, b[3]*inv);
+            const Vector3x8 u = real.GetVector(), d(b[4]*inv, b[5]*inv, b[6]*inv);
+            const Floatx8 dw = b[7]*inv;
+            // Translation 2*(w*d - dw*u + u x d), as in DualQuaternion::GetTranslation()
+            const Vector3x8 t = (d*real.w - u*dw + CrossProduct(u, d))*2.0f;
+
+            Floatx8 p[3];
+            Gather<3>(positions, i, n, p, PaddingPosition);
+            const Vector3x8 r = Rotate(Vector3x8(p[0], p[1], p[2]), real) + t;
+            Floatx8 res[3] = {r.x, r.y, r.z};
+            Scatter<3>(outPositions, i, n, res);
+            if (!skinNormals) continue;
+            Gather<3>(normals, i, n, p, PaddingNormal);
+            const Vector3x8 nr = Rotate(Vector3x8(p[0], p[1], p[2]), real);
+            Floatx8 nres[3] = {nr.x, nr.y, nr.z};
+            Scatter<3>(outNormals, i, n, nres);
+        }
+    });
+}
@@ -0,0 +1,228 @@
+#include "Math\SoA.h"
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * INNER PRODUCTS * * * * * //
+
+void InnerProduct(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, float *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 d = Floatx8::Load(a[0] + i) * Floatx8::Load(b[0] + i)
+                  + Floatx8::Load(a[1] + i) * Floatx8::Load(b[1] + i)
+                  + Floatx8::Load(a[2] + i) * Floatx8::Load(b[2] + i);
+        d.Store(out + i);
+    }
+    for (; i < a.count; i++) out[i] = InnerProduct(a.Get(i), b.Get(i));
+}
+
+// * * * * * 3D CROSS PRODUCT * * * * * //
+
+void CrossProduct(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        (ay*bz - az*by).Store(out[0] + i);
+        (az*bx - ax*bz).Store(out[1] + i);
+        (ax*by - ay*bx).Store(out[2] + i);
+    }
+    for (; i < a.count; i++) out.Set(i, CrossProduct(a.Get(i), b.Get(i)));
+}
+
+// * * * * * MAGNITUDES * * * * * //
+
+void Magnitude(const SoASpan<const Vector3>& a, float *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 x = Floatx8::Load(a[0] + i), y = Floatx8::Load(a[1] + i), z = Floatx8::Load(a[2] + i);
+        Sqrt(x*x + y*y + z*z).Store(out + i);
+    }
+    for (; i < a.count; i++) out[i] = Magnitude(a.Get(i));
+}
+
+// * * * * * NORMALIZATION * * * * * //
+
+void Normalize(const SoASpan<const Vector3>& a, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 x = Floatx8::Load(a[0] + i), y = Floatx8::Load(a[1] + i), z = Floatx8::Load(a[2] + i);
+        Floatx8 sc = Floatx8::Broadcast(1.0f) / Sqrt(x*x + y*y + z*z);
+        (x*sc).Store(out[0] + i);
+        (y*sc).Store(out[1] + i);
+        (z*sc).Store(out[2] + i);
+    }
+    for (; i < a.count; i++) out.Set(i, Normalize(a.Get(i)));
+}
+
+// * * * * * FAST NORMALIZATION * * * * * //
+
+void InvMagnitudeFast(const SoASpan<const Vector3>& a, float *out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 x = Floatx8::Load(a[0] + i), y = Floatx8::Load(a[1] + i), z = Floatx8::Load(a[2] + i);
+        InvSqrtFast(x*x + y*y + z*z).Store(out + i);
+    }
+    for (; i < a.count; i++) out[i] = InvMagnitudeFast(a.Get(i));
+}
+
+void NormalizeFast(const SoASpan<const Vector3>& a, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 x = Floatx8::Load(a[0] + i), y = Floatx8::Load(a[1] + i), z = Floatx8::Load(a[2] + i);
+        Floatx8 sc = InvSqrtFast(x*x + y*y + z*z);
+        (x*sc).Store(out[0] + i);
+        (y*sc).Store(out[1] + i);
+        (z*sc).Store(out[2] + i);
+    }
+    for (; i < a.count; i++) out.Set(i, NormalizeFast(a.Get(i)));
+}
+
+// * * * * * PROJECTIONS * * * * * //
+
+void Projection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        Floatx8 sc = (ax*bx + ay*by + az*bz) / (bx*bx + by*by + bz*bz);
+        (sc*bx).Store(out[0] + i);
+        (sc*by).Store(out[1] + i);
+        (sc*bz).Store(out[2] + i);
+    }
+    for (; i < a.count; i++)
+    {
+        Vector3 u = a.Get(i), v = b.Get(i);
+        out.Set(i, ((u * v) / (v * v)) * v);
+    }
+}
+
+// * * * * * REJECTIONS * * * * * //
+
+void Rejection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out)
+{
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        Floatx8 sc = (ax*bx + ay*by + az*bz) / (bx*bx + by*by + bz*bz);
+        (ax - sc*bx).Store(out[0] + i);
+        (ay - sc*by).Store(out[1] + i);
+        (az - sc*bz).Store(out[2] + i);
+    }
+    for (; i < a.count; i++)
+    {
+        Vector3 u = a.Get(i), v = b.Get(i);
+        out.Set(i, u - ((u * v) / (v * v)) * v);
+    }
+}
+
+// * * * * * EXCEPTION-FREE VARIANTS * * * * * //
+
+// Scalar tail of the Try kernels: runs f on elements [first, count), writes their mask byte and
+// returns the bits of the invalid elements
+template<typename F>
+static int TryTail(int first, int count, uint8_t *valid, F f)
+{
+    if (first >= count) return 0;
+    int m = 0;
+    for (int j=0; first + j < count; j++) m |= int(f(first + j)) << j;
+    valid[first / MATH_BATCH_WIDTH] = uint8_t(m);
+    return m ^ ((1 << (count - first)) - 1);
+}
+
+bool TryProjection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out, uint8_t *valid) noexcept
+{
+    Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    int invalid = 0;
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        Floatx8 d = bx*bx + by*by + bz*bz;
+        Floatx8 ok = CmpGreater(d, zero);
+        // Invalid lanes divide by 1 and are masked to zero afterwards
+        Floatx8 sc = (ax*bx + ay*by + az*bz) / Select(ok, d, one);
+        And(ok, sc*bx).Store(out[0] + i);
+        And(ok, sc*by).Store(out[1] + i);
+        And(ok, sc*bz).Store(out[2] + i);
+        int m = MoveMask(ok);
+        valid[i / MATH_BATCH_WIDTH] = uint8_t(m);
+        invalid |= m ^ 0xFF;
+    }
+    invalid |= TryTail(i, a.count, valid, [&](int k)
+    {
+        Vector3 p;
+        bool ok = TryProjection(a.Get(k), b.Get(k), p);
+        out.Set(k, p);
+        return ok;
+    });
+    return (invalid == 0);
+}
+
+bool TryRejection(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, const SoASpan<Vector3>& out, uint8_t *valid) noexcept
+{
+    Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    int invalid = 0;
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        Floatx8 d = bx*bx + by*by + bz*bz;
+        Floatx8 ok = CmpGreater(d, zero);
+        Floatx8 sc = (ax*bx + ay*by + az*bz) / Select(ok, d, one);
+        (ax - And(ok, sc*bx)).Store(out[0] + i);
+        (ay - And(ok, sc*by)).Store(out[1] + i);
+        (az - And(ok, sc*bz)).Store(out[2] + i);
+        int m = MoveMask(ok);
+        valid[i / MATH_BATCH_WIDTH] = uint8_t(m);
+        invalid |= m ^ 0xFF;
+    }
+    invalid |= TryTail(i, a.count, valid, [&](int k)
+    {
+        Vector3 r;
+        bool ok = TryRejection(a.Get(k), b.Get(k), r);
+        out.Set(k, r);
+        return ok;
+    });
+    return (invalid == 0);
+}
+
+bool TryAngle(const SoASpan<const Vector3>& a, const SoASpan<const Vector3>& b, float *out, uint8_t *valid) noexcept
+{
+    Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f), inf = Floatx8::Broadcast(INFINITY);
+    int invalid = 0;
+    int i = 0;
+    for (; i + MATH_BATCH_WIDTH <= a.count; i += MATH_BATCH_WIDTH)
+    {
+        Floatx8 ax = Floatx8::Load(a[0] + i), ay = Floatx8::Load(a[1] + i), az = Floatx8::Load(a[2] + i);
+        Floatx8 bx = Floatx8::Load(b[0] + i), by = Floatx8::Load(b[1] + i), bz = Floatx8::Load(b[2] + i);
+        Floatx8 m = Sqrt(ax*ax + ay*ay + az*az) * Sqrt(bx*bx + by*by + bz*bz);
+        Floatx8 ok = And(CmpGreater(m, zero), CmpLess(m, inf));
+        Floatx8 c = (ax*bx + ay*by + az*bz) / Select(ok, m, one);
+        And(ok, Acos(Min(Max(c, -one), one))).Store(out + i);
+        int mask = MoveMask(ok);
+        valid[i / MATH_BATCH_WIDTH] = uint8_t(mask);
+        invalid |= mask ^ 0xFF;
+    }
+    invalid |= TryTail(i, a.count, valid, [&](int k) {return TryAngle(a.Get(k), b.Get(k), out[k]);});
+    return (invalid == 0);
+}
@@ -0,0 +1,1074 @@
+#include "Math\Transforms.h"
+#include "Math\Packets.h"
+#include "Rotations.h"
+#include <cfloat>
+
+//---------------------------------------------------------------------------------------------
+//                                       BATCH FUNCTIONS
+//---------------------------------------------------------------------------------------------
+
+// * * * * * KERNEL * * * * * //
+
+// Coefficients of a batch transform: output r of an element is the sum of in[k]*c[k][r] over its
+// NI inputs, plus c[NI][r] for affine transforms
+struct TransformCoefficients
+{
+    float c[5][4];
+};
+
+// Coefficients reading the matrix by columns, for M*v
+static TransformCoefficients Columns(const Matrix4& M)
+{
+    TransformCoefficients t = {};
+    for (int k=0; k<4; k++)
+        for (int r=0; r<4; r++) t.c[k][r] = M(r,k);
+    return t;
+}
+
+// Coefficients reading the matrix by rows, for v*M
+static TransformCoefficients Rows(const Matrix4& M)
+{
+    TransformCoefficients t = {};
+    for (int k=0; k<4; k++)
+        for (int r=0; r<4; r++) t.c[k][r] = M(k,r);
+    return t;
+}
+
+// Loads N components of the n elements starting at element i, zero filling a partial packet
+template<int N, typename T>
+static inline void Gather(const SoASpan<const T>& s, int i, int n, Floatx8 *v)
+{
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<N; k++) v[k] = Floatx8::Load(s[k] + i);
+        return;
+    }
+    float f[N][MATH_BATCH_WIDTH] = {};
+    for (int k=0; k<N; k++)
+        for (int j=0; j<n; j++) f[k][j] = s[k][i + j];
+    for (int k=0; k<N; k++) v[k] = Floatx8::Load(f[k]);
+}
+
+// Stores N components of the first n lanes into the elements starting at element i
+template<int N, typename T>
+static inline void Scatter(const SoASpan<T>& s, int i, int n, const Floatx8 *v)
+{
+    if (n == MATH_BATCH_WIDTH)
+    {
+        for (int k=0; k<N; k++) v[k].Store(s[k] + i);
+        return;
+    }
+    float f[N][MATH_BATCH_WIDTH];
+    for (int k=0; k<N; k++) v[k].Store(f[k]);
+    for (int k=0; k<N; k++)
+        for (int j=0; j<n; j++) s[k][i + j] = f[k][j];
+}
+
+// Runs one transform over an SoA span: NI components are read and NO written per element. Affine
+// transforms add the constant column c[NI], projective ones also compute output 3 (w) and divide
+// the outputs by it. Partial packets go through the same arithmetic as full ones, so every element
+// is rounded identically wherever it falls in the span
+template<int NI, int NO, bool Affine, bool Project, typename T, typename U>
+static void TransformBatch(const TransformCoefficients& t, const SoASpan<const T>& in, const SoASpan<U>& out)
+{
+    const int NR = Project ? 4 : NO;
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        Floatx8 c[NI + 1][NR];
+        for (int k=0; k<=NI; k++)
+            for (int r=0; r<NR; r++) c[k][r] = Floatx8::Broadcast(t.c[k][r]);
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            int n = min(MATH_BATCH_WIDTH, last - i);
+            Floatx8 a[NI], res[NR];
+            Gather<NI>(in, i, n, a);
+            for (int r=0; r<NR; r++)
+            {
+                Floatx8 s = a[0]*c[0][r];
+                for (int k=1; k<NI; k++) s = s + a[k]*c[k][r];
+                if (Affine) s = s + c[NI][r];
+                res[r] = s;
+            }
+            if (Project)
+                for (int r=0; r<NO; r++) res[r] = res[r] / res[3];
+            Scatter<NO>(out, i, n, res);
+        }
+    });
+}
+
+// Same transform over a strided array of structures, with the same rounding lane for lane. Packed
+// 3-component arrays are deinterleaved 4 elements at a time and run like the SoA kernel; any other
+// element is loaded into a single register and multiplied by the coefficient columns
+template<int NI, int NO, bool Affine, bool Project, typename T, typename U>
+static void TransformBatch(const TransformCoefficients& t, const StridedSpan<const T>& in, const StridedSpan<U>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+#if MATH_SIMD_SSE
+        __m128 c[NI + 1];
+        for (int k=0; k<=NI; k++) c[k] = _mm_loadu_ps(t.c[k]);
+        int i = first;
+        if (NI == 3 && NO == 3 && in.stride == 3*int(sizeof(float)) && out.stride == 3*int(sizeof(float)))
+        {
+            const int NR = Project ? 4 : NO;
+            __m128 b[NI + 1][NR];
+            for (int k=0; k<=NI; k++)
+                for (int r=0; r<NR; r++) b[k][r] = _mm_set1_ps(t.c[k][r]);
+            for (; i + 4 <= last; i += 4)
+            {
+                const float *p = reinterpret_cast<const float *>(&in[i]);
+                __m128 a[3], res[NR];
+                SimdDeinterleave3(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), a[0], a[1], a[2]);
+                for (int r=0; r<NR; r++)
+                {
+                    __m128 s = _mm_mul_ps(a[0], b[0][r]);
+                    s = _mm_add_ps(s, _mm_mul_ps(a[1], b[1][r]));
+                    s = _mm_add_ps(s, _mm_mul_ps(a[2], b[2][r]));
+                    if (Affine) s = _mm_add_ps(s, b[NI][r]);
+                    res[r] = s;
+                }
+                if (Project)
+                    for (int r=0; r<NO; r++) res[r] = _mm_div_ps(res[r], res[NR - 1]);
+                float *q = reinterpret_cast<float *>(&out[i]);
+                __m128 o0, o1, o2;
+                SimdInterleave3(res[0], res[1], res[2], o0, o1, o2);
+                _mm_storeu_ps(q, o0);
+                _mm_storeu_ps(q + 4, o1);
+                _mm_storeu_ps(q + 8, o2);
+            }
+        }
+        for (; i<last; i++)
+        {
+            const float *p = reinterpret_cast<const float *>(&in[i]);
+            __m128 a = (NI == 4) ? _mm_loadu_ps(p)
+                : _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(p)), _mm_load_ss(p + 2));
+            __m128 s = _mm_mul_ps(SimdSplat<0>(a), c[0]);
+            s = _mm_add_ps(s, _mm_mul_ps(SimdSplat<1>(a), c[1]));
+            s = _mm_add_ps(s, _mm_mul_ps(SimdSplat<2>(a), c[2]));
+            if (NI == 4) s = _mm_add_ps(s, _mm_mul_ps(SimdSplat<3>(a), c[3]));
+            if (Affine) s = _mm_add_ps(s, c[NI]);
+            if (Project) s = _mm_div_ps(s, SimdSplat<3>(s));
+            float *q = reinterpret_cast<float *>(&out[i]);
+            if (NO == 4) _mm_storeu_ps(q, s);
+            else {_mm_storel_pi(reinterpret_cast<__m64 *>(q), s); _mm_store_ss(q + 2, _mm_movehl_ps(s, s));}
+        }
+#else
+        const int NR = Project ? 4 : NO;
+        for (int i=first; i<last; i++)
+        {
+            float a[NI], res[NR];
+            memcpy(a, &in[i], sizeof(a));
+            for (int r=0; r<NR; r++)
+            {
+                float s = a[0]*t.c[0][r];
+                for (int k=1; k<NI; k++) s = s + a[k]*t.c[k][r];
+                if (Affine) s = s + t.c[NI][r];
+                res[r] = s;
+            }
+            if (Project)
+                for (int r=0; r<NO; r++) res[r] = res[r] / res[3];
+            memcpy(&out[i], res, NO*sizeof(float));
+        }
+#endif
+    });
+}
+
+// * * * * * TRANSFORM4 * * * * * //
+
+void TransformPoints(const Transform4& T, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out)
+    {TransformBatch<3, 3, true, false>(Columns(T), in, out);}
+void TransformPoints(const Transform4& T, const SoASpan<const Point3>& in, const SoASpan<Point3>& out)
+    {TransformBatch<3, 3, true, false>(Columns(T), in, out);}
+void TransformVectors(const Transform4& T, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {TransformVectors(static_cast<const Matrix4&>(T), in, out);}
+void TransformVectors(const Transform4& T, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {TransformVectors(static_cast<const Matrix4&>(T), in, out);}
+void TransformNormals(const Transform4& T, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {TransformNormals(static_cast<const Matrix4&>(T), in, out);}
+void TransformNormals(const Transform4& T, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {TransformNormals(static_cast<const Matrix4&>(T), in, out);}
+// The implicit bottom row (0,0,0,1) passes the plane constant through, as in Plane*Transform4
+void TransformPlanes(const Transform4& T, const StridedSpan<const Plane>& in, const StridedSpan<Plane>& out)
+    {TransformPlanes(static_cast<const Matrix4&>(T), in, out);}
+void TransformPlanes(const Transform4& T, const SoASpan<const Plane>& in, const SoASpan<Plane>& out)
+    {TransformPlanes(static_cast<const Matrix4&>(T), in, out);}
+
+// * * * * * MATRIX4 * * * * * //
+
+void TransformPoints(const Matrix4& M, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out)
+    {TransformBatch<3, 3, true, true>(Columns(M), in, out);}
+void TransformPoints(const Matrix4& M, const SoASpan<const Point3>& in, const SoASpan<Point3>& out)
+    {TransformBatch<3, 3, true, true>(Columns(M), in, out);}
+void TransformVectors(const Matrix4& M, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {TransformBatch<3, 3, false, false>(Columns(M), in, out);}
+void TransformVectors(const Matrix4& M, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {TransformBatch<3, 3, false, false>(Columns(M), in, out);}
+void TransformNormals(const Matrix4& M, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {TransformBatch<3, 3, false, false>(Rows(M), in, out);}
+void TransformNormals(const Matrix4& M, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {TransformBatch<3, 3, false, false>(Rows(M), in, out);}
+void TransformPlanes(const Matrix4& M, const StridedSpan<const Plane>& in, const StridedSpan<Plane>& out)
+    {TransformBatch<4, 4, false, false>(Rows(M), in, out);}
+void TransformPlanes(const Matrix4& M, const SoASpan<const Plane>& in, const SoASpan<Plane>& out)
+    {TransformBatch<4, 4, false, false>(Rows(M), in, out);}
+
+// * * * * * ROTATIONS * * * * * //
+
+// UnitQuaternion::GetRotation() on 8 lanes, q = (x, y, z, w) and r[i][j] = R(i,j)
+static inline void UnitQuaternionToRotation8(const Floatx8 (&q)[4], Floatx8 (&r)[3][3])
+{
+    const Floatx8 one = Floatx8::Broadcast(1.0f), two = Floatx8::Broadcast(2.0f);
+    const Floatx8 x = q[0], y = q[1], z = q[2], w = q[3];
+    r[0][0] = one - two*(y*y + z*z); r[0][1] = two*(x*y - w*z); r[0][2] = two*(x*z + w*y);
+    r[1][0] = two*(x*y + w*z); r[1][1] = one - two*(x*x + z*z); r[1][2] = two*(y*z - w*x);
+    r[2][0] = two*(x*z - w*y); r[2][1] = two*(y*z + w*x); r[2][2] = one - two*(x*x + y*y);
+}
+
+// UnitQuaternion::SetRotation() on 8 lanes: the four cases are blended by lane masks, so every
+// lane picks the same case, and the same quaternion sign, as the scalar functions
+static inline void RotationToUnitQuaternion8(const Floatx8 (&m)[3][3], Floatx8 (&q)[4])
+{
+    const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    const Floatx8 trace = m[0][0] + m[1][1] + m[2][2];
+    const Floatx8 caseW = CmpGreater(trace, zero);
+    const Floatx8 caseX = AndNot(caseW, And(CmpGreater(m[0][0], m[1][1]), CmpGreater(m[0][0], m[2][2])));
+    const Floatx8 caseY = AndNot(Or(caseW, caseX), CmpGreater(m[1][1], m[2][2]));
+    const Floatx8 t = Select(caseW, one + trace, Select(caseX, one + m[0][0] - m[1][1] - m[2][2],
+                      Select(caseY, one - m[0][0] + m[1][1] - m[2][2], one - m[0][0] - m[1][1] + m[2][2])));
+    const Floatx8 s = Floatx8::Broadcast(0.5f)*InvSqrtFast(t);
+    const Floatx8 dx = m[2][1] - m[1][2], dy = m[0][2] - m[2][0], dz = m[1][0] - m[0][1];
+    const Floatx8 sxy = m[1][0] + m[0][1], sxz = m[0][2] + m[2][0], syz = m[2][1] + m[1][2];
+    q[0] = s*Select(caseW, dx, Select(caseX, t, Select(caseY, sxy, sxz)));
+    q[1] = s*Select(caseW, dy, Select(caseX, sxy, Select(caseY, t, syz)));
+    q[2] = s*Select(caseW, dz, Select(caseX, sxz, Select(caseY, syz, t)));
+    q[3] = s*Select(caseW, t, Select(caseX, dx, Select(caseY, dy, dz)));
+}
+
+// Conversions over arrays of structures run the scalar functions, which have no branches either:
+// deinterleaving the 4 or 9 floats of every element costs more than the SIMD arithmetic saves
+void QuaternionsToRotations(const StridedSpan<const UnitQuaternion>& in, const StridedSpan<Matrix3>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i++) out[i] = in[i].GetRotation();
+    });
+}
+
+void RotationsToQuaternions(const StridedSpan<const Matrix3>& in, const StridedSpan<UnitQuaternion>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i++) out[i].SetRotation(in[i]);
+    });
+}
+
+// SoA conversions, 8 elements per step. Matrix3 streams run column by column
+void QuaternionsToRotations(const SoASpan<const UnitQuaternion>& in, const SoASpan<Matrix3>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            Floatx8 q[4], r[3][3], c[9];
+            Gather<4>(in, i, n, q);
+            UnitQuaternionToRotation8(q, r);
+            for (int k=0; k<9; k++) c[k] = r[k%3][k/3];
+            Scatter<9>(out, i, n, c);
+        }
+    });
+}
+
+void RotationsToQuaternions(const SoASpan<const Matrix3>& in, const SoASpan<UnitQuaternion>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            Floatx8 c[9], m[3][3], q[4];
+            Gather<9>(in, i, n, c);
+            for (int k=0; k<9; k++) m[k%3][k/3] = c[k];
+            RotationToUnitQuaternion8(m, q);
+            Scatter<4>(out, i, n, q);
+        }
+    });
+}
+
+// * * * * * QUATERNION ROTATION * * * * * //
+
+// Rotates the elements of an SoA span by one quaternion (shared), or else by the matching
+// element of rotations, 8 elements per step
+template<typename T>
+static void RotateBatch(const UnitQuaternion *shared, const SoASpan<const UnitQuaternion>& rotations, const SoASpan<const T>& in, const SoASpan<T>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        const Quaternionx8 broadcast = shared ? Quaternionx8(*shared) : Quaternionx8();
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            Floatx8 a[3], c[4];
+            Gather<3>(in, i, n, a);
+            Quaternionx8 q = broadcast;
+            if (!shared)
+            {
+                Gather<4>(rotations, i, n, c);
+                q = Quaternionx8(c[0], c[1], c[2], c[3]);
+            }
+            const Vector3x8 v = Rotate(Vector3x8(a[0], a[1], a[2]), q);
+            const Floatx8 r[3] = {v.x, v.y, v.z};
+            Scatter<3>(out, i, n, r);
+        }
+    });
+}
+
+// Same rotation over strided arrays of structures. Packed arrays are deinterleaved 4 elements
+// (and 4 packed quaternions) at a time; any other element runs the scalar function
+template<typename T>
+static void RotateBatch(const UnitQuaternion *shared, const StridedSpan<const UnitQuaternion>& rotations, const StridedSpan<const T>& in, const StridedSpan<T>& out)
+{
+    ParallelFor(in.count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        int i = first;
+#if MATH_SIMD_SSE
+        const int packed = 3*int(sizeof(float));
+        if (in.stride == packed && out.stride == packed && (shared || rotations.stride == int(sizeof(UnitQuaternion))))
+        {
+            const Quaternionx4 broadcast = shared ? Quaternionx4(*shared) : Quaternionx4();
+            for (; i + 4 <= last; i += 4)
+            {
+                const float *p = reinterpret_cast<const float *>(&in[i]);
+                __m128 x, y, z;
+                SimdDeinterleave3(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x, y, z);
+                Quaternionx4 q = broadcast;
+                if (!shared)
+                {
+                    const float *r = reinterpret_cast<const float *>(&rotations[i]);
+                    __m128 qx = _mm_loadu_ps(r), qy = _mm_loadu_ps(r + 4), qz = _mm_loadu_ps(r + 8), qw = _mm_loadu_ps(r + 12);
+                    _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+                    q = Quaternionx4(SimdPacket4(qx), SimdPacket4(qy), SimdPacket4(qz), SimdPacket4(qw));
+                }
+                const Vector3x4 v = Rotate(Vector3x4(SimdPacket4(x), SimdPacket4(y), SimdPacket4(z)), q);
+                float *o = reinterpret_cast<float *>(&out[i]);
+                __m128 o0, o1, o2;
+                SimdInterleave3(v.x.v, v.y.v, v.z.v, o0, o1, o2);
+                _mm_storeu_ps(o, o0);
+                _mm_storeu_ps(o + 4, o1);
+                _mm_storeu_ps(o + 8, o2);
+            }
+        }
+#endif
+        for (; i<last; i++)
+        {
+            const Vector3 v = Transform(in[i], shared ? *shared : rotations[i]);
+            out[i] = T(v.x, v.y, v.z);
+        }
+    });
+}
+
+void TransformVectors(const UnitQuaternion& q, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {RotateBatch(&q, StridedSpan<const UnitQuaternion>(), in, out);}
+void TransformVectors(const UnitQuaternion& q, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {RotateBatch(&q, SoASpan<const UnitQuaternion>(), in, out);}
+void TransformPoints(const UnitQuaternion& q, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out)
+    {RotateBatch(&q, StridedSpan<const UnitQuaternion>(), in, out);}
+void TransformPoints(const UnitQuaternion& q, const SoASpan<const Point3>& in, const SoASpan<Point3>& out)
+    {RotateBatch(&q, SoASpan<const UnitQuaternion>(), in, out);}
+void TransformVectors(const StridedSpan<const UnitQuaternion>& q, const StridedSpan<const Vector3>& in, const StridedSpan<Vector3>& out)
+    {RotateBatch(nullptr, q, in, out);}
+void TransformVectors(const SoASpan<const UnitQuaternion>& q, const SoASpan<const Vector3>& in, const SoASpan<Vector3>& out)
+    {RotateBatch(nullptr, q, in, out);}
+void TransformPoints(const StridedSpan<const UnitQuaternion>& q, const StridedSpan<const Point3>& in, const StridedSpan<Point3>& out)
+    {RotateBatch(nullptr, q, in, out);}
+void TransformPoints(const SoASpan<const UnitQuaternion>& q, const SoASpan<const Point3>& in, const SoASpan<Point3>& out)
+    {RotateBatch(nullptr, q, in, out);}
+
+// * * * * * INVERSION * * * * * //
+
+typedef Vector3xN<Floatx4> Vector3x4;
+
+// Loads 4 consecutive matrices: c[k][r] holds element (r,k) of every matrix, one per lane
+static inline void LoadMatrices4(const Matrix4 *m, Floatx4 (&c)[4][4])
+{
+    for (int k=0; k<4; k++)
+    {
+#if MATH_SIMD_SSE
+        __m128 r0 = _mm_loadu_ps(&m[0](0,k)), r1 = _mm_loadu_ps(&m[1](0,k)), r2 = _mm_loadu_ps(&m[2](0,k)), r3 = _mm_loadu_ps(&m[3](0,k));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        c[k][0] = SimdPacket4(r0); c[k][1] = SimdPacket4(r1); c[k][2] = SimdPacket4(r2); c[k][3] = SimdPacket4(r3);
+#else
+        for (int r=0; r<4; r++)
+        {
+            float f[4] = {m[0](r,k), m[1](r,k), m[2](r,k), m[3](r,k)};
+            c[k][r] = Floatx4::Load(f);
+        }
+#endif
+    }
+}
+
+// Stores 4 consecutive matrices from their lanes, the inverse of LoadMatrices4()
+static inline void StoreMatrices4(const Floatx4 (&c)[4][4], Matrix4 *m)
+{
+    for (int k=0; k<4; k++)
+    {
+#if MATH_SIMD_SSE
+        __m128 r0 = c[k][0].v, r1 = c[k][1].v, r2 = c[k][2].v, r3 = c[k][3].v;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(&m[0](0,k), r0); _mm_storeu_ps(&m[1](0,k), r1); _mm_storeu_ps(&m[2](0,k), r2); _mm_storeu_ps(&m[3](0,k), r3);
+#else
+        for (int r=0; r<4; r++)
+            for (int j=0; j<4; j++) m[j](r,k) = c[k][r].Lane(j);
+#endif
+    }
+}
+
+// Lanes whose determinant and reciprocal are both finite, like the scalar TryInverse
+static inline Floatx4 Invertible(const Floatx4& det, const Floatx4& sc)
+{
+    Floatx4 inf = Floatx4::Broadcast(INFINITY);
+    return And(CmpLess(Abs(det), inf), CmpLess(Abs(sc), inf));
+}
+
+// Packet form of TryInverse(const Matrix4&), operation for operation. Singular lanes are cleared
+static inline Floatx4 TryInverse4(Floatx4 (&m)[4][4], Floatx4& det)
+{
+    Vector3x4 a(m[0][0], m[0][1], m[0][2]), b(m[1][0], m[1][1], m[1][2]);
+    Vector3x4 c(m[2][0], m[2][1], m[2][2]), d(m[3][0], m[3][1], m[3][2]);
+    Floatx4 x = m[0][3], y = m[1][3], z = m[2][3], w = m[3][3];
+
+    Vector3x4 s = CrossProduct(a, b);
+    Vector3x4 t = CrossProduct(c, d);
+    Vector3x4 u = a*y - b*x;
+    Vector3x4 v = c*w - d*z;
+
+    det = (s*v)+(t*u);
+    Floatx4 sc = Floatx4::Broadcast(1.0f) / det;
+    Floatx4 ok = Invertible(det, sc);
+
+    s *= sc;
+    t *= sc;
+    u *= sc;
+    v *= sc;
+
+    Vector3x4 r0 = CrossProduct(b, v) + t*y;
+    Vector3x4 r1 = CrossProduct(v, a) - t*x;
+    Vector3x4 r2 = CrossProduct(d, u) + s*w;
+    Vector3x4 r3 = CrossProduct(u, c) - s*z;
+
+    Floatx4 inv[4][4] = {{r0.x, r1.x, r2.x, r3.x}, {r0.y, r1.y, r2.y, r3.y}, {r0.z, r1.z, r2.z, r3.z}, {-(b*t), (a*t), -(d*s), (c*s)}};
+    for (int k=0; k<4; k++)
+        for (int r=0; r<4; r++) m[k][r] = And(ok, inv[k][r]);
+    return ok;
+}
+
+// Packet form of TryInverse(const Transform4&), operation for operation. Singular lanes are
+// cleared like Transform4::Zero(), so every lane keeps the bottom row (0,0,0,1)
+static inline Floatx4 TryInverseTransform4(Floatx4 (&m)[4][4], Floatx4& det)
+{
+    Vector3x4 w(m[0][0], m[0][1], m[0][2]), x(m[1][0], m[1][1], m[1][2]);
+    Vector3x4 y(m[2][0], m[2][1], m[2][2]), z(m[3][0], m[3][1], m[3][2]);
+
+    Vector3x4 s = CrossProduct(w, x);
+    Vector3x4 t = CrossProduct(y, z);
+
+    det = s*y;
+    Floatx4 sc = Floatx4::Broadcast(1.0f) / det;
+    Floatx4 ok = Invertible(det, sc);
+
+    s *= sc;
+    t *= sc;
+
+    Vector3x4 vec = y*sc;
+    Vector3x4 r0 = CrossProduct(x, vec);
+    Vector3x4 r1 = CrossProduct(vec, w);
+
+    Floatx4 zero = Floatx4::Zero();
+    Floatx4 inv[4][4] = {{r0.x, r1.x, s.x, zero}, {r0.y, r1.y, s.y, zero}, {r0.z, r1.z, s.z, zero},
+                         {-(x*t), (w*t), -(z*s), zero}};
+    for (int k=0; k<4; k++)
+        for (int r=0; r<4; r++) m[k][r] = And(ok, inv[k][r]);
+    m[3][3] = Floatx4::Broadcast(1.0f);
+    return ok;
+}
+
+// True if the validity mask of count elements has every bit set
+static bool AllValid(const uint8_t *valid, int count)
+{
+    int invalid = 0;
+    for (int b=0; b < count / MATH_BATCH_WIDTH; b++) invalid |= valid[b] ^ 0xFF;
+    if (count % MATH_BATCH_WIDTH) invalid |= valid[count / MATH_BATCH_WIDTH] ^ ((1 << (count % MATH_BATCH_WIDTH)) - 1);
+    return (invalid == 0);
+}
+
+// Runs a packet inversion kernel over 8 matrices per step, as two groups of 4, and finishes the
+// remaining ones with the scalar function. Chunks handed to threads start on a mask byte
+template<typename M, typename Kernel>
+static bool TryInverseBatch(const M *in, int count, M *out, float *det, uint8_t *valid, Kernel kernel)
+{
+    ParallelFor(count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            int mask = 0;
+            for (int g=0; g<MATH_BATCH_WIDTH; g += 4)
+            {
+                Floatx4 m[4][4], d;
+                LoadMatrices4(in + i + g, m);
+                mask |= MoveMask(kernel(m, d)) << g;
+                StoreMatrices4(m, out + i + g);
+                if (det) d.Store(det + i + g);
+            }
+            valid[i / MATH_BATCH_WIDTH] = uint8_t(mask);
+        }
+        if (i < last)
+        {
+            int mask = 0;
+            for (int j=0; i + j < last; j++)
+            {
+                float d;
+                mask |= int(TryInverse(in[i + j], out[i + j], d)) << j;
+                if (det) det[i + j] = d;
+            }
+            valid[i / MATH_BATCH_WIDTH] = uint8_t(mask);
+        }
+    });
+    return AllValid(valid, count);
+}
+
+bool TryInverse(const Matrix4 *in, int count, Matrix4 *out, float *det, uint8_t *valid) noexcept
+{
+    return TryInverseBatch(in, count, out, det, valid, [](Floatx4 (&m)[4][4], Floatx4& d) {return TryInverse4(m, d);});
+}
+
+bool TryInverse(const Transform4 *in, int count, Transform4 *out, float *det, uint8_t *valid) noexcept
+{
+    return TryInverseBatch(in, count, out, det, valid, [](Floatx4 (&m)[4][4], Floatx4& d) {return TryInverseTransform4(m, d);});
+}
+
+// * * * * * TRS * * * * * //
+
+// Decompositions cost about as much as a few dozen point transforms, so threads take fewer elements
+static const int DecompositionParallelGrain = MATH_TRANSFORM_PARALLEL_GRAIN / 32;
+
+// Loads the 3x3 parts and translations of 8 transforms into column packets, lane l holding T[l]
+static inline void LoadTRS(const Transform4 *T, Vector3x8 (&a)[3], Point3x8& t)
+{
+    float c[12][MATH_BATCH_WIDTH];
+    for (int l=0; l<MATH_BATCH_WIDTH; l++)
+        for (int j=0; j<4; j++)
+            for (int i=0; i<3; i++) c[j*3 + i][l] = T[l](i,j);
+    for (int j=0; j<3; j++) a[j] = Vector3x8(Floatx8::Load(c[j*3]), Floatx8::Load(c[j*3 + 1]), Floatx8::Load(c[j*3 + 2]));
+    t = Point3x8(Floatx8::Load(c[9]), Floatx8::Load(c[10]), Floatx8::Load(c[11]));
+}
+
+// Quaternion::SetRotation() on 8 lanes, the unit quaternion kernel renormalized
+static inline Quaternionx8 RotationToQuaternion(const Vector3x8 (&r)[3])
+{
+    const Floatx8 m[3][3] = {{r[0].x, r[1].x, r[2].x}, {r[0].y, r[1].y, r[2].y}, {r[0].z, r[1].z, r[2].z}};
+    Floatx8 q[4];
+    RotationToUnitQuaternion8(m, q);
+    return Normalize(Quaternionx8(q[0], q[1], q[2], q[3]));
+}
+
+// DecomposeTRS() on 8 lanes. Every lane runs the scaled Newton iteration until all of them have
+// converged; extra iterations leave a converged lane unchanged. Returns the lane validity mask
+static inline Floatx8 DecomposeTRS8(Vector3x8 (&a)[3], Quaternionx8& q, Vector3x8& s)
+{
+    const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f), half = Floatx8::Broadcast(0.5f);
+    const Floatx8 det = a[0]*CrossProduct(a[1], a[2]);
+    const Floatx8 norm2 = a[0]*a[0] + a[1]*a[1] + a[2]*a[2];
+    const Floatx8 valid = CmpGreater(Abs(det), Floatx8::Broadcast(MATH_TRS_MIN_DETERMINANT)*norm2*Sqrt(norm2));
+    const Floatx8 flip = Select(CmpLess(det, zero), -one, one);
+    a[0] *= flip;
+
+    Vector3x8 x[3] = {a[0], a[1], a[2]};
+    // Singular lanes produce NaN and are never waited for
+    Floatx8 done = AndNot(valid, CmpEqual(zero, zero));
+    for (int it=0; it<MATH_TRS_MAX_ITERATIONS && MoveMask(done) != 0xFF; it++)
+    {
+        Vector3x8 c[3] = {CrossProduct(x[1], x[2]), CrossProduct(x[2], x[0]), CrossProduct(x[0], x[1])};
+        Floatx8 d = x[0]*c[0];
+        Floatx8 xn = x[0]*x[0] + x[1]*x[1] + x[2]*x[2];
+        Floatx8 cn = c[0]*c[0] + c[1]*c[1] + c[2]*c[2];
+        Floatx8 g = Sqrt(Sqrt(cn/(xn*d*d)));
+        Floatx8 h = half/(g*d);
+        Floatx8 hg = half*g;
+        Floatx8 change = zero;
+        for (int k=0; k<3; k++)
+        {
+            Vector3x8 n = x[k]*hg + c[k]*h;
+            change = Max(change, Max(Abs(n.x - x[k].x), Max(Abs(n.y - x[k].y), Abs(n.z - x[k].z))));
+            x[k] = n;
+        }
+        done = Or(done, CmpLess(change, Floatx8::Broadcast(MATH_TRS_TOLERANCE)));
+    }
+    s = Vector3x8(flip*(x[0]*a[0]), x[1]*a[1], x[2]*a[2]);
+    q = RotationToQuaternion(x);
+    // Singular lanes: identity rotation and the column lengths
+    s = Select(valid, s, Vector3x8(Magnitude(a[0]), Magnitude(a[1]), Magnitude(a[2])));
+    q = QuaternionxN<Floatx8>(Select(valid, q.x, zero), Select(valid, q.y, zero), Select(valid, q.z, zero), Select(valid, q.w, one));
+    return valid;
+}
+
+bool DecomposeTRS(const Transform4 *in, int count, Point3 *translation, Quaternion *rotation, Vector3 *scale, uint8_t *valid) noexcept
+{
+    ParallelFor(count, DecompositionParallelGrain, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            Vector3x8 a[3];
+            Point3x8 t;
+            Quaternionx8 q;
+            Vector3x8 s;
+            LoadTRS(in + i, a, t);
+            valid[i / MATH_BATCH_WIDTH] = uint8_t(MoveMask(DecomposeTRS8(a, q, s)));
+            float c[10][MATH_BATCH_WIDTH];
+            const Floatx8 *packets[10] = {&t.x, &t.y, &t.z, &q.x, &q.y, &q.z, &q.w, &s.x, &s.y, &s.z};
+            for (int k=0; k<10; k++) packets[k]->Store(c[k]);
+            for (int l=0; l<MATH_BATCH_WIDTH; l++)
+            {
+                translation[i + l] = Point3(c[0][l], c[1][l], c[2][l]);
+                rotation[i + l] = Quaternion(c[3][l], c[4][l], c[5][l], c[6][l]);
+                scale[i + l] = Vector3(c[7][l], c[8][l], c[9][l]);
+            }
+        }
+        if (i < last)
+        {
+            int mask = 0;
+            for (int j=0; i + j < last; j++)
+                mask |= int(DecomposeTRS(in[i + j], translation[i + j], rotation[i + j], scale[i + j])) << j;
+            valid[i / MATH_BATCH_WIDTH] = uint8_t(mask);
+        }
+    });
+    return AllValid(valid, count);
+}
+
+void ComposeTRS(const Point3 *translation, const Quaternion *rotation, const Vector3 *scale, int count, Transform4 *out) noexcept
+{
+    ParallelFor(count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        for (int i=first; i<last; i++) out[i] = ComposeTRS(translation[i], rotation[i], scale[i]);
+    });
+}
+
+// * * * * * EIGEN DECOMPOSITION * * * * * //
+
+// JacobiRotate() of Matrices.cpp on 8 lanes. Lanes whose a[p][q] is already zero get the identity
+// rotation (t = 0) instead of skipping, which leaves them unchanged
+static inline void JacobiRotate8(Floatx8 (&a)[3][3], Floatx8 (&v)[3][3], int p, int q)
+{
+    const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    const Floatx8 apq = a[p][q];
+    const Floatx8 skip = CmpEqual(apq, zero);
+    const int r = 3 - p - q;
+    const Floatx8 tau = (a[q][q] - a[p][p]) / (Floatx8::Broadcast(2.0f)*Select(skip, one, apq));
+    Floatx8 t = one / (Abs(tau) + Sqrt(one + tau*tau));
+    t = AndNot(skip, Or(t, And(tau, Floatx8::Broadcast(-0.0f))));
+    const Floatx8 c = one / Sqrt(one + t*t);
+    const Floatx8 s = t*c;
+    a[p][p] = a[p][p] - t*apq;
+    a[q][q] = a[q][q] + t*apq;
+    a[p][q] = a[q][p] = zero;
+    const Floatx8 arp = a[r][p], arq = a[r][q];
+    a[r][p] = a[p][r] = c*arp - s*arq;
+    a[r][q] = a[q][r] = s*arp + c*arq;
+    for (int i=0; i<3; i++)
+    {
+        const Floatx8 vp = v[i][p], vq = v[i][q];
+        v[i][p] = c*vp - s*vq;
+        v[i][q] = s*vp + c*vq;
+    }
+}
+
+// DiagonalizeSymmetric() on 8 matrices, leaving the eigenvectors in v (v[i][j] = R(i,j)) and the
+// sorted eigenvalues in d
+static inline void DiagonalizeSymmetric8(const Matrix3 *M, Floatx8 (&v)[3][3], Floatx8 (&d)[3])
+{
+    float c[9][MATH_BATCH_WIDTH];
+    for (int l=0; l<MATH_BATCH_WIDTH; l++)
+        for (int i=0; i<3; i++)
+            for (int j=0; j<3; j++) c[i*3 + j][l] = 0.5f*(M[l](i,j) + M[l](j,i));
+    Floatx8 a[3][3];
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++)
+        {
+            a[i][j] = Floatx8::Load(c[i*3 + j]);
+            v[i][j] = Floatx8::Broadcast(float(i == j));
+        }
+    for (int sweep=0; sweep<MATH_JACOBI_SWEEPS; sweep++)
+    {
+        JacobiRotate8(a, v, 0, 1);
+        JacobiRotate8(a, v, 0, 2);
+        JacobiRotate8(a, v, 1, 2);
+    }
+    for (int i=0; i<3; i++) d[i] = a[i][i];
+    const int pairs[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+    for (const auto& pr : pairs)
+    {
+        const int i = pr[0], j = pr[1];
+        const Floatx8 swap = CmpLess(d[i], d[j]);
+        const Floatx8 di = d[i];
+        d[i] = Select(swap, d[j], di);
+        d[j] = Select(swap, di, d[j]);
+        for (int k=0; k<3; k++)
+        {
+            const Floatx8 vi = v[k][i];
+            v[k][i] = Select(swap, v[k][j], vi);
+            v[k][j] = Select(swap, -vi, v[k][j]);
+        }
+    }
+}
+
+void DiagonalizeSymmetric(const Matrix3 *in, int count, Matrix3 *rotation, Vector3 *values) noexcept
+{
+    ParallelFor(count, DecompositionParallelGrain, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            Floatx8 v[3][3], d[3];
+            DiagonalizeSymmetric8(in + i, v, d);
+            float c[12][MATH_BATCH_WIDTH];
+            for (int k=0; k<9; k++) v[k/3][k%3].Store(c[k]);
+            for (int k=0; k<3; k++) d[k].Store(c[9 + k]);
+            for (int l=0; l<MATH_BATCH_WIDTH; l++)
+            {
+                rotation[i + l] = Matrix3(c[0][l], c[1][l], c[2][l], c[3][l], c[4][l], c[5][l], c[6][l], c[7][l], c[8][l]);
+                values[i + l] = Vector3(c[9][l], c[10][l], c[11][l]);
+            }
+        }
+        for (; i<last; i++) DiagonalizeSymmetric(in[i], rotation[i], values[i]);
+    });
+}
+
+void DiagonalizeSymmetric(const Matrix3 *in, int count, Quaternion *rotation, Vector3 *values) noexcept
+{
+    ParallelFor(count, DecompositionParallelGrain, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            Floatx8 v[3][3], d[3];
+            DiagonalizeSymmetric8(in + i, v, d);
+            Vector3x8 r[3] = {Vector3x8(v[0][0], v[1][0], v[2][0]), Vector3x8(v[0][1], v[1][1], v[2][1]), Vector3x8(v[0][2], v[1][2], v[2][2])};
+            Quaternionx8 q = RotationToQuaternion(r);
+            float c[7][MATH_BATCH_WIDTH];
+            const Floatx8 *packets[7] = {&q.x, &q.y, &q.z, &q.w, &d[0], &d[1], &d[2]};
+            for (int k=0; k<7; k++) packets[k]->Store(c[k]);
+            for (int l=0; l<MATH_BATCH_WIDTH; l++)
+            {
+                rotation[i + l] = Quaternion(c[0][l], c[1][l], c[2][l], c[3][l]);
+                values[i + l] = Vector3(c[4][l], c[5][l], c[6][l]);
+            }
+        }
+        for (; i<last; i++) DiagonalizeSymmetric(in[i], rotation[i], values[i]);
+    });
+}
+
+// * * * * * SINGULAR VALUE DECOMPOSITION * * * * * //
+
+// The helpers of SVD() in Matrices.cpp on 8 lanes, with selects in place of its branches
+
+static inline void RotateQuaternion8(Floatx8 (&q)[4], int i, int j, const Floatx8& ch, const Floatx8& sh)
+{
+    const int k = 3 - i - j;
+    const Floatx8 sk = (j == (i + 1) % 3) ? sh : -sh;
+    const Floatx8 qi = q[i], qj = q[j], qk = q[k], qw = q[3];
+    q[i] = ch*qi + sh*qj;
+    q[j] = ch*qj - sh*qi;
+    q[k] = ch*qk + sk*qw;
+    q[3] = ch*qw - sk*qk;
+}
+
+static inline void JacobiOrthogonalize8(Floatx8 (&b)[3][3], Floatx8 (&q)[4], int i, int j)
+{
+    const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    Floatx8 bii = zero, bjj = zero, bij = zero;
+    for (int k=0; k<3; k++)
+    {
+        bii = bii + b[k][i]*b[k][i];
+        bjj = bjj + b[k][j]*b[k][j];
+        bij = bij + b[k][i]*b[k][j];
+    }
+    const Floatx8 d = bii - bjj, e2 = Floatx8::Broadcast(2.0f)*bij;
+    const Floatx8 e = Select(CmpLess(d, zero), -e2, e2);
+    const Floatx8 r2 = d*d + e*e;
+    const Floatx8 w2 = AndNot(CmpLess(r2, Floatx8::Broadcast(FLT_MIN)), InvSqrtFast(Max(r2, Floatx8::Broadcast(FLT_MIN))));
+    const Floatx8 c2 = one + Abs(d)*w2, s2 = e*w2;
+    const Floatx8 w1 = InvSqrtFast(c2*c2 + s2*s2);
+    const Floatx8 c1 = one + c2*w1, s1 = s2*w1;
+    const Floatx8 w = InvSqrtFast(c1*c1 + s1*s1);
+    const Floatx8 ch = c1*w, sh = s1*w;
+    const Floatx8 c = ch*ch - sh*sh, s = Floatx8::Broadcast(2.0f)*ch*sh;
+    for (int k=0; k<3; k++)
+    {
+        const Floatx8 bi = b[k][i], bj = b[k][j];
+        b[k][i] = c*bi + s*bj;
+        b[k][j] = c*bj - s*bi;
+    }
+    RotateQuaternion8(q, i, j, ch, sh);
+}
+
+static inline void QRGivens8(Floatx8 (&b)[3][3], Floatx8 (&q)[4], int i, int j, int col)
+{
+    const Floatx8 eps = Floatx8::Broadcast(SVDEpsilon);
+    const Floatx8 a1 = b[i][col], a2 = b[j][col];
+    const Floatx8 r2 = a1*a1 + a2*a2;
+    const Floatx8 pivot = CmpGreater(r2, eps*eps);
+    const Floatx8 rho = Select(pivot, r2*InvSqrtFast(Max(r2, eps*eps)), eps);
+    const Floatx8 x = Abs(a1) + rho, y = And(pivot, a2);
+    const Floatx8 negative = CmpLess(a1, Floatx8::Zero());
+    Floatx8 ch = Select(negative, y, x), sh = Select(negative, x, y);
+    const Floatx8 w = InvSqrtFast(ch*ch + sh*sh);
+    ch = ch*w;
+    sh = sh*w;
+    const Floatx8 c = ch*ch - sh*sh, s = Floatx8::Broadcast(2.0f)*ch*sh;
+    for (int k=0; k<3; k++)
+    {
+        const Floatx8 bi = b[i][k], bj = b[j][k];
+        b[i][k] = c*bi + s*bj;
+        b[j][k] = c*bj - s*bi;
+    }
+    RotateQuaternion8(q, i, j, ch, sh);
+}
+
+static inline void QuaternionToRotation8(Floatx8 (&q)[4], Floatx8 (&r)[3][3])
+{
+    const Floatx8 n = InvSqrtFast(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3]);
+    for (int i=0; i<4; i++) q[i] = q[i]*n;
+    UnitQuaternionToRotation8(q, r);
+}
+
+// SVD() of 8 matrices into quaternions u and v, their matrices U and V, and the singular values
+static inline void SVD8(const Matrix3 *M, Floatx8 (&u)[4], Floatx8 (&U)[3][3], Floatx8 (&sigma)[3], Floatx8 (&v)[4], Floatx8 (&V)[3][3])
+{
+    const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+    float c[9][MATH_BATCH_WIDTH];
+    for (int l=0; l<MATH_BATCH_WIDTH; l++)
+        for (int i=0; i<3; i++)
+            for (int j=0; j<3; j++) c[i*3 + j][l] = M[l](i,j);
+    Floatx8 B[3][3], rho[3];
+    Floatx8 m = zero;
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++)
+        {
+            B[i][j] = Floatx8::Load(c[i*3 + j]);
+            m = Max(m, Abs(B[i][j]));
+        }
+    const Floatx8 scale = Select(CmpGreater(m, zero), one/Max(m, Floatx8::Broadcast(FLT_MIN)), one);
+    for (int i=0; i<3; i++)
+        for (int j=0; j<3; j++) B[i][j] = scale*B[i][j];
+
+    v[0] = v[1] = v[2] = zero; v[3] = one;
+    for (int sweep=0; sweep<MATH_SVD_SWEEPS; sweep++)
+    {
+        JacobiOrthogonalize8(B, v, 0, 1);
+        JacobiOrthogonalize8(B, v, 1, 2);
+        JacobiOrthogonalize8(B, v, 2, 0);
+    }
+
+    for (int j=0; j<3; j++) rho[j] = B[0][j]*B[0][j] + B[1][j]*B[1][j] + B[2][j]*B[2][j];
+    const Floatx8 half = Floatx8::Broadcast(SVDSqrtHalf);
+    const int pairs[3][2] = {{0, 1}, {1, 2}, {0, 1}};
+    for (const auto& pr : pairs)
+    {
+        const int i = pr[0], j = pr[1];
+        const Floatx8 swap = CmpLess(rho[i], rho[j]);
+        const Floatx8 ri = rho[i];
+        rho[i] = Select(swap, rho[j], ri);
+        rho[j] = Select(swap, ri, rho[j]);
+        for (int k=0; k<3; k++)
+        {
+            const Floatx8 bi = B[k][i];
+            B[k][i] = Select(swap, B[k][j], bi);
+            B[k][j] = Select(swap, -bi, B[k][j]);
+        }
+        RotateQuaternion8(v, i, j, Select(swap, half, one), And(swap, half));
+    }
+    QuaternionToRotation8(v, V);
+
+    u[0] = u[1] = u[2] = zero; u[3] = one;
+    QRGivens8(B, u, 0, 1, 0);
+    QRGivens8(B, u, 0, 2, 0);
+    QRGivens8(B, u, 1, 2, 1);
+    QuaternionToRotation8(u, U);
+    for (int i=0; i<3; i++) sigma[i] = m*B[i][i];
+}
+
+void SVD(const Matrix3 *in, int count, Matrix3 *U, Vector3 *sigma, Matrix3 *V) noexcept
+{
+    ParallelFor(count, DecompositionParallelGrain, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            Floatx8 u[4], v[4], Ur[3][3], Vr[3][3], s[3];
+            SVD8(in + i, u, Ur, s, v, Vr);
+            float c[21][MATH_BATCH_WIDTH];
+            for (int k=0; k<9; k++)
+            {
+                Ur[k/3][k%3].Store(c[k]);
+                Vr[k/3][k%3].Store(c[9 + k]);
+            }
+            for (int k=0; k<3; k++) s[k].Store(c[18 + k]);
+            for (int l=0; l<MATH_BATCH_WIDTH; l++)
+            {
+                U[i + l] = Matrix3(c[0][l], c[1][l], c[2][l], c[3][l], c[4][l], c[5][l], c[6][l], c[7][l], c[8][l]);
+                V[i + l] = Matrix3(c[9][l], c[10][l], c[11][l], c[12][l], c[13][l], c[14][l], c[15][l], c[16][l], c[17][l]);
+                sigma[i + l] = Vector3(c[18][l], c[19][l], c[20][l]);
+            }
+        }
+        for (; i<last; i++) SVD(in[i], U[i], sigma[i], V[i]);
+    });
+}
+
+void SVD(const Matrix3 *in, int count, Quaternion *U, Vector3 *sigma, Quaternion *V) noexcept
+{
+    ParallelFor(count, DecompositionParallelGrain, [&](int first, int last)
+    {
+        int i = first;
+        for (; i + MATH_BATCH_WIDTH <= last; i += MATH_BATCH_WIDTH)
+        {
+            Floatx8 u[4], v[4], Ur[3][3], Vr[3][3], s[3];
+            SVD8(in + i, u, Ur, s, v, Vr);
+            float c[11][MATH_BATCH_WIDTH];
+            for (int k=0; k<4; k++)
+            {
+                u[k].Store(c[k]);
+                v[k].Store(c[4 + k]);
+            }
+            for (int k=0; k<3; k++) s[k].Store(c[8 + k]);
+            for (int l=0; l<MATH_BATCH_WIDTH; l++)
+            {
+                U[i + l] = Quaternion(c[0][l], c[1][l], c[2][l], c[3][l]);
+                V[i + l] = Quaternion(c[4][l], c[5][l], c[6][l], c[7][l]);
+                sigma[i + l] = Vector3(c[8][l], c[9][l], c[10][l]);
+            }
+        }
+        for (; i<last; i++) SVD(in[i], U[i], sigma[i], V[i]);
+    });
+}
+
+// * * * * * INTERPOLATION * * * * * //
+
+// SlerpWeight() of Matrices.cpp on 8 lanes
+template<int Terms>
+static inline Floatx8 SlerpWeight8(const SlerpSeries<Terms>& series, const Floatx8& d, const Floatx8& t)
+{
+    const Floatx8 one = Floatx8::Broadcast(1.0f), t2 = t*t;
+    Floatx8 s = one;
+    for (int i=Terms; i>=1; i--)
+    {
+        const Floatx8 c = Floatx8::Broadcast(series.u[i])*t2 - Floatx8::Broadcast(series.v[i]);
+        s = MulAdd(c*d, s, one);
+    }
+    return t*s;
+}
+
+#if MATH_SIMD_SSE
+// Lanes 0-3 and 4-7 of a packet as SSE registers, and back
+static inline void SplitPacket(const Floatx8& p, __m128& lo, __m128& hi)
+{
+#if MATH_SIMD_AVX
+    lo = _mm256_castps256_ps128(p.v); hi = _mm256_extractf128_ps(p.v, 1);
+#else
+    lo = p.lo; hi = p.hi;
+#endif
+}
+static inline Floatx8 JoinPacket(__m128 lo, __m128 hi)
+{
+#if MATH_SIMD_AVX
+    return SimdPacket(_mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1));
+#else
+    return SimdPacket(lo, hi);
+#endif
+}
+#endif
+
+// Loads the n quaternions starting at q, padding a partial packet with the identity. A full
+// packet is transposed in registers, 4 quaternions at a time
+static inline void LoadQuaternions(const Quaternion *q, int n, Floatx8 (&v)[4])
+{
+#if MATH_SIMD_SSE
+    if (n == MATH_BATCH_WIDTH)
+    {
+        __m128 r[8];
+        for (int l=0; l<8; l++) r[l] = _mm_loadu_ps(&q[l].x);
+        _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+        _MM_TRANSPOSE4_PS(r[4], r[5], r[6], r[7]);
+        for (int k=0; k<4; k++) v[k] = JoinPacket(r[k], r[4 + k]);
+        return;
+    }
+#endif
+    float c[4][MATH_BATCH_WIDTH];
+    for (int l=0; l<n; l++) {c[0][l] = q[l].x; c[1][l] = q[l].y; c[2][l] = q[l].z; c[3][l] = q[l].w;}
+    for (int l=n; l<MATH_BATCH_WIDTH; l++) {c[0][l] = c[1][l] = c[2][l] = 0.0f; c[3][l] = 1.0f;}
+    for (int k=0; k<4; k++) v[k] = Floatx8::Load(c[k]);
+}
+
+// Stores the first n lanes as the quaternions starting at q, the inverse of LoadQuaternions()
+static inline void StoreQuaternions(const Floatx8 (&v)[4], int n, Quaternion *q)
+{
+#if MATH_SIMD_SSE
+    if (n == MATH_BATCH_WIDTH)
+    {
+        __m128 r[8];
+        for (int k=0; k<4; k++) SplitPacket(v[k], r[k], r[4 + k]);
+        _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+        _MM_TRANSPOSE4_PS(r[4], r[5], r[6], r[7]);
+        for (int l=0; l<8; l++) _mm_storeu_ps(&q[l].x, r[l]);
+        return;
+    }
+#endif
+    float c[4][MATH_BATCH_WIDTH];
+    for (int k=0; k<4; k++) v[k].Store(c[k]);
+    for (int l=0; l<n; l++) q[l] = Quaternion(c[0][l], c[1][l], c[2][l], c[3][l]);
+}
+
+// Blends every pair along the shorter arc: a null series is Nlerp(), otherwise both weights come
+// from the series. Partial packets run the same arithmetic as full ones
+template<int Terms>
+static void InterpolateBatch(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out, const SlerpSeries<Terms> *series)
+{
+    ParallelFor(count, MATH_TRANSFORM_PARALLEL_GRAIN, [&](int first, int last)
+    {
+        const Floatx8 zero = Floatx8::Zero(), one = Floatx8::Broadcast(1.0f);
+        for (int i=first; i<last; i += MATH_BATCH_WIDTH)
+        {
+            const int n = min(MATH_BATCH_WIDTH, last - i);
+            Floatx8 qa[4], qb[4], r[4];
+            LoadQuaternions(a + i, n, qa);
+            LoadQuaternions(b + i, n, qb);
+            float w[MATH_BATCH_WIDTH] = {};
+            if (n < MATH_BATCH_WIDTH) for (int l=0; l<n; l++) w[l] = t[i + l];
+            const Floatx8 tb = Floatx8::Load((n == MATH_BATCH_WIDTH) ? t + i : w), ta = one - tb;
+            const Floatx8 d = qa[0]*qb[0] + qa[1]*qb[1] + qa[2]*qb[2] + qa[3]*qb[3];
+            Floatx8 wa = ta, wb = tb;
+            if (series)
+            {
+                const Floatx8 x = Abs(d) - one;
+                wa = SlerpWeight8(*series, x, ta);
+                wb = SlerpWeight8(*series, x, tb);
+            }
+            wb = Select(CmpLess(d, zero), -wb, wb);
+            for (int k=0; k<4; k++) r[k] = wa*qa[k] + wb*qb[k];
+            if (!series)
+            {
+                // Normalize() as the scalar Nlerp(): the reciprocal of the exact magnitude
+                const Floatx8 s = one/Sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3]);
+                for (int k=0; k<4; k++) r[k] = r[k]*s;
+            }
+            StoreQuaternions(r, n, out + i);
+        }
+    });
+}
+
+void Nlerp(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept
+    {InterpolateBatch<8>(a, b, t, count, out, nullptr);}     // no series: the weights stay linear
+void Slerp(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept
+    {InterpolateBatch(a, b, t, count, out, &SlerpExactSeries);}
+void SlerpFast(const Quaternion *a, const Quaternion *b, const float *t, int count, Quaternion *out) noexcept
+    {InterpolateBatch(a, b, t, count, out, &SlerpFastSeries);}
@@ -4,15 +4,6 @@
 //                                          FUNCTIONS
 //---------------------------------------------------------------------------------------------
 
-// * * * * * 3D CROSS PRODUCT * * * * * //
-
-Vector3 CrossProduct(const Vector3& v1,const Vector3& v2)
-{
-    return (Vector3(v1.y*v2.z - v1.z*v2.y,
-                    v1.z*v2.x - v1.x*v2.z,
-                    v1.x*v2.y - v1.y*v2.x));
-}
-
 // * * * * * 3D SCALAR TRIPLE PRODUCT * * * * * //
 
 float ScalarTripleProduct(const Vector3& v1,const Vector3& v2,const Vector3& v3)
@@ -0,0 +1,6 @@
+@echo off
+
+setlocal
+for /f "tokens=2,3,4 delims=/ " %%f in ('date /t') do set d=%%h%%f%%g
+
+C:\Sources\RenderingEngine\Project\Test\Engine_Benchmark.exe > C:\Sources\RenderingEngine\Project\Logs\Benchmark\Benchmark_Math_%d%_%TIME:~0,2%%TIME:~3,2%%TIME:~6,2%.log